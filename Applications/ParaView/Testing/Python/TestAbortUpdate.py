@@ -0,0 +1,40 @@
+from paraview import servermanager
+from paraview.simple import *
+
+# Tests aborting a pipeline update from a progress observer: the update is
+# interrupted and the aborted algorithms execute again on the next update.
+connection = servermanager.ActiveConnection
+handler = connection.Session.GetProgressHandler()
+handler.SetProgressFrequency(0.01)
+
+wavelet = Wavelet(WholeExtent=[-80, 80, -80, 80, -80, 80])
+elevation = Elevation(Input=wavelet)
+
+def abortUpdate(caller, event):
+    connection.AbortUpdate()
+
+aborted = []
+def checkAborted(caller, event):
+    aborted.append(caller.GetAbortRequested())
+
+progressTag = handler.AddObserver("ProgressEvent", abortUpdate)
+endTag = handler.AddObserver("EndEvent", checkAborted)
+elevation.UpdatePipeline()
+handler.RemoveObserver(progressTag)
+handler.RemoveObserver(endTag)
+
+if not aborted or not aborted[0]:
+    raise RuntimeError("The update was not aborted")
+
+output = elevation.GetClientSideObject().GetOutputDataObject(0)
+abortedTime = output.GetMTime()
+
+# Without abort request, the whole pipeline executes again.
+elevation.UpdatePipeline()
+output = elevation.GetClientSideObject().GetOutputDataObject(0)
+if output.GetMTime() <= abortedTime:
+    raise RuntimeError("The aborted pipeline did not execute again")
+if output.GetNumberOfPoints() != 161 ** 3:
+    raise RuntimeError("Unexpected number of points: %d" % output.GetNumberOfPoints())
+if handler.GetAbortRequested():
+    raise RuntimeError("The abort request was not reset")
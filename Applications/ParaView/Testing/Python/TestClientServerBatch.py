@@ -0,0 +1,75 @@
+from paraview import servermanager
+from paraview import simple as smp
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+def getHost(url):
+   return url.split(':')[1][2:]
+def getPort(url):
+   return int(url.split(':')[2])
+
+def setResolution(sphere, resolution):
+    sphere.SMProxy.GetProperty("ThetaResolution").SetElement(0, resolution)
+    sphere.SMProxy.GetProperty("PhiResolution").SetElement(0, resolution)
+    sphere.SMProxy.UpdateVTKObjects()
+
+def runTest():
+    options = servermanager.vtkProcessModule.GetProcessModule().GetOptions()
+    url = options.GetServerURL()
+    smp.Connect(getHost(url), getPort(url))
+
+    session = servermanager.ActiveConnection.Session
+    if not session.IsA("vtkSMSessionClient"):
+        raise RuntimeError("Expected a client session")
+
+    spheres = [smp.Sphere() for i in range(3)]
+    session.FlushMessages()
+
+    # Pushes of several proxies are sent to the server as a single BATCH
+    # message and applied in order.
+    session.ResetStatistics()
+    session.StartBatch()
+    for i, sphere in enumerate(spheres):
+        setResolution(sphere, 3)
+        setResolution(sphere, 10 + i)
+    if session.GetNumberOfMessagesSent() != 0:
+        raise RuntimeError("Messages were sent before the end of the batch")
+    session.EndBatch()
+    if session.GetNumberOfBatches() != 1 or session.GetNumberOfBatchedMessages() != 6 or \
+       session.GetNumberOfMessagesSent() != 1:
+        raise RuntimeError("Unexpected batch statistics: %d batches, %d messages" % \
+            (session.GetNumberOfBatches(), session.GetNumberOfBatchedMessages()))
+    for i, sphere in enumerate(spheres):
+        sphere.UpdatePipeline()
+        resolution = 10 + i
+        expected = (resolution - 2) * resolution + 2
+        if sphere.GetDataInformation().GetNumberOfPoints() != expected:
+            raise RuntimeError("Batched properties were not applied in order")
+
+    # A synchronization point sends the queued messages first.
+    session.ResetStatistics()
+    session.StartBatch()
+    setResolution(spheres[0], 20)
+    setResolution(spheres[1], 20)
+    spheres[0].UpdatePipeline()
+    if spheres[0].GetDataInformation().GetNumberOfPoints() != 18 * 20 + 2 or \
+       session.GetNumberOfBatches() != 1:
+        raise RuntimeError("Batch was not flushed before the round trip")
+    session.EndBatch()
+
+    # All the pushes of an apply reach the server in one message, including
+    # the ones of subproxies.
+    rep = smp.Show(spheres[0])
+    smp.Render()
+    rep.SMProxy.GetProperty("Opacity").SetElement(0, 0.5)
+    rep.SMProxy.GetProperty("Visibility").SetElement(0, 0)
+    session.ResetStatistics()
+    rep.SMProxy.UpdateVTKObjects()
+    if session.GetNumberOfMessagesSent() > 1:
+        raise RuntimeError("UpdateVTKObjects() sent %d messages" % \
+            session.GetNumberOfMessagesSent())
+
+    smp.Disconnect()
+
+runTest()
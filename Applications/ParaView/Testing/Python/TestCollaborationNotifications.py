@@ -0,0 +1,103 @@
+from paraview import servermanager
+from paraview import simple as smp
+
+import time
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+def getHost(url):
+   return url.split(':')[1][2:]
+def getPort(url):
+   return int(url.split(':')[2])
+
+# The server runs with --observer-notification-interval=1000: the second
+# client, which is neither the master nor the active one, gets at most one
+# update per second.
+INTERVAL = 1.0
+
+def processEvents(duration):
+    nam = servermanager.vtkProcessModule.GetProcessModule().GetNetworkAccessManager()
+    end = time.time() + duration
+    while time.time() < end:
+        nam.ProcessEvents(50)
+
+def waitFor(condition, message):
+    nam = servermanager.vtkProcessModule.GetProcessModule().GetNetworkAccessManager()
+    end = time.time() + 10 * INTERVAL
+    while not condition():
+        if time.time() > end:
+            raise RuntimeError(message)
+        nam.ProcessEvents(50)
+
+def setRadius(sphere, radius):
+    sphere.SMProxy.GetProperty("Radius").SetElement(0, radius)
+    sphere.SMProxy.UpdateVTKObjects()
+
+def getRadius(proxy):
+    return proxy.GetProperty("Radius").GetElement(0)
+
+def runTest():
+    options = servermanager.vtkProcessModule.GetProcessModule().GetOptions()
+    url = options.GetServerURL()
+
+    # Two clients of the same server: the first one is the master.
+    master = smp.Connect(getHost(url), getPort(url))
+    observer = servermanager.Connect(getHost(url), getPort(url))
+    smp.SetActiveConnection(master)
+    observerSession = observer.Session
+    observerPxm = observerSession.GetSessionProxyManager()
+
+    sphere = smp.Sphere()
+    shrink = smp.Shrink(Input=sphere)
+    waitFor(lambda: observerPxm.GetProxy("sources", "Shrink1") is not None,
+        "Proxies of the master were not registered on the observer")
+    observerSphere = observerPxm.GetProxy("sources", "Sphere1")
+    observerShrink = observerPxm.GetProxy("sources", "Shrink1")
+
+    # Coalescing: the updates of a batch are merged in a single notification.
+    processEvents(INTERVAL + 0.5)
+    observerSession.ResetStatistics()
+    master.Session.StartBatch()
+    for i in range(10):
+        setRadius(sphere, 1 + i)
+    master.Session.EndBatch()
+    waitFor(lambda: getRadius(observerSphere) == 10,
+        "The observer did not get the last value of the batch")
+    if observerSession.GetNumberOfNotificationsReceived() != 1:
+        raise RuntimeError("Batched updates were sent in %d notifications" % \
+            observerSession.GetNumberOfNotificationsReceived())
+
+    # Throttling: separate updates within the interval are merged, and the
+    # last one is sent by the server event loop once the interval elapsed,
+    # without any other message from the clients.
+    observerSession.ResetStatistics()
+    start = time.time()
+    for i in range(10):
+        setRadius(sphere, 20 + i)
+    elapsed = time.time() - start
+    waitFor(lambda: getRadius(observerSphere) == 29,
+        "The observer did not get the throttled updates")
+    if elapsed < INTERVAL and observerSession.GetNumberOfNotificationsReceived() > 2:
+        raise RuntimeError("Throttled updates were sent in %d notifications" % \
+            observerSession.GetNumberOfNotificationsReceived())
+
+    # Ordering: an update referring to a proxy registered after a previous
+    # update of the same proxy, still queued, is not merged with it.
+    processEvents(INTERVAL + 0.5)
+    setRadius(sphere, 30)
+    shrink.SMProxy.GetProperty("ShrinkFactor").SetElement(0, 0.25)
+    shrink.SMProxy.UpdateVTKObjects()
+    sphere2 = smp.Sphere()
+    shrink.Input = sphere2
+    waitFor(lambda: observerPxm.GetProxy("sources", "Sphere2") is not None and \
+        observerShrink.GetProperty("Input").GetProxy(0) == \
+        observerPxm.GetProxy("sources", "Sphere2"),
+        "The observer did not get the new input")
+    if observerShrink.GetProperty("ShrinkFactor").GetElement(0) != 0.25:
+        raise RuntimeError("The observer did not get the shrink factor")
+
+    smp.Disconnect()
+    servermanager.Disconnect(observer)
+
+runTest()
@@ -64,6 +64,7 @@ static bool RealMain(int argc, char* argv[], vtkProcessModule::ProcessTypes type
 
   vtkPVSessionServer* session = vtkPVSessionServer::New();
   session->SetMultipleConnection(options->GetMultiClientMode() != 0);
+  session->SetObserverNotificationInterval(options->GetObserverNotificationInterval());
   int process_id = controller->GetLocalProcessId();
   if (process_id == 0)
   {
@@ -84,8 +85,11 @@ static bool RealMain(int argc, char* argv[], vtkProcessModule::ProcessTypes type
     pm->RegisterSession(session);
     if (controller->GetLocalProcessId() == 0)
     {
-      while (pm->GetNetworkAccessManager()->ProcessEvents(0) != -1)
+      // Wake up when throttled notifications are due, if any.
+      unsigned long timeout = 0;
+      while (pm->GetNetworkAccessManager()->ProcessEvents(timeout) != -1)
       {
+        timeout = session->FlushNotifications();
       }
     }
     else
@@ -17,6 +17,7 @@
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkCommand.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPSystemTools.h"
 #include "vtkPVConfig.h"
@@ -31,8 +32,10 @@
 #include "vtkProcessModule.h"
 
 #include <assert.h>
+#include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <vtksys/String.hxx>
 #include <vtksys/SystemTools.hxx>
@@ -64,10 +67,17 @@ public:
   std::string PluginName;
   vtkPVPlugin* Plugin;
   bool AutoLoad;
+  // Set for auto-load plugins that are loaded on demand, until loaded.
+  bool LazyLoad;
+  // (group, name) of the proxies listed in the manifest of the plugin.
+  std::set<std::pair<std::string, std::string> > Proxies;
+  // The <Plugin/> element the manifest was read from.
+  vtkSmartPointer<vtkPVXMLElement> Manifest;
   vtkItem()
   {
     this->Plugin = NULL;
     this->AutoLoad = false;
+    this->LazyLoad = false;
   }
 };
 
@@ -345,7 +355,31 @@ void vtkPVPluginTracker::LoadPluginConfigurationXML(vtkPVXMLElement* root, bool
       }
       vtkPVPluginTrackerDebugMacro("--- Found " << plugin_filename);
       unsigned int index = this->RegisterAvailablePlugin(plugin_filename.c_str());
-      if ((auto_load || forceLoad) && !this->GetPluginLoaded(index))
+
+      // Collect the manifest of the proxies defined by the plugin.
+      int lazy_load = 0;
+      child->GetScalarAttribute("lazy_load", &lazy_load);
+      std::set<std::pair<std::string, std::string> > proxies;
+      for (unsigned int kk = 0; lazy_load && kk < child->GetNumberOfNestedElements(); kk++)
+      {
+        vtkPVXMLElement* proxy = child->GetNestedElement(kk);
+        if (proxy->GetName() && strcmp(proxy->GetName(), "Proxy") == 0 &&
+          proxy->GetAttribute("group") && proxy->GetAttribute("name"))
+        {
+          proxies.insert(std::make_pair(
+            std::string(proxy->GetAttribute("group")), std::string(proxy->GetAttribute("name"))));
+        }
+      }
+      if ((auto_load || forceLoad) && !proxies.empty() && !this->GetPluginLoaded(index))
+      {
+        vtkPVPluginTrackerDebugMacro("--- Deferring loading until one of its "
+          << proxies.size() << " proxies is requested.");
+        (*this->PluginsList)[index].LazyLoad = true;
+        (*this->PluginsList)[index].Proxies.swap(proxies);
+        (*this->PluginsList)[index].Manifest = child;
+        this->InvokeEvent(vtkPVPluginTracker::ManifestRegisteredEvent, &index);
+      }
+      else if ((auto_load || forceLoad) && !this->GetPluginLoaded(index))
       {
         // load the plugin.
         vtkPVPluginLoader* loader = vtkPVPluginLoader::New();
@@ -357,6 +391,38 @@ void vtkPVPluginTracker::LoadPluginConfigurationXML(vtkPVXMLElement* root, bool
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVPluginTracker::LoadPluginForProxy(const char* groupName, const char* proxyName)
+{
+  if (!groupName || !proxyName)
+  {
+    return false;
+  }
+
+  std::pair<std::string, std::string> key(groupName, proxyName);
+  for (unsigned int cc = 0; cc < this->GetNumberOfPlugins(); cc++)
+  {
+    vtkItem& item = (*this->PluginsList)[cc];
+    if (!item.LazyLoad || item.Plugin != NULL || item.Proxies.find(key) == item.Proxies.end())
+    {
+      continue;
+    }
+
+    // Loading is attempted only once, even if it fails.
+    item.LazyLoad = false;
+    std::string filename = item.FileName;
+
+    bool debug_plugin = vtksys::SystemTools::GetEnv("PV_PLUGIN_DEBUG") != NULL;
+    vtkPVPluginTrackerDebugMacro("Loading " << filename << " for proxy (" << groupName << ", "
+                                            << proxyName << ")");
+    // Note: loading the plugin registers it, which may add items to
+    // PluginsList, hence `item` must not be used beyond this point.
+    vtkNew<vtkPVPluginLoader> loader;
+    return loader->LoadPlugin(filename.c_str());
+  }
+  return false;
+}
+
 //----------------------------------------------------------------------------
 unsigned int vtkPVPluginTracker::GetNumberOfPlugins()
 {
@@ -509,6 +575,23 @@ bool vtkPVPluginTracker::GetPluginAutoLoad(unsigned int index)
   return (*this->PluginsList)[index].AutoLoad;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVPluginTracker::GetPluginLazyLoad(unsigned int index)
+{
+  if (index >= this->GetNumberOfPlugins())
+  {
+    vtkWarningMacro("Invalid index: " << index);
+    return false;
+  }
+  return (*this->PluginsList)[index].LazyLoad && (*this->PluginsList)[index].Plugin == NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLElement* vtkPVPluginTracker::GetPluginManifest(unsigned int index)
+{
+  return this->GetPluginLazyLoad(index) ? (*this->PluginsList)[index].Manifest.GetPointer() : NULL;
+}
+
 //-----------------------------------------------------------------------------
 void vtkPVPluginTracker::SetStaticPluginSearchFunction(vtkPluginSearchFunction function)
 {
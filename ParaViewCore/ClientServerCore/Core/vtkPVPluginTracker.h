@@ -22,7 +22,9 @@
  * statically using PV_PLUGIN_IMPORT() or dynamically, it gets registered with
  * the  on every process that it is loaded.
  * Whenever a plugin is registered, this class fires a vtkCommand::RegisterEvent
- * that handlers can listen to, to process the plugin.
+ * that handlers can listen to, to process the plugin. Whenever the manifest of
+ * a lazy-load plugin is registered, it fires ManifestRegisteredEvent with the
+ * index of the plugin as call data.
 */
 
 #ifndef vtkPVPluginTracker_h
@@ -75,6 +77,10 @@ public:
    * @code
    * <Plugins>
    * <Plugin name="[plugin name]" filename="[optionnal file name] auto_load="[bool]" />
+   * <Plugin name="[plugin name]" auto_load="1" lazy_load="1">
+   *   <Proxy group="[proxy group]" name="[proxy name]" />
+   *   ...
+   * </Plugin>
    * ...
    * </Plugins>
    * @endcode
@@ -84,12 +90,27 @@ public:
    * filaname is also optionnal, if not provided this method will look in
    * different place to find the plugin, eg. paraview lib dir. It will NOT look
    * in PV_PLUGIN_PATH.
+   * When lazy_load is set, the nested Proxy elements are the manifest of the
+   * proxies defined by the plugin and a plugin that would be loaded (because
+   * of auto_load or forceLoad) is instead loaded by LoadPluginForProxy() when
+   * one of those proxies is first requested. Until then,
+   * vtkSIProxyDefinitionManager registers stub definitions for these proxies
+   * so that they are listed along with the others. The Proxy elements may
+   * have a label and Hints, used by the stubs.
    */
   void LoadPluginConfigurationXML(const char* filename, bool forceLoad = false);
   void LoadPluginConfigurationXML(vtkPVXMLElement*, bool forceLoad = false);
   void LoadPluginConfigurationXMLFromString(const char* xmlcontents, bool forceLoad = false);
   //@}
 
+  /**
+   * Loads the lazy-load plugin whose manifest lists the given proxy, if any
+   * and if not already loaded. Returns true if a plugin was loaded. This is
+   * called by vtkSIProxyDefinitionManager when a definition is missing and
+   * happens on every process that looks up the definition.
+   */
+  bool LoadPluginForProxy(const char* groupName, const char* proxyName);
+
   /**
    * Methods to iterate over registered plugins.
    */
@@ -111,8 +132,21 @@ public:
   const char* GetPluginFileName(unsigned int index);
   bool GetPluginLoaded(unsigned int index);
   bool GetPluginAutoLoad(unsigned int index);
+  bool GetPluginLazyLoad(unsigned int index);
   //@}
 
+  /**
+   * Returns the <Plugin/> element of the configuration XML that lists the
+   * proxies of a lazy-load plugin, or NULL if the plugin is not a lazy-load
+   * plugin or is already loaded.
+   */
+  vtkPVXMLElement* GetPluginManifest(unsigned int index);
+
+  enum
+  {
+    ManifestRegisteredEvent = 2010
+  };
+
   /**
    * Sets the function used to load static plugins.
    */
@@ -16,19 +16,45 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkByteSwap.h"
+#include "vtkClientSocket.h"
 #include "vtkCommand.h"
 #include "vtkCommunicator.h"
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutputWindow.h"
+#include "vtkPVConfig.h"
 #include "vtkPVOptions.h"
 #include "vtkPVSession.h"
 #include "vtkProcessModule.h"
+#include "vtkSocketCommunicator.h"
 #include "vtkTimerLog.h"
+#include "vtkWeakPointer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
+
+#ifdef PARAVIEW_USE_MPI
+#include "vtkMPI.h"
+#include "vtkMPICommunicator.h"
+#include "vtkMPIController.h"
+#if MPI_VERSION >= 3
+#define PV_USE_PROGRESS_WINDOW
+#endif
+#endif
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#include <sys/types.h>
+#endif
 
 // define this variable to disable progress all together. This may be useful to
 // doing really large runs.
@@ -58,6 +84,10 @@ public:
   typedef std::map<void*, int> MapOfObjectToInt;
   MapOfObjectToInt RegisteredObjects;
 
+  // Registered objects by id, used to modify the algorithms aborted on other
+  // processes.
+  std::map<int, vtkWeakPointer<vtkObject> > ObjectsById;
+
   // Disables progress all together.
   bool DisableProgressHandling;
 
@@ -65,11 +95,211 @@ public:
   // between calls to PrepareProgress() and CleanupPendingProgress().
   bool EnableProgress;
 
+  // Set by RequestAbort() or when the client sends an abort request. Read from
+  // any thread reporting progress.
+  std::atomic<bool> AbortRequested;
+
+  // Algorithms asked to abort. Their output is incomplete, so they are
+  // modified once the update is done to make sure they execute again on the
+  // next update. Protected by PendingMutex.
+  std::vector<vtkWeakPointer<vtkAlgorithm> > AbortedAlgorithms;
+
+  // Thread that called PrepareProgress(). Progress from other threads is
+  // recorded in Pending* and reported by ProcessPendingProgress().
+  std::thread::id MainThread;
+  std::mutex PendingMutex;
+  bool HasPendingProgress;
+  std::string PendingProgressText;
+  int PendingProgressId;
+  double PendingProgress;
+
+  // Text and object id for the last progress reported, used while waiting for
+  // satellites.
+  std::string LastReportedText;
+  int LastReportedId;
+
+#ifdef PV_USE_PROGRESS_WINDOW
+  // One-sided window used to aggregate progress from satellites and to
+  // broadcast abort requests to them. The root node exposes one slot per
+  // process. A slot packs the request number, the id of the object reporting
+  // progress and the progress in a single 64-bit value, so that it is always
+  // updated atomically. The request number is incremented by every
+  // PrepareProgress(), which is called on all processes, and lets the root
+  // ignore values left from previous updates without ever having to reset the
+  // window. Satellites expose a single slot, in which the root writes the
+  // number of the request to abort.
+  //
+  // A passive target epoch is opened on all processes as soon as the window is
+  // created. Processes only wait for the local completion of their writes and
+  // read their own memory, so no process ever waits for another one to make
+  // progress in MPI.
+  bool ProgressWindowCreated;
+  MPI_Comm Communicator;
+  MPI_Win ProgressWindow;
+  int LocalProcessId;
+  int NumberOfProcesses;
+  std::vector<vtkTypeUInt64> ProgressValues;
+  vtkTypeUInt64 RequestNumber;
+
+  static vtkTypeUInt64 Pack(vtkTypeUInt64 request, int id, double progress)
+  {
+    const vtkTypeUInt64 object = static_cast<vtkTypeUInt32>(id);
+    return ((request & 0xffff) << 48) | (object << 16) |
+      static_cast<vtkTypeUInt64>(progress * 0xffff);
+  }
+
+  // Must be called on all processes (the window creation is collective).
+  void InitializeProgressWindow()
+  {
+    vtkMPIController* controller =
+      vtkMPIController::SafeDownCast(vtkMultiProcessController::GetGlobalController());
+    vtkMPICommunicator* communicator =
+      controller ? vtkMPICommunicator::SafeDownCast(controller->GetCommunicator()) : NULL;
+    if (this->ProgressWindowCreated || communicator == NULL ||
+      controller->GetNumberOfProcesses() <= 1)
+    {
+      return;
+    }
+
+    this->Communicator = *communicator->GetMPIComm()->GetHandle();
+    this->LocalProcessId = controller->GetLocalProcessId();
+    this->NumberOfProcesses = controller->GetNumberOfProcesses();
+    if (this->LocalProcessId == 0)
+    {
+      this->ProgressValues.resize(this->NumberOfProcesses, 0);
+      MPI_Win_create(&this->ProgressValues[0],
+        static_cast<MPI_Aint>(this->NumberOfProcesses * sizeof(vtkTypeUInt64)),
+        sizeof(vtkTypeUInt64), MPI_INFO_NULL, this->Communicator, &this->ProgressWindow);
+    }
+    else
+    {
+      this->ProgressValues.resize(1, 0);
+      MPI_Win_create(&this->ProgressValues[0], static_cast<MPI_Aint>(sizeof(vtkTypeUInt64)),
+        sizeof(vtkTypeUInt64), MPI_INFO_NULL, this->Communicator, &this->ProgressWindow);
+    }
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, this->ProgressWindow);
+    this->ProgressWindowCreated = true;
+  }
+
+  void FinalizeProgressWindow()
+  {
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (this->ProgressWindowCreated && !finalized)
+    {
+      MPI_Win_unlock_all(this->ProgressWindow);
+      MPI_Win_free(&this->ProgressWindow);
+    }
+    this->ProgressWindowCreated = false;
+  }
+
+  // Called on all processes when progress reporting begins.
+  void BeginRequest()
+  {
+    // 0 is the value of slots that were never written.
+    this->RequestNumber = (this->RequestNumber + 1) & 0xffff;
+    this->RequestNumber = this->RequestNumber == 0 ? 1 : this->RequestNumber;
+  }
+
+  // Called on satellites to publish the progress of the object `id`.
+  void PutProgress(int id, double progress)
+  {
+    if (this->ProgressWindowCreated && this->LocalProcessId != 0)
+    {
+      vtkTypeUInt64 value = Pack(this->RequestNumber, id, progress);
+      MPI_Accumulate(&value, 1, MPI_UINT64_T, 0, this->LocalProcessId, 1, MPI_UINT64_T,
+        MPI_REPLACE, this->ProgressWindow);
+      MPI_Win_flush_local(0, this->ProgressWindow);
+    }
+  }
+
+  // Called on the root node to combine its progress for the object `id` with
+  // the progress of the satellites currently executing the same object.
+  // Satellites executing other objects are ignored: averaging the progress of
+  // different filters is meaningless.
+  double GetAggregatedProgress(int id, double localProgress)
+  {
+    if (!this->ProgressWindowCreated || this->LocalProcessId != 0)
+    {
+      return localProgress;
+    }
+    MPI_Win_sync(this->ProgressWindow);
+
+    const vtkTypeUInt64 key = Pack(this->RequestNumber, id, 0.0);
+    double sum = localProgress;
+    int count = 1;
+    for (int cc = 1; cc < this->NumberOfProcesses; ++cc)
+    {
+      const vtkTypeUInt64 value = this->ProgressValues[cc];
+      if ((value & ~static_cast<vtkTypeUInt64>(0xffff)) == key)
+      {
+        sum += static_cast<double>(value & 0xffff) / 0xffff;
+        ++count;
+      }
+    }
+    return sum / count;
+  }
+
+  // Called on the root node to ask the satellites to abort the current request.
+  void PublishAbort()
+  {
+    if (this->ProgressWindowCreated && this->LocalProcessId == 0)
+    {
+      const vtkTypeUInt64 value = this->RequestNumber;
+      for (int cc = 1; cc < this->NumberOfProcesses; ++cc)
+      {
+        MPI_Accumulate(
+          &value, 1, MPI_UINT64_T, cc, 0, 1, MPI_UINT64_T, MPI_REPLACE, this->ProgressWindow);
+      }
+      MPI_Win_flush_local_all(this->ProgressWindow);
+    }
+  }
+
+  // Called on satellites to check if the root asked to abort the current
+  // request.
+  bool IsAbortPublished()
+  {
+    if (!this->ProgressWindowCreated || this->LocalProcessId == 0)
+    {
+      return false;
+    }
+    MPI_Win_sync(this->ProgressWindow);
+    return this->ProgressValues[0] == this->RequestNumber;
+  }
+#endif
+
+  // Abort requests must reach all processes, otherwise the processes that
+  // aborted would wait for the others in collective calls.
+  bool CanBroadcastAbort()
+  {
+    vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+    if (controller == NULL || controller->GetNumberOfProcesses() <= 1)
+    {
+      return true;
+    }
+#ifdef PV_USE_PROGRESS_WINDOW
+    return this->ProgressWindowCreated;
+#else
+    return false;
+#endif
+  }
+
   vtkNew<vtkTimerLog> ProgressTimer;
   vtkInternals()
   {
+#ifdef PV_USE_PROGRESS_WINDOW
+    this->ProgressWindowCreated = false;
+    this->LocalProcessId = 0;
+    this->NumberOfProcesses = 1;
+    this->RequestNumber = 0;
+#endif
     this->EnableProgress = false;
     this->DisableProgressHandling = false;
+    this->AbortRequested = false;
+    this->HasPendingProgress = false;
+    this->PendingProgressId = 0;
+    this->PendingProgress = 0.0;
+    this->LastReportedId = 0;
 
 #ifdef PV_DISABLE_PROGRESS_HANDLING
     this->DisableProgressHandling = true;
@@ -117,6 +347,9 @@ vtkPVProgressHandler::~vtkPVProgressHandler()
   this->SetLastProgressText(NULL);
   this->SetLastMessage(NULL);
   this->SetSession(0);
+#ifdef PV_USE_PROGRESS_WINDOW
+  this->Internals->FinalizeProgressWindow();
+#endif
   delete this->Internals;
 }
 
@@ -127,6 +360,7 @@ void vtkPVProgressHandler::RegisterProgressEvent(vtkObject* object, int id)
                   object->IsA("vtkExporter") || object->IsA("vtkSMAnimationSceneWriter")))
   {
     this->Internals->RegisteredObjects[object] = id;
+    this->Internals->ObjectsById[id] = object;
     object->AddObserver(vtkCommand::ProgressEvent, this, &vtkPVProgressHandler::OnProgressEvent);
     object->AddObserver(vtkCommand::MessageEvent, this, &vtkPVProgressHandler::OnMessageEvent);
   }
@@ -166,20 +400,203 @@ void vtkPVProgressHandler::PrepareProgress()
       ds_controller->GetCommunicator()->AddObserver(
         vtkCommand::WrongTagEvent, this, &vtkPVProgressHandler::OnWrongTagEvent);
     }
+    // On server root nodes, this is needed to discard abort requests that
+    // arrive after the update was completed.
+    vtkMultiProcessController* client_controller =
+      this->Session->GetController(vtkPVSession::CLIENT);
+    if (client_controller)
+    {
+      client_controller->GetCommunicator()->AddObserver(
+        vtkCommand::WrongTagEvent, this, &vtkPVProgressHandler::OnWrongTagEvent);
+    }
   }
   this->AddedHandlers = true;
 
 #ifndef PV_DISABLE_PROGRESS_HANDLING
   SKIP_IF_DISABLED();
+#ifdef PV_USE_PROGRESS_WINDOW
+  // PrepareProgress() is called on all processes; the first call creates the
+  // window used to collect progress from satellites.
+  this->Internals->InitializeProgressWindow();
+#endif
   this->Internals->DisableProgressHandling = this->Session ? this->Session->IsMultiClients() : true;
 #endif
 
   SKIP_IF_DISABLED();
 
+  this->Internals->AbortRequested = false;
+  this->Internals->MainThread = std::this_thread::get_id();
+  this->Internals->HasPendingProgress = false;
+  this->Internals->LastReportedText.clear();
+  this->Internals->LastReportedId = 0;
+#ifdef PV_USE_PROGRESS_WINDOW
+  this->Internals->BeginRequest();
+#endif
+
   this->InvokeEvent(vtkCommand::StartEvent, this);
   this->Internals->EnableProgress = true;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::RequestAbort()
+{
+  SKIP_IF_DISABLED();
+  if (!this->Internals->EnableProgress || this->Internals->AbortRequested)
+  {
+    return;
+  }
+
+  this->HandleAbortRequest();
+  if (!this->Internals->AbortRequested)
+  {
+    return;
+  }
+
+  // On client-node, forward the request to the server-root-nodes.
+  vtkMultiProcessController* ds_controller =
+    this->Session->GetController(vtkPVSession::DATA_SERVER_ROOT);
+  vtkMultiProcessController* rs_controller =
+    this->Session->GetController(vtkPVSession::RENDER_SERVER_ROOT);
+  char temp = 1;
+  if (ds_controller)
+  {
+    ds_controller->Send(&temp, 1, 1, ABORT_TAG);
+  }
+  if (rs_controller && rs_controller != ds_controller)
+  {
+    rs_controller->Send(&temp, 1, 1, ABORT_TAG);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVProgressHandler::GetAbortRequested()
+{
+  return this->Internals->AbortRequested;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::HandleAbortRequest()
+{
+  if (this->Internals->AbortRequested)
+  {
+    return;
+  }
+  if (!this->Internals->CanBroadcastAbort())
+  {
+    vtkWarningMacro("Aborting is not supported when running in parallel without MPI-3.");
+    return;
+  }
+#ifdef PV_USE_PROGRESS_WINDOW
+  // Let the satellites know before aborting here.
+  this->Internals->PublishAbort();
+#endif
+  this->Internals->AbortRequested = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::PollForAbortRequest()
+{
+  if (this->Internals->AbortRequested)
+  {
+    return;
+  }
+#ifdef PV_USE_PROGRESS_WINDOW
+  if (this->Internals->IsAbortPublished())
+  {
+    this->Internals->AbortRequested = true;
+    return;
+  }
+#endif
+
+  vtkMultiProcessController* client_controller = this->Session->GetController(vtkPVSession::CLIENT);
+  vtkSocketCommunicator* comm = client_controller
+    ? vtkSocketCommunicator::SafeDownCast(client_controller->GetCommunicator())
+    : NULL;
+  if (comm == NULL || comm->GetSocket() == NULL)
+  {
+    return;
+  }
+
+  int socket = comm->GetSocket()->GetSocketDescriptor();
+  int selected = -1;
+  if (vtkSocket::SelectSockets(&socket, 1, 0, &selected) != 1)
+  {
+    return;
+  }
+
+  // Peek at the tag of the next message without consuming it. Anything but an
+  // abort request (e.g. a PushState or ExecuteStream RMI) must stay queued
+  // for the session to process once the update is done. An abort request
+  // queued behind such a message is only seen when the update completes.
+  int tag = 0;
+  if (recv(socket, reinterpret_cast<char*>(&tag), sizeof(tag), MSG_PEEK) !=
+    static_cast<int>(sizeof(tag)))
+  {
+    return;
+  }
+  if (comm->GetSwapBytesInReceivedData() == vtkSocketCommunicator::SwapOn)
+  {
+    vtkByteSwap::SwapVoidRange(&tag, 1, sizeof(tag));
+  }
+  if (tag == ABORT_TAG)
+  {
+    char temp = 0;
+    client_controller->Receive(&temp, 1, 1, ABORT_TAG);
+    this->HandleAbortRequest();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::ProcessPendingProgress()
+{
+  SKIP_IF_DISABLED();
+  if (!this->Internals->EnableProgress)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->PendingMutex);
+    if (!this->Internals->HasPendingProgress)
+    {
+      return;
+    }
+  }
+
+  this->Internals->ProgressTimer->StopTimer();
+  if (this->Internals->ProgressTimer->GetElapsedTime() < this->ProgressFrequency)
+  {
+    return;
+  }
+  this->Internals->ProgressTimer->StartTimer();
+
+  this->PollForAbortRequest();
+
+  std::string text;
+  int id = 0;
+  double progress = 0.0;
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->PendingMutex);
+    text = this->Internals->PendingProgressText;
+    id = this->Internals->PendingProgressId;
+    progress = this->Internals->PendingProgress;
+    this->Internals->HasPendingProgress = false;
+  }
+  this->ReportProgress(id, text.c_str(), progress);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::ReportProgress(int id, const char* text, double progress)
+{
+#ifdef PV_USE_PROGRESS_WINDOW
+  this->Internals->PutProgress(id, progress);
+  progress = this->Internals->GetAggregatedProgress(id, progress);
+#endif
+  this->Internals->LastReportedText = text;
+  this->Internals->LastReportedId = id;
+  this->RefreshProgress(text, progress);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVProgressHandler::CleanupPendingProgress()
 {
@@ -198,7 +615,8 @@ void vtkPVProgressHandler::CleanupPendingProgress()
   vtkMultiProcessController* mpiController = vtkMultiProcessController::GetGlobalController();
   if (mpiController && mpiController->GetNumberOfProcesses() > 1)
   {
-    mpiController->Barrier();
+    this->WaitForSatellites(mpiController);
+    this->GatherAbortedAlgorithms(mpiController);
   }
 
   // On the server-node (render-server root or data-server root), we send a
@@ -229,10 +647,109 @@ void vtkPVProgressHandler::CleanupPendingProgress()
     rs_controller->Receive(&temp, 1, 1, CLEANUP_TAG);
   }
 
+  // Outputs of aborted algorithms are incomplete but the pipeline considers
+  // them up-to-date. Modify the algorithms so that they execute again.
+  std::vector<vtkWeakPointer<vtkAlgorithm> > aborted;
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->PendingMutex);
+    std::swap(aborted, this->Internals->AbortedAlgorithms);
+  }
+  for (size_t cc = 0; cc < aborted.size(); ++cc)
+  {
+    if (vtkAlgorithm* algorithm = aborted[cc])
+    {
+      algorithm->SetAbortExecute(0);
+      algorithm->Modified();
+    }
+  }
+
   this->Internals->EnableProgress = false;
   this->InvokeEvent(vtkCommand::EndEvent, this);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::GatherAbortedAlgorithms(vtkMultiProcessController* controller)
+{
+  // An algorithm may be aborted on some processes only, e.g. when the others
+  // were done with it when the request arrived. It must be modified on all of
+  // them, otherwise only some processes would execute it on the next update.
+  // All threads are done with the update, the lock is not needed.
+  std::vector<vtkWeakPointer<vtkAlgorithm> >& aborted = this->Internals->AbortedAlgorithms;
+  std::vector<int> ids;
+  for (size_t cc = 0; cc < aborted.size(); ++cc)
+  {
+    int id = aborted[cc] ? this->Internals->GetIDFromObject(aborted[cc]) : 0;
+    if (id != 0)
+    {
+      ids.push_back(id);
+    }
+  }
+
+  int count = static_cast<int>(ids.size());
+  int maxCount = 0;
+  controller->AllReduce(&count, &maxCount, 1, vtkCommunicator::MAX_OP);
+  if (maxCount == 0)
+  {
+    return;
+  }
+
+  ids.resize(maxCount, 0);
+  std::vector<int> allIds(maxCount * controller->GetNumberOfProcesses(), 0);
+  controller->AllGather(&ids[0], &allIds[0], maxCount);
+  for (size_t cc = 0; cc < allIds.size(); ++cc)
+  {
+    std::map<int, vtkWeakPointer<vtkObject> >::iterator iter =
+      this->Internals->ObjectsById.find(allIds[cc]);
+    if (allIds[cc] == 0 || iter == this->Internals->ObjectsById.end())
+    {
+      continue;
+    }
+    vtkAlgorithm* algorithm = vtkAlgorithm::SafeDownCast(iter->second);
+    if (algorithm && std::find(aborted.begin(), aborted.end(), algorithm) == aborted.end())
+    {
+      aborted.push_back(algorithm);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::WaitForSatellites(vtkMultiProcessController* controller)
+{
+#ifdef PV_USE_PROGRESS_WINDOW
+  if (this->Internals->ProgressWindowCreated)
+  {
+    // The root node is usually done before the satellites. Use a non-blocking
+    // barrier so that it can keep reporting their progress meanwhile.
+    MPI_Request request;
+    MPI_Ibarrier(this->Internals->Communicator, &request);
+    int done = 0;
+    MPI_Test(&request, &done, MPI_STATUS_IGNORE);
+    while (!done)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      // Publish (or, on the root, report) progress recorded from other threads.
+      this->ProcessPendingProgress();
+      if (this->Internals->LocalProcessId == 0)
+      {
+        this->Internals->ProgressTimer->StopTimer();
+        if (this->Internals->ProgressTimer->GetElapsedTime() >= this->ProgressFrequency)
+        {
+          this->Internals->ProgressTimer->StartTimer();
+          // Satellites are still executing: keep forwarding abort requests.
+          this->PollForAbortRequest();
+          const std::string text = this->Internals->LastReportedText;
+          this->RefreshProgress(text.empty() ? "Waiting for satellites" : text.c_str(),
+            this->Internals->GetAggregatedProgress(this->Internals->LastReportedId, 1.0));
+        }
+      }
+      MPI_Test(&request, &done, MPI_STATUS_IGNORE);
+    }
+    return;
+  }
+#endif
+  controller->Barrier();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVProgressHandler::OnProgressEvent(vtkObject* caller, unsigned long eventid, void* calldata)
 {
@@ -242,6 +759,40 @@ void vtkPVProgressHandler::OnProgressEvent(vtkObject* caller, unsigned long even
     return;
   }
 
+  // Cooperative cancellation: ask the algorithm reporting progress to abort.
+  // vtkDemandDrivenPipeline resets the flag before the next execution.
+  if (this->Internals->AbortRequested)
+  {
+    vtkAlgorithm* algorithm = vtkAlgorithm::SafeDownCast(caller);
+    if (algorithm && !algorithm->GetAbortExecute())
+    {
+      algorithm->SetAbortExecute(1);
+      std::lock_guard<std::mutex> lock(this->Internals->PendingMutex);
+      this->Internals->AbortedAlgorithms.push_back(algorithm);
+    }
+  }
+
+  if (std::this_thread::get_id() != this->Internals->MainThread)
+  {
+    double progress = *reinterpret_cast<double*>(calldata);
+    progress = (progress < 0) ? 0 : progress;
+    progress = (progress > 1.0) ? 1.0 : progress;
+
+    std::lock_guard<std::mutex> lock(this->Internals->PendingMutex);
+    this->Internals->HasPendingProgress = true;
+    this->Internals->PendingProgressText = ::vtkGetProgressText(caller);
+    this->Internals->PendingProgressId = this->Internals->GetIDFromObject(caller);
+    this->Internals->PendingProgress = progress;
+    return;
+  }
+
+  // Progress from the main thread supersedes the one recorded from other
+  // threads.
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->PendingMutex);
+    this->Internals->HasPendingProgress = false;
+  }
+
   // Try to clamp frequent progress events.
   this->Internals->ProgressTimer->StopTimer();
   // cout <<"Elapsed: " << this->Internals->ProgressTimer->GetElapsedTime() <<
@@ -253,6 +804,8 @@ void vtkPVProgressHandler::OnProgressEvent(vtkObject* caller, unsigned long even
 
   this->Internals->ProgressTimer->StartTimer();
 
+  this->PollForAbortRequest();
+
   double progress = *reinterpret_cast<double*>(calldata);
   if (progress < 0 || progress > 1.0)
   {
@@ -265,8 +818,8 @@ void vtkPVProgressHandler::OnProgressEvent(vtkObject* caller, unsigned long even
     progress = (progress > 1.0) ? 1.0 : progress;
   }
 
-  std::string text = ::vtkGetProgressText(caller);
-  this->RefreshProgress(text.c_str(), progress);
+  this->ReportProgress(
+    this->Internals->GetIDFromObject(caller), ::vtkGetProgressText(caller), progress);
 }
 
 //----------------------------------------------------------------------------
@@ -320,6 +873,16 @@ bool vtkPVProgressHandler::OnWrongTagEvent(vtkObject*, unsigned long eventid, vo
   const char* ptr = data;
   memcpy(&tag, ptr, sizeof(tag));
 
+  if (tag == vtkPVProgressHandler::ABORT_TAG)
+  {
+    // Abort requests that arrive once the update is done are discarded.
+    if (this->Internals->EnableProgress)
+    {
+      this->HandleAbortRequest();
+    }
+    return true;
+  }
+
   if (tag == vtkPVProgressHandler::MESSAGE_EVENT_TAG)
   {
     ptr += sizeof(tag);
@@ -17,15 +17,29 @@
  * @brief   progress handler.
  *
  * vtkPVProgressHandler handles the progress messages. It handles progress in
- * all configurations single process, client-server. It must be noted that when
- * running in parallel, progress updates are fetched from the root node. Due to
- * performance reasons, we no longer collect progress events (or messages) from
- * satellites, only root-node events are reported back to the client. While this
- * may not faithfully report the progress, this avoid nasty MPI issues that can
- * be painful to debug and diagnose.
+ * all configurations single process, client-server. When running in parallel,
+ * satellites don't send any messages to the root node since that caused nasty
+ * MPI issues in the past. Instead, when MPI-3 is available, each satellite
+ * writes its latest (throttled) progress, tagged with the update it belongs
+ * to and the id of the object reporting it, into an MPI one-sided
+ * communication window exposed by the root node. When reporting progress to
+ * the client, the root node averages its progress with the progress of the
+ * satellites executing the same object in the same update. Neither side waits
+ * for the other to access the window. Messages from satellites are not
+ * reported.
  *
  * Progress events are currently not supported in multi-clients mode.
  *
+ * vtkPVProgressHandler also supports cooperative cancellation of the pipeline
+ * update in progress. RequestAbort() (typically called from a
+ * vtkCommand::ProgressEvent handler on the client, e.g. by pqProgressManager
+ * when the abort button is pressed) is forwarded to the server root nodes,
+ * which pass it on to the satellites. All processes then set
+ * vtkAlgorithm::AbortExecute on every algorithm reporting progress till the
+ * update completes. Aborted algorithms are modified on all processes at the
+ * end of the update so that their incomplete output is not reused. When
+ * running in parallel, aborting requires MPI-3 and is ignored otherwise.
+ *
  * @par Events:
  * vtkCommand::StartEvent
  * \li fired to indicate beginning of progress handling
@@ -79,6 +93,30 @@ public:
    */
   void CleanupPendingProgress();
 
+  //@{
+  /**
+   * Request that the pipeline update in progress be aborted. This is only
+   * honored between PrepareProgress() and CleanupPendingProgress(); the request
+   * is reset on the next PrepareProgress(). Algorithms are asked to abort the
+   * next time they report progress, hence the update may take a while to
+   * return, and algorithms that don't check vtkAlgorithm::GetAbortExecute()
+   * complete normally.
+   */
+  void RequestAbort();
+  bool GetAbortRequested();
+  //@}
+
+  /**
+   * Progress events fired on threads other than the one that called
+   * PrepareProgress() are not reported right away since the session and
+   * observers are not thread-safe. Instead, the most recent of these is
+   * recorded and reported by this method, on the thread that called
+   * PrepareProgress(). This is also done while waiting for satellites in
+   * CleanupPendingProgress(). This also checks for abort requests from the
+   * client.
+   */
+  void ProcessPendingProgress();
+
   //@{
   /**
    * Get/Set the progress frequency in seconds. Default is 0.5 seconds.
@@ -110,7 +148,8 @@ protected:
   {
     CLEANUP_TAG = 188969,
     PROGRESS_EVENT_TAG = 188970,
-    MESSAGE_EVENT_TAG = 188971
+    MESSAGE_EVENT_TAG = 188971,
+    ABORT_TAG = 188972
   };
 
   //@{
@@ -118,6 +157,36 @@ protected:
   void RefreshMessage(const char* message_text);
   //@}
 
+  /**
+   * Checks, without blocking, if the client (on server root nodes) or the root
+   * node (on satellites) sent an abort request.
+   */
+  void PollForAbortRequest();
+
+  /**
+   * Aborts the current request on this process and, on the root node, on the
+   * satellites.
+   */
+  void HandleAbortRequest();
+
+  /**
+   * Makes sure that algorithms aborted on any process are modified on all of
+   * them.
+   */
+  void GatherAbortedAlgorithms(vtkMultiProcessController* controller);
+
+  /**
+   * Reports the progress of the object registered with `id`, combined with
+   * the progress of the satellites when running in parallel.
+   */
+  void ReportProgress(int id, const char* text, double progress);
+
+  /**
+   * Waits for all processes to be done with the update, reporting the progress
+   * of the satellites if possible.
+   */
+  void WaitForSatellites(vtkMultiProcessController* controller);
+
   vtkPVSession* Session;
   double ProgressFrequency;
 
@@ -52,6 +52,7 @@ vtkPVServerOptions::vtkPVServerOptions()
 
   // This default value for ServerPort is setup in Initialize().
   this->ServerPort = 0;
+  this->ObserverNotificationInterval = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -72,6 +73,11 @@ void vtkPVServerOptions::Initialize()
     "Tell the data|render server the host name of the client, use with -rc.",
     vtkPVOptions::PVRENDER_SERVER | vtkPVOptions::PVDATA_SERVER | vtkPVOptions::PVSERVER);
 
+  this->AddArgument("--observer-notification-interval", 0, &this->ObserverNotificationInterval,
+    "When using --multi-clients, minimum time in milliseconds between two updates sent to the "
+    "clients that are not the master one. Superseded updates are skipped. (default 0).",
+    vtkPVOptions::PVDATA_SERVER | vtkPVOptions::PVSERVER);
+
   switch (vtkProcessModule::GetProcessType())
   {
     case vtkProcessModule::PROCESS_SERVER:
@@ -370,4 +376,5 @@ void vtkPVServerOptions::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ClientHostName: " << (this->ClientHostName ? this->ClientHostName : "(none)")
      << endl;
   os << indent << "ServerPort: " << this->ServerPort << endl;
+  os << indent << "ObserverNotificationInterval: " << this->ObserverNotificationInterval << endl;
 }
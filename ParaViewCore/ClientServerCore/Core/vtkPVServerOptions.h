@@ -54,6 +54,15 @@ public:
   vtkGetMacro(ServerPort, int);
   //@}
 
+  //@{
+  /**
+   * Minimum time, in milliseconds, between two notifications sent to the
+   * clients of a multi-clients session that are not the master one. 0 (the
+   * default) means that notifications are not throttled.
+   */
+  vtkGetMacro(ObserverNotificationInterval, int);
+  //@}
+
   /**
    * Pass in the name and the attributes for all tags that are not Options.
    * If it returns 1, then it is successful, and 0 if it failed.
@@ -107,6 +116,7 @@ protected:
   char* ClientHostName;
 
   int ServerPort;
+  int ObserverNotificationInterval;
 
 private:
   vtkPVServerOptions(const vtkPVServerOptions&) VTK_DELETE_FUNCTION;
@@ -0,0 +1,555 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestDataObjectMarshaller.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBitArray.h"
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkGenericDataObjectReader.h"
+#include "vtkGenericDataObjectWriter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVDataObjectMarshaller.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> CreatePolyData(int resolution)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i < resolution; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.1 * ((i + j) % 7));
+      normals->InsertNextTuple3(0, 0, 1);
+    }
+  }
+  for (int j = 0; j + 1 < resolution; ++j)
+  {
+    for (int i = 0; i + 1 < resolution; ++i)
+    {
+      vtkIdType quad[4] = { j * resolution + i, j * resolution + i + 1,
+        (j + 1) * resolution + i + 1, (j + 1) * resolution + i };
+      polys->InsertNextCell(4, quad);
+    }
+  }
+
+  vtkSmartPointer<vtkPolyData> pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points.GetPointer());
+  pd->SetPolys(polys.GetPointer());
+  pd->GetPointData()->SetNormals(normals.GetPointer());
+
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(pd->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < pd->GetNumberOfCells(); ++cc)
+  {
+    cellIds->SetValue(cc, static_cast<int>(cc));
+  }
+  pd->GetCellData()->AddArray(cellIds.GetPointer());
+
+  vtkNew<vtkCharArray> label;
+  label->SetName("Label");
+  label->InsertNextValue('p');
+  label->InsertNextValue('d');
+  pd->GetFieldData()->AddArray(label.GetPointer());
+  return pd;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> CreateUnstructuredGrid(int resolution)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < resolution; ++j)
+    {
+      for (int i = 0; i < resolution; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> ug = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  ug->SetPoints(points.GetPointer());
+  ug->Allocate((resolution - 1) * (resolution - 1));
+  const vtkIdType slab = resolution * resolution;
+  for (int j = 0; j + 1 < resolution; ++j)
+  {
+    for (int i = 0; i + 1 < resolution; ++i)
+    {
+      vtkIdType p0 = j * resolution + i;
+      vtkIdType hex[8] = { p0, p0 + 1, p0 + resolution + 1, p0 + resolution, p0 + slab,
+        p0 + slab + 1, p0 + slab + resolution + 1, p0 + slab + resolution };
+      ug->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+    }
+  }
+
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(ug->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < ug->GetNumberOfPoints(); ++cc)
+  {
+    scalars->SetValue(cc, 0.5 * cc);
+  }
+  ug->GetPointData()->SetScalars(scalars.GetPointer());
+  return ug;
+}
+
+vtkSmartPointer<vtkImageData> CreateImageData(int resolution)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, resolution - 1, 0, resolution - 1, 0, 3);
+  image->SetOrigin(-1, -2, -3);
+  image->SetSpacing(0.5, 0.25, 2.0);
+
+  vtkNew<vtkFloatArray> values;
+  values->SetName("Values");
+  values->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    values->SetValue(cc, static_cast<float>(cc % 255));
+  }
+  image->GetPointData()->SetScalars(values.GetPointer());
+  return image;
+}
+
+vtkSmartPointer<vtkMultiBlockDataSet> CreateMultiBlock(int resolution)
+{
+  vtkSmartPointer<vtkMultiBlockDataSet> mb = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  mb->SetNumberOfBlocks(3);
+  mb->SetBlock(0, CreatePolyData(resolution));
+  mb->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "surface");
+
+  vtkNew<vtkMultiBlockDataSet> child;
+  child->SetNumberOfBlocks(2);
+  child->SetBlock(0, CreateUnstructuredGrid(resolution));
+  child->SetBlock(1, CreateImageData(resolution));
+  mb->SetBlock(1, child.GetPointer());
+  // Block 2 is intentionally left NULL.
+  return mb;
+}
+
+bool CompareArrays(vtkDataArray* a1, vtkDataArray* a2)
+{
+  if (a1 == NULL || a2 == NULL || a1->GetDataType() != a2->GetDataType() ||
+    a1->GetNumberOfTuples() != a2->GetNumberOfTuples() ||
+    a1->GetNumberOfComponents() != a2->GetNumberOfComponents())
+  {
+    return false;
+  }
+  const vtkIdType numValues = a1->GetNumberOfTuples() * a1->GetNumberOfComponents();
+  return memcmp(a1->GetVoidPointer(0), a2->GetVoidPointer(0),
+           static_cast<size_t>(numValues * a1->GetDataTypeSize())) == 0;
+}
+
+bool CompareFieldData(vtkFieldData* fd1, vtkFieldData* fd2)
+{
+  if (fd1->GetNumberOfArrays() != fd2->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int cc = 0; cc < fd1->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = fd1->GetArray(cc);
+    if (!CompareArrays(array, fd2->GetArray(array->GetName())))
+    {
+      cerr << "ERROR: mismatch in array '" << array->GetName() << "'" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Compare(vtkDataObject* d1, vtkDataObject* d2)
+{
+  if (d1 == NULL || d2 == NULL)
+  {
+    return d1 == d2;
+  }
+  if (strcmp(d1->GetClassName(), d2->GetClassName()) != 0)
+  {
+    cerr << "ERROR: type mismatch: " << d1->GetClassName() << " != " << d2->GetClassName()
+         << endl;
+    return false;
+  }
+  if (!CompareFieldData(d1->GetFieldData(), d2->GetFieldData()))
+  {
+    return false;
+  }
+
+  if (vtkMultiBlockDataSet* mb1 = vtkMultiBlockDataSet::SafeDownCast(d1))
+  {
+    vtkMultiBlockDataSet* mb2 = vtkMultiBlockDataSet::SafeDownCast(d2);
+    if (mb1->GetNumberOfBlocks() != mb2->GetNumberOfBlocks())
+    {
+      return false;
+    }
+    for (unsigned int cc = 0; cc < mb1->GetNumberOfBlocks(); ++cc)
+    {
+      if (mb1->HasMetaData(cc) && mb1->GetMetaData(cc)->Has(vtkCompositeDataSet::NAME()))
+      {
+        if (!mb2->HasMetaData(cc) || !mb2->GetMetaData(cc)->Has(vtkCompositeDataSet::NAME()) ||
+          strcmp(mb1->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME()),
+            mb2->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME())) != 0)
+        {
+          cerr << "ERROR: block name mismatch." << endl;
+          return false;
+        }
+      }
+      if (!Compare(mb1->GetBlock(cc), mb2->GetBlock(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  vtkDataSet* ds1 = vtkDataSet::SafeDownCast(d1);
+  vtkDataSet* ds2 = vtkDataSet::SafeDownCast(d2);
+  if (ds1->GetNumberOfPoints() != ds2->GetNumberOfPoints() ||
+    ds1->GetNumberOfCells() != ds2->GetNumberOfCells())
+  {
+    cerr << "ERROR: number of points/cells mismatch." << endl;
+    return false;
+  }
+  if (!CompareFieldData(ds1->GetPointData(), ds2->GetPointData()) ||
+    !CompareFieldData(ds1->GetCellData(), ds2->GetCellData()))
+  {
+    return false;
+  }
+  if (ds1->GetPointData()->GetScalars() &&
+    (!ds2->GetPointData()->GetScalars() ||
+        strcmp(ds1->GetPointData()->GetScalars()->GetName(),
+          ds2->GetPointData()->GetScalars()->GetName()) != 0))
+  {
+    cerr << "ERROR: scalars attribute lost." << endl;
+    return false;
+  }
+
+  if (vtkPointSet* ps1 = vtkPointSet::SafeDownCast(ds1))
+  {
+    vtkPointSet* ps2 = vtkPointSet::SafeDownCast(ds2);
+    if (!CompareArrays(ps1->GetPoints()->GetData(), ps2->GetPoints()->GetData()))
+    {
+      cerr << "ERROR: points mismatch." << endl;
+      return false;
+    }
+  }
+  if (vtkPolyData* pd1 = vtkPolyData::SafeDownCast(ds1))
+  {
+    vtkPolyData* pd2 = vtkPolyData::SafeDownCast(ds2);
+    return CompareArrays(pd1->GetPolys()->GetData(), pd2->GetPolys()->GetData());
+  }
+  if (vtkUnstructuredGrid* ug1 = vtkUnstructuredGrid::SafeDownCast(ds1))
+  {
+    vtkUnstructuredGrid* ug2 = vtkUnstructuredGrid::SafeDownCast(ds2);
+    return CompareArrays(ug1->GetCells()->GetData(), ug2->GetCells()->GetData()) &&
+      CompareArrays(ug1->GetCellTypesArray(), ug2->GetCellTypesArray());
+  }
+  if (vtkImageData* id1 = vtkImageData::SafeDownCast(ds1))
+  {
+    vtkImageData* id2 = vtkImageData::SafeDownCast(ds2);
+    int* ext1 = id1->GetExtent();
+    int* ext2 = id2->GetExtent();
+    double* sp1 = id1->GetSpacing();
+    double* sp2 = id2->GetSpacing();
+    double* o1 = id1->GetOrigin();
+    double* o2 = id2->GetOrigin();
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      if (ext1[2 * cc] != ext2[2 * cc] || ext1[2 * cc + 1] != ext2[2 * cc + 1] ||
+        sp1[cc] != sp2[cc] || o1[cc] != o2[cc])
+      {
+        cerr << "ERROR: image structure mismatch." << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Round trip through the marshaller, using a flattened buffer.
+vtkSmartPointer<vtkDataObject> MarshallerRoundTrip(vtkDataObject* data, vtkIdType& length)
+{
+  vtkNew<vtkPVDataObjectMarshaller> marshaller;
+  if (!marshaller->Marshal(data))
+  {
+    return NULL;
+  }
+  length = marshaller->GetMarshalledLength();
+  std::vector<char> buffer(length);
+  marshaller->WriteMarshalledData(&buffer[0]);
+  if (!vtkPVDataObjectMarshaller::IsMarshalledData(&buffer[0], length))
+  {
+    return NULL;
+  }
+
+  vtkNew<vtkPVDataObjectMarshaller> unmarshaller;
+  vtkSmartPointer<vtkDataObject> result;
+  result.TakeReference(unmarshaller->Unmarshal(&buffer[0], length));
+  return result;
+}
+
+// Round trip through the legacy writer/reader, as vtkMPIMoveData used to do.
+vtkSmartPointer<vtkDataObject> LegacyRoundTrip(vtkDataObject* data, vtkIdType& length)
+{
+  vtkNew<vtkGenericDataObjectWriter> writer;
+  writer->SetFileTypeToBinary();
+  writer->WriteToOutputStringOn();
+  writer->SetInputData(data);
+  writer->Write();
+  length = writer->GetOutputStringLength();
+
+  vtkNew<vtkGenericDataObjectReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetBinaryInputString(writer->GetOutputString(), writer->GetOutputStringLength());
+  reader->Update();
+  return reader->GetOutputDataObject(0);
+}
+
+// Round trip receiving the segments directly in the arrays of the data object
+// being built, as done when the header and segments are sent separately.
+vtkSmartPointer<vtkDataObject> ZeroCopyRoundTrip(vtkDataObject* data)
+{
+  vtkNew<vtkPVDataObjectMarshaller> marshaller;
+  if (!marshaller->Marshal(data))
+  {
+    return NULL;
+  }
+
+  // The header may be received in two steps: the fixed size prefix first, to
+  // know the length of the rest.
+  std::vector<char> header(marshaller->GetHeader(),
+    marshaller->GetHeader() + marshaller->GetHeaderLength());
+  if (vtkPVDataObjectMarshaller::GetHeaderLength(&header[0]) !=
+    static_cast<vtkIdType>(header.size()))
+  {
+    cerr << "ERROR: header length mismatch." << endl;
+    return NULL;
+  }
+
+  vtkNew<vtkPVDataObjectMarshaller> unmarshaller;
+  if (!unmarshaller->PrepareUnmarshal(&header[0], static_cast<vtkIdType>(header.size())) ||
+    unmarshaller->GetNumberOfSegments() != marshaller->GetNumberOfSegments())
+  {
+    cerr << "ERROR: failed to prepare unmarshalling." << endl;
+    return NULL;
+  }
+  for (int cc = 0; cc < marshaller->GetNumberOfSegments(); ++cc)
+  {
+    const vtkIdType length = marshaller->GetSegmentLength(cc);
+    if (unmarshaller->GetSegmentLength(cc) != length)
+    {
+      cerr << "ERROR: segment " << cc << " length mismatch." << endl;
+      return NULL;
+    }
+    if (length > 0)
+    {
+      memcpy(unmarshaller->GetSegmentPointer(cc), marshaller->GetSegmentPointer(cc), length);
+    }
+  }
+  unmarshaller->FinalizeUnmarshal();
+  return unmarshaller->GetUnmarshalledDataObject();
+}
+
+// Writes values in the byte order opposite to the native one, to build the
+// buffer a sender with a different endianness would generate.
+class SwappedWriter
+{
+public:
+  template <typename T>
+  void Write(T value)
+  {
+    vtkByteSwap::SwapVoidRange(&value, 1, sizeof(T));
+    const char* ptr = reinterpret_cast<const char*>(&value);
+    this->Buffer.insert(this->Buffer.end(), ptr, ptr + sizeof(T));
+  }
+
+  void WriteString(const char* str)
+  {
+    this->Write(static_cast<vtkTypeInt32>(strlen(str)));
+    this->Buffer.insert(this->Buffer.end(), str, str + strlen(str));
+  }
+
+  void WriteArray(const char* name, int dataType, int elementSize, vtkTypeInt64 numTuples)
+  {
+    this->WriteString(name);
+    this->Write(static_cast<vtkTypeInt32>(dataType));
+    this->Write(static_cast<vtkTypeInt32>(elementSize));
+    this->Write(static_cast<vtkTypeInt32>(1));
+    this->Write(numTuples);
+  }
+
+  std::vector<char> Buffer;
+};
+
+// Unmarshals a vtkPolyData with 3 points (as floats) and a vtkIntArray point
+// array marshalled on a host with the opposite byte order.
+bool TestByteSwapping()
+{
+  const float coords[9] = { 0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f, 8.5f };
+  const int values[3] = { 1, 256, 65536 };
+
+  SwappedWriter writer;
+  writer.Buffer.insert(writer.Buffer.end(), "PVDM", "PVDM" + 4);
+  writer.Write(static_cast<vtkTypeUInt32>(0x01020304));
+  writer.Write(static_cast<vtkTypeUInt32>(1));
+  writer.Write(static_cast<vtkTypeInt64>(0)); // header length, set below.
+  writer.Write(static_cast<vtkTypeInt32>(VTK_POLY_DATA));
+  writer.Write(static_cast<vtkTypeInt8>(1));
+  writer.WriteArray("Points", VTK_FLOAT, sizeof(float), 3);
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    // verts, lines, polys and strips.
+    writer.Write(static_cast<vtkTypeInt64>(0));
+    writer.WriteArray("", VTK_ID_TYPE, sizeof(vtkIdType), 0);
+  }
+  writer.Write(static_cast<vtkTypeInt32>(1)); // point data
+  writer.Write(static_cast<vtkTypeInt32>(0));
+  writer.WriteArray("Values", VTK_INT, sizeof(int), 3);
+  writer.Write(static_cast<vtkTypeInt32>(0)); // cell data
+  writer.Write(static_cast<vtkTypeInt32>(0)); // field data
+
+  vtkTypeInt64 headerLength = static_cast<vtkTypeInt64>(writer.Buffer.size());
+  vtkByteSwap::SwapVoidRange(&headerLength, 1, sizeof(headerLength));
+  memcpy(&writer.Buffer[12], &headerLength, sizeof(headerLength));
+  for (int cc = 0; cc < 9; ++cc)
+  {
+    writer.Write(coords[cc]);
+  }
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    writer.Write(values[cc]);
+  }
+
+  vtkNew<vtkPVDataObjectMarshaller> unmarshaller;
+  vtkSmartPointer<vtkPolyData> pd;
+  pd.TakeReference(vtkPolyData::SafeDownCast(unmarshaller->Unmarshal(
+    &writer.Buffer[0], static_cast<vtkIdType>(writer.Buffer.size()))));
+  vtkDataArray* array = pd ? pd->GetPointData()->GetArray("Values") : NULL;
+  if (!pd || pd->GetNumberOfPoints() != 3 || !array || array->GetNumberOfTuples() != 3)
+  {
+    cerr << "ERROR: failed to unmarshal byte swapped data." << endl;
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < 3; ++cc)
+  {
+    double pt[3];
+    pd->GetPoint(cc, pt);
+    if (pt[0] != coords[3 * cc] || pt[1] != coords[3 * cc + 1] || pt[2] != coords[3 * cc + 2] ||
+      array->GetTuple1(cc) != values[cc])
+    {
+      cerr << "ERROR: byte swapped values mismatch." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestRoundTrip(const char* name, vtkDataObject* data)
+{
+  vtkNew<vtkTimerLog> timer;
+  vtkIdType marshalledLength = 0, legacyLength = 0;
+
+  timer->StartTimer();
+  vtkSmartPointer<vtkDataObject> result = MarshallerRoundTrip(data, marshalledLength);
+  timer->StopTimer();
+  const double marshallerTime = timer->GetElapsedTime();
+
+  timer->StartTimer();
+  LegacyRoundTrip(data, legacyLength);
+  timer->StopTimer();
+  const double legacyTime = timer->GetElapsedTime();
+
+  cout << name << ": marshaller " << marshallerTime << "s (" << marshalledLength
+       << " bytes), legacy " << legacyTime << "s (" << legacyLength << " bytes)" << endl;
+
+  if (!result || !Compare(data, result))
+  {
+    cerr << "ERROR: round trip failed for " << name << endl;
+    return false;
+  }
+
+  result = ZeroCopyRoundTrip(data);
+  if (!result || !Compare(data, result))
+  {
+    cerr << "ERROR: segment-wise round trip failed for " << name << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDataObjectMarshaller(int argc, char* argv[])
+{
+  (void)argc;
+  (void)argv;
+
+  const int resolution = 200;
+  bool success = true;
+  success &= TestRoundTrip("vtkPolyData", CreatePolyData(resolution));
+  success &= TestRoundTrip("vtkUnstructuredGrid", CreateUnstructuredGrid(resolution));
+  success &= TestRoundTrip("vtkImageData", CreateImageData(resolution));
+  success &= TestRoundTrip("vtkMultiBlockDataSet", CreateMultiBlock(resolution));
+
+  // Data that cannot be marshalled must be rejected, not mangled.
+  vtkNew<vtkPVDataObjectMarshaller> marshaller;
+  if (marshaller->Marshal(NULL))
+  {
+    cerr << "ERROR: NULL should not be marshallable." << endl;
+    success = false;
+  }
+  vtkSmartPointer<vtkPolyData> withBits = CreatePolyData(4);
+  vtkNew<vtkBitArray> bits;
+  bits->SetName("Bits");
+  bits->SetNumberOfTuples(withBits->GetNumberOfPoints());
+  withBits->GetPointData()->AddArray(bits.GetPointer());
+  if (vtkPVDataObjectMarshaller::CanMarshal(withBits) || marshaller->Marshal(withBits))
+  {
+    cerr << "ERROR: vtkBitArray should not be marshallable." << endl;
+    success = false;
+  }
+  const char garbage[] = "not a marshalled buffer";
+  if (vtkPVDataObjectMarshaller::IsMarshalledData(garbage, sizeof(garbage)))
+  {
+    cerr << "ERROR: garbage detected as marshalled data." << endl;
+    success = false;
+  }
+
+  success &= TestByteSwapping();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
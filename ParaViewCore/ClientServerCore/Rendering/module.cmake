@@ -27,8 +27,11 @@ vtk_module(vtkPVClientServerCoreRendering
     vtkViewsCore
     ${__dependencies}
   PRIVATE_DEPENDS
+    vtklz4
     vtksys
     vtkzlib
+  TEST_DEPENDS
+    vtkTestingCore
   TEST_LABELS
     PARAVIEW
   KIT
@@ -23,7 +23,9 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVDataObjectMarshaller.h"
 #include "vtkPVSession.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
@@ -33,6 +35,7 @@
 #include "vtkUnstructuredGrid.h"
 
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkClientServerMoveData);
 vtkCxxSetObjectMacro(vtkClientServerMoveData, Controller, vtkMultiProcessController);
@@ -210,7 +213,42 @@ int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessContr
     }
   }
 
-  return controller->Send(input, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  // Types supported by vtkPVDataObjectMarshaller are sent as a header followed
+  // by the raw array buffers, without copying them. The header length is sent
+  // first, 0 indicating that the legacy path follows.
+  vtkNew<vtkPVDataObjectMarshaller> marshaller;
+  vtkIdType headerLength = marshaller->Marshal(input) ? marshaller->GetHeaderLength() : 0;
+  controller->Send(&headerLength, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  if (headerLength == 0)
+  {
+    return controller->Send(input, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  }
+
+  std::vector<vtkIdType> lengths(marshaller->GetNumberOfSegments());
+  for (int cc = 0; cc < marshaller->GetNumberOfSegments(); ++cc)
+  {
+    lengths[cc] = marshaller->GetSegmentLength(cc);
+  }
+  vtkIdType numSegments = static_cast<vtkIdType>(lengths.size());
+  controller->Send(
+    marshaller->GetHeader(), headerLength, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  controller->Send(&numSegments, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  if (numSegments > 0)
+  {
+    controller->Send(
+      &lengths[0], numSegments, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  }
+  int status = 1;
+  for (vtkIdType cc = 0; cc < numSegments; ++cc)
+  {
+    if (lengths[cc] > 0)
+    {
+      char* segment = static_cast<char*>(marshaller->GetSegmentPointer(static_cast<int>(cc)));
+      status &=
+        controller->Send(segment, lengths[cc], 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    }
+  }
+  return status;
 }
 
 //-----------------------------------------------------------------------------
@@ -239,7 +277,65 @@ vtkDataObject* vtkClientServerMoveData::ReceiveData(vtkMultiProcessController* c
   }
   else
   {
-    data = controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    vtkIdType headerLength = 0;
+    controller->Receive(&headerLength, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    if (headerLength == 0)
+    {
+      return controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    }
+
+    std::vector<char> header(headerLength);
+    controller->Receive(
+      &header[0], headerLength, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    vtkIdType numSegments = 0;
+    controller->Receive(&numSegments, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    std::vector<vtkIdType> lengths(numSegments);
+    if (numSegments > 0)
+    {
+      controller->Receive(
+        &lengths[0], numSegments, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    }
+
+    vtkNew<vtkPVDataObjectMarshaller> marshaller;
+    bool valid = marshaller->PrepareUnmarshal(&header[0], headerLength) != NULL &&
+      marshaller->GetNumberOfSegments() == numSegments;
+    for (vtkIdType cc = 0; valid && cc < numSegments; ++cc)
+    {
+      valid = (marshaller->GetSegmentLength(static_cast<int>(cc)) == lengths[cc]);
+    }
+
+    // Receive the array buffers directly into the arrays of the data object
+    // being built. If the header couldn't be understood, we still need to
+    // receive (and discard) everything the server sent.
+    std::vector<char> scratch;
+    for (vtkIdType cc = 0; cc < numSegments; ++cc)
+    {
+      if (lengths[cc] <= 0)
+      {
+        continue;
+      }
+      char* destination = NULL;
+      if (valid)
+      {
+        destination = static_cast<char*>(marshaller->GetSegmentPointer(static_cast<int>(cc)));
+      }
+      else
+      {
+        scratch.resize(lengths[cc]);
+        destination = &scratch[0];
+      }
+      controller->Receive(
+        destination, lengths[cc], 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    }
+
+    if (!valid)
+    {
+      vtkErrorMacro("Failed to unmarshal the data received from the server.");
+      return NULL;
+    }
+    marshaller->FinalizeUnmarshal();
+    data = marshaller->GetUnmarshalledDataObject();
+    data->Register(this);
   }
   return data;
 }
@@ -27,16 +27,19 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLZ4Compressor.h"
 #include "vtkMPIMToNSocketConnection.h"
 #include "vtkMolecule.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessControllerHelper.h"
+#include "vtkNew.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineFilter.h"
 #include "vtkOverlappingAMR.h"
 #include "vtkPVConfig.h"
+#include "vtkPVDataObjectMarshaller.h"
 #include "vtkPVSession.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -49,9 +52,13 @@
 #include "vtkTimerLog.h"
 #include "vtkToolkits.h"
 #include "vtkUndirectedGraph.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include "vtk_lz4.h"
 #include "vtk_zlib.h"
+
+#include <algorithm>
 #include <sstream>
 #include <vector>
 
@@ -60,9 +67,9 @@
 #include "vtkMPICommunicator.h"
 #endif
 
-#include <vector>
-
 bool vtkMPIMoveData::UseZLibCompression = false;
+bool vtkMPIMoveData::UseLZ4Compression = false;
+vtkIdType vtkMPIMoveData::TransferChunkSize = 4 * 1024 * 1024;
 
 namespace
 {
@@ -96,8 +103,84 @@ void unsetGlobalIdsAttribute(vtkDataObject* piece)
     it->Delete();
   }
 }
+
+enum CompressionCodecs
+{
+  CODEC_NONE = 0,
+  CODEC_ZLIB = 1,
+  CODEC_LZ4 = 2
 };
 
+// Compresses `length` bytes from `input` into `output`. Returns false if the
+// data couldn't be compressed (or didn't get any smaller), in which case the
+// caller is expected to send it uncompressed.
+bool vtkMPIMoveDataCompress(
+  int codec, const char* input, vtkIdType length, vtkUnsignedCharArray* output)
+{
+  if (codec == CODEC_ZLIB)
+  {
+    uLongf out_size = compressBound(static_cast<uLong>(length));
+    if (compress2(output->WritePointer(0, static_cast<vtkIdType>(out_size)), &out_size,
+          reinterpret_cast<const Bytef*>(input), static_cast<uLong>(length),
+          Z_DEFAULT_COMPRESSION) != Z_OK)
+    {
+      return false;
+    }
+    output->SetNumberOfTuples(static_cast<vtkIdType>(out_size));
+  }
+  else if (codec == CODEC_LZ4)
+  {
+    // LZ4 sizes are ints and the input must not exceed LZ4_MAX_INPUT_SIZE.
+    if (length > LZ4_MAX_INPUT_SIZE)
+    {
+      return false;
+    }
+    vtkNew<vtkUnsignedCharArray> in;
+    in->SetArray(reinterpret_cast<unsigned char*>(const_cast<char*>(input)), length, 1);
+    vtkNew<vtkLZ4Compressor> compressor;
+    compressor->SetLossLessMode(1);
+    compressor->SetQuality(0);
+    compressor->SetInput(in.GetPointer());
+    compressor->SetOutput(output);
+    if (compressor->Compress() != VTK_OK)
+    {
+      return false;
+    }
+  }
+  else
+  {
+    return false;
+  }
+  return output->GetNumberOfTuples() < length;
+}
+
+// Decompresses `length` bytes from `input` into the `output_length` bytes
+// long `output` buffer.
+bool vtkMPIMoveDataDecompress(
+  int codec, const char* input, vtkIdType length, char* output, vtkIdType output_length)
+{
+  if (codec == CODEC_ZLIB)
+  {
+    uLongf destLen = static_cast<uLongf>(output_length);
+    return uncompress(reinterpret_cast<Bytef*>(output), &destLen,
+             reinterpret_cast<const Bytef*>(input), static_cast<uLong>(length)) == Z_OK &&
+      static_cast<vtkIdType>(destLen) == output_length;
+  }
+  else if (codec == CODEC_LZ4)
+  {
+    // vtkLZ4Compressor::Decompress() accepts any positive size, so call
+    // LZ4_decompress_safe directly to reject truncated or corrupted chunks.
+    if (length > LZ4_MAX_INPUT_SIZE || output_length > LZ4_MAX_INPUT_SIZE)
+    {
+      return false;
+    }
+    return LZ4_decompress_safe(input, output, static_cast<int>(length),
+             static_cast<int>(output_length)) == static_cast<int>(output_length);
+  }
+  return false;
+}
+}
+
 vtkStandardNewMacro(vtkMPIMoveData);
 
 vtkCxxSetObjectMacro(vtkMPIMoveData, Controller, vtkMultiProcessController);
@@ -194,6 +277,30 @@ bool vtkMPIMoveData::GetUseZLibCompression()
   return vtkMPIMoveData::UseZLibCompression;
 }
 
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetUseLZ4Compression(bool b)
+{
+  vtkMPIMoveData::UseLZ4Compression = b;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMPIMoveData::GetUseLZ4Compression()
+{
+  return vtkMPIMoveData::UseLZ4Compression;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetTransferChunkSize(vtkIdType size)
+{
+  vtkMPIMoveData::TransferChunkSize = size > 0 ? size : 1;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkMPIMoveData::GetTransferChunkSize()
+{
+  return vtkMPIMoveData::TransferChunkSize;
+}
+
 //----------------------------------------------------------------------------
 int vtkMPIMoveData::FillInputPortInformation(int, vtkInformation* info)
 {
@@ -792,11 +899,9 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
   // int fixme;
   // We might be able to eliminate this marshal.
   this->ClearBuffer();
-  this->MarshalDataToBuffer(output);
-
-  com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
-  com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-  com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
+  this->MarshalDataToBuffer(output, /*compress=*/false);
+  this->SendBuffersInChunks(com, 23480);
+  this->ClearBuffer();
 }
 
 //-----------------------------------------------------------------------------
@@ -810,20 +915,7 @@ void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
     return;
   }
 
-  this->ClearBuffer();
-  com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
-  this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-  com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-  // Compute additional buffer information.
-  this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
-  this->BufferTotalLength = 0;
-  for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
-  {
-    this->BufferOffsets[idx] = this->BufferTotalLength;
-    this->BufferTotalLength += this->BufferLengths[idx];
-  }
-  this->Buffers = new char[this->BufferTotalLength];
-  com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
+  this->ReceiveBuffersInChunks(com, 23480);
 
   // int fixme;  // Can we avoid this?
   this->ReconstructDataFromBuffer(output);
@@ -849,10 +941,8 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
     // int fixme;
     // We might be able to eliminate this marshal.
     this->ClearBuffer();
-    this->MarshalDataToBuffer(data);
-    com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
-    com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-    com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
+    this->MarshalDataToBuffer(data, /*compress=*/false);
+    this->SendBuffersInChunks(com, 23480);
     this->ClearBuffer();
   }
 }
@@ -872,20 +962,7 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* da
       return;
     }
 
-    this->ClearBuffer();
-    com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
-    this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-    com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-    // Compute additional buffer information.
-    this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
-    this->BufferTotalLength = 0;
-    for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
-    {
-      this->BufferOffsets[idx] = this->BufferTotalLength;
-      this->BufferTotalLength += this->BufferLengths[idx];
-    }
-    this->Buffers = new char[this->BufferTotalLength];
-    com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
+    this->ReceiveBuffersInChunks(com, 23480);
 
     // int fixme;  // Can we avoid this?
     this->ReconstructDataFromBuffer(data);
@@ -907,11 +984,8 @@ void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
   {
     vtkTimerLog::MarkStartEvent("Dataserver sending to client");
     this->ClearBuffer();
-    this->MarshalDataToBuffer(output);
-    this->ClientDataServerSocketController->Send(&(this->NumberOfBuffers), 1, 1, 23490);
-    this->ClientDataServerSocketController->Send(
-      this->BufferLengths, this->NumberOfBuffers, 1, 23491);
-    this->ClientDataServerSocketController->Send(this->Buffers, this->BufferTotalLength, 1, 23492);
+    this->MarshalDataToBuffer(output, /*compress=*/false);
+    this->SendBuffersInChunks(this->ClientDataServerSocketController->GetCommunicator(), 23490);
     this->ClearBuffer();
     vtkTimerLog::MarkEndEvent("Dataserver sending to client");
   }
@@ -928,20 +1002,7 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
     return;
   }
 
-  this->ClearBuffer();
-  com->Receive(&(this->NumberOfBuffers), 1, 1, 23490);
-  this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-  com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23491);
-  // Compute additional buffer information.
-  this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
-  this->BufferTotalLength = 0;
-  for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
-  {
-    this->BufferOffsets[idx] = this->BufferTotalLength;
-    this->BufferTotalLength += this->BufferLengths[idx];
-  }
-  this->Buffers = new char[this->BufferTotalLength];
-  com->Receive(this->Buffers, this->BufferTotalLength, 1, 23492);
+  this->ReceiveBuffersInChunks(com, 23490);
   this->ReconstructDataFromBuffer(output);
   this->ClearBuffer();
 }
@@ -1026,7 +1087,7 @@ void vtkMPIMoveData::ClearBuffer()
 }
 
 //-----------------------------------------------------------------------------
-void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
+void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data, bool compress)
 {
   vtkDataSet* dataSet = vtkDataSet::SafeDownCast(data);
   vtkImageData* imageData = vtkImageData::SafeDownCast(data);
@@ -1039,57 +1100,91 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
     this->NumberOfBuffers = 0;
   }
 
-  // Copy input to isolate reader from the pipeline.
-  vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
-  writer->SetInputData(data);
-  if (imageData)
+  char* marshalled = NULL;
+  vtkIdType marshalled_length = 0;
+
+  vtkNew<vtkPVDataObjectMarshaller> marshaller;
+  if (marshaller->Marshal(data))
   {
-    // We add the image extents to the header, since the writer doesn't preserve
-    // the extents.
-    int* extent = imageData->GetExtent();
-    double* origin = imageData->GetOrigin();
-    std::ostringstream stream;
-    stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
-           << " " << extent[4] << " " << extent[5];
-    stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
-    writer->SetHeader(stream.str().c_str());
+    // Supported types are marshalled in binary form, avoiding the legacy
+    // writer altogether.
+    vtkTimerLog::MarkStartEvent("Binary marshal");
+    marshalled_length = marshaller->GetMarshalledLength();
+    marshalled = new char[marshalled_length];
+    marshaller->WriteMarshalledData(marshalled);
+    vtkTimerLog::MarkEndEvent("Binary marshal");
   }
+  else
+  {
+    // Copy input to isolate reader from the pipeline.
+    vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
+    writer->SetInputData(data);
+    if (imageData)
+    {
+      // We add the image extents to the header, since the writer doesn't preserve
+      // the extents.
+      int* extent = imageData->GetExtent();
+      double* origin = imageData->GetOrigin();
+      std::ostringstream stream;
+      stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " "
+             << extent[3] << " " << extent[4] << " " << extent[5];
+      stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
+      writer->SetHeader(stream.str().c_str());
+    }
+
+    writer->SetFileTypeToBinary();
+    writer->WriteToOutputStringOn();
+    writer->Write();
 
-  writer->SetFileTypeToBinary();
-  writer->WriteToOutputStringOn();
-  writer->Write();
+    marshalled_length = writer->GetOutputStringLength();
+    marshalled = writer->RegisterAndGetOutputString();
+    writer->Delete();
+    writer = 0;
+  }
 
   char* buffer = NULL;
   vtkIdType buffer_length = 0;
 
-  if (vtkMPIMoveData::UseZLibCompression)
-  {
-    vtkTimerLog::MarkStartEvent("Zlib compress");
-    // Use z-lib compression.
-    uLongf out_size = compressBound(writer->GetOutputStringLength());
-    buffer = new char[out_size + 8];
-    memcpy(buffer, "zlib0000", 8);
+  const int codec = !compress
+    ? CODEC_NONE
+    : (vtkMPIMoveData::UseLZ4Compression
+          ? CODEC_LZ4
+          : (vtkMPIMoveData::UseZLibCompression ? CODEC_ZLIB : CODEC_NONE));
+  vtkNew<vtkUnsignedCharArray> compressed;
+  if (codec != CODEC_NONE)
+  {
+    vtkTimerLog::MarkStartEvent(codec == CODEC_LZ4 ? "LZ4 compress" : "Zlib compress");
+    if (!vtkMPIMoveDataCompress(
+          codec, marshalled, marshalled_length, compressed.GetPointer()))
+    {
+      compressed->SetNumberOfTuples(0);
+    }
+    vtkTimerLog::MarkEndEvent(codec == CODEC_LZ4 ? "LZ4 compress" : "Zlib compress");
+  }
 
-    compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
-      reinterpret_cast<const Bytef*>(writer->GetOutputString()), writer->GetOutputStringLength(),
-      /* compression_level */ Z_DEFAULT_COMPRESSION);
-    vtkTimerLog::MarkEndEvent("Zlib compress");
-    int in_size = static_cast<int>(writer->GetOutputStringLength());
+  const vtkIdType compressed_length = compressed->GetNumberOfTuples();
+  if (compressed_length > 0)
+  {
+    buffer = new char[compressed_length + 8];
+    memcpy(buffer, codec == CODEC_LZ4 ? "lz4_0000" : "zlib0000", 8);
+    memcpy(buffer + 8, compressed->GetPointer(0), compressed_length);
+    int in_size = static_cast<int>(marshalled_length);
     for (int cc = 0; cc < 4; cc++)
     {
-      // the first 4 bytes in the header are "zlib" which helps the receiver
-      // identify that zlib compression has been used.
+      // the first 4 bytes in the header are "zlib" (or "lz4_") which helps the
+      // receiver identify that compression has been used.
       // the next 4 bytes are the original length since zlib doesn't provide
       // that to the receiver.
       buffer[4 + cc] = (in_size & 0x0ff);
       in_size = in_size >> 8;
     }
-    buffer_length = out_size + 8;
+    buffer_length = compressed_length + 8;
+    delete[] marshalled;
   }
   else
   {
-    buffer_length = writer->GetOutputStringLength();
-    buffer = writer->RegisterAndGetOutputString();
+    buffer_length = marshalled_length;
+    buffer = marshalled;
   }
 
   // Get string.
@@ -1100,9 +1195,101 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   this->BufferOffsets[0] = 0;
   this->Buffers = buffer;
   this->BufferTotalLength = this->BufferLengths[0];
+}
+
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::SendBuffersInChunks(vtkCommunicator* com, int tag)
+{
+  com->Send(&(this->NumberOfBuffers), 1, 1, tag);
+  com->Send(this->BufferLengths, this->NumberOfBuffers, 1, tag + 1);
+
+  const vtkIdType chunkSize = vtkMPIMoveData::TransferChunkSize;
+  vtkIdType numChunks = (this->BufferTotalLength + chunkSize - 1) / chunkSize;
+  com->Send(&numChunks, 1, 1, tag + 2);
+
+  const int codec = vtkMPIMoveData::UseLZ4Compression
+    ? CODEC_LZ4
+    : (vtkMPIMoveData::UseZLibCompression ? CODEC_ZLIB : CODEC_NONE);
+  vtkTimerLog::MarkStartEvent("Compress and send chunks");
+  vtkNew<vtkUnsignedCharArray> compressed;
+  for (vtkIdType cc = 0; cc < numChunks; ++cc)
+  {
+    // Each chunk is sent as soon as it is compressed, so that the receiver
+    // decompresses it while the following one is being compressed.
+    const char* data = this->Buffers + cc * chunkSize;
+    vtkIdType length = std::min(chunkSize, this->BufferTotalLength - cc * chunkSize);
+    vtkIdType header[3] = { CODEC_NONE, length, length };
+    if (codec != CODEC_NONE &&
+      vtkMPIMoveDataCompress(codec, data, length, compressed.GetPointer()))
+    {
+      header[0] = codec;
+      header[1] = compressed->GetNumberOfTuples();
+      data = reinterpret_cast<const char*>(compressed->GetPointer(0));
+    }
+    com->Send(header, 3, 1, tag + 3);
+    com->Send(data, header[1], 1, tag + 4);
+  }
+  vtkTimerLog::MarkEndEvent("Compress and send chunks");
+}
+
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::ReceiveBuffersInChunks(vtkCommunicator* com, int tag)
+{
+  this->ClearBuffer();
+  com->Receive(&(this->NumberOfBuffers), 1, 1, tag);
+  this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
+  com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, tag + 1);
+  // Compute additional buffer information.
+  this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
+  this->BufferTotalLength = 0;
+  for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
+  {
+    this->BufferOffsets[idx] = this->BufferTotalLength;
+    this->BufferTotalLength += this->BufferLengths[idx];
+  }
+  this->Buffers = new char[this->BufferTotalLength];
+
+  vtkIdType numChunks = 0;
+  com->Receive(&numChunks, 1, 1, tag + 2);
+
+  vtkTimerLog::MarkStartEvent("Receive and uncompress chunks");
+  std::vector<char> payload;
+  vtkIdType offset = 0;
+  bool failed = false;
+  for (vtkIdType cc = 0; cc < numChunks; ++cc)
+  {
+    vtkIdType header[3];
+    com->Receive(header, 3, 1, tag + 3);
+
+    // All chunks are received, even after an error, so that the
+    // communicator stays in sync with the sender.
+    payload.resize(static_cast<size_t>(std::max<vtkIdType>(header[1], 1)));
+    com->Receive(&payload[0], header[1], 1, tag + 4);
+    if (failed || offset + header[2] > this->BufferTotalLength)
+    {
+      failed = true;
+      continue;
+    }
+    if (header[0] == CODEC_NONE)
+    {
+      std::copy(payload.begin(), payload.begin() + header[1], this->Buffers + offset);
+    }
+    else if (!vtkMPIMoveDataDecompress(static_cast<int>(header[0]), &payload[0], header[1],
+               this->Buffers + offset, header[2]))
+    {
+      failed = true;
+    }
+    offset += header[2];
+  }
+  vtkTimerLog::MarkEndEvent("Receive and uncompress chunks");
 
-  writer->Delete();
-  writer = 0;
+  if (failed || offset != this->BufferTotalLength)
+  {
+    // this can only happen if the sender and the receiver are out of sync or
+    // the data is corrupted.
+    vtkErrorMacro("Failed to receive data: received chunks do not match the announced buffers.");
+    this->ClearBuffer();
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -1123,28 +1310,55 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
     vtkIdType bufferLength = this->BufferLengths[idx];
 
     char* realBuffer = 0;
-    if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
+    const bool zlib = bufferLength > 8 && strncmp(bufferArray, "zlib", 4) == 0;
+    const bool lz4 = bufferLength > 8 && strncmp(bufferArray, "lz4_", 4) == 0;
+    if (zlib || lz4)
     {
-      // sender used zlib compression. Decompress it.
-      vtkIdType compressed_length = bufferLength - 8; // remove the zlib header.
+      // sender used compression. Decompress it.
+      vtkIdType compressed_length = bufferLength - 8; // remove the header.
       vtkIdType uncompressed_length = 0;
       for (int cc = 0; cc < 4; cc++)
       {
         uncompressed_length = uncompressed_length | ((0xff & (bufferArray[4 + cc])) << 8 * cc);
       }
 
-      // using zlib compression.
       realBuffer = new char[uncompressed_length];
-      uLongf destLen = uncompressed_length;
-      vtkTimerLog::MarkStartEvent("Zlib uncompress");
-      uncompress(reinterpret_cast<Bytef*>(realBuffer), &destLen,
-        reinterpret_cast<const Bytef*>(bufferArray + 8), compressed_length);
-      vtkTimerLog::MarkEndEvent("Zlib uncompress");
+      vtkTimerLog::MarkStartEvent(lz4 ? "LZ4 uncompress" : "Zlib uncompress");
+      bool decompressed = vtkMPIMoveDataDecompress(lz4 ? CODEC_LZ4 : CODEC_ZLIB, bufferArray + 8,
+        compressed_length, realBuffer, uncompressed_length);
+      vtkTimerLog::MarkEndEvent(lz4 ? "LZ4 uncompress" : "Zlib uncompress");
+      if (!decompressed)
+      {
+        // Don't try to parse whatever the decompressor left in the buffer.
+        vtkErrorMacro("Failed to decompress received data.");
+        delete[] realBuffer;
+        continue;
+      }
 
       bufferArray = realBuffer;
       bufferLength = uncompressed_length;
     }
 
+    if (vtkPVDataObjectMarshaller::IsMarshalledData(bufferArray, bufferLength))
+    {
+      vtkNew<vtkPVDataObjectMarshaller> marshaller;
+      vtkSmartPointer<vtkDataObject> piece;
+      piece.TakeReference(marshaller->Unmarshal(bufferArray, bufferLength));
+      if (piece)
+      {
+        // reconstructing data distributted on MPI node, so global ids are valid
+        unsetGlobalIdsAttribute(piece);
+        pieces.push_back(piece);
+      }
+      else
+      {
+        vtkErrorMacro("Failed to unmarshal received data.");
+      }
+      delete[] realBuffer;
+      realBuffer = 0;
+      continue;
+    }
+
     // Setup a reader.
     vtkDataReader* reader = vtkGenericDataObjectReader::New();
     reader->ReadFromInputStringOn();
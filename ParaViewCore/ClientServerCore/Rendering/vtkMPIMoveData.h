@@ -29,6 +29,7 @@
 #include "vtkPVClientServerCoreRenderingModule.h" //needed for exports
 #include "vtkPassInputTypeAlgorithm.h"
 
+class vtkCommunicator;
 class vtkMultiProcessController;
 class vtkSocketController;
 class vtkMPIMToNSocketConnection;
@@ -113,6 +114,28 @@ public:
   static bool GetUseZLibCompression();
   //@}
 
+  //@{
+  /**
+   * When set to true, LZ4 compression is used. LZ4 compresses less than zlib
+   * but is much faster, which makes it a better fit for fast networks. When
+   * both zlib and LZ4 compression are enabled, LZ4 is used. False by default.
+   * As with zlib, the receiver detects the compression used by the sender.
+   */
+  static void SetUseLZ4Compression(bool b);
+  static bool GetUseLZ4Compression();
+  //@}
+
+  //@{
+  /**
+   * Data sent over sockets (to the client or from data server to render server)
+   * is split into chunks of this size (in bytes). Each chunk is compressed and
+   * sent on its own, so the receiver can decompress a chunk while the sender is
+   * compressing the next one. Default is 4 MiB.
+   */
+  static void SetTransferChunkSize(vtkIdType size);
+  static vtkIdType GetTransferChunkSize();
+  //@}
+
   /**
    * vtkMPIMoveData doesn't necessarily generate a valid output data on all the
    * involved processes (depending on the MoveMode and Server ivars). This
@@ -171,9 +194,19 @@ protected:
   vtkIdType BufferTotalLength;
 
   void ClearBuffer();
-  void MarshalDataToBuffer(vtkDataObject* data);
+  void MarshalDataToBuffer(vtkDataObject* data, bool compress = true);
   void ReconstructDataFromBuffer(vtkDataObject* data);
 
+  //@{
+  /**
+   * Send/receive the marshalled buffers over a socket communicator in chunks,
+   * each compressed independently. `tag` is the first of the 5 consecutive tags
+   * used.
+   */
+  void SendBuffersInChunks(vtkCommunicator* com, int tag);
+  void ReceiveBuffersInChunks(vtkCommunicator* com, int tag);
+  //@}
+
   int MoveMode;
   int Server;
 
@@ -196,6 +229,8 @@ private:
   void operator=(const vtkMPIMoveData&) VTK_DELETE_FUNCTION;
 
   static bool UseZLibCompression;
+  static bool UseLZ4Compression;
+  static vtkIdType TransferChunkSize;
 };
 
 #endif
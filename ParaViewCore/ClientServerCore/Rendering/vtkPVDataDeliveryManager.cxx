@@ -225,6 +225,10 @@ public:
 
   ItemsMapType ItemsMap;
   RepresentationsMapType RepresentationsMap;
+
+  // Kept across renders so that the kd-tree cuts can be reused when the data
+  // bounds don't change much.
+  vtkNew<vtkKdTreeManager> KdTreeManager;
 };
 
 //*****************************************************************************
@@ -232,7 +236,9 @@ public:
 vtkStandardNewMacro(vtkPVDataDeliveryManager);
 //----------------------------------------------------------------------------
 vtkPVDataDeliveryManager::vtkPVDataDeliveryManager()
-  : Internals(new vtkInternals())
+  : KdTreeReuseTolerance(0.0)
+  , KdTreeReused(false)
+  , Internals(new vtkInternals())
 {
 }
 
@@ -574,7 +580,10 @@ void vtkPVDataDeliveryManager::RedistributeDataForOrderedCompositing(bool use_lo
     // need to re-generate the kd-tree.
     this->RedistributionTimeStamp.Modified();
 
-    vtkNew<vtkKdTreeManager> cutsGenerator;
+    vtkKdTreeManager* cutsGenerator = this->Internals->KdTreeManager.GetPointer();
+    cutsGenerator->RemoveAllDataObjects();
+    cutsGenerator->ClearStructuredDataInformation();
+    cutsGenerator->SetReuseCutsTolerance(this->KdTreeReuseTolerance);
     vtkInternals::ItemsMapType::iterator iter;
     for (iter = this->Internals->ItemsMap.begin(); iter != this->Internals->ItemsMap.end(); ++iter)
     {
@@ -595,7 +604,11 @@ void vtkPVDataDeliveryManager::RedistributeDataForOrderedCompositing(bool use_lo
         }
       }
     }
-    cutsGenerator->GenerateKdTree();
+    this->KdTreeReused = !cutsGenerator->GenerateKdTree();
+    if (this->KdTreeReused)
+    {
+      vtkTimerLog::MarkEvent("Reusing Kd-Tree cuts");
+    }
     this->KdTree = cutsGenerator->GetKdTree();
 
     vtkTimerLog::MarkEndEvent("Regenerate Kd-Tree");
@@ -645,6 +658,9 @@ void vtkPVDataDeliveryManager::RedistributeDataForOrderedCompositing(bool use_lo
     redistributor->SetInputData(item.GetDeliveredDataObject());
     redistributor->SetPKdTree(this->KdTree);
     redistributor->SetPassThrough(0);
+    // When the kd-tree cuts were reused, most cells are already on the
+    // process that owns them.
+    redistributor->SetIncrementalRedistribution(this->KdTreeReused);
     redistributor->Update();
     item.SetRedistributedDataObject(redistributor->GetOutputDataObject(0));
   }
@@ -796,6 +812,7 @@ void vtkPVDataDeliveryManager::DeliverStreamedPieces(unsigned int size, unsigned
 void vtkPVDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "KdTreeReuseTolerance: " << this->KdTreeReuseTolerance << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -150,6 +150,19 @@ public:
    */
   void RedistributeDataForOrderedCompositing(bool use_lod);
 
+  //@{
+  /**
+   * When the data changes, e.g. when playing an animation, the kd-tree used for
+   * ordered compositing is only regenerated if the global data bounds have
+   * changed by more than this fraction of the bounding box diagonal (see
+   * vtkKdTreeManager::SetReuseCutsTolerance()). Otherwise, the existing cuts are
+   * reused and only cells that no longer lie in a region owned by their process
+   * are migrated. Set to 0 to always regenerate the kd-tree. Default is 0.
+   */
+  vtkSetClampMacro(KdTreeReuseTolerance, double, 0.0, 1.0);
+  vtkGetMacro(KdTreeReuseTolerance, double);
+  //@}
+
   /**
    * Removes all redistributed data that may have been redistributed for ordered compositing
    * earlier when using KdTree based redistribution.
@@ -222,6 +235,10 @@ protected:
   vtkSmartPointer<vtkPKdTree> KdTree;
 
   vtkTimeStamp RedistributionTimeStamp;
+  double KdTreeReuseTolerance;
+
+  // True when the last kd-tree update reused the previous cuts.
+  bool KdTreeReused;
 
 private:
   vtkPVDataDeliveryManager(const vtkPVDataDeliveryManager&) VTK_DELETE_FUNCTION;
@@ -0,0 +1,882 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataObjectMarshaller.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVDataObjectMarshaller.h"
+
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+// The header starts with: the magic string, the byte order marker, the format
+// version and the total length of the header.
+const char MarshallerMagic[4] = { 'P', 'V', 'D', 'M' };
+const vtkTypeUInt32 MarshallerByteOrder = 0x01020304;
+const vtkTypeUInt32 MarshallerSwappedByteOrder = 0x04030201;
+const vtkTypeUInt32 MarshallerVersion = 1;
+const vtkIdType MarshallerPrefixLength = 4 + 4 + 4 + 8;
+
+// Used for NULL blocks in composite datasets.
+const vtkTypeInt32 NULL_DATA_OBJECT = -1;
+
+class HeaderWriter
+{
+public:
+  HeaderWriter(std::vector<char>& buffer)
+    : Buffer(buffer)
+  {
+  }
+
+  template <typename T>
+  void Write(const T& value)
+  {
+    const char* ptr = reinterpret_cast<const char*>(&value);
+    this->Buffer.insert(this->Buffer.end(), ptr, ptr + sizeof(T));
+  }
+
+  void WriteString(const char* str)
+  {
+    vtkTypeInt32 length = str ? static_cast<vtkTypeInt32>(strlen(str)) : -1;
+    this->Write(length);
+    if (length > 0)
+    {
+      this->Buffer.insert(this->Buffer.end(), str, str + length);
+    }
+  }
+
+private:
+  std::vector<char>& Buffer;
+};
+
+class HeaderReader
+{
+public:
+  HeaderReader(const char* buffer, vtkIdType length, bool swap)
+    : Ptr(buffer)
+    , End(buffer + length)
+    , Swap(swap)
+  {
+  }
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (this->End - this->Ptr < static_cast<vtkIdType>(sizeof(T)))
+    {
+      return false;
+    }
+    memcpy(&value, this->Ptr, sizeof(T));
+    if (this->Swap)
+    {
+      vtkByteSwap::SwapVoidRange(&value, 1, sizeof(T));
+    }
+    this->Ptr += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(std::string& str, bool& valid)
+  {
+    vtkTypeInt32 length;
+    if (!this->Read(length) || this->End - this->Ptr < length)
+    {
+      return false;
+    }
+    valid = (length >= 0);
+    str = valid ? std::string(this->Ptr, length) : std::string();
+    this->Ptr += (length > 0 ? length : 0);
+    return true;
+  }
+
+private:
+  const char* Ptr;
+  const char* End;
+  bool Swap;
+};
+
+bool CanMarshalFieldData(vtkFieldData* fd)
+{
+  for (int cc = 0, max = fd ? fd->GetNumberOfArrays() : 0; cc < max; ++cc)
+  {
+    vtkDataArray* array = fd->GetArray(cc);
+    if (array == NULL)
+    {
+      // vtkStringArray, vtkVariantArray etc. are not supported.
+      return false;
+    }
+    if (array->GetDataType() == VTK_BIT)
+    {
+      // bits are packed, the array cannot be described as a segment of
+      // elements of GetDataTypeSize() bytes.
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//*****************************************************************************
+class vtkPVDataObjectMarshaller::vtkInternals
+{
+public:
+  struct vtkSegment
+  {
+    void* Pointer;
+    vtkIdType NumberOfValues;
+    int ElementSize;
+  };
+
+  std::vector<char> Header;
+  std::vector<vtkSegment> Segments;
+  vtkSmartPointer<vtkDataObject> DataObject;
+  bool Swap;
+
+  vtkInternals()
+    : Swap(false)
+  {
+  }
+
+  void Reset()
+  {
+    this->Header.clear();
+    this->Segments.clear();
+    this->DataObject = NULL;
+    this->Swap = false;
+  }
+
+  //---------------------------------------------------------------------------
+  // Marshalling.
+  void WriteArray(HeaderWriter& writer, vtkDataArray* array)
+  {
+    writer.WriteString(array->GetName());
+    writer.Write(static_cast<vtkTypeInt32>(array->GetDataType()));
+    writer.Write(static_cast<vtkTypeInt32>(array->GetDataTypeSize()));
+    writer.Write(static_cast<vtkTypeInt32>(array->GetNumberOfComponents()));
+    writer.Write(static_cast<vtkTypeInt64>(array->GetNumberOfTuples()));
+
+    vtkSegment segment;
+    segment.NumberOfValues = array->GetNumberOfTuples() * array->GetNumberOfComponents();
+    segment.ElementSize = array->GetDataTypeSize();
+    segment.Pointer = segment.NumberOfValues > 0 ? array->GetVoidPointer(0) : NULL;
+    this->Segments.push_back(segment);
+  }
+
+  void WriteFieldData(HeaderWriter& writer, vtkFieldData* fd)
+  {
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    writer.Write(static_cast<vtkTypeInt32>(fd->GetNumberOfArrays()));
+    for (int cc = 0; cc < fd->GetNumberOfArrays(); ++cc)
+    {
+      vtkDataArray* array = fd->GetArray(cc);
+      vtkTypeInt32 attributes = 0;
+      for (int attr = 0; dsa && attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+      {
+        if (dsa->GetAbstractAttribute(attr) == array)
+        {
+          attributes |= (1 << attr);
+        }
+      }
+      writer.Write(attributes);
+      this->WriteArray(writer, array);
+    }
+  }
+
+  void WriteCellArray(HeaderWriter& writer, vtkCellArray* cells)
+  {
+    writer.Write(static_cast<vtkTypeInt64>(cells->GetNumberOfCells()));
+    this->WriteArray(writer, cells->GetData());
+  }
+
+  void WriteDataObject(HeaderWriter& writer, vtkDataObject* dobj)
+  {
+    if (dobj == NULL)
+    {
+      writer.Write(NULL_DATA_OBJECT);
+      return;
+    }
+
+    const vtkTypeInt32 type = dobj->GetDataObjectType();
+    writer.Write(type);
+    if (type == VTK_MULTIBLOCK_DATA_SET || type == VTK_MULTIPIECE_DATA_SET)
+    {
+      vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(dobj);
+      vtkMultiPieceDataSet* mp = vtkMultiPieceDataSet::SafeDownCast(dobj);
+      unsigned int numBlocks = mb ? mb->GetNumberOfBlocks() : mp->GetNumberOfPieces();
+      writer.Write(static_cast<vtkTypeUInt32>(numBlocks));
+      for (unsigned int cc = 0; cc < numBlocks; ++cc)
+      {
+        bool hasMetaData = mb ? mb->HasMetaData(cc) != 0 : mp->HasMetaData(cc) != 0;
+        vtkInformation* metadata =
+          hasMetaData ? (mb ? mb->GetMetaData(cc) : mp->GetMetaData(cc)) : NULL;
+        writer.WriteString(metadata && metadata->Has(vtkCompositeDataSet::NAME())
+            ? metadata->Get(vtkCompositeDataSet::NAME())
+            : NULL);
+        this->WriteDataObject(writer, mb ? mb->GetBlock(cc) : mp->GetPiece(cc));
+      }
+    }
+    else
+    {
+      vtkDataSet* ds = vtkDataSet::SafeDownCast(dobj);
+      if (vtkImageData* id = vtkImageData::SafeDownCast(ds))
+      {
+        int* extent = id->GetExtent();
+        double* origin = id->GetOrigin();
+        double* spacing = id->GetSpacing();
+        for (int cc = 0; cc < 6; ++cc)
+        {
+          writer.Write(static_cast<vtkTypeInt32>(extent[cc]));
+        }
+        for (int cc = 0; cc < 3; ++cc)
+        {
+          writer.Write(origin[cc]);
+        }
+        for (int cc = 0; cc < 3; ++cc)
+        {
+          writer.Write(spacing[cc]);
+        }
+      }
+      else
+      {
+        vtkPointSet* ps = vtkPointSet::SafeDownCast(ds);
+        vtkPoints* points = ps->GetPoints();
+        writer.Write(static_cast<vtkTypeInt8>(points ? 1 : 0));
+        if (points)
+        {
+          this->WriteArray(writer, points->GetData());
+        }
+
+        if (vtkPolyData* pd = vtkPolyData::SafeDownCast(ds))
+        {
+          this->WriteCellArray(writer, pd->GetVerts());
+          this->WriteCellArray(writer, pd->GetLines());
+          this->WriteCellArray(writer, pd->GetPolys());
+          this->WriteCellArray(writer, pd->GetStrips());
+        }
+        else if (vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(ds))
+        {
+          bool hasCells = ug->GetCells() && ug->GetCellTypesArray() && ug->GetCellLocationsArray();
+          writer.Write(static_cast<vtkTypeInt8>(hasCells ? 1 : 0));
+          if (hasCells)
+          {
+            this->WriteCellArray(writer, ug->GetCells());
+            this->WriteArray(writer, ug->GetCellTypesArray());
+            this->WriteArray(writer, ug->GetCellLocationsArray());
+          }
+        }
+      }
+      this->WriteFieldData(writer, ds->GetPointData());
+      this->WriteFieldData(writer, ds->GetCellData());
+    }
+    this->WriteFieldData(writer, dobj->GetFieldData());
+  }
+
+  //---------------------------------------------------------------------------
+  // Unmarshalling.
+  vtkSmartPointer<vtkDataArray> ReadArray(HeaderReader& reader)
+  {
+    std::string name;
+    bool hasName;
+    vtkTypeInt32 dataType, elementSize, numComps;
+    vtkTypeInt64 numTuples;
+    if (!reader.ReadString(name, hasName) || !reader.Read(dataType) ||
+      !reader.Read(elementSize) || !reader.Read(numComps) || !reader.Read(numTuples) ||
+      dataType == VTK_BIT || elementSize < 1 || numComps < 1 || numTuples < 0)
+    {
+      return NULL;
+    }
+
+    vtkSmartPointer<vtkDataArray> array;
+    array.TakeReference(vtkDataArray::CreateDataArray(dataType));
+    if (!array || array->GetDataTypeSize() != elementSize)
+    {
+      // unknown type or type with a different size on this platform.
+      return NULL;
+    }
+    if (hasName)
+    {
+      array->SetName(name.c_str());
+    }
+    array->SetNumberOfComponents(numComps);
+    array->SetNumberOfTuples(static_cast<vtkIdType>(numTuples));
+
+    vtkSegment segment;
+    segment.NumberOfValues = static_cast<vtkIdType>(numTuples) * numComps;
+    segment.ElementSize = elementSize;
+    segment.Pointer = segment.NumberOfValues > 0 ? array->GetVoidPointer(0) : NULL;
+    this->Segments.push_back(segment);
+    return array;
+  }
+
+  bool ReadFieldData(HeaderReader& reader, vtkFieldData* fd)
+  {
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    vtkTypeInt32 numArrays;
+    if (!reader.Read(numArrays))
+    {
+      return false;
+    }
+    for (vtkTypeInt32 cc = 0; cc < numArrays; ++cc)
+    {
+      vtkTypeInt32 attributes;
+      if (!reader.Read(attributes))
+      {
+        return false;
+      }
+      vtkSmartPointer<vtkDataArray> array = this->ReadArray(reader);
+      if (!array)
+      {
+        return false;
+      }
+      int index = fd->AddArray(array);
+      for (int attr = 0; dsa && attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+      {
+        if (attributes & (1 << attr))
+        {
+          dsa->SetActiveAttribute(index, attr);
+        }
+      }
+    }
+    return true;
+  }
+
+  vtkSmartPointer<vtkCellArray> ReadCellArray(HeaderReader& reader)
+  {
+    vtkTypeInt64 numCells;
+    if (!reader.Read(numCells))
+    {
+      return NULL;
+    }
+    vtkSmartPointer<vtkDataArray> data = this->ReadArray(reader);
+    if (!vtkIdTypeArray::SafeDownCast(data))
+    {
+      return NULL;
+    }
+    vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetCells(static_cast<vtkIdType>(numCells), vtkIdTypeArray::SafeDownCast(data));
+    return cells;
+  }
+
+  vtkSmartPointer<vtkDataObject> ReadDataObject(HeaderReader& reader, bool& ok)
+  {
+    ok = false;
+    vtkTypeInt32 type;
+    if (!reader.Read(type))
+    {
+      return NULL;
+    }
+
+    vtkSmartPointer<vtkDataObject> dobj;
+    switch (type)
+    {
+      case NULL_DATA_OBJECT:
+        ok = true;
+        return NULL;
+
+      case VTK_MULTIBLOCK_DATA_SET:
+      case VTK_MULTIPIECE_DATA_SET:
+      {
+        vtkSmartPointer<vtkMultiBlockDataSet> mb;
+        vtkSmartPointer<vtkMultiPieceDataSet> mp;
+        if (type == VTK_MULTIBLOCK_DATA_SET)
+        {
+          dobj = mb = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+        }
+        else
+        {
+          dobj = mp = vtkSmartPointer<vtkMultiPieceDataSet>::New();
+        }
+        vtkTypeUInt32 numBlocks;
+        if (!reader.Read(numBlocks))
+        {
+          return NULL;
+        }
+        if (mb)
+        {
+          mb->SetNumberOfBlocks(numBlocks);
+        }
+        else
+        {
+          mp->SetNumberOfPieces(numBlocks);
+        }
+        for (vtkTypeUInt32 cc = 0; cc < numBlocks; ++cc)
+        {
+          std::string name;
+          bool hasName;
+          bool childOk;
+          if (!reader.ReadString(name, hasName))
+          {
+            return NULL;
+          }
+          vtkSmartPointer<vtkDataObject> child = this->ReadDataObject(reader, childOk);
+          if (!childOk)
+          {
+            return NULL;
+          }
+          if (mb)
+          {
+            mb->SetBlock(cc, child);
+          }
+          else
+          {
+            mp->SetPiece(cc, child);
+          }
+          if (hasName)
+          {
+            (mb ? mb->GetMetaData(cc) : mp->GetMetaData(cc))
+              ->Set(vtkCompositeDataSet::NAME(), name.c_str());
+          }
+        }
+      }
+      break;
+
+      case VTK_IMAGE_DATA:
+      {
+        vtkSmartPointer<vtkImageData> id = vtkSmartPointer<vtkImageData>::New();
+        vtkTypeInt32 extent[6];
+        double origin[3], spacing[3];
+        for (int cc = 0; cc < 6; ++cc)
+        {
+          if (!reader.Read(extent[cc]))
+          {
+            return NULL;
+          }
+        }
+        for (int cc = 0; cc < 3; ++cc)
+        {
+          if (!reader.Read(origin[cc]))
+          {
+            return NULL;
+          }
+        }
+        for (int cc = 0; cc < 3; ++cc)
+        {
+          if (!reader.Read(spacing[cc]))
+          {
+            return NULL;
+          }
+        }
+        id->SetExtent(extent[0], extent[1], extent[2], extent[3], extent[4], extent[5]);
+        id->SetOrigin(origin);
+        id->SetSpacing(spacing);
+        dobj = id;
+      }
+      break;
+
+      case VTK_POLY_DATA:
+      case VTK_UNSTRUCTURED_GRID:
+      {
+        vtkSmartPointer<vtkPointSet> ps;
+        ps.TakeReference(type == VTK_POLY_DATA
+            ? static_cast<vtkPointSet*>(vtkPolyData::New())
+            : static_cast<vtkPointSet*>(vtkUnstructuredGrid::New()));
+        vtkTypeInt8 hasPoints;
+        if (!reader.Read(hasPoints))
+        {
+          return NULL;
+        }
+        if (hasPoints)
+        {
+          vtkSmartPointer<vtkDataArray> data = this->ReadArray(reader);
+          if (!data)
+          {
+            return NULL;
+          }
+          vtkNew<vtkPoints> points;
+          points->SetData(data);
+          ps->SetPoints(points.GetPointer());
+        }
+
+        if (vtkPolyData* pd = vtkPolyData::SafeDownCast(ps))
+        {
+          vtkSmartPointer<vtkCellArray> cells[4];
+          for (int cc = 0; cc < 4; ++cc)
+          {
+            cells[cc] = this->ReadCellArray(reader);
+            if (!cells[cc])
+            {
+              return NULL;
+            }
+          }
+          pd->SetVerts(cells[0]);
+          pd->SetLines(cells[1]);
+          pd->SetPolys(cells[2]);
+          pd->SetStrips(cells[3]);
+        }
+        else
+        {
+          vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(ps);
+          vtkTypeInt8 hasCells;
+          if (!reader.Read(hasCells))
+          {
+            return NULL;
+          }
+          if (hasCells)
+          {
+            vtkSmartPointer<vtkCellArray> cells = this->ReadCellArray(reader);
+            if (!cells)
+            {
+              return NULL;
+            }
+            vtkSmartPointer<vtkDataArray> types = this->ReadArray(reader);
+            vtkSmartPointer<vtkDataArray> locations = this->ReadArray(reader);
+            if (!vtkUnsignedCharArray::SafeDownCast(types) ||
+              !vtkIdTypeArray::SafeDownCast(locations))
+            {
+              return NULL;
+            }
+            ug->SetCells(vtkUnsignedCharArray::SafeDownCast(types),
+              vtkIdTypeArray::SafeDownCast(locations), cells);
+          }
+        }
+        dobj = ps;
+      }
+      break;
+
+      default:
+        return NULL;
+    }
+
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(dobj);
+    if (ds && (!this->ReadFieldData(reader, ds->GetPointData()) ||
+                !this->ReadFieldData(reader, ds->GetCellData())))
+    {
+      return NULL;
+    }
+    if (!this->ReadFieldData(reader, dobj->GetFieldData()))
+    {
+      return NULL;
+    }
+    ok = true;
+    return dobj;
+  }
+};
+
+//*****************************************************************************
+namespace
+{
+bool CanMarshalDataObject(vtkDataObject* dobj)
+{
+  if (!CanMarshalFieldData(dobj->GetFieldData()))
+  {
+    return false;
+  }
+
+  switch (dobj->GetDataObjectType())
+  {
+    case VTK_MULTIBLOCK_DATA_SET:
+    {
+      vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(dobj);
+      for (unsigned int cc = 0; cc < mb->GetNumberOfBlocks(); ++cc)
+      {
+        vtkDataObject* block = mb->GetBlock(cc);
+        if (block && !CanMarshalDataObject(block))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    case VTK_MULTIPIECE_DATA_SET:
+    {
+      vtkMultiPieceDataSet* mp = vtkMultiPieceDataSet::SafeDownCast(dobj);
+      for (unsigned int cc = 0; cc < mp->GetNumberOfPieces(); ++cc)
+      {
+        vtkDataObject* piece = mp->GetPiece(cc);
+        if (piece && !CanMarshalDataObject(piece))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    case VTK_UNSTRUCTURED_GRID:
+    case VTK_POLY_DATA:
+    case VTK_IMAGE_DATA:
+    {
+      vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dobj);
+      if (ug && ug->GetFaces() != NULL)
+      {
+        // polyhedral cells are not supported.
+        return false;
+      }
+      vtkDataSet* ds = vtkDataSet::SafeDownCast(dobj);
+      return CanMarshalFieldData(ds->GetPointData()) && CanMarshalFieldData(ds->GetCellData());
+    }
+  }
+  return false;
+}
+}
+
+vtkStandardNewMacro(vtkPVDataObjectMarshaller);
+//----------------------------------------------------------------------------
+vtkPVDataObjectMarshaller::vtkPVDataObjectMarshaller()
+  : Internals(new vtkPVDataObjectMarshaller::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVDataObjectMarshaller::~vtkPVDataObjectMarshaller()
+{
+  delete this->Internals;
+  this->Internals = NULL;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataObjectMarshaller::CanMarshal(vtkDataObject* data)
+{
+  return data != NULL && CanMarshalDataObject(data);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataObjectMarshaller::IsMarshalledData(const char* buffer, vtkIdType length)
+{
+  return buffer != NULL && length >= MarshallerPrefixLength &&
+    memcmp(buffer, MarshallerMagic, sizeof(MarshallerMagic)) == 0;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVDataObjectMarshaller::GetHeaderPrefixLength()
+{
+  return MarshallerPrefixLength;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVDataObjectMarshaller::GetHeaderLength(const char* prefix)
+{
+  if (!vtkPVDataObjectMarshaller::IsMarshalledData(prefix, MarshallerPrefixLength))
+  {
+    return 0;
+  }
+
+  vtkTypeUInt32 byteOrder;
+  memcpy(&byteOrder, prefix + 4, sizeof(byteOrder));
+  if (byteOrder != MarshallerByteOrder && byteOrder != MarshallerSwappedByteOrder)
+  {
+    return 0;
+  }
+
+  HeaderReader reader(prefix + 12, 8, byteOrder == MarshallerSwappedByteOrder);
+  vtkTypeInt64 length = 0;
+  reader.Read(length);
+  return static_cast<vtkIdType>(length);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataObjectMarshaller::Marshal(vtkDataObject* data)
+{
+  vtkInternals& internals = (*this->Internals);
+  internals.Reset();
+  if (!vtkPVDataObjectMarshaller::CanMarshal(data))
+  {
+    return false;
+  }
+  internals.DataObject = data;
+
+  HeaderWriter writer(internals.Header);
+  internals.Header.insert(
+    internals.Header.end(), MarshallerMagic, MarshallerMagic + sizeof(MarshallerMagic));
+  writer.Write(MarshallerByteOrder);
+  writer.Write(MarshallerVersion);
+  writer.Write(static_cast<vtkTypeInt64>(0)); // placeholder for the header length.
+  internals.WriteDataObject(writer, data);
+
+  vtkTypeInt64 length = static_cast<vtkTypeInt64>(internals.Header.size());
+  memcpy(&internals.Header[12], &length, sizeof(length));
+  return true;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVDataObjectMarshaller::GetHeader()
+{
+  return this->Internals->Header.empty() ? NULL : &this->Internals->Header[0];
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVDataObjectMarshaller::GetHeaderLength()
+{
+  return static_cast<vtkIdType>(this->Internals->Header.size());
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVDataObjectMarshaller::GetMarshalledLength()
+{
+  vtkIdType length = this->GetHeaderLength();
+  for (int cc = 0; cc < this->GetNumberOfSegments(); ++cc)
+  {
+    length += this->GetSegmentLength(cc);
+  }
+  return length;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataObjectMarshaller::WriteMarshalledData(char* buffer)
+{
+  if (this->Internals->Header.empty())
+  {
+    return;
+  }
+  memcpy(buffer, this->GetHeader(), this->GetHeaderLength());
+  buffer += this->GetHeaderLength();
+  for (int cc = 0; cc < this->GetNumberOfSegments(); ++cc)
+  {
+    vtkIdType length = this->GetSegmentLength(cc);
+    if (length > 0)
+    {
+      memcpy(buffer, this->GetSegmentPointer(cc), length);
+      buffer += length;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkPVDataObjectMarshaller::PrepareUnmarshal(const char* header, vtkIdType length)
+{
+  vtkInternals& internals = (*this->Internals);
+  internals.Reset();
+
+  vtkIdType headerLength = vtkPVDataObjectMarshaller::GetHeaderLength(header);
+  if (headerLength < MarshallerPrefixLength || headerLength > length)
+  {
+    vtkErrorMacro("Invalid or truncated header.");
+    return NULL;
+  }
+
+  vtkTypeUInt32 byteOrder;
+  memcpy(&byteOrder, header + 4, sizeof(byteOrder));
+  internals.Swap = (byteOrder == MarshallerSwappedByteOrder);
+
+  HeaderReader reader(header + 8, headerLength - 8, internals.Swap);
+  vtkTypeUInt32 version;
+  vtkTypeInt64 dummy;
+  if (!reader.Read(version) || version != MarshallerVersion || !reader.Read(dummy))
+  {
+    vtkErrorMacro("Unsupported version.");
+    return NULL;
+  }
+
+  bool ok;
+  internals.DataObject = internals.ReadDataObject(reader, ok);
+  if (!ok || !internals.DataObject)
+  {
+    vtkErrorMacro("Failed to parse header.");
+    internals.Reset();
+    return NULL;
+  }
+  return internals.DataObject;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkPVDataObjectMarshaller::GetUnmarshalledDataObject()
+{
+  return this->Internals->DataObject;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataObjectMarshaller::FinalizeUnmarshal()
+{
+  vtkInternals& internals = (*this->Internals);
+  if (!internals.Swap)
+  {
+    return;
+  }
+  for (size_t cc = 0; cc < internals.Segments.size(); ++cc)
+  {
+    const vtkInternals::vtkSegment& segment = internals.Segments[cc];
+    if (segment.ElementSize > 1 && segment.NumberOfValues > 0)
+    {
+      vtkByteSwap::SwapVoidRange(segment.Pointer, segment.NumberOfValues, segment.ElementSize);
+    }
+  }
+  internals.Swap = false;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVDataObjectMarshaller::GetNumberOfSegments()
+{
+  return static_cast<int>(this->Internals->Segments.size());
+}
+
+//----------------------------------------------------------------------------
+void* vtkPVDataObjectMarshaller::GetSegmentPointer(int index)
+{
+  return this->Internals->Segments[index].Pointer;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVDataObjectMarshaller::GetSegmentLength(int index)
+{
+  const vtkInternals::vtkSegment& segment = this->Internals->Segments[index];
+  return segment.NumberOfValues * segment.ElementSize;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkPVDataObjectMarshaller::Unmarshal(const char* buffer, vtkIdType length)
+{
+  if (!this->PrepareUnmarshal(buffer, length))
+  {
+    return NULL;
+  }
+
+  vtkIdType offset = this->GetHeaderLength(buffer);
+  for (int cc = 0; cc < this->GetNumberOfSegments(); ++cc)
+  {
+    vtkIdType segmentLength = this->GetSegmentLength(cc);
+    if (offset + segmentLength > length)
+    {
+      vtkErrorMacro("Buffer is too short.");
+      this->Internals->Reset();
+      return NULL;
+    }
+    if (segmentLength > 0)
+    {
+      memcpy(this->GetSegmentPointer(cc), buffer + offset, segmentLength);
+    }
+    offset += segmentLength;
+  }
+  this->FinalizeUnmarshal();
+
+  vtkDataObject* result = this->Internals->DataObject;
+  result->Register(this);
+  this->Internals->Reset();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataObjectMarshaller::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "HeaderLength: " << this->GetHeaderLength() << endl;
+  os << indent << "NumberOfSegments: " << this->GetNumberOfSegments() << endl;
+}
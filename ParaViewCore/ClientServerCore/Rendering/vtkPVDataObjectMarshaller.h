@@ -0,0 +1,153 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataObjectMarshaller.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVDataObjectMarshaller
+ * @brief   binary marshalling of data objects for delivery.
+ *
+ * vtkPVDataObjectMarshaller serializes vtkPolyData, vtkUnstructuredGrid,
+ * vtkImageData and vtkMultiBlockDataSet / vtkMultiPieceDataSet comprising of
+ * these into a compact binary format. Unlike the legacy VTK writer/reader used
+ * by vtkMPIMoveData and vtkCommunicator, there's no text parsing or
+ * type-by-type conversion: the marshalled data is a small header describing
+ * the structure of the data object followed by the raw buffers (segments) of
+ * all its arrays.
+ *
+ * On the sending side, Marshal() builds the header and collects the segments
+ * without copying any array. The marshalled data can either be flattened into
+ * a single buffer using WriteMarshalledData(), or the header and segments can
+ * be sent separately.
+ *
+ * On the receiving side, PrepareUnmarshal() parses the header and builds a
+ * data object with all arrays allocated. GetSegmentPointer() then provides the
+ * memory each segment must be received into, making it possible to receive the
+ * array buffers directly into the arrays. Unmarshal() is a convenience method
+ * that does the same from a flattened buffer.
+ *
+ * The header records the byte order of the sender; buffers are byte-swapped
+ * when sender and receiver differ. Data that cannot be marshalled (see
+ * CanMarshal()) must be sent using the legacy path.
+ */
+
+#ifndef vtkPVDataObjectMarshaller_h
+#define vtkPVDataObjectMarshaller_h
+
+#include "vtkObject.h"
+#include "vtkPVClientServerCoreRenderingModule.h" //needed for exports
+
+class vtkDataObject;
+
+class VTKPVCLIENTSERVERCORERENDERING_EXPORT vtkPVDataObjectMarshaller : public vtkObject
+{
+public:
+  static vtkPVDataObjectMarshaller* New();
+  vtkTypeMacro(vtkPVDataObjectMarshaller, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
+
+  /**
+   * Returns true if the data object can be marshalled i.e. it is a
+   * vtkPolyData, vtkUnstructuredGrid (without polyhedra), vtkImageData or a
+   * vtkMultiBlockDataSet / vtkMultiPieceDataSet of those with only
+   * vtkDataArray subclasses, other than vtkBitArray, in its field data. NULL
+   * is not supported.
+   */
+  static bool CanMarshal(vtkDataObject* data);
+
+  /**
+   * Returns true if the buffer starts with a header generated by this class.
+   */
+  static bool IsMarshalledData(const char* buffer, vtkIdType length);
+
+  /**
+   * Length of the fixed size prefix of the header. The total length of the
+   * header can be obtained using GetHeaderLength() from the first
+   * `GetHeaderPrefixLength()` bytes.
+   */
+  static vtkIdType GetHeaderPrefixLength();
+  static vtkIdType GetHeaderLength(const char* prefix);
+
+  //@{
+  /**
+   * Marshals `data`. Returns false if the data cannot be marshalled. The
+   * segments reference the arrays of `data`, which is kept alive till the next
+   * call to Marshal() or PrepareUnmarshal().
+   */
+  bool Marshal(vtkDataObject* data);
+  const char* GetHeader();
+  vtkIdType GetHeaderLength();
+  //@}
+
+  /**
+   * Returns the total length of the marshalled data i.e. the header and all
+   * segments.
+   */
+  vtkIdType GetMarshalledLength();
+
+  /**
+   * Writes the header followed by all segments in `buffer` which must be at
+   * least GetMarshalledLength() long.
+   */
+  void WriteMarshalledData(char* buffer);
+
+  /**
+   * Parses the header and creates the data object with all arrays allocated.
+   * Returns NULL on failure. The data object is owned by this class; use
+   * GetUnmarshalledDataObject() to access it.
+   */
+  vtkDataObject* PrepareUnmarshal(const char* header, vtkIdType length);
+
+  /**
+   * Returns the data object created by PrepareUnmarshal(). Call
+   * FinalizeUnmarshal() once all segments have been filled in.
+   */
+  vtkDataObject* GetUnmarshalledDataObject();
+
+  /**
+   * Must be called once all segments have been received. This takes care of
+   * byte swapping if needed.
+   */
+  void FinalizeUnmarshal();
+
+  //@{
+  /**
+   * Access to the segments i.e. the raw array buffers following the header.
+   * After Marshal() these point to the arrays of the marshalled data. After
+   * PrepareUnmarshal() these point to the arrays of the data object being
+   * built, in which the received segments must be copied.
+   */
+  int GetNumberOfSegments();
+  void* GetSegmentPointer(int index);
+  vtkIdType GetSegmentLength(int index);
+  //@}
+
+  /**
+   * Convenience method to unmarshal a buffer generated by
+   * WriteMarshalledData(). Returns a new data object (the caller is responsible
+   * for deleting it) or NULL on failure.
+   */
+  vtkDataObject* Unmarshal(const char* buffer, vtkIdType length);
+
+protected:
+  vtkPVDataObjectMarshaller();
+  ~vtkPVDataObjectMarshaller();
+
+private:
+  vtkPVDataObjectMarshaller(const vtkPVDataObjectMarshaller&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkPVDataObjectMarshaller&) VTK_DELETE_FUNCTION;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
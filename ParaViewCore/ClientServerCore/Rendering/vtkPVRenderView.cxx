@@ -594,6 +594,18 @@ vtkPVDataDeliveryManager* vtkPVRenderView::GetDeliveryManager()
   return this->Internals->DeliveryManager.GetPointer();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetKdTreeReuseTolerance(double tolerance)
+{
+  this->Internals->DeliveryManager->SetKdTreeReuseTolerance(tolerance);
+}
+
+//----------------------------------------------------------------------------
+double vtkPVRenderView::GetKdTreeReuseTolerance()
+{
+  return this->Internals->DeliveryManager->GetKdTreeReuseTolerance();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::SetUseOffscreenRendering(bool use_offscreen)
 {
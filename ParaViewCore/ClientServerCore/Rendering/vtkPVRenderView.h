@@ -256,6 +256,17 @@ public:
   vtkGetMacro(LODResolution, double);
   //@}
 
+  //@{
+  /**
+   * Get/Set the tolerance used to decide whether the kd-tree built for ordered
+   * compositing can be reused when the data changes, e.g. when playing an
+   * animation. See vtkPVDataDeliveryManager::SetKdTreeReuseTolerance().
+   * \note CallOnAllProcesses
+   */
+  void SetKdTreeReuseTolerance(double tolerance);
+  double GetKdTreeReuseTolerance();
+  //@}
+
   //@{
   /**
    * When set to true, instead of using simplified geometry for LOD rendering,
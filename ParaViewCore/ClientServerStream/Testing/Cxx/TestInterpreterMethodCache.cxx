@@ -0,0 +1,230 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestInterpreterMethodCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Invokes a method of a superclass many times, with and without the method
+// cache of vtkClientServerInterpreter, checking that both give the same
+// results. Use the --invokes argument to use this for benchmarking.
+
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerStream.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+class vtkTestBaseObject : public vtkObject
+{
+public:
+  static vtkTestBaseObject* New();
+  vtkTypeMacro(vtkTestBaseObject, vtkObject);
+
+  void SetValue(double value) { this->Value = value; }
+  double GetValue() { return this->Value; }
+
+protected:
+  vtkTestBaseObject()
+    : Value(0)
+  {
+  }
+
+  double Value;
+
+private:
+  vtkTestBaseObject(const vtkTestBaseObject&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkTestBaseObject&) VTK_DELETE_FUNCTION;
+};
+vtkStandardNewMacro(vtkTestBaseObject);
+
+class vtkTestDerivedObject : public vtkTestBaseObject
+{
+public:
+  static vtkTestDerivedObject* New();
+  vtkTypeMacro(vtkTestDerivedObject, vtkTestBaseObject);
+
+  // Same name, different parameter than vtkTestBaseObject::SetValue().
+  void SetValue(const char* value) { this->Label = value; }
+  std::string Label;
+
+protected:
+  vtkTestDerivedObject() {}
+
+private:
+  vtkTestDerivedObject(const vtkTestDerivedObject&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkTestDerivedObject&) VTK_DELETE_FUNCTION;
+};
+vtkStandardNewMacro(vtkTestDerivedObject);
+
+// The command functions below are written like the generated wrappers.
+int vtkTestBaseObjectCommand(vtkClientServerInterpreter*, vtkObjectBase* ob, const char* method,
+  const vtkClientServerStream& msg, vtkClientServerStream& resultStream, void*)
+{
+  vtkTestBaseObject* op = vtkTestBaseObject::SafeDownCast(ob);
+  if (!op)
+  {
+    return 0;
+  }
+  if (!strcmp("SetValue", method) && msg.GetNumberOfArguments(0) == 3)
+  {
+    double temp0;
+    if (msg.GetArgument(0, 2, &temp0))
+    {
+      op->SetValue(temp0);
+      return 1;
+    }
+  }
+  if (!strcmp("GetValue", method) && msg.GetNumberOfArguments(0) == 2)
+  {
+    resultStream.Reset();
+    resultStream << vtkClientServerStream::Reply << op->GetValue() << vtkClientServerStream::End;
+    return 1;
+  }
+  resultStream.Reset();
+  resultStream << vtkClientServerStream::Error << "Method not found."
+               << vtkClientServerStream::End;
+  return 0;
+}
+
+int vtkTestDerivedObjectCommand(vtkClientServerInterpreter* arlu, vtkObjectBase* ob,
+  const char* method, const vtkClientServerStream& msg, vtkClientServerStream& resultStream, void*)
+{
+  vtkTestDerivedObject* op = vtkTestDerivedObject::SafeDownCast(ob);
+  if (!op)
+  {
+    return 0;
+  }
+
+  // Generated wrappers compare the method with all the methods of the class
+  // before looking in the superclass.
+  static std::vector<std::string> methods;
+  if (methods.empty())
+  {
+    for (int cc = 0; cc < 200; ++cc)
+    {
+      std::ostringstream name;
+      name << "SetProperty" << cc;
+      methods.push_back(name.str());
+    }
+  }
+  for (size_t cc = 0; cc < methods.size(); ++cc)
+  {
+    if (!strcmp(methods[cc].c_str(), method) && msg.GetNumberOfArguments(0) == 3)
+    {
+      return 1;
+    }
+  }
+  if (!strcmp("SetValue", method) && msg.GetNumberOfArguments(0) == 3)
+  {
+    const char* temp0;
+    if (msg.GetArgument(0, 2, &temp0))
+    {
+      op->SetValue(temp0);
+      return 1;
+    }
+  }
+
+  const char* commandName = "vtkTestBaseObject";
+  if (arlu->HasCommandFunction(commandName) &&
+    arlu->CallCommandFunction(commandName, op, method, msg, resultStream))
+  {
+    return 1;
+  }
+  return 0;
+}
+
+bool InvokeSetValue(vtkClientServerInterpreter* interp, vtkClientServerID id, int numberOfInvokes,
+  double& elapsed)
+{
+  vtkClientServerStream stream;
+  for (int cc = 0; cc < numberOfInvokes; ++cc)
+  {
+    stream << vtkClientServerStream::Invoke << id << "SetValue" << static_cast<double>(cc)
+           << vtkClientServerStream::End;
+  }
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  int status = interp->ProcessStream(stream);
+  timer->StopTimer();
+  elapsed = timer->GetElapsedTime();
+  return status != 0;
+}
+}
+
+int TestInterpreterMethodCache(int argc, char* argv[])
+{
+  int numberOfInvokes = 10000;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument("--invokes", argT::EQUAL_ARGUMENT, &numberOfInvokes,
+    "Number of invokes in the stream.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse())
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkClientServerInterpreter> interp;
+  interp->AddCommandFunction("vtkTestBaseObject", vtkTestBaseObjectCommand);
+  interp->AddCommandFunction("vtkTestDerivedObject", vtkTestDerivedObjectCommand);
+
+  vtkNew<vtkTestDerivedObject> object;
+  vtkClientServerID id = interp->GetNextAvailableId();
+  interp->NewInstance(object.GetPointer(), id);
+
+  double uncached = 0.0;
+  double cached = 0.0;
+  interp->UseMethodCacheOff();
+  if (!InvokeSetValue(interp.GetPointer(), id, numberOfInvokes, uncached) ||
+    object->GetValue() != numberOfInvokes - 1)
+  {
+    cerr << "Uncached invokes failed." << endl;
+    return EXIT_FAILURE;
+  }
+  interp->UseMethodCacheOn();
+  object->SetValue(0.0);
+  if (!InvokeSetValue(interp.GetPointer(), id, numberOfInvokes, cached) ||
+    object->GetValue() != numberOfInvokes - 1)
+  {
+    cerr << "Cached invokes failed." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Arguments of other types must still reach the right command function.
+  vtkClientServerStream stream;
+  stream << vtkClientServerStream::Invoke << id << "SetValue"
+         << "label" << vtkClientServerStream::End;
+  stream << vtkClientServerStream::Invoke << id << "GetValue" << vtkClientServerStream::End;
+  double value = 0.0;
+  if (!interp->ProcessStream(stream) || object->Label != "label" ||
+    !interp->GetLastResult().GetArgument(0, 0, &value) || value != numberOfInvokes - 1)
+  {
+    cerr << "Invokes with other arguments failed." << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << numberOfInvokes << " invokes" << endl;
+  cout << "  without method cache: " << uncached << "s" << endl;
+  cout << "  with method cache:    " << cached << "s" << endl;
+  return EXIT_SUCCESS;
+}
@@ -14,6 +14,8 @@ vtk_module(vtkClientServer
     vtksys
   TEST_DEPENDS
     vtkCommonCore
+    vtkCommonSystem
+    vtksys
     vtkTestingCore
   EXCLUDE_FROM_WRAPPING
   TEST_LABELS
@@ -75,6 +75,53 @@ public:
   NewInstanceFunctionsType NewInstanceFunctions;
   ClassToFunctionMapType ClassToFunctionMap;
   IDToMessageMapType IDToMessageMap;
+
+  // Command function that handled a method, keyed by GetMethodKey().
+  typedef std::map<std::string, const CommandFunction*> MethodCacheType;
+  MethodCacheType MethodCache;
+
+  // The innermost command function that succeeded during the current
+  // ProcessCommandInvoke(), set by CallCommandFunction().
+  const CommandFunction* Handler;
+
+  vtkClientServerInterpreterInternals()
+    : Handler(NULL)
+  {
+  }
+
+  // The wrappers select the method to call from its name, the number of
+  // arguments and whether the arguments can be converted to the parameter
+  // types, hence the same command function handles the method as long as the
+  // arguments have the same types, array lengths and object classes.
+  static std::string GetMethodKey(
+    vtkObjectBase* obj, const char* method, const vtkClientServerStream& msg)
+  {
+    std::string key = obj->GetClassName();
+    key += '\0';
+    key += method;
+    int numberOfArguments = msg.GetNumberOfArguments(0);
+    for (int cc = 2; cc < numberOfArguments; ++cc)
+    {
+      vtkClientServerStream::Types type = msg.GetArgumentType(0, cc);
+      key += '\0';
+      key += static_cast<char>('A' + type);
+      if (type < vtkClientServerStream::bool_value && (type % 2) == 1)
+      {
+        vtkTypeUInt32 length = 0;
+        msg.GetArgumentLength(0, cc, &length);
+        std::ostringstream lengthStr;
+        lengthStr << length;
+        key += lengthStr.str();
+      }
+      else if (type == vtkClientServerStream::vtk_object_pointer)
+      {
+        vtkObjectBase* arg = NULL;
+        msg.GetArgument(0, cc, &arg);
+        key += arg ? arg->GetClassName() : "NULL";
+      }
+    }
+    return key;
+  }
 };
 
 //----------------------------------------------------------------------------
@@ -85,6 +132,7 @@ vtkClientServerInterpreter::vtkClientServerInterpreter()
   this->LastResultMessage = new vtkClientServerStream(this);
   this->LogStream = 0;
   this->LogFileStream = 0;
+  this->UseMethodCache = true;
 }
 
 //----------------------------------------------------------------------------
@@ -420,8 +468,43 @@ int vtkClientServerInterpreter::ProcessCommandInvoke(const vtkClientServerStream
     // Find the command function for this object's type.
     if (obj && this->HasCommandFunction(obj->GetClassName()))
     {
-      if (this->CallCommandFunction(
-            obj->GetClassName(), obj, method, msg, *this->LastResultMessage))
+      const vtkClientServerInterpreterInternals::CommandFunction* previousHandler =
+        this->Internal->Handler;
+      int success = 0;
+
+      // Directly call the command function that handled the method last
+      // time, if any. If it fails, look for the method as usual.
+      std::string key;
+      if (this->UseMethodCache)
+      {
+        key = vtkClientServerInterpreterInternals::GetMethodKey(obj, method, msg);
+        vtkClientServerInterpreterInternals::MethodCacheType::iterator iter =
+          this->Internal->MethodCache.find(key);
+        if (iter != this->Internal->MethodCache.end())
+        {
+          const vtkClientServerInterpreterInternals::CommandFunction* n = iter->second;
+          void* ctx = n->Context ? n->Context->Context : 0;
+          success = n->Function(this, obj, method, msg, *this->LastResultMessage, ctx);
+          if (!success)
+          {
+            this->Internal->MethodCache.erase(iter);
+            this->LastResultMessage->Reset();
+          }
+        }
+      }
+
+      if (!success)
+      {
+        this->Internal->Handler = NULL;
+        success = this->CallCommandFunction(
+          obj->GetClassName(), obj, method, msg, *this->LastResultMessage);
+        if (success && this->UseMethodCache && this->Internal->Handler)
+        {
+          this->Internal->MethodCache[key] = this->Internal->Handler;
+        }
+      }
+      this->Internal->Handler = previousHandler;
+      if (success)
       {
         return 1;
       }
@@ -770,6 +853,9 @@ void vtkClientServerInterpreter::AddCommandFunction(const char* cname,
 
   this->Internal->ClassToFunctionMap[cname] =
     new vtkClientServerInterpreterInternals::CommandFunction(func, context);
+
+  // The new command function may handle methods of subclasses.
+  this->Internal->MethodCache.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -799,7 +885,12 @@ int vtkClientServerInterpreter::CallCommandFunction(const char* cname, vtkObject
 
   vtkClientServerCommandFunction function = n->Function;
   void* ctx = n->Context ? n->Context->Context : 0;
-  return function(this, ptr, method, msg, result, ctx);
+  int success = function(this, ptr, method, msg, result, ctx);
+  if (success && !this->Internal->Handler)
+  {
+    this->Internal->Handler = n;
+  }
+  return success;
 }
 
 void vtkClientServerInterpreter::AddNewInstanceFunction(const char* name,
@@ -1018,4 +1109,5 @@ vtkObjectBase* vtkClientServerInterpreter::NewInstance(const char* classname)
 void vtkClientServerInterpreter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseMethodCache: " << this->UseMethodCache << endl;
 }
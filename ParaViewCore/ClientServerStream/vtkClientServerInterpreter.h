@@ -19,6 +19,12 @@
  * vtkClientServerInterpreter will process messages stored in a
  * vtkClientServerStream.  This allows run-time creation and execution
  * of VTK programs.
+ *
+ * The wrapper of a class looks for the invoked method by name in the class
+ * and then in its superclasses, through the interpreter. To avoid walking the
+ * class hierarchy for every Invoke, the interpreter remembers which command
+ * function handled a method for a given class and argument types, and
+ * directly calls it the next time (see UseMethodCache).
 */
 
 #ifndef vtkClientServerInterpreter_h
@@ -190,6 +196,16 @@ public:
    */
   vtkClientServerID GetNextAvailableId();
 
+  //@{
+  /**
+   * Enable/Disable the cache of the command functions handling the invoked
+   * methods. Default is on.
+   */
+  vtkSetMacro(UseMethodCache, bool);
+  vtkGetMacro(UseMethodCache, bool);
+  vtkBooleanMacro(UseMethodCache, bool);
+  //@}
+
 protected:
   // constructor and destructor
   vtkClientServerInterpreter();
@@ -199,6 +215,8 @@ protected:
   ostream* LogStream;
   ofstream* LogFileStream;
 
+  bool UseMethodCache;
+
   // Internal message processing functions.
   int ProcessCommandNew(const vtkClientServerStream& css, int midx);
   int ProcessCommandInvoke(const vtkClientServerStream& css, int midx);
@@ -4,6 +4,7 @@
 #include "vtkCommandOptions.h"
 #include "vtkCommandOptionsXMLParser.h"
 #include "vtkPVTestUtilities.h"
+#include "vtkPVXMLBinarySerializer.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
 #include "vtkStringList.h"
@@ -19,6 +20,7 @@ int ParaViewCoreCommonPrintSelf(int, char* [])
   PRINT_SELF(vtkCommandOptions);
   PRINT_SELF(vtkCommandOptionsXMLParser);
   PRINT_SELF(vtkPVTestUtilities);
+  PRINT_SELF(vtkPVXMLBinarySerializer);
   PRINT_SELF(vtkPVXMLElement);
   PRINT_SELF(vtkPVXMLParser);
   PRINT_SELF(vtkStringList);
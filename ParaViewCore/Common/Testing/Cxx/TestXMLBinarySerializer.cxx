@@ -0,0 +1,119 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestXMLBinarySerializer.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkPVXMLBinarySerializer.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+int TestXMLBinarySerializer(int, char* [])
+{
+  std::ostringstream xml;
+  xml << "<ServerManagerState version=\"5.4.0\">\n"
+      << "  <Proxy group=\"lookup_tables\" type=\"PVLookupTable\" id=\"1234\" servers=\"21\">\n"
+      << "    <Property name=\"RGBPoints\" id=\"1234.RGBPoints\" number_of_elements=\"2048\">\n";
+  for (int cc = 0; cc < 2048; ++cc)
+  {
+    xml << "      <Element index=\"" << cc << "\" value=\"" << (cc * 0.125) << "\"/>\n";
+  }
+  xml << "    </Property>\n"
+      << "    <Property name=\"Name\" id=\"1234.Name\">\n"
+      << "      <Element index=\"0\" value=\"quotes &quot;&amp; &lt;brackets&gt;\"/>\n"
+      << "    </Property>\n"
+      << "  </Proxy>\n"
+      << "  <Annotation>character data</Annotation>\n"
+      << "</ServerManagerState>\n";
+
+  vtkSmartPointer<vtkPVXMLElement> root = vtkPVXMLParser::ParseXML(xml.str().c_str());
+  if (!root)
+  {
+    cerr << "Failed to parse the XML." << endl;
+    return EXIT_FAILURE;
+  }
+
+  std::stringstream binary;
+  if (!vtkPVXMLBinarySerializer::Write(root, binary))
+  {
+    cerr << "Failed to write binary state." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!vtkPVXMLBinarySerializer::IsBinary(binary))
+  {
+    cerr << "Binary state was not recognized." << endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string data = binary.str();
+  cout << "XML: " << xml.str().size() << " bytes, binary: " << data.size() << " bytes" << endl;
+  if (data.size() >= xml.str().size())
+  {
+    cerr << "Binary state is not smaller than the XML." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkPVXMLElement> copy = vtkPVXMLBinarySerializer::Read(binary);
+  if (!copy || !copy->Equals(root))
+  {
+    cerr << "Binary state does not match the XML." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkPVXMLElement* proxy = copy->FindNestedElementByName("Proxy");
+  if (!proxy || strcmp(proxy->GetId(), "1234") != 0 || copy->LookupElement("1234") != proxy)
+  {
+    cerr << "Element ids do not match." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Truncated and non-binary streams must be rejected.
+  std::istringstream truncated(data.substr(0, data.size() / 2));
+  std::istringstream text(xml.str());
+  if (vtkPVXMLBinarySerializer::IsBinary(text) || vtkPVXMLBinarySerializer::Read(truncated) ||
+    vtkPVXMLBinarySerializer::Read(text))
+  {
+    cerr << "Invalid binary state was accepted." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The signature and version, followed by a string claiming to be 2^40
+  // bytes long, must be rejected without allocating the string.
+  std::string header = data.substr(0, 9);
+  std::string huge = header + std::string("\x00\x80\x80\x80\x80\x80\x20", 7);
+  std::istringstream hugeStream(huge);
+  if (vtkPVXMLBinarySerializer::Read(hugeStream))
+  {
+    cerr << "String longer than the stream was accepted." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Elements nested deeper than the maximum depth must be rejected. Each
+  // element is named "a" and has no attributes, no character data and one
+  // nested element.
+  std::string deep = header + std::string("\x01\x01" "a" "\x00\x00\x00\x01", 7);
+  for (int cc = 0; cc < vtkPVXMLBinarySerializer::GetMaximumDepth() + 10; ++cc)
+  {
+    deep += std::string("\x02\x00\x00\x00\x01", 5);
+  }
+  std::istringstream deepStream(deep);
+  if (vtkPVXMLBinarySerializer::Read(deepStream))
+  {
+    cerr << "Too deeply nested state was accepted." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,447 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVXMLBinarySerializer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVXMLBinarySerializer.h"
+
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// The format is:
+//   signature    8 bytes, see Signature below.
+//   version      varint
+//   root element
+// where each element is:
+//   name               string reference
+//   attribute count    varint
+//   attributes         (name, value) string references
+//   character data     string reference
+//   nested count       varint
+//   nested elements
+// A string reference is a varint `ref` followed, for ref < 2, by the string
+// length (varint) and characters. ref == 1 additionally appends the string
+// to the string table and ref >= 2 refers to the string (ref - 2) of the
+// table. Varints are unsigned LEB128, hence independent of the byte order.
+namespace
+{
+const char Signature[8] = { '\x89', 'P', 'V', 'X', 'B', '\r', '\n', '\x1a' };
+const int FormatVersion = 1;
+
+// Only short strings are added to the string table: names and small values
+// such as indices or enumerations repeat a lot, while large values (e.g.
+// serialized arrays) rarely do.
+const size_t MaximumTableStringLength = 64;
+const size_t MaximumTableSize = 1 << 20;
+
+// Limits for corrupted or malicious streams: the depth of the element tree,
+// and the size of the blocks strings are read by when the remaining size of
+// the stream is unknown.
+const int MaximumDepth = 1024;
+const size_t ReadBlockSize = 1 << 16;
+
+// Function to check if a string is full of whitespace characters.
+bool IsSpace(const char* str)
+{
+  for (; *str; ++str)
+  {
+    if (!isspace(static_cast<unsigned char>(*str)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+class vtkBinaryWriter
+{
+public:
+  vtkBinaryWriter(ostream& os)
+    : Stream(os)
+  {
+  }
+
+  void WriteVarint(vtkTypeUInt64 value)
+  {
+    char buffer[10];
+    int length = 0;
+    do
+    {
+      unsigned char byte = static_cast<unsigned char>(value & 0x7f);
+      value >>= 7;
+      buffer[length++] = static_cast<char>(value ? (byte | 0x80) : byte);
+    } while (value);
+    this->Stream.write(buffer, length);
+  }
+
+  void WriteString(const char* str)
+  {
+    size_t length = strlen(str);
+    if (length <= MaximumTableStringLength)
+    {
+      std::string key(str, length);
+      std::map<std::string, vtkTypeUInt64>::iterator iter = this->Table.find(key);
+      if (iter != this->Table.end())
+      {
+        this->WriteVarint(iter->second + 2);
+        return;
+      }
+      if (this->Table.size() < MaximumTableSize)
+      {
+        vtkTypeUInt64 index = static_cast<vtkTypeUInt64>(this->Table.size());
+        this->Table.insert(std::make_pair(key, index));
+        this->WriteVarint(1);
+        this->WriteVarint(length);
+        this->Stream.write(str, length);
+        return;
+      }
+    }
+    this->WriteVarint(0);
+    this->WriteVarint(length);
+    this->Stream.write(str, length);
+  }
+
+  void WriteElement(vtkPVXMLElement* element)
+  {
+    this->WriteString(element->GetName() ? element->GetName() : "NoName");
+    unsigned int numAttributes = element->GetNumberOfAttributes();
+    this->WriteVarint(numAttributes);
+    for (unsigned int cc = 0; cc < numAttributes; ++cc)
+    {
+      this->WriteString(element->GetAttributeName(cc));
+      this->WriteString(element->GetAttributeValue(cc));
+    }
+    // Like PrintXML(), whitespace-only character data is dropped.
+    const char* cdata = element->GetCharacterData();
+    this->WriteString(IsSpace(cdata) ? "" : cdata);
+    unsigned int numNested = element->GetNumberOfNestedElements();
+    this->WriteVarint(numNested);
+    for (unsigned int cc = 0; cc < numNested; ++cc)
+    {
+      this->WriteElement(element->GetNestedElement(cc));
+    }
+  }
+
+private:
+  ostream& Stream;
+  std::map<std::string, vtkTypeUInt64> Table;
+};
+}
+
+//----------------------------------------------------------------------------
+class vtkPVXMLBinarySerializer::vtkBinaryReader
+{
+public:
+  vtkBinaryReader(istream& is)
+    : Stream(is)
+    , ElementIdIndex(0)
+    , Depth(0)
+    , End(-1)
+  {
+    // Find the end of the stream, if it can be seeked, to reject lengths
+    // larger than the rest of the stream before allocating anything.
+    std::streampos pos = is.tellg();
+    if (pos != std::streampos(-1))
+    {
+      if (is.seekg(0, ios::end))
+      {
+        this->End = is.tellg();
+      }
+      is.clear();
+      is.seekg(pos);
+    }
+  }
+
+  bool ReadVarint(vtkTypeUInt64& value)
+  {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+      int byte = this->Stream.get();
+      if (byte == EOF)
+      {
+        return false;
+      }
+      value |= static_cast<vtkTypeUInt64>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadString(std::string& str)
+  {
+    vtkTypeUInt64 ref;
+    if (!this->ReadVarint(ref))
+    {
+      return false;
+    }
+    if (ref >= 2)
+    {
+      if (ref - 2 >= this->Table.size())
+      {
+        return false;
+      }
+      str = this->Table[static_cast<size_t>(ref - 2)];
+      return true;
+    }
+    vtkTypeUInt64 length;
+    if (!this->ReadVarint(length))
+    {
+      return false;
+    }
+    std::streampos pos = this->Stream.tellg();
+    if (this->End != std::streampos(-1) && pos != std::streampos(-1) &&
+      length > static_cast<vtkTypeUInt64>(this->End - pos))
+    {
+      return false;
+    }
+    // Otherwise the string grows as blocks are read, so that a corrupted
+    // length cannot allocate more than what the stream provides.
+    str.clear();
+    while (length > 0)
+    {
+      size_t size = str.size();
+      size_t block = static_cast<size_t>(std::min<vtkTypeUInt64>(length, ReadBlockSize));
+      str.resize(size + block);
+      if (!this->Stream.read(&str[size], static_cast<std::streamsize>(block)))
+      {
+        return false;
+      }
+      length -= block;
+    }
+    if (ref == 1)
+    {
+      this->Table.push_back(str);
+    }
+    return true;
+  }
+
+  istream& Stream;
+  std::vector<std::string> Table;
+  int ElementIdIndex;
+  int Depth;
+  std::streampos End;
+};
+
+vtkStandardNewMacro(vtkPVXMLBinarySerializer);
+//----------------------------------------------------------------------------
+vtkPVXMLBinarySerializer::vtkPVXMLBinarySerializer()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLBinarySerializer::~vtkPVXMLBinarySerializer()
+{
+}
+
+//----------------------------------------------------------------------------
+int vtkPVXMLBinarySerializer::GetFormatVersion()
+{
+  return FormatVersion;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVXMLBinarySerializer::GetMaximumDepth()
+{
+  return MaximumDepth;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLBinarySerializer::IsBinary(istream& is)
+{
+  char buffer[sizeof(Signature)];
+  std::streampos pos = is.tellg();
+  bool match = is.read(buffer, sizeof(Signature)) &&
+    memcmp(buffer, Signature, sizeof(Signature)) == 0;
+  is.clear();
+  is.seekg(pos);
+  return match;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLBinarySerializer::IsBinary(const char* filename)
+{
+  ifstream is(filename, ios::in | ios::binary);
+  return is && vtkPVXMLBinarySerializer::IsBinary(is);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLBinarySerializer::Write(vtkPVXMLElement* root, ostream& os)
+{
+  if (!root)
+  {
+    return false;
+  }
+  os.write(Signature, sizeof(Signature));
+  vtkBinaryWriter writer(os);
+  writer.WriteVarint(FormatVersion);
+  writer.WriteElement(root);
+  return !os.fail();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLBinarySerializer::Write(vtkPVXMLElement* root, const char* filename)
+{
+  ofstream os(filename, ios::out | ios::binary);
+  if (!os)
+  {
+    vtkGenericWarningMacro("Failed to open file for writing: " << filename);
+    return false;
+  }
+  return vtkPVXMLBinarySerializer::Write(root, os);
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPVXMLElement> vtkPVXMLBinarySerializer::ReadElement(vtkBinaryReader& reader)
+{
+  std::string name, value;
+  vtkTypeUInt64 count;
+  if (!reader.ReadString(name) || !reader.ReadVarint(count))
+  {
+    return NULL;
+  }
+
+  vtkSmartPointer<vtkPVXMLElement> element = vtkSmartPointer<vtkPVXMLElement>::New();
+  element->SetName(name.c_str());
+  for (vtkTypeUInt64 cc = 0; cc < count; ++cc)
+  {
+    if (!reader.ReadString(name) || !reader.ReadString(value))
+    {
+      return NULL;
+    }
+    element->AddAttribute(name.c_str(), value.c_str());
+  }
+
+  // Assign ids the same way vtkPVXMLParser does.
+  if (const char* id = element->GetAttribute("id"))
+  {
+    element->SetId(id);
+  }
+  else
+  {
+    std::ostringstream idstr;
+    idstr << reader.ElementIdIndex++;
+    element->SetId(idstr.str().c_str());
+  }
+
+  if (!reader.ReadString(value) || !reader.ReadVarint(count))
+  {
+    return NULL;
+  }
+  element->AddCharacterData(value.c_str(), static_cast<int>(value.size()));
+  if (count > 0 && reader.Depth >= MaximumDepth)
+  {
+    return NULL;
+  }
+  ++reader.Depth;
+  for (vtkTypeUInt64 cc = 0; cc < count; ++cc)
+  {
+    vtkSmartPointer<vtkPVXMLElement> nested = vtkPVXMLBinarySerializer::ReadElement(reader);
+    if (!nested)
+    {
+      return NULL;
+    }
+    element->AddNestedElement(nested);
+  }
+  --reader.Depth;
+  return element;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPVXMLElement> vtkPVXMLBinarySerializer::Read(istream& is)
+{
+  char buffer[sizeof(Signature)];
+  if (!is.read(buffer, sizeof(Signature)) || memcmp(buffer, Signature, sizeof(Signature)) != 0)
+  {
+    vtkGenericWarningMacro("Not a binary state stream.");
+    return NULL;
+  }
+
+  vtkBinaryReader reader(is);
+  vtkTypeUInt64 version;
+  if (!reader.ReadVarint(version) || version > static_cast<vtkTypeUInt64>(FormatVersion))
+  {
+    vtkGenericWarningMacro("Unsupported binary state version.");
+    return NULL;
+  }
+
+  vtkSmartPointer<vtkPVXMLElement> root = vtkPVXMLBinarySerializer::ReadElement(reader);
+  if (!root)
+  {
+    vtkGenericWarningMacro("Failed to read binary state, the stream is truncated or corrupted.");
+  }
+  return root;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPVXMLElement> vtkPVXMLBinarySerializer::Read(const char* filename)
+{
+  ifstream is(filename, ios::in | ios::binary);
+  if (!is)
+  {
+    vtkGenericWarningMacro("Failed to open file for reading: " << filename);
+    return NULL;
+  }
+  return vtkPVXMLBinarySerializer::Read(is);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLBinarySerializer::ConvertXMLToBinary(
+  const char* xmlFilename, const char* binaryFilename)
+{
+  vtkNew<vtkPVXMLParser> parser;
+  parser->SetFileName(xmlFilename);
+  if (!parser->Parse())
+  {
+    return false;
+  }
+  return vtkPVXMLBinarySerializer::Write(parser->GetRootElement(), binaryFilename);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLBinarySerializer::ConvertBinaryToXML(
+  const char* binaryFilename, const char* xmlFilename)
+{
+  vtkSmartPointer<vtkPVXMLElement> root = vtkPVXMLBinarySerializer::Read(binaryFilename);
+  if (!root)
+  {
+    return false;
+  }
+  ofstream os(xmlFilename, ios::out);
+  if (!os)
+  {
+    vtkGenericWarningMacro("Failed to open file for writing: " << xmlFilename);
+    return false;
+  }
+  root->PrintXML(os, vtkIndent());
+  return !os.fail();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLBinarySerializer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
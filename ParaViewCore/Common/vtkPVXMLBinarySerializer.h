@@ -0,0 +1,108 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVXMLBinarySerializer.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVXMLBinarySerializer
+ * @brief   compact binary serialization of vtkPVXMLElement trees.
+ *
+ * vtkPVXMLBinarySerializer reads and writes vtkPVXMLElement trees, such as
+ * server manager state, in a compact, versioned binary format. Element and
+ * attribute names as well as short attribute values are written once and
+ * then referred to by index, and no text escaping or XML parsing is needed.
+ * This is not a streaming API: Write() serializes an existing element tree
+ * and Read() builds the complete element tree before returning it, as
+ * vtkPVXMLParser does.
+ *
+ * The elements read back are identical to those obtained by parsing the XML
+ * written by vtkPVXMLElement::PrintXML() hence the binary format can be used
+ * wherever XML state is, and converted to / from XML without any loss.
+ *
+ * @sa
+ * vtkPVXMLElement vtkPVXMLParser
+ */
+
+#ifndef vtkPVXMLBinarySerializer_h
+#define vtkPVXMLBinarySerializer_h
+
+#include "vtkObject.h"
+#include "vtkPVCommonModule.h" // needed for export macro
+#include "vtkSmartPointer.h"   // needed for vtkSmartPointer.
+
+class vtkPVXMLElement;
+
+class VTKPVCOMMON_EXPORT vtkPVXMLBinarySerializer : public vtkObject
+{
+public:
+  static vtkPVXMLBinarySerializer* New();
+  vtkTypeMacro(vtkPVXMLBinarySerializer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
+
+  /**
+   * Version of the format written by this class.
+   */
+  static int GetFormatVersion();
+
+  /**
+   * Maximum nesting depth of the elements accepted by Read().
+   */
+  static int GetMaximumDepth();
+
+  //@{
+  /**
+   * Returns true if the stream / file starts with the binary format
+   * signature. The stream position is left unchanged.
+   */
+  static bool IsBinary(istream& is);
+  static bool IsBinary(const char* filename);
+  //@}
+
+  //@{
+  /**
+   * Write the element and all its nested elements. Returns false on failure.
+   */
+  static bool Write(vtkPVXMLElement* root, ostream& os);
+  static bool Write(vtkPVXMLElement* root, const char* filename);
+  //@}
+
+  //@{
+  /**
+   * Read an element tree written by Write(). Returns NULL on failure, which
+   * includes truncated streams, strings longer than the rest of the stream
+   * and elements nested deeper than GetMaximumDepth().
+   */
+  static vtkSmartPointer<vtkPVXMLElement> Read(istream& is);
+  static vtkSmartPointer<vtkPVXMLElement> Read(const char* filename);
+  //@}
+
+  //@{
+  /**
+   * Converts between XML and binary files. Returns false on failure.
+   */
+  static bool ConvertXMLToBinary(const char* xmlFilename, const char* binaryFilename);
+  static bool ConvertBinaryToXML(const char* binaryFilename, const char* xmlFilename);
+  //@}
+
+protected:
+  vtkPVXMLBinarySerializer();
+  ~vtkPVXMLBinarySerializer();
+
+private:
+  vtkPVXMLBinarySerializer(const vtkPVXMLBinarySerializer&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkPVXMLBinarySerializer&) VTK_DELETE_FUNCTION;
+
+  class vtkBinaryReader;
+  static vtkSmartPointer<vtkPVXMLElement> ReadElement(vtkBinaryReader& reader);
+};
+
+#endif
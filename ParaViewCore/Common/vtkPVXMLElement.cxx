@@ -148,6 +148,28 @@ void vtkPVXMLElement::AddAttribute(const char* attrName, const char* attrValue)
   this->Internal->AttributeValues.push_back(attrValue);
 }
 
+//----------------------------------------------------------------------------
+unsigned int vtkPVXMLElement::GetNumberOfAttributes()
+{
+  return static_cast<unsigned int>(this->Internal->AttributeNames.size());
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVXMLElement::GetAttributeName(unsigned int index)
+{
+  return index < this->Internal->AttributeNames.size()
+    ? this->Internal->AttributeNames[index].c_str()
+    : NULL;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVXMLElement::GetAttributeValue(unsigned int index)
+{
+  return index < this->Internal->AttributeValues.size()
+    ? this->Internal->AttributeValues[index].c_str()
+    : NULL;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVXMLElement::SetAttribute(const char* attrName, const char* attrValue)
 {
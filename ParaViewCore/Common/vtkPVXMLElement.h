@@ -181,6 +181,15 @@ public:
 #endif
   //@}
 
+  //@{
+  /**
+   * Access the attributes by index, in the order they were added.
+   */
+  unsigned int GetNumberOfAttributes();
+  const char* GetAttributeName(unsigned int index);
+  const char* GetAttributeValue(unsigned int index);
+  //@}
+
   /**
    * Remove the attribute from the current element
    */
@@ -280,6 +289,7 @@ protected:
   void SetParent(vtkPVXMLElement* parent);
 
   friend class vtkPVXMLParser;
+  friend class vtkPVXMLBinarySerializer;
 
 private:
   vtkPVXMLElement(const vtkPVXMLElement&) VTK_DELETE_FUNCTION;
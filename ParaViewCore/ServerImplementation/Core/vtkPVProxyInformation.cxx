@@ -0,0 +1,427 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVProxyInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVProxyInformation.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkClientServerStream.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVSessionBase.h"
+#include "vtkProcessModule.h"
+#include "vtkSIProxy.h"
+#include "vtkSMMessage.h"
+#include "vtkSmartPointer.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+class vtkPVProxyInformation::vtkInternals
+{
+public:
+  struct Request
+  {
+    vtkTypeUInt32 GlobalId;
+    vtkTypeUInt64 MTime;
+    bool UpdatePipeline;
+    std::vector<std::string> PropertyNames;
+  };
+  std::vector<Request> Requests;
+
+  struct Result
+  {
+    vtkTypeUInt64 MTime;
+    bool Modified;
+    vtkSMMessage State;
+  };
+  std::map<vtkTypeUInt32, Result> Results;
+
+  typedef std::pair<vtkTypeUInt32, int> PortType;
+  std::vector<PortType> DataRequests;
+  std::map<PortType, vtkSmartPointer<vtkPVDataInformation> > DataResults;
+
+  // Returns the time the information properties of the proxy may have last
+  // changed: they are read from the VTK object, and for algorithms, are
+  // typically updated in RequestInformation() which also modifies the
+  // output information.
+  static vtkTypeUInt64 GetInformationMTime(vtkSIProxy* siProxy)
+  {
+    vtkObject* object = vtkObject::SafeDownCast(siProxy->GetVTKObject());
+    if (!object)
+    {
+      return 0;
+    }
+    vtkTypeUInt64 mtime = object->GetMTime();
+    vtkAlgorithm* algorithm = vtkAlgorithm::SafeDownCast(object);
+    vtkExecutive* executive = algorithm ? algorithm->GetExecutive() : NULL;
+    for (int port = 0; executive && port < algorithm->GetNumberOfOutputPorts(); ++port)
+    {
+      vtkInformation* outInfo = executive->GetOutputInformation(port);
+      if (outInfo && outInfo->GetMTime() > mtime)
+      {
+        mtime = outInfo->GetMTime();
+      }
+    }
+    return mtime;
+  }
+};
+
+vtkStandardNewMacro(vtkPVProxyInformation);
+//----------------------------------------------------------------------------
+vtkPVProxyInformation::vtkPVProxyInformation()
+{
+  this->Internals = new vtkInternals();
+  this->RootOnly = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkPVProxyInformation::~vtkPVProxyInformation()
+{
+  delete this->Internals;
+  this->Internals = NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyInformation::AddProxy(
+  vtkTypeUInt32 globalId, vtkTypeUInt64 mtime, bool updatePipeline)
+{
+  vtkInternals::Request request;
+  request.GlobalId = globalId;
+  request.MTime = mtime;
+  request.UpdatePipeline = updatePipeline;
+  this->Internals->Requests.push_back(request);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyInformation::AddPropertyName(const char* name)
+{
+  if (this->Internals->Requests.empty() || !name)
+  {
+    vtkErrorMacro("AddProxy() must be called before AddPropertyName().");
+    return;
+  }
+  this->Internals->Requests.back().PropertyNames.push_back(name);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyInformation::AddDataInformation(vtkTypeUInt32 globalId, int port)
+{
+  this->Internals->DataRequests.push_back(vtkInternals::PortType(globalId, port));
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyInformation::Initialize()
+{
+  this->Internals->Requests.clear();
+  this->Internals->Results.clear();
+  this->Internals->DataRequests.clear();
+  this->Internals->DataResults.clear();
+}
+
+//----------------------------------------------------------------------------
+const vtkSMMessage* vtkPVProxyInformation::GetState(vtkTypeUInt32 globalId)
+{
+  std::map<vtkTypeUInt32, vtkInternals::Result>::const_iterator iter =
+    this->Internals->Results.find(globalId);
+  return (iter != this->Internals->Results.end() && iter->second.Modified) ? &iter->second.State
+                                                                           : NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVProxyInformation::GetMTime(vtkTypeUInt32 globalId)
+{
+  std::map<vtkTypeUInt32, vtkInternals::Result>::const_iterator iter =
+    this->Internals->Results.find(globalId);
+  return iter != this->Internals->Results.end() ? iter->second.MTime : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkPVDataInformation* vtkPVProxyInformation::GetDataInformation(vtkTypeUInt32 globalId, int port)
+{
+  std::map<vtkInternals::PortType, vtkSmartPointer<vtkPVDataInformation> >::const_iterator iter =
+    this->Internals->DataResults.find(vtkInternals::PortType(globalId, port));
+  return iter != this->Internals->DataResults.end() ? iter->second.GetPointer() : NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyInformation::CopyFromObject(vtkObject*)
+{
+  this->Internals->Results.clear();
+  this->Internals->DataResults.clear();
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  // Satellites process the request without activating their session.
+  vtkPVSessionBase* session = vtkPVSessionBase::SafeDownCast(pm->GetSession());
+  if (!session)
+  {
+    return;
+  }
+
+  // Pipeline information must be updated on all processes, in order, since
+  // it may involve collective operations.
+  bool root = pm->GetPartitionId() == 0;
+  std::vector<vtkInternals::Request>::const_iterator iter;
+  for (iter = this->Internals->Requests.begin(); iter != this->Internals->Requests.end(); ++iter)
+  {
+    vtkSIProxy* siProxy = vtkSIProxy::SafeDownCast(session->GetSIObject(iter->GlobalId));
+    if (!siProxy)
+    {
+      continue;
+    }
+    if (iter->UpdatePipeline)
+    {
+      siProxy->UpdatePipelineInformation();
+    }
+    if (!root)
+    {
+      continue;
+    }
+
+    vtkInternals::Result& result = this->Internals->Results[iter->GlobalId];
+    result.MTime = vtkInternals::GetInformationMTime(siProxy);
+    result.Modified = (result.MTime == 0 || result.MTime != iter->MTime);
+    if (result.Modified && !iter->PropertyNames.empty())
+    {
+      result.State.set_global_id(iter->GlobalId);
+      Variant* var = result.State.AddExtension(PullRequest::arguments);
+      var->set_type(Variant::STRING);
+      for (size_t cc = 0; cc < iter->PropertyNames.size(); ++cc)
+      {
+        var->add_txt(iter->PropertyNames[cc]);
+      }
+      siProxy->Pull(&result.State);
+    }
+  }
+
+  // The data information is gathered on all processes, as done by
+  // vtkPVSessionCore::GatherInformation() for a vtkPVDataInformation.
+  std::vector<vtkInternals::PortType>::const_iterator port;
+  for (port = this->Internals->DataRequests.begin(); port != this->Internals->DataRequests.end();
+       ++port)
+  {
+    vtkSIProxy* siProxy = vtkSIProxy::SafeDownCast(session->GetSIObject(port->first));
+    if (!siProxy)
+    {
+      continue;
+    }
+    vtkSmartPointer<vtkPVDataInformation> dataInfo = vtkSmartPointer<vtkPVDataInformation>::New();
+    dataInfo->SetPortNumber(port->second);
+    dataInfo->CopyFromObject(vtkObject::SafeDownCast(siProxy->GetVTKObject()));
+    this->Internals->DataResults[*port] = dataInfo;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyInformation::AddInformation(vtkPVInformation* pvi)
+{
+  // The properties are only pulled on the root node, only the data
+  // information is merged.
+  vtkPVProxyInformation* other = vtkPVProxyInformation::SafeDownCast(pvi);
+  if (!other)
+  {
+    return;
+  }
+  std::map<vtkInternals::PortType, vtkSmartPointer<vtkPVDataInformation> >::const_iterator iter;
+  for (iter = other->Internals->DataResults.begin(); iter != other->Internals->DataResults.end();
+       ++iter)
+  {
+    vtkSmartPointer<vtkPVDataInformation>& dataInfo = this->Internals->DataResults[iter->first];
+    if (dataInfo)
+    {
+      dataInfo->AddInformation(iter->second);
+    }
+    else
+    {
+      dataInfo = iter->second;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply
+       << static_cast<vtkTypeUInt32>(this->Internals->Results.size());
+  std::map<vtkTypeUInt32, vtkInternals::Result>::const_iterator iter;
+  for (iter = this->Internals->Results.begin(); iter != this->Internals->Results.end(); ++iter)
+  {
+    std::string state;
+    if (iter->second.Modified)
+    {
+      state = iter->second.State.SerializeAsString();
+    }
+    *css << iter->first << iter->second.MTime << iter->second.Modified
+         << vtkClientServerStream::InsertArray(
+              reinterpret_cast<const unsigned char*>(state.data()), static_cast<int>(state.size()));
+  }
+
+  *css << static_cast<vtkTypeUInt32>(this->Internals->DataResults.size());
+  std::map<vtkInternals::PortType, vtkSmartPointer<vtkPVDataInformation> >::const_iterator port;
+  for (port = this->Internals->DataResults.begin(); port != this->Internals->DataResults.end();
+       ++port)
+  {
+    vtkClientServerStream dcss;
+    port->second->CopyToStream(&dcss);
+    const unsigned char* data;
+    size_t length;
+    dcss.GetData(&data, &length);
+    *css << port->first.first << port->first.second
+         << vtkClientServerStream::InsertArray(data, static_cast<int>(length));
+  }
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  this->Internals->Results.clear();
+  this->Internals->DataResults.clear();
+
+  vtkTypeUInt32 count = 0;
+  if (!css->GetArgument(0, 0, &count))
+  {
+    vtkErrorMacro("Error parsing number of proxies from message.");
+    return;
+  }
+  int arg = 1;
+  for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+  {
+    vtkTypeUInt32 globalId;
+    vtkInternals::Result result;
+    vtkTypeUInt32 length = 0;
+    if (!css->GetArgument(0, arg++, &globalId) || !css->GetArgument(0, arg++, &result.MTime) ||
+      !css->GetArgument(0, arg++, &result.Modified) || !css->GetArgumentLength(0, arg, &length))
+    {
+      vtkErrorMacro("Error parsing proxy information from message.");
+      return;
+    }
+    std::string state(length, '\0');
+    if (length > 0 &&
+      !css->GetArgument(0, arg, reinterpret_cast<unsigned char*>(&state[0]), length))
+    {
+      vtkErrorMacro("Error parsing proxy state from message.");
+      return;
+    }
+    ++arg;
+    if (result.Modified && length > 0 && !result.State.ParseFromString(state))
+    {
+      vtkErrorMacro("Error parsing proxy state from message.");
+      return;
+    }
+    this->Internals->Results[globalId] = result;
+  }
+
+  if (!css->GetArgument(0, arg++, &count))
+  {
+    vtkErrorMacro("Error parsing number of output ports from message.");
+    return;
+  }
+  for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+  {
+    vtkInternals::PortType port;
+    vtkTypeUInt32 length = 0;
+    if (!css->GetArgument(0, arg++, &port.first) || !css->GetArgument(0, arg++, &port.second) ||
+      !css->GetArgumentLength(0, arg, &length))
+    {
+      vtkErrorMacro("Error parsing data information from message.");
+      return;
+    }
+    std::vector<unsigned char> data(length);
+    if (length == 0 || !css->GetArgument(0, arg++, &data[0], length))
+    {
+      vtkErrorMacro("Error parsing data information from message.");
+      return;
+    }
+    vtkClientServerStream dcss;
+    dcss.SetData(&data[0], length);
+    vtkSmartPointer<vtkPVDataInformation> dataInfo = vtkSmartPointer<vtkPVDataInformation>::New();
+    dataInfo->SetPortNumber(port.second);
+    dataInfo->CopyFromStream(&dcss);
+    this->Internals->DataResults[port] = dataInfo;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyInformation::CopyParametersToStream(vtkMultiProcessStream& str)
+{
+  str << 829994 << static_cast<unsigned int>(this->Internals->Requests.size());
+  std::vector<vtkInternals::Request>::const_iterator iter;
+  for (iter = this->Internals->Requests.begin(); iter != this->Internals->Requests.end(); ++iter)
+  {
+    str << static_cast<unsigned int>(iter->GlobalId) << iter->MTime
+        << static_cast<int>(iter->UpdatePipeline)
+        << static_cast<unsigned int>(iter->PropertyNames.size());
+    for (size_t cc = 0; cc < iter->PropertyNames.size(); ++cc)
+    {
+      str << iter->PropertyNames[cc];
+    }
+  }
+  str << static_cast<unsigned int>(this->Internals->DataRequests.size());
+  std::vector<vtkInternals::PortType>::const_iterator port;
+  for (port = this->Internals->DataRequests.begin(); port != this->Internals->DataRequests.end();
+       ++port)
+  {
+    str << static_cast<unsigned int>(port->first) << port->second;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
+{
+  int magic_number;
+  unsigned int count;
+  str >> magic_number >> count;
+  if (magic_number != 829994)
+  {
+    vtkErrorMacro("Magic number mismatch.");
+    return;
+  }
+  this->Internals->Requests.resize(count);
+  for (unsigned int cc = 0; cc < count; ++cc)
+  {
+    vtkInternals::Request& request = this->Internals->Requests[cc];
+    unsigned int globalId, numberOfNames;
+    int updatePipeline;
+    str >> globalId >> request.MTime >> updatePipeline >> numberOfNames;
+    request.GlobalId = globalId;
+    request.UpdatePipeline = updatePipeline != 0;
+    request.PropertyNames.resize(numberOfNames);
+    for (unsigned int i = 0; i < numberOfNames; ++i)
+    {
+      str >> request.PropertyNames[i];
+    }
+  }
+  str >> count;
+  this->Internals->DataRequests.resize(count);
+  for (unsigned int cc = 0; cc < count; ++cc)
+  {
+    unsigned int globalId;
+    str >> globalId >> this->Internals->DataRequests[cc].second;
+    this->Internals->DataRequests[cc].first = globalId;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Number of proxies: " << this->Internals->Requests.size() << endl;
+  os << indent << "Number of output ports: " << this->Internals->DataRequests.size() << endl;
+}
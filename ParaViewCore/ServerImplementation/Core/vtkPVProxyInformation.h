@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVProxyInformation.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVProxyInformation
+ * @brief   information properties of a set of proxies.
+ *
+ * vtkPVProxyInformation gathers the values of the information properties of
+ * several proxies at once, optionally after updating their pipeline
+ * information, so that a whole pipeline can be refreshed with a single
+ * request to the server. It must be gathered with a global id of 0.
+ *
+ * The pipeline information is updated on all processes while the properties
+ * are only pulled on the root node. For each proxy, the client can provide
+ * the modification time returned by a previous gather: the state of the
+ * proxy is then only returned if the VTK object or its output information
+ * were modified since.
+ *
+ * The data information of output ports can be gathered in the same request,
+ * after the pipeline information was updated. Like vtkPVDataInformation, it is
+ * gathered on all processes and merged on the root node.
+ *
+ * @sa
+ * vtkSMSourceProxy::UpdatePipelineInformation
+ */
+
+#ifndef vtkPVProxyInformation_h
+#define vtkPVProxyInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkPVServerImplementationCoreModule.h" //needed for exports
+#include "vtkSMMessageMinimal.h"                 // needed for vtkSMMessage
+
+class vtkPVDataInformation;
+
+class VTKPVSERVERIMPLEMENTATIONCORE_EXPORT vtkPVProxyInformation : public vtkPVInformation
+{
+public:
+  static vtkPVProxyInformation* New();
+  vtkTypeMacro(vtkPVProxyInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
+
+  /**
+   * Add a proxy to gather the information properties of. `mtime` is the
+   * modification time returned for the proxy by a previous gather, 0 if
+   * none. If `updatePipeline` is true, UpdatePipelineInformation() is called
+   * on the vtkSIProxy first.
+   */
+  void AddProxy(vtkTypeUInt32 globalId, vtkTypeUInt64 mtime, bool updatePipeline);
+
+  /**
+   * Add an information property to pull for the last added proxy.
+   */
+  void AddPropertyName(const char* name);
+
+  /**
+   * Add an output port of a source proxy to gather the vtkPVDataInformation
+   * of.
+   */
+  void AddDataInformation(vtkTypeUInt32 globalId, int port);
+
+  /**
+   * Removes all proxies, output ports and gathered information.
+   */
+  void Initialize();
+
+  /**
+   * Returns the state of the information properties of the proxy, or NULL if
+   * it was not modified since the time given to AddProxy().
+   */
+  const vtkSMMessage* GetState(vtkTypeUInt32 globalId);
+
+  /**
+   * Returns the modification time of the proxy on the server, to be given to
+   * AddProxy() for the next gather.
+   */
+  vtkTypeUInt64 GetMTime(vtkTypeUInt32 globalId);
+
+  /**
+   * Returns the data information gathered for the output port, or NULL if it
+   * was not added with AddDataInformation().
+   */
+  vtkPVDataInformation* GetDataInformation(vtkTypeUInt32 globalId, int port);
+
+  /**
+   * Transfer information about a single object into this object.
+   */
+  void CopyFromObject(vtkObject*) VTK_OVERRIDE;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) VTK_OVERRIDE;
+
+  //@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) VTK_OVERRIDE;
+  void CopyFromStream(const vtkClientServerStream*) VTK_OVERRIDE;
+  //@}
+
+  //@{
+  /**
+   * Serialize/Deserialize the proxies and properties to gather.
+   */
+  void CopyParametersToStream(vtkMultiProcessStream&) VTK_OVERRIDE;
+  void CopyParametersFromStream(vtkMultiProcessStream&) VTK_OVERRIDE;
+  //@}
+
+protected:
+  vtkPVProxyInformation();
+  ~vtkPVProxyInformation();
+
+private:
+  vtkPVProxyInformation(const vtkPVProxyInformation&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkPVProxyInformation&) VTK_DELETE_FUNCTION;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -240,7 +240,14 @@ void vtkPVSessionBase::CleanupPendingProgressInternal()
 bool vtkPVSessionBase::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
-  return this->SessionCore->GatherInformation(location, information, globalid);
+  this->Activate();
+
+  // This class does not handle remote sessions, so all messages are directly
+  // processes locally.
+  bool ret = this->SessionCore->GatherInformation(location, information, globalid);
+
+  this->DeActivate();
+  return ret;
 }
 
 //----------------------------------------------------------------------------
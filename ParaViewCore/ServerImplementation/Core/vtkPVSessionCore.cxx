@@ -430,6 +430,15 @@ void vtkPVSessionCore::PushStateInternal(vtkSMMessage* message)
       return;
       // abort();
     }
+    // A proxy of a lazy-load plugin needs the plugin, which may also provide
+    // the SI class, so look up its definition first to load the plugin.
+    if (message->HasExtension(ProxyState::xml_group) && message->HasExtension(ProxyState::xml_name))
+    {
+      this->ProxyDefinitionManager->GetProxyDefinition(
+        message->GetExtension(ProxyState::xml_group).c_str(),
+        message->GetExtension(ProxyState::xml_name).c_str(), false);
+    }
+
     // Create the corresponding SI object.
     std::string classname = message->GetExtension(DefinitionHeader::server_class);
     vtkObject* object;
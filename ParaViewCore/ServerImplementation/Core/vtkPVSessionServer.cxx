@@ -35,6 +35,7 @@
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
+#include "vtkTimerLog.h"
 
 #include <assert.h>
 #include <map>
@@ -62,6 +63,84 @@ void CloseSessionCallback(void* localArg, void* vtkNotUsed(remoteArg),
   vtkPVSessionServer* self = reinterpret_cast<vtkPVSessionServer*>(localArg);
   self->OnCloseSessionRMI();
 }
+
+// Returns true if the message only holds property values, such as the ones
+// pushed by vtkSMProxy::UpdateVTKObjects(). Such messages can be merged with
+// the following ones of the same proxy.
+bool IsPropertyUpdate(const vtkSMMessage& msg)
+{
+  int size = msg.ExtensionSize(ProxyState::property);
+  if (size == 0 || msg.share_only() || msg.req_def())
+  {
+    return false;
+  }
+  for (int cc = 0; cc < size; ++cc)
+  {
+    if (msg.GetExtension(ProxyState::property, cc).delta_range_size() > 0)
+    {
+      return false;
+    }
+  }
+
+  vtkSMMessage header;
+  header.set_global_id(msg.global_id());
+  header.set_location(msg.location());
+  if (msg.has_client_id())
+  {
+    header.set_client_id(msg.client_id());
+  }
+  vtkSMMessage copy;
+  copy.CopyFrom(msg);
+  copy.ClearExtension(ProxyState::property);
+  return copy.ByteSize() == header.ByteSize();
+}
+
+// Updates `queued`, a message still waiting to be sent to a client, with
+// `msg`, a later message for the same object. Returns false if both messages
+// must be sent.
+bool Coalesce(vtkSMMessage& queued, const vtkSMMessage& msg)
+{
+  if (queued.global_id() != msg.global_id() || queued.location() != msg.location())
+  {
+    return false;
+  }
+
+  // States shared by a client (e.g. its camera) are full states: the last one
+  // replaces the previous one.
+  if (queued.share_only() && msg.share_only() && queued.client_id() == msg.client_id())
+  {
+    queued.CopyFrom(msg);
+    return true;
+  }
+
+  if (!IsPropertyUpdate(queued) || !IsPropertyUpdate(msg))
+  {
+    return false;
+  }
+  for (int cc = 0; cc < msg.ExtensionSize(ProxyState::property); ++cc)
+  {
+    const ProxyState_Property& prop = msg.GetExtension(ProxyState::property, cc);
+    int index = 0;
+    int size = queued.ExtensionSize(ProxyState::property);
+    while (index < size && queued.GetExtension(ProxyState::property, index).name() != prop.name())
+    {
+      ++index;
+    }
+    if (index < size)
+    {
+      queued.MutableExtension(ProxyState::property, index)->CopyFrom(prop);
+    }
+    else
+    {
+      queued.AddExtension(ProxyState::property)->CopyFrom(prop);
+    }
+  }
+  if (msg.has_client_id())
+  {
+    queued.set_client_id(msg.client_id());
+  }
+  return true;
+}
 };
 //****************************************************************************/
 class vtkPVSessionServer::vtkInternals
@@ -71,6 +150,7 @@ public:
   {
     this->SatelliteServerSession = (vtkProcessModule::GetProcessModule()->GetPartitionId() > 0);
     this->Owner = owner;
+    this->MessageDepth = 0;
 
     // Attach callbacks
     this->CompositeMultiProcessController->AddRMICallback(
@@ -119,18 +199,132 @@ public:
   //-----------------------------------------------------------------
   void SetClientURL(const char* client_url) { this->ClientURL = client_url; }
   //-----------------------------------------------------------------
+  // Notifications are not sent right away but queued for each client, then
+  // sent by FlushNotifications() once the message of the active client has
+  // been processed. A message superseding a queued one of the same object
+  // replaces it (see Coalesce()), so that clients, and throttled ones in
+  // particular, skip intermediate states.
   void NotifyOtherClients(const vtkSMMessage* msgToBroadcast)
   {
-    std::string data = msgToBroadcast->SerializeAsString();
-    this->CompositeMultiProcessController->TriggerRMI2All(1, (void*)data.c_str(),
-      static_cast<int>(data.size()), vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI, false);
+    this->QueueNotification(msgToBroadcast, false);
   }
   //-----------------------------------------------------------------
   void NotifyAllClients(const vtkSMMessage* msgToBroadcast)
   {
-    std::string data = msgToBroadcast->SerializeAsString();
-    this->CompositeMultiProcessController->TriggerRMI2All(1, (void*)data.c_str(),
-      static_cast<int>(data.size()), vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI, true);
+    this->QueueNotification(msgToBroadcast, true);
+  }
+  //-----------------------------------------------------------------
+  void QueueNotification(const vtkSMMessage* msg, bool sendToActive)
+  {
+    vtkCompositeMultiProcessController* ctrl = this->CompositeMultiProcessController.GetPointer();
+    int activeId = ctrl->GetActiveControllerID();
+    int nbCtrls = ctrl->GetNumberOfControllers();
+    for (int i = 0; i < nbCtrls; i++)
+    {
+      int id = ctrl->GetControllerId(i);
+      if (sendToActive || id != activeId)
+      {
+        std::vector<vtkSMMessage>& queue = this->NotificationQueues[id].Messages;
+        // Only the last queued message of the same object may be superseded,
+        // in place, so that the order of the messages of an object is kept.
+        // It is not when other messages than property updates, such as the
+        // registration of a proxy the new value may refer to, were queued
+        // after it: the message is then queued as is, keeping the stream in
+        // order.
+        std::vector<vtkSMMessage>::iterator iter = queue.end();
+        bool independent = true;
+        while (iter != queue.begin() && (iter - 1)->global_id() != msg->global_id())
+        {
+          --iter;
+          independent = independent && (IsPropertyUpdate(*iter) || iter->share_only());
+        }
+        if (!independent || iter == queue.begin() || !Coalesce(*(iter - 1), *msg))
+        {
+          queue.push_back(*msg);
+        }
+      }
+    }
+    if (this->MessageDepth == 0)
+    {
+      this->FlushNotifications(false);
+    }
+  }
+  //-----------------------------------------------------------------
+  // Sends the queued notifications. Unless `force` is true, clients other
+  // than the master and the active ones only get notifications every
+  // ObserverNotificationInterval milliseconds. Returns the time in
+  // milliseconds until such throttled notifications are due, 0 if none are
+  // pending.
+  unsigned long FlushNotifications(bool force)
+  {
+    vtkCompositeMultiProcessController* ctrl = this->CompositeMultiProcessController.GetPointer();
+    int activeId = ctrl->GetActiveControllerID();
+    int masterId = ctrl->GetMasterController();
+    double now = vtkTimerLog::GetUniversalTime();
+    double interval = this->Owner->ObserverNotificationInterval / 1000.0;
+    double nextFlush = 0;
+
+    std::map<int, NotificationQueue>::iterator iter = this->NotificationQueues.begin();
+    while (iter != this->NotificationQueues.end())
+    {
+      NotificationQueue& queue = iter->second;
+      bool throttled = !force && iter->first != activeId && iter->first != masterId;
+      if (queue.Messages.empty() ||
+        (throttled && now < queue.LastFlushTime + interval))
+      {
+        if (!queue.Messages.empty())
+        {
+          double due = queue.LastFlushTime + interval - now;
+          nextFlush = (nextFlush == 0 || due < nextFlush) ? due : nextFlush;
+        }
+        ++iter;
+        continue;
+      }
+
+      bool connected = true;
+      for (size_t cc = 0; connected && cc < queue.Messages.size(); ++cc)
+      {
+        std::string data = queue.Messages[cc].SerializeAsString();
+        connected = ctrl->TriggerRMI2Controller(iter->first, (void*)data.c_str(),
+          static_cast<int>(data.size()), vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI);
+      }
+      queue.Messages.clear();
+      queue.LastFlushTime = now;
+      if (connected)
+      {
+        ++iter;
+      }
+      else
+      {
+        this->NotificationQueues.erase(iter++);
+      }
+    }
+    return nextFlush > 0 ? static_cast<unsigned long>(nextFlush * 1000) + 1 : 0;
+  }
+  //-----------------------------------------------------------------
+  // Keeps track of nested calls to OnClientServerMessageRMI(), from
+  // ProcessBatch(): notifications are sent at the end of the outermost call.
+  void BeginClientMessage()
+  {
+    if (this->MessageDepth++ == 0)
+    {
+      // Notifications still pending for the active client are sent before
+      // its message is processed, to keep them in order with the replies.
+      int activeId = this->CompositeMultiProcessController->GetActiveControllerID();
+      std::map<int, NotificationQueue>::iterator iter = this->NotificationQueues.find(activeId);
+      if (iter != this->NotificationQueues.end() && !iter->second.Messages.empty())
+      {
+        this->FlushNotifications(false);
+      }
+    }
+  }
+  //-----------------------------------------------------------------
+  void EndClientMessage()
+  {
+    if (--this->MessageDepth == 0)
+    {
+      this->FlushNotifications(false);
+    }
   }
   //-----------------------------------------------------------------
   vtkCompositeMultiProcessController* GetActiveController()
@@ -198,7 +392,19 @@ public:
   }
 
 private:
+  struct NotificationQueue
+  {
+    NotificationQueue()
+      : LastFlushTime(0)
+    {
+    }
+    std::vector<vtkSMMessage> Messages;
+    double LastFlushTime;
+  };
+
   vtkNew<vtkCompositeMultiProcessController> CompositeMultiProcessController;
+  std::map<int, NotificationQueue> NotificationQueues;
+  int MessageDepth;
   vtkWeakPointer<vtkPVSessionServer> Owner;
   std::string ClientURL;
   std::map<vtkTypeUInt32, vtkSMMessage> ShareOnlyCache;
@@ -214,6 +420,7 @@ vtkPVSessionServer::vtkPVSessionServer()
 
   // By default we act as a server for a single client
   this->MultipleConnection = false;
+  this->ObserverNotificationInterval = 0;
 
   // On server side only one session is available so we just set it Active()
   // forever
@@ -453,6 +660,8 @@ bool vtkPVSessionServer::GetIsAlive()
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_length)
 {
+  this->Internal->BeginClientMessage();
+
   vtkMultiProcessStream stream;
   stream.SetRawData(reinterpret_cast<const unsigned char*>(message), message_length);
   int type;
@@ -548,6 +757,68 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
       this->GatherInformationInternal(location, classname.c_str(), globalid, stream);
     }
     break;
+
+    case vtkPVSessionServer::BATCH:
+    {
+      this->ProcessBatch(stream);
+    }
+    break;
+  }
+
+  this->Internal->EndClientMessage();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::ProcessBatch(vtkMultiProcessStream& stream)
+{
+  // The header provides the (message length, payload length) pair of each
+  // message in the batch. The messages follow as a single buffer, each message
+  // being the raw data of the vtkMultiProcessStream that would have been sent
+  // using CLIENT_SERVER_MESSAGE_RMI, followed by its payload (only used for
+  // EXECUTE_STREAM).
+  int count = 0;
+  stream >> count;
+  std::vector<int> lengths(2 * count);
+  size_t total = 0;
+  for (int cc = 0; cc < 2 * count; cc++)
+  {
+    stream >> lengths[cc];
+    total += static_cast<size_t>(lengths[cc]);
+  }
+  if (total == 0)
+  {
+    return;
+  }
+
+  std::vector<unsigned char> data(total);
+  this->Internal->GetActiveController()->Receive(
+    &data[0], static_cast<vtkIdType>(total), 1, vtkPVSessionServer::BATCH_TAG);
+
+  size_t offset = 0;
+  for (int cc = 0; cc < count; cc++)
+  {
+    unsigned char* message = &data[offset];
+    int message_length = lengths[2 * cc];
+    int payload_length = lengths[2 * cc + 1];
+    offset += static_cast<size_t>(message_length);
+
+    vtkMultiProcessStream messageStream;
+    messageStream.SetRawData(message, message_length);
+    int type;
+    messageStream >> type;
+    if (type == vtkPVSessionServer::EXECUTE_STREAM)
+    {
+      int ignore_errors, size;
+      messageStream >> ignore_errors >> size;
+      vtkClientServerStream cssStream;
+      cssStream.SetData(payload_length > 0 ? &data[offset] : NULL, payload_length);
+      this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
+    }
+    else if (type != vtkPVSessionServer::BATCH)
+    {
+      this->OnClientServerMessageRMI(message, message_length);
+    }
+    offset += static_cast<size_t>(payload_length);
   }
 }
 
@@ -617,6 +888,8 @@ void vtkPVSessionServer::OnCloseSessionRMI()
 void vtkPVSessionServer::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "MultipleConnection: " << this->MultipleConnection << endl;
+  os << indent << "ObserverNotificationInterval: " << this->ObserverNotificationInterval << endl;
 }
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::NotifyOtherClients(const vtkSMMessage* msg)
@@ -629,3 +902,13 @@ void vtkPVSessionServer::NotifyAllClients(const vtkSMMessage* msg)
 {
   this->Internal->NotifyAllClients(msg);
 }
+
+//----------------------------------------------------------------------------
+unsigned long vtkPVSessionServer::FlushNotifications(bool force)
+{
+  if (this->Internal->IsSatelliteSession())
+  {
+    return 0;
+  }
+  return this->Internal->FlushNotifications(force);
+}
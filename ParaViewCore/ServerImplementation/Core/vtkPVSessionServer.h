@@ -83,13 +83,15 @@ public:
     REGISTER_SI = 16,
     UNREGISTER_SI = 17,
     LAST_RESULT = 18,
+    BATCH = 19,
     SERVER_NOTIFICATION_MESSAGE_RMI = 55624,
     CLIENT_SERVER_MESSAGE_RMI = 55625,
     CLOSE_SESSION = 55626,
     REPLY_GATHER_INFORMATION_TAG = 55627,
     REPLY_PULL = 55628,
     REPLY_LAST_RESULT = 55629,
-    EXECUTE_STREAM_TAG = 55630
+    EXECUTE_STREAM_TAG = 55630,
+    BATCH_TAG = 55631
   };
 
   //@{
@@ -117,6 +119,27 @@ public:
    */
   virtual void NotifyOtherClients(const vtkSMMessage*) VTK_OVERRIDE;
 
+  //@{
+  /**
+   * Minimum time in milliseconds between two notifications sent to the
+   * clients that are neither the master nor the active client i.e. the
+   * passive observers of a collaborative session. Meanwhile, notifications
+   * are queued and superseded updates of the same proxy are coalesced.
+   * 0 (the default) sends notifications as soon as the message of the
+   * active client has been processed.
+   */
+  vtkSetClampMacro(ObserverNotificationInterval, int, 0, VTK_INT_MAX);
+  vtkGetMacro(ObserverNotificationInterval, int);
+  //@}
+
+  /**
+   * Sends the notifications queued for the clients, including the throttled
+   * ones if `force` is true. Returns the time in milliseconds until pending
+   * throttled notifications are due, 0 if there are none. Server event loops
+   * use it as the timeout to wait for client messages.
+   */
+  unsigned long FlushNotifications(bool force = false);
+
 protected:
   vtkPVSessionServer();
   ~vtkPVSessionServer();
@@ -132,9 +155,16 @@ protected:
    */
   void SendLastResultToClient();
 
+  /**
+   * Called when client sends a batch of messages. \c stream is the header
+   * of the batch that provides the length of each message.
+   */
+  void ProcessBatch(vtkMultiProcessStream& stream);
+
   vtkMPIMToNSocketConnection* MPIMToNSocketConnection;
 
   bool MultipleConnection;
+  int ObserverNotificationInterval;
 
   class vtkInternals;
   vtkInternals* Internal;
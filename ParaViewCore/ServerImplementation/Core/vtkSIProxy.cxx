@@ -33,6 +33,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 //****************************************************************************
 struct SubProxyInfo
@@ -46,10 +47,145 @@ struct SubProxyInfo
   std::string Name;
   vtkTypeUInt32 GlobalID;
 };
+//****************************************************************************
+namespace
+{
+int GetNumberOfElements(const Variant& value)
+{
+  switch (value.type())
+  {
+    case Variant::INT:
+      return value.integer_size();
+    case Variant::FLOAT64:
+      return value.float64_size();
+    case Variant::IDTYPE:
+      return value.idtype_size();
+    default:
+      return 0;
+  }
+}
+
+// Copies the values of a delta (see ProxyState.Property.delta_range) into
+// the full value.
+template <class T>
+bool ApplyDelta(const ProxyState_Property& delta, const google::protobuf::RepeatedField<T>& values,
+  google::protobuf::RepeatedField<T>* full)
+{
+  int next = 0;
+  for (int cc = 0; cc + 1 < delta.delta_range_size(); cc += 2)
+  {
+    int first = static_cast<int>(delta.delta_range(cc));
+    int count = static_cast<int>(delta.delta_range(cc + 1));
+    if (first + count > full->size() || next + count > values.size())
+    {
+      return false;
+    }
+    for (int i = 0; i < count; ++i)
+    {
+      full->Set(first + i, values.Get(next++));
+    }
+  }
+  return next == values.size();
+}
+
+// Removes the properties at the given indices, in increasing order, from the
+// message.
+void RemoveProperties(vtkSMMessage* message, const std::vector<int>& indices)
+{
+  if (indices.empty())
+  {
+    return;
+  }
+  std::vector<ProxyState_Property> kept;
+  size_t next = 0;
+  for (int cc = 0; cc < message->ExtensionSize(ProxyState::property); cc++)
+  {
+    if (next < indices.size() && indices[next] == cc)
+    {
+      ++next;
+      continue;
+    }
+    kept.push_back(message->GetExtension(ProxyState::property, cc));
+  }
+  message->ClearExtension(ProxyState::property);
+  for (size_t cc = 0; cc < kept.size(); cc++)
+  {
+    message->AddExtension(ProxyState::property)->CopyFrom(kept[cc]);
+  }
+}
+}
+
 //****************************************************************************
 class vtkSIProxy::vtkInternals
 {
 public:
+  // Last value of the properties that may be pushed as a delta.
+  typedef std::map<std::string, Variant> PropertyValuesMapType;
+  PropertyValuesMapType PropertyValues;
+
+  // Replaces a delta by the full value of the property and keeps track of the
+  // value of large numeric properties. Returns false if the delta cannot be
+  // applied, e.g. when it was computed from another value than the one known
+  // here.
+  bool ExpandDelta(ProxyState_Property* prop)
+  {
+    if (prop->delta_range_size() == 0)
+    {
+      if (prop->has_value() &&
+        GetNumberOfElements(prop->value()) >= vtkSIProxy::GetMinimumDeltaSize())
+      {
+        this->PropertyValues[prop->name()] = prop->value();
+      }
+      else
+      {
+        this->PropertyValues.erase(prop->name());
+      }
+      return true;
+    }
+
+    PropertyValuesMapType::iterator iter = this->PropertyValues.find(prop->name());
+    if (iter == this->PropertyValues.end())
+    {
+      return false;
+    }
+    const Variant& values = prop->value();
+    if (iter->second.type() != values.type() ||
+      GetNumberOfElements(iter->second) != static_cast<int>(prop->delta_size()) ||
+      !prop->has_delta_base() || prop->delta_base() != vtkSMMessageHashValues(iter->second))
+    {
+      return false;
+    }
+
+    // The delta is applied to a copy, the last value pushed is kept if the
+    // delta turns out to be invalid.
+    Variant full = iter->second;
+    bool status = false;
+    switch (full.type())
+    {
+      case Variant::INT:
+        status = ApplyDelta(*prop, values.integer(), full.mutable_integer());
+        break;
+      case Variant::FLOAT64:
+        status = ApplyDelta(*prop, values.float64(), full.mutable_float64());
+        break;
+      case Variant::IDTYPE:
+        status = ApplyDelta(*prop, values.idtype(), full.mutable_idtype());
+        break;
+      default:
+        break;
+    }
+    if (!status)
+    {
+      return false;
+    }
+    iter->second.Swap(&full);
+    prop->mutable_value()->CopyFrom(iter->second);
+    prop->clear_delta_range();
+    prop->clear_delta_size();
+    prop->clear_delta_base();
+    return true;
+  }
+
   void ClearDependencies()
   {
     this->SIProperties.clear();
@@ -122,10 +258,21 @@ void vtkSIProxy::Push(vtkSMMessage* message)
   // Handle properties
   int cc = 0;
   int size = message->ExtensionSize(ProxyState::property);
+  std::vector<int> rejected;
   for (; cc < size; cc++)
   {
     const ProxyState_Property& propMsg = message->GetExtension(ProxyState::property, cc);
 
+    // Expand the value in place, so that the message forwarded to other
+    // clients is complete too.
+    if (!this->Internals->ExpandDelta(message->MutableExtension(ProxyState::property, cc)))
+    {
+      vtkErrorMacro("Rejecting delta that does not apply to the current value of property: "
+        << propMsg.name());
+      rejected.push_back(cc);
+      continue;
+    }
+
     // Convert state to interpretor stream
     vtkSIProperty* prop = this->GetSIProperty(propMsg.name().c_str());
     if (prop)
@@ -134,11 +281,15 @@ void vtkSIProxy::Push(vtkSMMessage* message)
       {
         vtkErrorMacro("Error pushing property state: " << propMsg.name());
         message->PrintDebugString();
+        RemoveProperties(message, rejected);
         return;
       }
     }
   }
 
+  // Rejected deltas must not be forwarded to other clients either.
+  RemoveProperties(message, rejected);
+
   // Execute post_push if any
   if (this->PostPush != NULL)
   {
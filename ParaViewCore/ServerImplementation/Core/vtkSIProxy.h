@@ -72,6 +72,13 @@ public:
    */
   vtkSIProperty* GetSIProperty(const char* name);
 
+  /**
+   * Numeric properties with at least that many elements may be pushed as a
+   * delta from their previously pushed value (see vtkSMProxy::UpdateVTKObjects()).
+   * vtkSIProxy keeps the last value of such properties to expand the deltas.
+   */
+  static int GetMinimumDeltaSize() { return 1024; }
+
   //@{
   /**
    * Returns the VTKClassName.
@@ -25,6 +25,7 @@
 #include "vtkPVProxyDefinitionIterator.h"
 #include "vtkPVServerManagerPluginInterface.h"
 #include "vtkPVSession.h"
+#include "vtkPVXMLBinarySerializer.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
 #include "vtkProcessModule.h"
@@ -35,12 +36,16 @@
 #include "vtkStringList.h"
 #include "vtkTimerLog.h"
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <map>
 #include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
 
 #include <assert.h>
 
@@ -53,6 +58,7 @@
 typedef vtkSmartPointer<vtkPVXMLElement> XMLElement;
 typedef std::map<vtkStdString, XMLElement> StrToXmlMap;
 typedef std::map<vtkStdString, StrToXmlMap> StrToStrToXmlMap;
+typedef std::map<vtkStdString, std::pair<size_t, size_t> > StrToRangeMap;
 
 class vtkSIProxyDefinitionManager::vtkInternals
 {
@@ -63,9 +69,19 @@ public:
   StrToStrToXmlMap CoreDefinitions;
   // Keep track of custom definition
   StrToStrToXmlMap CustomsDefinitions;
+  // Content of the definition cache and location of the groups that have not
+  // been added to CoreDefinitions yet.
+  std::string CacheBuffer;
+  StrToRangeMap CachedGroups;
+  // The collapsed definitions of the cache are only valid as long as no other
+  // core definition is added or extended.
+  bool CollapsedCacheValid;
+  StrToStrToXmlMap* CollapsedDefinitions;
   //-------------------------------------------------------------------------
   vtkInternals()
     : EnableXMLProxyDefinitionUpdate(true)
+    , CollapsedCacheValid(false)
+    , CollapsedDefinitions(NULL)
   {
   }
   //-------------------------------------------------------------------------
@@ -73,10 +89,67 @@ public:
   {
     this->CoreDefinitions.clear();
     this->CustomsDefinitions.clear();
+    this->CacheBuffer.clear();
+    this->CachedGroups.clear();
+    this->CollapsedCacheValid = false;
+  }
+  //-------------------------------------------------------------------------
+  // Deserialize the definitions of the group from the cache, if not done yet.
+  void LoadCachedGroup(const char* groupName)
+  {
+    if (!groupName || this->CachedGroups.empty())
+    {
+      return;
+    }
+    StrToRangeMap::iterator iter = this->CachedGroups.find(groupName);
+    if (iter == this->CachedGroups.end())
+    {
+      return;
+    }
+    std::istringstream stream(this->CacheBuffer.substr(iter->second.first, iter->second.second));
+    this->CachedGroups.erase(iter);
+    if (this->CachedGroups.empty())
+    {
+      std::string().swap(this->CacheBuffer);
+    }
+
+    vtkSmartPointer<vtkPVXMLElement> group = vtkPVXMLBinarySerializer::Read(stream);
+    if (!group)
+    {
+      vtkGenericWarningMacro("Failed to read group \"" << groupName
+                                                       << "\" from the definition cache.");
+      return;
+    }
+    StrToXmlMap& definitions = this->CoreDefinitions[groupName];
+    for (unsigned int cc = 0; cc < group->GetNumberOfNestedElements(); ++cc)
+    {
+      vtkPVXMLElement* entry = group->GetNestedElement(cc);
+      const char* proxyName = entry->GetAttribute("name");
+      if (!proxyName || entry->GetNumberOfNestedElements() == 0)
+      {
+        continue;
+      }
+      definitions[proxyName] = entry->GetNestedElement(0);
+      if (entry->GetNumberOfNestedElements() > 1 && this->CollapsedCacheValid &&
+        this->CollapsedDefinitions)
+      {
+        (*this->CollapsedDefinitions)[groupName][proxyName] = entry->GetNestedElement(1);
+      }
+    }
+  }
+  //-------------------------------------------------------------------------
+  void LoadCachedGroups()
+  {
+    while (!this->CachedGroups.empty())
+    {
+      vtkStdString groupName = this->CachedGroups.begin()->first;
+      this->LoadCachedGroup(groupName.c_str());
+    }
   }
   //-------------------------------------------------------------------------
   bool HasCoreDefinition(const char* groupName, const char* proxyName)
   {
+    this->LoadCachedGroup(groupName);
     return this->GetProxyElement(this->CoreDefinitions, groupName, proxyName) != NULL;
   }
   //-------------------------------------------------------------------------
@@ -90,6 +163,7 @@ public:
     unsigned int nbProxy = 0;
     if (groupName)
     {
+      this->LoadCachedGroup(groupName);
       nbProxy += static_cast<unsigned int>(this->CoreDefinitions[groupName].size());
       nbProxy += static_cast<unsigned int>(this->CustomsDefinitions[groupName].size());
     }
@@ -101,6 +175,7 @@ public:
     vtkPVXMLElement* elementToReturn = NULL;
 
     // Search in ServerManager definitions
+    this->LoadCachedGroup(groupName);
     elementToReturn = this->GetProxyElement(this->CoreDefinitions, groupName, proxyName);
 
     // If not found yet, search in customs ones...
@@ -296,6 +371,10 @@ public:
     this->CustomDefinitionMap = map;
     this->InvalidCustomIterator = true;
   }
+  //-------------------------------------------------------------------------
+  // The groups of the definition cache are deserialized when the traversal
+  // starts, only those that are traversed.
+  void SetCacheOwner(vtkSIProxyDefinitionManager* owner) { this->CacheOwner = owner; }
 
   //-------------------------------------------------------------------------
   void GoToNextGroup() VTK_OVERRIDE { this->NextGroup(); }
@@ -308,6 +387,7 @@ protected:
     this->CustomDefinitionMap = 0;
     this->InvalidCoreIterator = true;
     this->InvalidCustomIterator = true;
+    this->CacheOwner = NULL;
   }
   ~vtkInternalDefinitionIterator() {}
 
@@ -318,6 +398,19 @@ protected:
     this->InvalidCoreIterator = true;
     this->InvalidCustomIterator = true;
 
+    if (this->CacheOwner)
+    {
+      if (this->GroupNames.size() == 0)
+      {
+        this->CacheOwner->Internals->LoadCachedGroups();
+      }
+      std::set<vtkStdString>::iterator iter = this->GroupNames.begin();
+      for (; iter != this->GroupNames.end(); ++iter)
+      {
+        this->CacheOwner->Internals->LoadCachedGroup(iter->c_str());
+      }
+    }
+
     if (this->GroupNames.size() == 0)
     {
       // Look for all name available
@@ -412,8 +505,33 @@ private:
   std::set<vtkStdString>::iterator GroupNameIterator;
   bool InvalidCoreIterator;
   bool InvalidCustomIterator;
+  vtkSIProxyDefinitionManager* CacheOwner;
 };
 
+//****************************************************************************/
+namespace
+{
+// Returns the key identifying the definition cache of the given core XMLs.
+std::string GetDefinitionCacheKey(const std::vector<std::string>& xmls)
+{
+  // 64-bit FNV-1a hash of the XMLs.
+  vtkTypeUInt64 hash = 14695981039346656037ULL;
+  for (size_t cc = 0; cc < xmls.size(); ++cc)
+  {
+    const std::string& xml = xmls[cc];
+    for (size_t i = 0; i <= xml.size(); ++i)
+    {
+      hash ^= static_cast<unsigned char>(i < xml.size() ? xml[i] : '\0');
+      hash *= 1099511628211ULL;
+    }
+  }
+  std::ostringstream key;
+  key << PARAVIEW_VERSION_FULL << "-" << vtkPVXMLBinarySerializer::GetFormatVersion() << "-"
+      << xmls.size() << "-" << std::hex << hash;
+  return key.str();
+}
+}
+
 //****************************************************************************/
 vtkStandardNewMacro(vtkSIProxyDefinitionManager) vtkStandardNewMacro(vtkInternalDefinitionIterator)
   //---------------------------------------------------------------------------
@@ -421,17 +539,36 @@ vtkStandardNewMacro(vtkSIProxyDefinitionManager) vtkStandardNewMacro(vtkInternal
 {
   this->Internals = new vtkInternals;
   this->InternalsFlatten = new vtkInternals;
+  this->Internals->CollapsedDefinitions = &this->InternalsFlatten->CoreDefinitions;
 
   vtkPVPluginTracker* tracker = vtkPVPluginTracker::GetInstance();
+  const char* cacheFileName = vtksys::SystemTools::GetEnv("PV_PROXY_DEFINITION_CACHE");
 
   // Load the core xmls.
-  // These are loaded from the vtkPVInitializerPlugin plugin.
+  // These are loaded from the vtkPVInitializerPlugin plugin, or from the
+  // definition cache if any.
   for (unsigned int cc = 0; cc < tracker->GetNumberOfPlugins(); cc++)
   {
     vtkPVPlugin* plugin = tracker->GetPlugin(cc);
     if (plugin && strcmp(plugin->GetPluginName(), "vtkPVInitializerPlugin") == 0)
     {
-      this->HandlePlugin(plugin);
+      vtkPVServerManagerPluginInterface* smplugin =
+        dynamic_cast<vtkPVServerManagerPluginInterface*>(plugin);
+      if (cacheFileName && *cacheFileName && smplugin)
+      {
+        std::vector<std::string> xmls;
+        smplugin->GetXMLs(xmls);
+        std::string key = GetDefinitionCacheKey(xmls);
+        if (!this->LoadDefinitionCache(cacheFileName, key.c_str()))
+        {
+          this->HandlePlugin(plugin);
+          this->SaveDefinitionCache(cacheFileName, key.c_str());
+        }
+      }
+      else
+      {
+        this->HandlePlugin(plugin);
+      }
       break;
     }
   }
@@ -447,6 +584,7 @@ vtkStandardNewMacro(vtkSIProxyDefinitionManager) vtkStandardNewMacro(vtkInternal
     }
 
     this->HandlePlugin(plugin);
+    this->HandleManifest(tracker->GetPluginManifest(cc));
   }
 
   // Register with the plugin tracker, so that when new plugins are loaded,
@@ -454,6 +592,8 @@ vtkStandardNewMacro(vtkSIProxyDefinitionManager) vtkStandardNewMacro(vtkInternal
   // definitions.
   tracker->AddObserver(
     vtkCommand::RegisterEvent, this, &vtkSIProxyDefinitionManager::OnPluginLoaded);
+  tracker->AddObserver(vtkPVPluginTracker::ManifestRegisteredEvent, this,
+    &vtkSIProxyDefinitionManager::OnManifestRegistered);
 }
 
 //---------------------------------------------------------------------------
@@ -475,6 +615,7 @@ void vtkSIProxyDefinitionManager::AddElement(
   const char* groupName, const char* proxyName, vtkPVXMLElement* element)
 {
   bool updated = false;
+  this->Internals->LoadCachedGroup(groupName);
   if (element->GetName() && strcmp(element->GetName(), "Extension") == 0)
   {
     // This is an extension for an existing definition.
@@ -504,6 +645,9 @@ void vtkSIProxyDefinitionManager::AddElement(
 
   if (updated)
   {
+    // Collapsed definitions read from the cache may no longer be valid.
+    this->Internals->CollapsedCacheValid = false;
+
     // Let the world know that a core-definition was registered i.e. added or
     // modified.
     RegisteredDefinitionInformation info(groupName, proxyName, false);
@@ -516,6 +660,21 @@ vtkPVXMLElement* vtkSIProxyDefinitionManager::GetProxyDefinition(
   const char* groupName, const char* proxyName, const bool throwError)
 {
   vtkPVXMLElement* element = this->Internals->GetProxyElement(groupName, proxyName);
+  if (this->Internals->EnableXMLProxyDefinitionUpdate &&
+    (!element || vtkSIProxyDefinitionManager::IsStubDefinition(element)))
+  {
+    // The definition may be provided by a lazy-load plugin, loading the
+    // plugin replaces the stub, if any, by the actual definition.
+    if (vtkPVPluginTracker::GetInstance()->LoadPluginForProxy(groupName, proxyName))
+    {
+      element = this->Internals->GetProxyElement(groupName, proxyName);
+    }
+    if (vtkSIProxyDefinitionManager::IsStubDefinition(element))
+    {
+      // The plugin failed to load or does not define the proxy.
+      element = NULL;
+    }
+  }
   if (!throwError || element)
   {
     return element;
@@ -842,6 +1001,10 @@ vtkPVProxyDefinitionIterator* vtkSIProxyDefinitionManager::NewSingleGroupIterato
 vtkPVProxyDefinitionIterator* vtkSIProxyDefinitionManager::NewIterator(int scope)
 {
   vtkInternalDefinitionIterator* iterator = vtkInternalDefinitionIterator::New();
+  if (scope != vtkSIProxyDefinitionManager::CUSTOM_DEFINITIONS)
+  {
+    iterator->SetCacheOwner(this);
+  }
   switch (scope)
   {
     case vtkSIProxyDefinitionManager::CORE_DEFINITIONS: // Core only
@@ -901,6 +1064,10 @@ vtkPVXMLElement* vtkSIProxyDefinitionManager::ExtractSubProxy(
 vtkPVXMLElement* vtkSIProxyDefinitionManager::GetCollapsedProxyDefinition(
   const char* group, const char* name, const char* subProxyName, bool throwError)
 {
+  // Make sure the group is loaded, along with its cached collapsed
+  // definitions, if it comes from the definition cache.
+  this->Internals->LoadCachedGroup(group);
+
   // Look in the cache
   vtkPVXMLElement* flattenDefinition = this->InternalsFlatten->GetProxyElement(group, name);
   if (flattenDefinition)
@@ -1176,6 +1343,214 @@ void vtkSIProxyDefinitionManager::HandlePlugin(vtkPVPlugin* plugin)
     }
   }
 }
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::OnManifestRegistered(vtkObject*, unsigned long, void* calldata)
+{
+  unsigned int index = *reinterpret_cast<unsigned int*>(calldata);
+  this->HandleManifest(vtkPVPluginTracker::GetInstance()->GetPluginManifest(index));
+}
+
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::HandleManifest(vtkPVXMLElement* manifest)
+{
+  // As for plugin XMLs, only the SERVER processes the manifests. Clients get
+  // the stubs along with the other definitions.
+  if (!manifest || !this->Internals->EnableXMLProxyDefinitionUpdate)
+  {
+    return;
+  }
+
+  bool updated = false;
+  for (unsigned int cc = 0; cc < manifest->GetNumberOfNestedElements(); cc++)
+  {
+    vtkPVXMLElement* entry = manifest->GetNestedElement(cc);
+    std::string groupName = entry->GetAttributeOrEmpty("group");
+    std::string proxyName = entry->GetAttributeOrEmpty("name");
+    if (!entry->GetName() || strcmp(entry->GetName(), "Proxy") != 0 || groupName.empty() ||
+      proxyName.empty() || this->Internals->HasCoreDefinition(groupName.c_str(), proxyName.c_str()))
+    {
+      continue;
+    }
+
+    // The stub keeps the label and hints of the manifest entry, e.g. the
+    // ReaderFactory hints of a reader.
+    vtkNew<vtkPVXMLElement> stub;
+    entry->CopyTo(stub.GetPointer());
+    stub->SetName("Proxy");
+    stub->RemoveAttribute("group");
+    stub->AddAttribute("lazy_load_plugin", manifest->GetAttributeOrEmpty("name"));
+    if (groupName == "sources" || groupName == "filters")
+    {
+      this->AttachShowInMenuHintsToProxy(stub.GetPointer());
+    }
+    this->AddElement(groupName.c_str(), proxyName.c_str(), stub.GetPointer());
+    updated = true;
+  }
+
+  if (updated)
+  {
+    this->InvokeEvent(vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated);
+  }
+}
+
+//---------------------------------------------------------------------------
+bool vtkSIProxyDefinitionManager::SaveDefinitionCache(const char* filename, const char* key)
+{
+  if (!filename || !key)
+  {
+    return false;
+  }
+
+  vtkTimerLog::MarkStartEvent("vtkSIProxyDefinitionManager Save Definition Cache");
+  this->Internals->LoadCachedGroups();
+
+  // The header lists the location of each group in the rest of the file so
+  // that groups can be deserialized independently.
+  vtkNew<vtkPVXMLElement> header;
+  header->SetName("ProxyDefinitionCache");
+  header->AddAttribute("key", key);
+  std::string groups;
+  StrToStrToXmlMap::iterator groupIter;
+  for (groupIter = this->Internals->CoreDefinitions.begin();
+       groupIter != this->Internals->CoreDefinitions.end(); ++groupIter)
+  {
+    if (groupIter->second.empty())
+    {
+      continue;
+    }
+    const char* groupName = groupIter->first.c_str();
+    vtkNew<vtkPVXMLElement> group;
+    group->SetName("ProxyGroup");
+    group->AddAttribute("name", groupName);
+    for (StrToXmlMap::iterator iter = groupIter->second.begin(); iter != groupIter->second.end();
+         ++iter)
+    {
+      vtkPVXMLElement* definition = iter->second.GetPointer();
+      vtkNew<vtkPVXMLElement> entry;
+      entry->SetName("Definition");
+      entry->AddAttribute("name", iter->first.c_str());
+      entry->AddNestedElement(definition, 0);
+      if (definition->GetAttribute("base_proxygroup") && definition->GetAttribute("base_proxyname"))
+      {
+        vtkPVXMLElement* collapsed =
+          this->GetCollapsedProxyDefinition(groupName, iter->first.c_str(), NULL, false);
+        if (collapsed && collapsed != definition)
+        {
+          entry->AddNestedElement(collapsed, 0);
+        }
+      }
+      group->AddNestedElement(entry.GetPointer());
+    }
+
+    std::ostringstream stream;
+    vtkPVXMLBinarySerializer::Write(group.GetPointer(), stream);
+    vtkNew<vtkPVXMLElement> location;
+    location->SetName("Group");
+    location->AddAttribute("name", groupName);
+    location->AddAttribute("offset", static_cast<vtkIdType>(groups.size()));
+    location->AddAttribute("length", static_cast<vtkIdType>(stream.str().size()));
+    header->AddNestedElement(location.GetPointer());
+    groups += stream.str();
+  }
+
+  // Several processes may be writing the cache at the same time: write to a
+  // temporary file and rename it so that readers never see a partial file.
+  std::ostringstream tmpName;
+  tmpName << filename << "." << static_cast<void*>(this) << "." << std::hex
+          << static_cast<vtkTypeUInt64>(vtkTimerLog::GetUniversalTime() * 1e6) << ".tmp";
+  bool status;
+  {
+    std::ofstream os(tmpName.str().c_str(), ios::out | ios::binary);
+    status = os && vtkPVXMLBinarySerializer::Write(header.GetPointer(), os) &&
+      os.write(groups.c_str(), static_cast<std::streamsize>(groups.size()));
+  }
+  if (!status || std::rename(tmpName.str().c_str(), filename) != 0)
+  {
+    vtkDebugMacro("Failed to write the proxy definition cache: " << filename);
+    std::remove(tmpName.str().c_str());
+    status = false;
+  }
+  vtkTimerLog::MarkEndEvent("vtkSIProxyDefinitionManager Save Definition Cache");
+  return status;
+}
+
+//---------------------------------------------------------------------------
+bool vtkSIProxyDefinitionManager::LoadDefinitionCache(const char* filename, const char* key)
+{
+  if (!filename || !key)
+  {
+    return false;
+  }
+  std::ifstream is(filename, ios::in | ios::binary);
+  if (!is || !vtkPVXMLBinarySerializer::IsBinary(is))
+  {
+    return false;
+  }
+
+  vtkTimerLog::MarkStartEvent("vtkSIProxyDefinitionManager Load Definition Cache");
+  vtkSmartPointer<vtkPVXMLElement> header = vtkPVXMLBinarySerializer::Read(is);
+  bool status = header && header->GetName() &&
+    strcmp(header->GetName(), "ProxyDefinitionCache") == 0 && header->GetAttribute("key") &&
+    strcmp(header->GetAttribute("key"), key) == 0;
+  if (!status)
+  {
+    vtkDebugMacro("Proxy definition cache is out of date: " << filename);
+  }
+
+  std::string buffer;
+  StrToRangeMap groups;
+  if (status)
+  {
+    buffer.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    for (unsigned int cc = 0; status && cc < header->GetNumberOfNestedElements(); ++cc)
+    {
+      vtkPVXMLElement* location = header->GetNestedElement(cc);
+      vtkIdType offset, length;
+      status = location->GetAttribute("name") && location->GetScalarAttribute("offset", &offset) &&
+        location->GetScalarAttribute("length", &length) && offset >= 0 && length >= 0 &&
+        static_cast<size_t>(offset + length) <= buffer.size();
+      if (status)
+      {
+        groups[location->GetAttribute("name")] =
+          std::make_pair(static_cast<size_t>(offset), static_cast<size_t>(length));
+      }
+    }
+    if (!status)
+    {
+      vtkWarningMacro("Invalid proxy definition cache: " << filename);
+    }
+  }
+
+  if (status)
+  {
+    this->Internals->CacheBuffer.swap(buffer);
+    this->Internals->CachedGroups.swap(groups);
+    this->Internals->CollapsedCacheValid = true;
+    this->InternalsFlatten->Clear();
+    this->InvokeEvent(vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated);
+  }
+  vtkTimerLog::MarkEndEvent("vtkSIProxyDefinitionManager Load Definition Cache");
+  return status;
+}
+
+//---------------------------------------------------------------------------
+unsigned int vtkSIProxyDefinitionManager::GetNumberOfUnloadedCacheGroups()
+{
+  return static_cast<unsigned int>(this->Internals->CachedGroups.size());
+}
+
+//---------------------------------------------------------------------------
+bool vtkSIProxyDefinitionManager::IsStubDefinition(vtkPVXMLElement* definition)
+{
+  return definition != NULL && definition->GetAttribute("lazy_load_plugin") != NULL;
+}
+
+//---------------------------------------------------------------------------
+bool vtkSIProxyDefinitionManager::LoadStubDefinition(const char* groupName, const char* proxyName)
+{
+  return this->GetProxyDefinition(groupName, proxyName, false) != NULL;
+}
+
 //---------------------------------------------------------------------------
 bool vtkSIProxyDefinitionManager::HasDefinition(const char* groupName, const char* proxyName)
 {
@@ -37,6 +37,25 @@
  * \li \c vtkCommand::UnRegisterEvent - Fired when a proxy definition is
  * removed. Since this class only support removing custom proxies, this event is
  * fired only when a custom proxy is removed.
+ *
+ * Parsing the ParaView core XMLs is a noticeable part of the startup time.
+ * When the environment variable PV_PROXY_DEFINITION_CACHE is set to a file
+ * name, the core definitions, along with the collapsed version of the
+ * definitions that have a base proxy, are saved in that file using the
+ * binary format of vtkPVXMLBinarySerializer and subsequent processes read the
+ * definitions from it instead of parsing the XMLs. Each proxy group is stored
+ * separately and is only deserialized the first time a definition of that
+ * group is requested. The cache is keyed by the ParaView version and the
+ * content of the core XMLs, and is regenerated when either change. Plugin
+ * XMLs are always parsed.
+ *
+ * The proxies listed in the manifest of a lazy-load plugin (see
+ * vtkPVPluginTracker::LoadPluginConfigurationXML()) are registered as stub
+ * definitions, so that they show up in iterators, menus and the state sent
+ * to remote clients. Requesting the definition of a stub loads the plugin,
+ * which replaces the stub by the actual definition. When XML definition
+ * updates are disabled, i.e. on remote clients, stubs are returned as is and
+ * vtkSMProxyDefinitionManager requests the load from the servers.
 */
 
 #ifndef vtkSIProxyDefinitionManager_h
@@ -88,6 +107,28 @@ public:
    */
   bool HasDefinition(const char* groupName, const char* proxyName);
 
+  /**
+   * Returns true if the definition is the stub of a proxy of a lazy-load
+   * plugin that has not been loaded yet.
+   */
+  static bool IsStubDefinition(vtkPVXMLElement* definition);
+
+  /**
+   * Loads the lazy-load plugin that provides the proxy, if any and if not
+   * already loaded. Returns true if a definition that is not a stub is
+   * available for the proxy. This is invoked on the servers by
+   * vtkSMProxyDefinitionManager when a remote client needs a definition it
+   * only has the stub of.
+   */
+  bool LoadStubDefinition(const char* groupName, const char* proxyName);
+
+  /**
+   * Returns the number of groups of the definition cache that have not been
+   * deserialized yet (see PV_PROXY_DEFINITION_CACHE). Groups are deserialized
+   * when first accessed, including by iterators traversing them.
+   */
+  unsigned int GetNumberOfUnloadedCacheGroups();
+
   //@{
   /**
    * Returns the same thing as GetProxyDefinition in a flatten manner.
@@ -278,6 +319,15 @@ protected:
   void HandlePlugin(vtkPVPlugin*);
   //@}
 
+  //@{
+  /**
+   * Registers stub definitions for the proxies listed in the manifest of a
+   * lazy-load plugin, when the manifest is registered.
+   */
+  void OnManifestRegistered(vtkObject* caller, unsigned long event, void* calldata);
+  void HandleManifest(vtkPVXMLElement* manifest);
+  //@}
+
   /**
    * Called by the XML parser to add an element from which a proxy
    * can be created. Called during parsing.
@@ -321,6 +371,16 @@ protected:
    */
   void InvokeCustomDefitionsUpdated();
 
+  //@{
+  /**
+   * Save / load the core definitions to / from the definition cache file.
+   * Loading fails if the file is missing, invalid or was not written for the
+   * given key. Loaded groups are only deserialized when first accessed.
+   */
+  bool SaveDefinitionCache(const char* filename, const char* key);
+  bool LoadDefinitionCache(const char* filename, const char* key);
+  //@}
+
 private:
   vtkSIProxyDefinitionManager(const vtkSIProxyDefinitionManager&) VTK_DELETE_FUNCTION;
   void operator=(const vtkSIProxyDefinitionManager&) VTK_DELETE_FUNCTION;
@@ -328,6 +388,8 @@ private:
   class vtkInternals;
   vtkInternals* Internals;
   vtkInternals* InternalsFlatten;
+
+  friend class vtkInternalDefinitionIterator;
 };
 
 #endif
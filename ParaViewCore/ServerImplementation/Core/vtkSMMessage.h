@@ -24,6 +24,7 @@
 
 #include "vtkSMMessageMinimal.h"
 
+#include <cstring>
 #include <string>
 #if __GNUC__
 #pragma GCC diagnostic ignored "-Wsign-compare"
@@ -83,6 +84,43 @@ inline vtkClientServerStream& operator<<(
   return stream;
 }
 
+/**
+ * Returns a hash of the numeric values of the variant. It does not depend on
+ * the byte order, so that the client and the servers agree on it.
+ */
+inline vtkTypeUInt64 vtkSMMessageHashValues(const paraview_protobuf::Variant& variant)
+{
+  vtkTypeUInt64 hash = 14695981039346656037ULL;
+  int size = variant.type() == paraview_protobuf::Variant::INT
+    ? variant.integer_size()
+    : (variant.type() == paraview_protobuf::Variant::FLOAT64
+          ? variant.float64_size()
+          : (variant.type() == paraview_protobuf::Variant::IDTYPE ? variant.idtype_size() : 0));
+  for (int cc = -1; cc < size; cc++)
+  {
+    vtkTypeUInt64 value = static_cast<vtkTypeUInt64>(variant.type());
+    if (cc >= 0 && variant.type() == paraview_protobuf::Variant::INT)
+    {
+      value = static_cast<vtkTypeUInt64>(static_cast<vtkTypeInt64>(variant.integer(cc)));
+    }
+    else if (cc >= 0 && variant.type() == paraview_protobuf::Variant::FLOAT64)
+    {
+      double element = variant.float64(cc);
+      memcpy(&value, &element, sizeof(value));
+    }
+    else if (cc >= 0)
+    {
+      value = static_cast<vtkTypeUInt64>(variant.idtype(cc));
+    }
+    for (int byte = 0; byte < 8; byte++)
+    {
+      hash ^= (value >> (8 * byte)) & 0xff;
+      hash *= 1099511628211ULL;
+    }
+  }
+  return hash;
+}
+
 using namespace paraview_protobuf;
 #endif
 
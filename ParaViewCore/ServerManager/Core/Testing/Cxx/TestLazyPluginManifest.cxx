@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestLazyPluginManifest.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the stub definitions registered for the proxies listed in the
+// manifest of a lazy-load plugin (see vtkPVPluginTracker): the stubs are
+// listed by the iterators and in the state sent to clients, carry the hints
+// of the manifest, and listing them does not load the plugin.
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVPluginTracker.h"
+#include "vtkPVProxyDefinitionIterator.h"
+#include "vtkPVXMLElement.h"
+#include "vtkProcessModule.h"
+#include "vtkSIProxyDefinitionManager.h"
+#include "vtkSMMessage.h"
+
+#include <cstring>
+#include <string>
+
+namespace
+{
+// Returns the plugin index of the lazy-load plugin, or -1.
+int FindLazyPlugin(vtkPVPluginTracker* tracker)
+{
+  for (unsigned int cc = 0; cc < tracker->GetNumberOfPlugins(); ++cc)
+  {
+    if (tracker->GetPluginLazyLoad(cc))
+    {
+      return static_cast<int>(cc);
+    }
+  }
+  return -1;
+}
+
+bool CheckStubs(vtkSIProxyDefinitionManager* manager, const char* label)
+{
+  bool found = false;
+  vtkPVProxyDefinitionIterator* iter = manager->NewSingleGroupIterator("filters");
+  for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (strcmp(iter->GetProxyName(), "LazyTestFilter") != 0)
+    {
+      continue;
+    }
+    vtkPVXMLElement* stub = iter->GetProxyDefinition();
+    vtkPVXMLElement* hints = iter->GetProxyHints();
+    found = vtkSIProxyDefinitionManager::IsStubDefinition(stub) &&
+      strcmp(stub->GetAttributeOrEmpty("label"), "Lazy Test Filter") == 0 &&
+      !stub->GetAttribute("group") && hints && hints->FindNestedElementByName("ShowInMenu") &&
+      hints->FindNestedElementByName("ReaderFactory");
+  }
+  iter->Delete();
+  if (!found)
+  {
+    cerr << label << ": missing or invalid stub for (filters, LazyTestFilter)." << endl;
+    return false;
+  }
+
+  // Remote clients get the stubs along with the other definitions.
+  vtkSMMessage message;
+  manager->Pull(&message);
+  int size = message.ExtensionSize(ProxyDefinitionState::xml_definition_proxy);
+  for (int cc = 0; cc < size; ++cc)
+  {
+    const ProxyDefinitionState_ProxyXMLDefinition& xmlDef =
+      message.GetExtension(ProxyDefinitionState::xml_definition_proxy, cc);
+    if (xmlDef.group() == "sources" && xmlDef.name() == "LazyTestSource")
+    {
+      return true;
+    }
+  }
+  cerr << label << ": stub for (sources, LazyTestSource) missing from the state." << endl;
+  return false;
+}
+}
+
+int TestLazyPluginManifest(int vtkNotUsed(argc), char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  int status = EXIT_SUCCESS;
+  {
+    vtkPVPluginTracker* tracker = vtkPVPluginTracker::GetInstance();
+    vtkNew<vtkSIProxyDefinitionManager> before;
+
+    // The test executable stands for the plugin library, it is never loaded.
+    std::string xml = std::string("<Plugins>"
+                                  "  <Plugin name=\"LazyTestPlugin\" filename=\"") +
+      argv[0] + "\" auto_load=\"1\" lazy_load=\"1\">"
+                "    <Proxy group=\"filters\" name=\"LazyTestFilter\" label=\"Lazy Test Filter\">"
+                "      <Hints><ReaderFactory extensions=\"lazy\"/></Hints>"
+                "    </Proxy>"
+                "    <Proxy group=\"sources\" name=\"LazyTestSource\"/>"
+                "  </Plugin>"
+                "</Plugins>";
+    tracker->LoadPluginConfigurationXMLFromString(xml.c_str());
+    int index = FindLazyPlugin(tracker);
+    if (index < 0 || !tracker->GetPluginManifest(index))
+    {
+      cerr << "The manifest of the lazy-load plugin was not registered." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    // Managers created before and after the manifest is registered.
+    vtkNew<vtkSIProxyDefinitionManager> after;
+    if (!CheckStubs(before.GetPointer(), "before") || !CheckStubs(after.GetPointer(), "after"))
+    {
+      status = EXIT_FAILURE;
+    }
+
+    // Without XML definition updates, i.e. on a remote client, the stub is
+    // returned as is.
+    after->EnableXMLProxyDefnitionUpdate(false);
+    if (!vtkSIProxyDefinitionManager::IsStubDefinition(
+          after->GetProxyDefinition("filters", "LazyTestFilter", false)))
+    {
+      cerr << "The stub was not returned without XML definition updates." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    if (index < 0 || !tracker->GetPluginLazyLoad(index) || tracker->GetPluginLoaded(index))
+    {
+      cerr << "Listing the stubs loaded the plugin." << endl;
+      status = EXIT_FAILURE;
+    }
+  }
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -0,0 +1,127 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPipelineInformationBatch.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests vtkSMSourceProxy::UpdateDownstreamPipelineInformation(): the
+// information properties of a whole pipeline, and the data information its
+// domains query, are refreshed with a single information request, and the
+// state of proxies that did not change on the server is not loaded again.
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataInformation.h"
+#include "vtkProcessModule.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+// Counts the information requests sent to the server.
+class vtkCountingSession : public vtkSMSession
+{
+public:
+  static vtkCountingSession* New();
+  vtkTypeMacro(vtkCountingSession, vtkSMSession);
+
+  bool GatherInformation(vtkTypeUInt32 location, vtkPVInformation* information,
+    vtkTypeUInt32 globalid) VTK_OVERRIDE
+  {
+    ++this->Count;
+    return this->Superclass::GatherInformation(location, information, globalid);
+  }
+  int Count;
+
+protected:
+  vtkCountingSession()
+    : Count(0)
+  {
+  }
+};
+vtkStandardNewMacro(vtkCountingSession);
+
+vtkSMSourceProxy* NewSource(vtkSMSessionProxyManager* pxm, const char* group, const char* name,
+  vtkSMProxy* input = NULL)
+{
+  vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(pxm->NewProxy(group, name));
+  if (input)
+  {
+    vtkSMPropertyHelper(source, "Input").Set(input);
+  }
+  source->UpdateVTKObjects();
+  return source;
+}
+}
+
+int TestPipelineInformationBatch(int vtkNotUsed(argc), char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  int status = EXIT_SUCCESS;
+  {
+    vtkNew<vtkCountingSession> session;
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+    vtkSmartPointer<vtkSMSourceProxy> source;
+    source.TakeReference(NewSource(pxm, "sources", "TimeSource"));
+    vtkSmartPointer<vtkSMSourceProxy> shrink;
+    shrink.TakeReference(NewSource(pxm, "filters", "ShrinkFilter", source));
+    vtkSmartPointer<vtkSMSourceProxy> shrink2;
+    shrink2.TakeReference(NewSource(pxm, "filters", "ShrinkFilter", shrink));
+    shrink2->UpdatePipeline();
+
+    // One request for the whole pipeline, including the data information of
+    // the up to date output ports.
+    session->Count = 0;
+    source->UpdateDownstreamPipelineInformation();
+    if (session->Count != 1 ||
+      vtkSMPropertyHelper(source, "TimestepValues").GetNumberOfElements() == 0)
+    {
+      cerr << "ERROR: the pipeline information was updated with " << session->Count
+           << " requests." << endl;
+      status = EXIT_FAILURE;
+    }
+    vtkIdType numberOfCells = source->GetDataInformation(0)->GetNumberOfCells();
+    if (numberOfCells == 0 || shrink->GetDataInformation(0)->GetNumberOfCells() != numberOfCells ||
+      shrink2->GetDataInformation(0)->GetNumberOfCells() != numberOfCells || session->Count != 1)
+    {
+      cerr << "ERROR: the data information was not gathered with the pipeline information."
+           << endl;
+      status = EXIT_FAILURE;
+    }
+
+    // The state of a source that did not change on the server is skipped: the
+    // value set on the client is kept.
+    vtkSMPropertyHelper(source, "TimestepValues").Set(0, -1.0);
+    session->Count = 0;
+    source->UpdateDownstreamPipelineInformation();
+    if (session->Count != 1 || vtkSMPropertyHelper(source, "TimestepValues").GetAsDouble(0) != -1)
+    {
+      cerr << "ERROR: the state of an unmodified source was loaded again." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    // Once the source is modified, its state is loaded.
+    vtkSMPropertyHelper(source, "X Amplitude").Set(0.5);
+    source->UpdateVTKObjects();
+    source->UpdateDownstreamPipelineInformation();
+    if (vtkSMPropertyHelper(source, "TimestepValues").GetAsDouble(0) == -1)
+    {
+      cerr << "ERROR: the state of a modified source was not loaded." << endl;
+      status = EXIT_FAILURE;
+    }
+  }
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPropertyDelta.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the delta encoding of large vector properties (see
+// vtkSMProxy::UpdateVTKObjects()): partial changes reach the VTK object
+// intact, deltas are expanded in the message forwarded to other clients, and
+// deltas computed from another value than the one known by the server are
+// rejected and removed from the message.
+#include "vtkCommand.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVSession.h"
+#include "vtkPoints.h"
+#include "vtkPolyLineSource.h"
+#include "vtkProcessModule.h"
+#include "vtkSIObject.h"
+#include "vtkSIProxy.h"
+#include "vtkSMMessage.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+namespace
+{
+class vtkErrorCounter : public vtkCommand
+{
+public:
+  static vtkErrorCounter* New() { return new vtkErrorCounter; }
+  void Execute(vtkObject*, unsigned long, void*) VTK_OVERRIDE { ++this->Count; }
+  int Count;
+
+protected:
+  vtkErrorCounter()
+    : Count(0)
+  {
+  }
+};
+
+bool CheckPoints(vtkSMProxy* proxy, const std::vector<double>& values, const char* step)
+{
+  vtkPoints* points = vtkPolyLineSource::SafeDownCast(proxy->GetClientSideObject())->GetPoints();
+  bool valid = points && points->GetNumberOfPoints() * 3 == static_cast<vtkIdType>(values.size());
+  for (size_t cc = 0; valid && cc < values.size(); ++cc)
+  {
+    valid = points->GetPoint(static_cast<vtkIdType>(cc / 3))[cc % 3] == values[cc];
+  }
+  if (!valid)
+  {
+    cerr << "ERROR: " << step << ": points of the VTK object do not match." << endl;
+  }
+  return valid;
+}
+
+// Returns a message that sets the first coordinate to `x` as a delta from
+// `base`.
+void MakeDelta(vtkSMProxy* proxy, const std::vector<double>& base, double x, vtkSMMessage* msg)
+{
+  Variant full;
+  full.set_type(Variant::FLOAT64);
+  for (size_t cc = 0; cc < base.size(); ++cc)
+  {
+    full.add_float64(base[cc]);
+  }
+
+  msg->set_global_id(proxy->GetGlobalID());
+  msg->set_location(vtkPVSession::CLIENT_AND_SERVERS);
+  ProxyState_Property* prop = msg->AddExtension(ProxyState::property);
+  prop->set_name("Points");
+  prop->mutable_value()->set_type(Variant::FLOAT64);
+  prop->mutable_value()->add_float64(x);
+  prop->add_delta_range(0);
+  prop->add_delta_range(1);
+  prop->set_delta_size(static_cast<vtkTypeUInt32>(base.size()));
+  prop->set_delta_base(vtkSMMessageHashValues(full));
+}
+}
+
+int TestPropertyDelta(int vtkNotUsed(argc), char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  int status = EXIT_SUCCESS;
+  {
+    vtkNew<vtkSMSession> session;
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+    vtkSmartPointer<vtkSMSourceProxy> proxy;
+    proxy.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "PolyLineSource")));
+
+    // Enough points for the property to be sent as a delta.
+    std::vector<double> values(3 * vtkSIProxy::GetMinimumDeltaSize());
+    for (size_t cc = 0; cc < values.size(); ++cc)
+    {
+      values[cc] = static_cast<double>(cc);
+    }
+    vtkSMPropertyHelper(proxy, "Points").Set(&values[0], static_cast<unsigned int>(values.size()));
+    proxy->UpdateVTKObjects();
+    if (!CheckPoints(proxy, values, "full push"))
+    {
+      status = EXIT_FAILURE;
+    }
+
+    // A few elements change, including the first and the last ones.
+    values[0] = -1;
+    values[1] = -2;
+    values[100] = -3;
+    values[values.size() - 1] = -4;
+    vtkSMPropertyHelper(proxy, "Points").Set(&values[0], static_cast<unsigned int>(values.size()));
+    proxy->UpdateVTKObjects();
+    if (!CheckPoints(proxy, values, "delta push"))
+    {
+      status = EXIT_FAILURE;
+    }
+
+    // A delta from the current value is applied, and expanded in the message.
+    vtkSMMessage delta;
+    MakeDelta(proxy, values, 10, &delta);
+    session->PushState(&delta);
+    values[0] = 10;
+    if (!CheckPoints(proxy, values, "valid delta") ||
+      delta.ExtensionSize(ProxyState::property) != 1 ||
+      delta.GetExtension(ProxyState::property, 0).delta_range_size() != 0 ||
+      delta.GetExtension(ProxyState::property, 0).value().float64_size() !=
+        static_cast<int>(values.size()))
+    {
+      cerr << "ERROR: the valid delta was not expanded in the message." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    // A delta from a stale value is rejected, and not forwarded.
+    std::vector<double> stale(values);
+    stale[0] = 0;
+    vtkSMMessage staleDelta;
+    MakeDelta(proxy, stale, 20, &staleDelta);
+    vtkNew<vtkErrorCounter> errors;
+    vtkSIObject* siProxy = session->GetSIObject(proxy->GetGlobalID());
+    siProxy->AddObserver(vtkCommand::ErrorEvent, errors.GetPointer());
+    session->PushState(&staleDelta);
+    siProxy->RemoveObserver(errors.GetPointer());
+    if (errors->Count != 1 || staleDelta.ExtensionSize(ProxyState::property) != 0 ||
+      !CheckPoints(proxy, values, "stale delta"))
+    {
+      cerr << "ERROR: the stale delta was not rejected." << endl;
+      status = EXIT_FAILURE;
+    }
+  }
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestProxyDefinitionCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the proxy definition cache of vtkSIProxyDefinitionManager (see
+// PV_PROXY_DEFINITION_CACHE): the cache is written when missing or stale,
+// definitions loaded from it match those parsed from the XMLs, and groups
+// are only deserialized when traversed.
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVProxyDefinitionIterator.h"
+#include "vtkPVXMLBinarySerializer.h"
+#include "vtkPVXMLElement.h"
+#include "vtkProcessModule.h"
+#include "vtkSIProxyDefinitionManager.h"
+#include "vtkSmartPointer.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace
+{
+// Compares the definitions of the group in both managers, returns the number
+// of definitions or -1 if they do not match.
+int CompareGroup(
+  vtkSIProxyDefinitionManager* reference, vtkSIProxyDefinitionManager* cached, const char* group)
+{
+  int count = 0;
+  vtkPVProxyDefinitionIterator* iter = cached->NewSingleGroupIterator(
+    group, vtkSIProxyDefinitionManager::CORE_DEFINITIONS);
+  for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkPVXMLElement* expected =
+      reference->GetProxyDefinition(iter->GetGroupName(), iter->GetProxyName(), false);
+    if (!expected || !expected->Equals(iter->GetProxyDefinition()))
+    {
+      cerr << "Definition of " << iter->GetGroupName() << "/" << iter->GetProxyName()
+           << " does not match." << endl;
+      count = -1;
+      break;
+    }
+    ++count;
+  }
+  iter->Delete();
+  return count;
+}
+
+// Checks that a new manager ignores the current cache file, parses the XMLs
+// and replaces the file by a valid cache.
+bool TestRebuild(vtkSIProxyDefinitionManager* reference, const std::string& filename)
+{
+  vtkNew<vtkSIProxyDefinitionManager> manager;
+  if (manager->GetNumberOfUnloadedCacheGroups() != 0 ||
+    CompareGroup(reference, manager.GetPointer(), "sources") <= 0)
+  {
+    cerr << "Definitions were not parsed from the XMLs." << endl;
+    return false;
+  }
+  vtkSmartPointer<vtkPVXMLElement> header =
+    vtkPVXMLBinarySerializer::Read(filename.c_str());
+  if (!header || !header->GetAttribute("key") || strcmp(header->GetAttribute("key"), "stale") == 0)
+  {
+    cerr << "The cache was not rewritten." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestProxyDefinitionCache(int argc, char* argv[])
+{
+  std::string tempDir = ".";
+  for (int cc = 1; cc + 1 < argc; ++cc)
+  {
+    if (strcmp(argv[cc], "-T") == 0)
+    {
+      tempDir = argv[cc + 1];
+    }
+  }
+  std::string filename = tempDir + "/TestProxyDefinitionCache.pvdc";
+  std::remove(filename.c_str());
+
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  int status = EXIT_SUCCESS;
+  {
+    // Definitions parsed from the XMLs.
+    vtkNew<vtkSIProxyDefinitionManager> reference;
+
+    // Missing cache: the XMLs are parsed and the cache is saved.
+    vtksys::SystemTools::PutEnv("PV_PROXY_DEFINITION_CACHE=" + filename);
+    if (!TestRebuild(reference.GetPointer(), filename))
+    {
+      status = EXIT_FAILURE;
+    }
+
+    // Valid cache: groups are loaded when traversed, and only those.
+    vtkNew<vtkSIProxyDefinitionManager> cached;
+    unsigned int unloaded = cached->GetNumberOfUnloadedCacheGroups();
+    int count = CompareGroup(reference.GetPointer(), cached.GetPointer(), "sources");
+    if (unloaded < 2 || count <= 0 || cached->GetNumberOfUnloadedCacheGroups() != unloaded - 1)
+    {
+      cerr << "Groups were not loaded lazily from the cache: " << unloaded << " groups, "
+           << cached->GetNumberOfUnloadedCacheGroups() << " left after traversing sources."
+           << endl;
+      status = EXIT_FAILURE;
+    }
+    vtkPVXMLElement* expected =
+      reference->GetCollapsedProxyDefinition("sources", "SphereSource", NULL, false);
+    vtkPVXMLElement* collapsed =
+      cached->GetCollapsedProxyDefinition("sources", "SphereSource", NULL, false);
+    if (!expected || !collapsed || !expected->Equals(collapsed))
+    {
+      cerr << "Collapsed definitions do not match." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    // Stale cache, written for other XMLs.
+    vtkNew<vtkPVXMLElement> staleHeader;
+    staleHeader->SetName("ProxyDefinitionCache");
+    staleHeader->AddAttribute("key", "stale");
+    vtkPVXMLBinarySerializer::Write(staleHeader.GetPointer(), filename.c_str());
+    if (!TestRebuild(reference.GetPointer(), filename))
+    {
+      status = EXIT_FAILURE;
+    }
+
+    // Corrupted cache.
+    {
+      std::ofstream os(filename.c_str(), ios::out | ios::binary);
+      os << "not a proxy definition cache";
+    }
+    if (!TestRebuild(reference.GetPointer(), filename))
+    {
+      status = EXIT_FAILURE;
+    }
+
+    vtksys::SystemTools::UnPutEnv("PV_PROXY_DEFINITION_CACHE");
+  }
+  vtkInitializationHelper::Finalize();
+  std::remove(filename.c_str());
+  return status;
+}
@@ -16,6 +16,7 @@ vtk_module(vtkPVServerManagerCore
   PRIVATE_DEPENDS
     vtksys
     vtkpugixml
+    vtkzlib
     ${__dependencies}
   TEST_LABELS
     PARAVIEW
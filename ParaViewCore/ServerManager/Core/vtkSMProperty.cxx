@@ -27,6 +27,7 @@
 #include "vtkSMProperty.h"
 #include "vtkSMPropertyLink.h"
 #include "vtkSMProxy.h"
+#include "vtkSMSessionProxyManager.h"
 #include "vtkSmartPointer.h"
 
 #include <sstream>
@@ -298,6 +299,20 @@ void vtkSMProperty::UpdateDomains()
   //  this->DomainIterator->Next();
   //  }
 
+  if (this->PInternals->Dependents.empty())
+  {
+    return;
+  }
+
+  // The proxy manager may be deferring domain updates, e.g. while loading a
+  // state.
+  vtkSMProxy* proxy = this->GetParent();
+  vtkSMSessionProxyManager* pxm = proxy ? proxy->GetSessionProxyManager() : NULL;
+  if (pxm && pxm->DeferDomainUpdate(this))
+  {
+    return;
+  }
+
   // Update other dependent domains
   vtkSMPropertyInternals::DependentsVector::iterator iter = this->PInternals->Dependents.begin();
   for (; iter != this->PInternals->Dependents.end(); iter++)
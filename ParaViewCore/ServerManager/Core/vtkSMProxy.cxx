@@ -47,6 +47,111 @@
 #include <vector>
 #include <vtksys/RegularExpression.hxx>
 
+namespace
+{
+//---------------------------------------------------------------------------
+// Fills `delta` with the ranges of elements of `current` that differ from
+// `previous` (see ProxyState.Property.delta_range). Returns false if the
+// delta is not worth it.
+template <class T>
+bool EncodeDelta(const google::protobuf::RepeatedField<T>& previous,
+  const google::protobuf::RepeatedField<T>& current, google::protobuf::RepeatedField<T>* values,
+  ProxyState_Property* delta)
+{
+  int size = current.size();
+  if (previous.size() != size)
+  {
+    return false;
+  }
+
+  // Changes separated by a single unchanged element are merged in the same
+  // range, since a range costs about as much as an element.
+  std::vector<std::pair<int, int> > ranges;
+  int numberOfChanges = 0;
+  for (int cc = 0; cc < size; ++cc)
+  {
+    if (previous.Get(cc) == current.Get(cc))
+    {
+      continue;
+    }
+    if (!ranges.empty() && cc - (ranges.back().first + ranges.back().second) <= 1)
+    {
+      numberOfChanges += cc - (ranges.back().first + ranges.back().second) + 1;
+      ranges.back().second = cc + 1 - ranges.back().first;
+    }
+    else
+    {
+      ++numberOfChanges;
+      ranges.push_back(std::make_pair(cc, 1));
+    }
+  }
+  if (2 * numberOfChanges > size)
+  {
+    return false;
+  }
+
+  for (size_t cc = 0; cc < ranges.size(); ++cc)
+  {
+    delta->add_delta_range(static_cast<vtkTypeUInt32>(ranges[cc].first));
+    delta->add_delta_range(static_cast<vtkTypeUInt32>(ranges[cc].second));
+    for (int i = ranges[cc].first; i < ranges[cc].first + ranges[cc].second; ++i)
+    {
+      values->Add(current.Get(i));
+    }
+  }
+  delta->set_delta_size(static_cast<vtkTypeUInt32>(size));
+  return true;
+}
+
+//---------------------------------------------------------------------------
+// Adds the property to the message, as a delta from the previously pushed
+// value when the property is a large numeric vector.
+void AddPropertyToMessage(
+  vtkSMMessage* message, const ProxyState_Property& current, const std::string& pushedValue)
+{
+  ProxyState_Property* prop = message->AddExtension(ProxyState::property);
+  const Variant& value = current.value();
+  int size = value.type() == Variant::INT
+    ? value.integer_size()
+    : (value.type() == Variant::FLOAT64
+          ? value.float64_size()
+          : (value.type() == Variant::IDTYPE ? value.idtype_size() : 0));
+  ProxyState_Property previous;
+  if (size >= vtkSIProxy::GetMinimumDeltaSize() && current.user_data_size() == 0 &&
+    previous.ParseFromString(pushedValue) && previous.value().type() == value.type())
+  {
+    prop->set_name(current.name());
+    Variant* delta = prop->mutable_value();
+    delta->set_type(value.type());
+    bool encoded = false;
+    switch (value.type())
+    {
+      case Variant::INT:
+        encoded =
+          EncodeDelta(previous.value().integer(), value.integer(), delta->mutable_integer(), prop);
+        break;
+      case Variant::FLOAT64:
+        encoded =
+          EncodeDelta(previous.value().float64(), value.float64(), delta->mutable_float64(), prop);
+        break;
+      case Variant::IDTYPE:
+        encoded =
+          EncodeDelta(previous.value().idtype(), value.idtype(), delta->mutable_idtype(), prop);
+        break;
+      default:
+        break;
+    }
+    if (encoded)
+    {
+      // Lets the receivers check that they apply it to the same value.
+      prop->set_delta_base(vtkSMMessageHashValues(previous.value()));
+      return;
+    }
+  }
+  prop->CopyFrom(current);
+}
+}
+
 //---------------------------------------------------------------------------
 // Observer for modified event of the property
 class vtkSMProxyObserver : public vtkCommand
@@ -378,6 +483,8 @@ bool vtkSMProxy::UpdateProperty(const char* name, int force)
       if (oldProperty->name() == it->second.Property->GetXMLName())
       {
         it->second.Property->WriteTo(this->State);
+        it->second.PushedValue =
+          this->State->GetExtension(ProxyState::property, cc).SerializeAsString();
       }
       else
       {
@@ -437,6 +544,9 @@ void vtkSMProxy::MarkAllPropertiesAsModified()
   vtkSMProxyInternals::PropertyInfoMap::iterator it;
   for (it = this->Internals->Properties.begin(); it != this->Internals->Properties.end(); it++)
   {
+    // Make sure the values are pushed even if they did not change.
+    it->second.PushedValue.clear();
+
     // Not the most efficient way to set the flag, but probably the safest.
     this->SetPropertyModifiedFlag(it->first.c_str(), 1);
   }
@@ -608,6 +718,14 @@ void vtkSMProxy::UpdateVTKObjects()
     return;
   }
 
+  // The pushes of this proxy and its subproxies are sent to the server
+  // together (see vtkSMSession::StartBatch()).
+  vtkSMSession* session = this->GetSession();
+  if (session)
+  {
+    session->StartBatch();
+  }
+
   if (this->PropertiesModified)
   {
     this->InUpdateVTKObjects = 1;
@@ -657,9 +775,17 @@ void vtkSMProxy::UpdateVTKObjects()
             // the property is no longer dirty.
             iter->second.ModifiedFlag = 0;
 
-            // Write to Push message
-            ProxyState_Property* prop = message.AddExtension(ProxyState::property);
-            prop->CopyFrom(this->State->GetExtension(ProxyState::property, cc));
+            // Write to Push message, unless the value is the one that was last
+            // pushed e.g. when a property is set to a new value and back
+            // between two updates. Large vectors are sent as a delta.
+            const ProxyState_Property& newValue =
+              this->State->GetExtension(ProxyState::property, cc);
+            std::string serializedValue = newValue.SerializeAsString();
+            if (serializedValue != iter->second.PushedValue)
+            {
+              AddPropertyToMessage(&message, newValue, iter->second.PushedValue);
+              iter->second.PushedValue.swap(serializedValue);
+            }
 
             // Fire event to let everyone know that a property has been updated.
             // This is currently used by vtkSMLink. Need to see if we can avoid this
@@ -682,8 +808,11 @@ void vtkSMProxy::UpdateVTKObjects()
     this->InUpdateVTKObjects = 0;
     this->PropertiesModified = false;
 
-    // Send the message
-    this->PushState(&message);
+    // Send the message, if any property changed.
+    if (message.ExtensionSize(ProxyState::property) > 0)
+    {
+      this->PushState(&message);
+    }
   }
 
   vtkSMProxyInternals::ProxyMap::iterator it2 = this->Internals->SubProxies.begin();
@@ -692,6 +821,11 @@ void vtkSMProxy::UpdateVTKObjects()
     it2->second.GetPointer()->UpdateVTKObjects();
   }
 
+  if (session)
+  {
+    session->EndBatch();
+  }
+
   this->MarkModified(this);
   this->InvokeEvent(vtkCommand::UpdateEvent, 0);
 }
@@ -2193,6 +2327,12 @@ void vtkSMProxy::LoadState(const vtkSMMessage* message, vtkSMProxyLocator* locat
         continue;
       }
 
+      // The value on the server is not known anymore.
+      it->second.PushedValue.clear();
+      if (it->second.Property->GetInformationOnly())
+      {
+        this->Internals->InformationMTime = 0;
+      }
       it->second.Property->ReadFrom(message, i, locator);
     }
   }
@@ -2498,5 +2638,10 @@ void vtkSMProxy::RecreateVTKObjects()
 
   // Push our full state over to the server. This is akin to loading the
   // state on the newly created VTK object.
+  vtkSMProxyInternals::PropertyInfoMap::iterator it;
+  for (it = this->Internals->Properties.begin(); it != this->Internals->Properties.end(); it++)
+  {
+    it->second.PushedValue.clear();
+  }
   this->PushState(this->State);
 }
@@ -17,6 +17,7 @@
 #include "vtkClientServerStream.h"
 #include "vtkEventForwarderCommand.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVPluginTracker.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSMMessage.h"
 #include "vtkSMSession.h"
@@ -96,6 +97,74 @@ void vtkSMProxyDefinitionManager::SynchronizeDefinitions()
   this->ProxyDefinitionManager->Push(&message);
   vtkTimerLog::MarkEndEvent("Process Proxy definitions");
 }
+//----------------------------------------------------------------------------
+vtkPVXMLElement* vtkSMProxyDefinitionManager::GetProxyDefinition(
+  const char* group, const char* name, bool throwError)
+{
+  if (!this->ProxyDefinitionManager)
+  {
+    return NULL;
+  }
+  this->LoadStubDefinition(group, name);
+  vtkPVXMLElement* element =
+    this->ProxyDefinitionManager->GetProxyDefinition(group, name, throwError);
+  if (vtkSIProxyDefinitionManager::IsStubDefinition(element))
+  {
+    // The plugin failed to load or does not define the proxy.
+    if (throwError)
+    {
+      vtkErrorMacro("Failed to load the plugin providing (" << group << ", " << name << ").");
+    }
+    return NULL;
+  }
+  return element;
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLElement* vtkSMProxyDefinitionManager::GetCollapsedProxyDefinition(
+  const char* group, const char* name, const char* subProxyName, bool throwError)
+{
+  if (!this->ProxyDefinitionManager)
+  {
+    return NULL;
+  }
+  if (!this->GetProxyDefinition(group, name, throwError))
+  {
+    return NULL;
+  }
+  return this->ProxyDefinitionManager->GetCollapsedProxyDefinition(
+    group, name, subProxyName, throwError);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMProxyDefinitionManager::LoadStubDefinition(const char* group, const char* name)
+{
+  if (!this->ProxyDefinitionManager || !this->GetSession() ||
+    (this->GetSession()->GetProcessRoles() & vtkPVSession::SERVERS) != 0)
+  {
+    // Not running in remote-mode, the lookup itself loads the plugin.
+    return;
+  }
+
+  // Looking up the definition does not load anything on the client.
+  if (!vtkSIProxyDefinitionManager::IsStubDefinition(
+        this->ProxyDefinitionManager->GetProxyDefinition(group, name, false)))
+  {
+    return;
+  }
+
+  // The client side of the plugin, if the client configuration lists it.
+  vtkPVPluginTracker::GetInstance()->LoadPluginForProxy(group, name);
+
+  vtkClientServerStream stream;
+  stream << vtkClientServerStream::Invoke << SIOBJECT(this) << "LoadStubDefinition" << group
+         << name << vtkClientServerStream::End;
+  this->GetSession()->ExecuteStream(vtkPVSession::SERVERS, stream, false);
+
+  // Fetch the definitions of the plugin, which replace the stubs.
+  this->SynchronizeDefinitions();
+}
+
 //----------------------------------------------------------------------------
 void vtkSMProxyDefinitionManager::LoadState(
   const vtkSMMessage* msg, vtkSMProxyLocator* vtkNotUsed(locator))
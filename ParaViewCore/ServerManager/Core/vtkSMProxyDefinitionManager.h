@@ -78,18 +78,13 @@ public:
    * Returns a registered proxy definition or return a NULL otherwise.
    * Moreover, error can be throw if the definition was not found if the
    * flag throwError is true.
+   * If the definition is the stub of a proxy of a lazy-load plugin, the
+   * plugin is loaded first (see LoadStubDefinition()).
    */
-  vtkPVXMLElement* GetProxyDefinition(const char* group, const char* name, bool throwError)
-  {
-    return this->ProxyDefinitionManager
-      ? this->ProxyDefinitionManager->GetProxyDefinition(group, name, throwError)
-      : NULL;
-  }
+  vtkPVXMLElement* GetProxyDefinition(const char* group, const char* name, bool throwError);
   vtkPVXMLElement* GetProxyDefinition(const char* group, const char* name)
   {
-    return this->ProxyDefinitionManager
-      ? this->ProxyDefinitionManager->GetProxyDefinition(group, name)
-      : NULL;
+    return this->GetProxyDefinition(group, name, true);
   }
   //@}
 
@@ -99,13 +94,7 @@ public:
    * into a single vtkPVXMLElement definition.
    */
   vtkPVXMLElement* GetCollapsedProxyDefinition(
-    const char* group, const char* name, const char* subProxyName, bool throwError)
-  {
-    return this->ProxyDefinitionManager
-      ? this->ProxyDefinitionManager->GetCollapsedProxyDefinition(
-          group, name, subProxyName, throwError)
-      : NULL;
-  }
+    const char* group, const char* name, const char* subProxyName, bool throwError);
 
   /**
    * Return true if the XML Definition was found
@@ -192,6 +181,14 @@ public:
   void LoadCustomProxyDefinitionsFromString(const char* xmlContent);
   //@}
 
+  /**
+   * When the definition of the proxy is the stub of a proxy of a lazy-load
+   * plugin, loads the plugin on the servers, and on the client if its
+   * configuration lists it too, then synchronizes the definitions. In
+   * built-in mode, the definition lookup loads the plugin already.
+   */
+  void LoadStubDefinition(const char* group, const char* name);
+
   //@{
   /**
    * Loads server-manager configuration xml.
@@ -48,6 +48,8 @@ struct vtkSMProxyInternals
     vtkSmartPointer<vtkSMProperty> Property;
     int ModifiedFlag;
     unsigned int ObserverTag;
+    // Serialized ProxyState_Property last pushed for the property, if known.
+    std::string PushedValue;
   };
   // Note that the name of the property is the map key. That is the
   // only place where name is stored
@@ -97,8 +99,17 @@ struct vtkSMProxyInternals
   AnnotationMap Annotations;
   bool EnableAnnotationPush;
 
+  // Server-side modification time of the information properties last loaded
+  // by vtkSMSourceProxy::UpdatePipelineInformation(vtkCollection*), 0 if
+  // unknown.
+  vtkTypeUInt64 InformationMTime;
+
   // Setup default values
-  vtkSMProxyInternals() { this->EnableAnnotationPush = true; }
+  vtkSMProxyInternals()
+  {
+    this->EnableAnnotationPush = true;
+    this->InformationMTime = 0;
+  }
 };
 
 #endif
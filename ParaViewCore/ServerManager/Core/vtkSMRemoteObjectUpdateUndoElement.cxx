@@ -26,6 +26,77 @@
 
 #include <vtkNew.h>
 
+#include "vtk_zlib.h"
+
+namespace
+{
+// Helpers to (de)serialize the compacted state, see
+// vtkSMRemoteObjectUpdateUndoElement::Compact().
+void AppendUInt32(std::string& buffer, vtkTypeUInt32 value)
+{
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    buffer.push_back(static_cast<char>((value >> (8 * cc)) & 0xff));
+  }
+}
+
+void AppendBytes(std::string& buffer, const std::string& bytes)
+{
+  AppendUInt32(buffer, static_cast<vtkTypeUInt32>(bytes.size()));
+  buffer.append(bytes);
+}
+
+bool ReadUInt32(const std::string& buffer, size_t& pos, vtkTypeUInt32& value)
+{
+  if (pos + 4 > buffer.size())
+  {
+    return false;
+  }
+  value = 0;
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    value |= static_cast<vtkTypeUInt32>(static_cast<unsigned char>(buffer[pos++])) << (8 * cc);
+  }
+  return true;
+}
+
+bool ReadBytes(const std::string& buffer, size_t& pos, std::string& bytes)
+{
+  vtkTypeUInt32 size;
+  if (!ReadUInt32(buffer, pos, size) || pos + size > buffer.size())
+  {
+    return false;
+  }
+  bytes = buffer.substr(pos, size);
+  pos += size;
+  return true;
+}
+
+// Returns true if the states only differ by the values of their properties.
+bool HaveSameLayout(const vtkSMMessage& before, const vtkSMMessage& after)
+{
+  int numberOfProperties = before.ExtensionSize(ProxyState::property);
+  if (after.ExtensionSize(ProxyState::property) != numberOfProperties)
+  {
+    return false;
+  }
+  for (int cc = 0; cc < numberOfProperties; ++cc)
+  {
+    if (before.GetExtension(ProxyState::property, cc).name() !=
+      after.GetExtension(ProxyState::property, cc).name())
+    {
+      return false;
+    }
+  }
+  vtkSMMessage beforeCopy, afterCopy;
+  beforeCopy.CopyFrom(before);
+  beforeCopy.ClearExtension(ProxyState::property);
+  afterCopy.CopyFrom(after);
+  afterCopy.ClearExtension(ProxyState::property);
+  return beforeCopy.SerializeAsString() == afterCopy.SerializeAsString();
+}
+}
+
 vtkStandardNewMacro(vtkSMRemoteObjectUpdateUndoElement);
 vtkSetObjectImplementationMacro(
   vtkSMRemoteObjectUpdateUndoElement, ProxyLocator, vtkSMProxyLocator);
@@ -33,6 +104,7 @@ vtkSetObjectImplementationMacro(
 vtkSMRemoteObjectUpdateUndoElement::vtkSMRemoteObjectUpdateUndoElement()
 {
   this->ProxyLocator = NULL;
+  this->GlobalId = 0;
   this->AfterState = new vtkSMMessage();
   this->BeforeState = new vtkSMMessage();
 }
@@ -53,6 +125,7 @@ void vtkSMRemoteObjectUpdateUndoElement::PrintSelf(ostream& os, vtkIndent indent
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "GlobalId: " << this->GetGlobalId() << endl;
+  os << indent << "Compacted: " << this->IsCompacted() << endl;
   os << indent << "Before state: " << endl;
   if (this->BeforeState)
     this->BeforeState->PrintDebugString();
@@ -63,12 +136,14 @@ void vtkSMRemoteObjectUpdateUndoElement::PrintSelf(ostream& os, vtkIndent indent
 //-----------------------------------------------------------------------------
 int vtkSMRemoteObjectUpdateUndoElement::Undo()
 {
+  this->Expand();
   return this->UpdateState(this->BeforeState);
 }
 
 //-----------------------------------------------------------------------------
 int vtkSMRemoteObjectUpdateUndoElement::Redo()
 {
+  this->Expand();
   return this->UpdateState(this->AfterState);
 }
 
@@ -105,6 +180,7 @@ int vtkSMRemoteObjectUpdateUndoElement::UpdateState(const vtkSMMessage* state)
 void vtkSMRemoteObjectUpdateUndoElement::SetUndoRedoState(
   const vtkSMMessage* before, const vtkSMMessage* after)
 {
+  this->CompactedState.clear();
   this->BeforeState->Clear();
   this->AfterState->Clear();
   if (before && after)
@@ -121,5 +197,123 @@ void vtkSMRemoteObjectUpdateUndoElement::SetUndoRedoState(
 //-----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMRemoteObjectUpdateUndoElement::GetGlobalId()
 {
-  return this->BeforeState->global_id();
+  return this->IsCompacted() ? this->GlobalId : this->BeforeState->global_id();
+}
+
+//-----------------------------------------------------------------------------
+// The compacted state is the size of the uncompressed data followed by the
+// zlib compressed data, which is:
+//   after state           serialized message
+//   before state mode     1 byte
+//   before state          for mode 0, the serialized message. For mode 1, the
+//                         number of properties that differ from the after
+//                         state followed by their index and serialized value.
+// Integers are 4 bytes little endian and serialized messages are preceded by
+// their size.
+void vtkSMRemoteObjectUpdateUndoElement::Compact()
+{
+  if (this->IsCompacted())
+  {
+    return;
+  }
+
+  std::string raw;
+  AppendBytes(raw, this->AfterState->SerializeAsString());
+  if (HaveSameLayout(*this->BeforeState, *this->AfterState))
+  {
+    std::string changes;
+    vtkTypeUInt32 numberOfChanges = 0;
+    int numberOfProperties = this->BeforeState->ExtensionSize(ProxyState::property);
+    for (int cc = 0; cc < numberOfProperties; ++cc)
+    {
+      std::string value =
+        this->BeforeState->GetExtension(ProxyState::property, cc).SerializeAsString();
+      if (value != this->AfterState->GetExtension(ProxyState::property, cc).SerializeAsString())
+      {
+        AppendUInt32(changes, static_cast<vtkTypeUInt32>(cc));
+        AppendBytes(changes, value);
+        ++numberOfChanges;
+      }
+    }
+    raw.push_back(1);
+    AppendUInt32(raw, numberOfChanges);
+    raw.append(changes);
+  }
+  else
+  {
+    raw.push_back(0);
+    AppendBytes(raw, this->BeforeState->SerializeAsString());
+  }
+
+  uLongf compressedSize = compressBound(static_cast<uLong>(raw.size()));
+  std::string compressed(compressedSize, '\0');
+  if (compress2(reinterpret_cast<Bytef*>(&compressed[0]), &compressedSize,
+        reinterpret_cast<const Bytef*>(raw.data()), static_cast<uLong>(raw.size()),
+        Z_DEFAULT_COMPRESSION) != Z_OK)
+  {
+    vtkWarningMacro("Failed to compress the undo element state.");
+    return;
+  }
+
+  this->GlobalId = this->BeforeState->global_id();
+  this->CompactedState.clear();
+  AppendUInt32(this->CompactedState, static_cast<vtkTypeUInt32>(raw.size()));
+  this->CompactedState.append(compressed, 0, compressedSize);
+  this->BeforeState->Clear();
+  this->AfterState->Clear();
+}
+
+//-----------------------------------------------------------------------------
+void vtkSMRemoteObjectUpdateUndoElement::Expand()
+{
+  if (!this->IsCompacted())
+  {
+    return;
+  }
+
+  size_t pos = 0;
+  vtkTypeUInt32 rawSize = 0;
+  ReadUInt32(this->CompactedState, pos, rawSize);
+  std::string raw(rawSize, '\0');
+  uLongf size = rawSize;
+  bool valid = uncompress(reinterpret_cast<Bytef*>(&raw[0]), &size,
+                 reinterpret_cast<const Bytef*>(this->CompactedState.data() + pos),
+                 static_cast<uLong>(this->CompactedState.size() - pos)) == Z_OK &&
+    size == rawSize;
+  this->CompactedState.clear();
+
+  std::string bytes;
+  pos = 0;
+  valid = valid && ReadBytes(raw, pos, bytes) && this->AfterState->ParseFromString(bytes) &&
+    pos < raw.size();
+  if (valid && raw[pos++] == 0)
+  {
+    valid = ReadBytes(raw, pos, bytes) && this->BeforeState->ParseFromString(bytes);
+  }
+  else if (valid)
+  {
+    this->BeforeState->CopyFrom(*this->AfterState);
+    vtkTypeUInt32 numberOfChanges = 0, index = 0;
+    valid = ReadUInt32(raw, pos, numberOfChanges);
+    for (vtkTypeUInt32 cc = 0; valid && cc < numberOfChanges; ++cc)
+    {
+      valid = ReadUInt32(raw, pos, index) &&
+        static_cast<int>(index) < this->BeforeState->ExtensionSize(ProxyState::property) &&
+        ReadBytes(raw, pos, bytes) &&
+        this->BeforeState->MutableExtension(ProxyState::property, index)->ParseFromString(bytes);
+    }
+  }
+  if (!valid)
+  {
+    vtkErrorMacro("Failed to restore the undo element state.");
+    this->BeforeState->Clear();
+    this->AfterState->Clear();
+  }
+}
+
+//-----------------------------------------------------------------------------
+size_t vtkSMRemoteObjectUpdateUndoElement::GetMemorySize()
+{
+  return sizeof(*this) + this->CompactedState.capacity() + this->BeforeState->SpaceUsed() +
+    this->AfterState->SpaceUsed();
 }
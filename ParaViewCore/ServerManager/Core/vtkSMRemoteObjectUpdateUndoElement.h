@@ -19,6 +19,10 @@
  * This class keeps the before and after state of the RemoteObject in the
  * vtkSMMessage form. It works with any proxy and RemoteObject. It is a very
  * generic undoElement.
+ *
+ * To reduce the memory used by long undo stacks, the states can be compacted
+ * (see Compact()): the before state is then only stored as the properties
+ * that differ from the after state, and both are serialized and compressed.
 */
 
 #ifndef vtkSMRemoteObjectUpdateUndoElement_h
@@ -29,6 +33,8 @@
 #include "vtkSMUndoElement.h"
 #include "vtkWeakPointer.h" //  needed for vtkWeakPointer.
 
+#include <string> // needed for std::string.
+
 class vtkSMProxyLocator;
 
 class VTKPVSERVERMANAGERCORE_EXPORT vtkSMRemoteObjectUpdateUndoElement : public vtkSMUndoElement
@@ -60,12 +66,29 @@ public:
    */
   virtual void SetUndoRedoState(const vtkSMMessage* before, const vtkSMMessage* after);
 
-  // Current full state of the UndoElement
+  // Current full state of the UndoElement. Both are empty while the element
+  // is compacted.
   vtkSMMessage* BeforeState;
   vtkSMMessage* AfterState;
 
   virtual vtkTypeUInt32 GetGlobalId();
 
+  //@{
+  /**
+   * Compact() replaces BeforeState and AfterState by a compressed
+   * representation of the states and Expand() restores them. Undo() and
+   * Redo() expand the element as needed.
+   */
+  void Compact();
+  void Expand();
+  bool IsCompacted() { return !this->CompactedState.empty(); }
+  //@}
+
+  /**
+   * Returns an estimate of the memory used by the element, in bytes.
+   */
+  size_t GetMemorySize();
+
 protected:
   vtkSMRemoteObjectUpdateUndoElement();
   ~vtkSMRemoteObjectUpdateUndoElement();
@@ -75,6 +98,9 @@ protected:
 
   vtkSMProxyLocator* ProxyLocator;
 
+  vtkTypeUInt32 GlobalId;
+  std::string CompactedState;
+
 private:
   vtkSMRemoteObjectUpdateUndoElement(const vtkSMRemoteObjectUpdateUndoElement&) VTK_DELETE_FUNCTION;
   void operator=(const vtkSMRemoteObjectUpdateUndoElement&) VTK_DELETE_FUNCTION;
@@ -165,6 +165,26 @@ public:
   // Called before application quit or session disconnection
   virtual void PreDisconnection() {}
 
+  //---------------------------------------------------------------------------
+  // API for message batching
+  //---------------------------------------------------------------------------
+
+  //@{
+  /**
+   * Messages sent to the server between StartBatch() and EndBatch() may be
+   * coalesced and sent together at the next synchronization point, or when
+   * the outermost EndBatch() is called. Calls can be nested. Only remote
+   * sessions (see vtkSMSessionClient) do something here.
+   */
+  virtual void StartBatch() {}
+  virtual void EndBatch() {}
+  //@}
+
+  /**
+   * Sends all pending batched messages to the server.
+   */
+  virtual void FlushMessages() {}
+
   //---------------------------------------------------------------------------
   // Static methods to create and register sessions easily.
   //---------------------------------------------------------------------------
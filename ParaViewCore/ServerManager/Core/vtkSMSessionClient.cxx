@@ -45,6 +45,7 @@
 #include <string>
 #include <vtksys/RegularExpression.hxx>
 
+#include <algorithm>
 #include <assert.h>
 #include <set>
 
@@ -60,6 +61,42 @@ void RMICallback(
   self->OnServerNotificationMessageRMI(remoteArg, remoteArgLength);
 }
 };
+
+//****************************************************************************/
+// Messages queued for a server process while batching. Each message is the
+// raw data of the vtkMultiProcessStream that would have been sent with
+// CLIENT_SERVER_MESSAGE_RMI, followed by its payload (EXECUTE_STREAM only).
+class vtkSMSessionClient::vtkMessageBatch
+{
+public:
+  // (message length, payload length) pairs.
+  std::vector<int> Lengths;
+  std::vector<bool> HasPayload;
+  std::vector<unsigned char> Data;
+
+  int GetNumberOfMessages() const { return static_cast<int>(this->HasPayload.size()); }
+
+  void Append(const std::vector<unsigned char>& message, const unsigned char* payload,
+    size_t payloadSize, bool hasPayload)
+  {
+    this->Lengths.push_back(static_cast<int>(message.size()));
+    this->Lengths.push_back(static_cast<int>(payloadSize));
+    this->HasPayload.push_back(hasPayload);
+    this->Data.insert(this->Data.end(), message.begin(), message.end());
+    if (payloadSize > 0)
+    {
+      this->Data.insert(this->Data.end(), payload, payload + payloadSize);
+    }
+  }
+
+  void Clear()
+  {
+    this->Lengths.clear();
+    this->HasPayload.clear();
+    this->Data.clear();
+  }
+};
+
 //****************************************************************************/
 vtkStandardNewMacro(vtkSMSessionClient);
 vtkCxxSetObjectMacro(vtkSMSessionClient, RenderServerController, vtkMultiProcessController);
@@ -91,6 +128,13 @@ vtkSMSessionClient::vtkSMSessionClient()
   // Default value
   this->NoMoreDelete = false;
   this->NotBusy = 0;
+
+  this->BatchMessages = true;
+  this->MaximumBatchSize = 1024;
+  this->BatchDepth = 0;
+  this->Batches[0] = new vtkMessageBatch();
+  this->Batches[1] = new vtkMessageBatch();
+  this->ResetStatistics();
 }
 
 //----------------------------------------------------------------------------
@@ -119,6 +163,8 @@ vtkSMSessionClient::~vtkSMSessionClient()
 
   delete this->ServerLastInvokeResult;
   this->ServerLastInvokeResult = NULL;
+  delete this->Batches[0];
+  delete this->Batches[1];
 }
 
 //----------------------------------------------------------------------------
@@ -441,6 +487,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->FlushMessages();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -459,6 +506,7 @@ void vtkSMSessionClient::CloseSession()
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PreDisconnection()
 {
+  this->FlushMessages();
   this->NoMoreDelete = true;
 }
 
@@ -511,11 +559,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
     stream << message->SerializeAsString();
     std::vector<unsigned char> raw_message;
     stream.GetRawData(raw_message);
-    for (int cc = 0; cc < num_controllers; cc++)
-    {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-    }
+    this->SendMessage(controllers, num_controllers, raw_message);
   }
 
   if ((location & vtkPVSession::CLIENT) != 0)
@@ -551,8 +595,9 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
         stream << msg.SerializeAsString();
         std::vector<unsigned char> raw_message;
         stream.GetRawData(raw_message);
-        this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        // Queued with the other messages so that it does not overtake them.
+        vtkMultiProcessController* dataServer = this->DataServerController;
+        this->SendMessage(&dataServer, 1, raw_message);
       }
       else if (!remoteObject)
       {
@@ -600,6 +645,9 @@ void vtkSMSessionClient::PullState(vtkSMMessage* message)
 
   if (controller)
   {
+    this->FlushMessages();
+    this->NumberOfRoundTrips++;
+
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::PULL);
     stream << message->SerializeAsString();
@@ -657,18 +705,14 @@ void vtkSMSessionClient::ExecuteStream(
            << static_cast<int>(ignore_errors) << static_cast<int>(size);
     std::vector<unsigned char> raw_message;
     stream.GetRawData(raw_message);
-
-    for (int cc = 0; cc < num_controllers; cc++)
-    {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-      controllers[cc]->Send(
-        data, static_cast<int>(size), 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
-    }
+    this->SendMessage(controllers, num_controllers, raw_message, data, size, true);
   }
 
   if ((location & vtkPVSession::CLIENT) != 0)
   {
+    // The local execution may need to communicate with the servers (e.g.
+    // rendering or data delivery), hence the servers must have caught up.
+    this->FlushMessages();
     this->Superclass::ExecuteStream(location, cssstream, ignore_errors);
   }
 }
@@ -696,6 +740,8 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 
   if (controller)
   {
+    this->FlushMessages();
+    this->NumberOfRoundTrips++;
     this->ServerLastInvokeResult->Reset();
 
     vtkMultiProcessStream stream;
@@ -776,6 +822,8 @@ bool vtkSMSessionClient::GatherInformation(
 
   if (controller)
   {
+    this->FlushMessages();
+    this->NumberOfRoundTrips++;
     controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
       vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
 
@@ -844,11 +892,7 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
     stream << message->SerializeAsString();
     std::vector<unsigned char> raw_message;
     stream.GetRawData(raw_message);
-    for (int cc = 0; cc < num_controllers; cc++)
-    {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-    }
+    this->SendMessage(controllers, num_controllers, raw_message);
   }
 
   if ((location & vtkPVSession::CLIENT) != 0)
@@ -885,14 +929,7 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
     stream << message->SerializeAsString();
     std::vector<unsigned char> raw_message;
     stream.GetRawData(raw_message);
-    for (int cc = 0; cc < num_controllers; cc++)
-    {
-      if (controllers[cc] != NULL)
-      {
-        controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-      }
-    }
+    this->SendMessage(controllers, num_controllers, raw_message);
   }
 
   if ((location & vtkPVSession::CLIENT) != 0)
@@ -905,6 +942,132 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
 void vtkSMSessionClient::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "BatchMessages: " << this->BatchMessages << endl;
+  os << indent << "MaximumBatchSize: " << this->MaximumBatchSize << endl;
+  os << indent << "NumberOfMessagesSent: " << this->NumberOfMessagesSent << endl;
+  os << indent << "NumberOfBatches: " << this->NumberOfBatches << endl;
+  os << indent << "NumberOfBatchedMessages: " << this->NumberOfBatchedMessages << endl;
+  os << indent << "LargestBatchSize: " << this->LargestBatchSize << endl;
+  os << indent << "NumberOfRoundTrips: " << this->NumberOfRoundTrips << endl;
+  os << indent << "NumberOfNotificationsReceived: " << this->NumberOfNotificationsReceived << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::ResetStatistics()
+{
+  this->NumberOfMessagesSent = 0;
+  this->NumberOfBatches = 0;
+  this->NumberOfBatchedMessages = 0;
+  this->LargestBatchSize = 0;
+  this->NumberOfRoundTrips = 0;
+  this->NumberOfNotificationsReceived = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::StartBatch()
+{
+  ++this->BatchDepth;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::EndBatch()
+{
+  if (this->BatchDepth > 0 && --this->BatchDepth == 0)
+  {
+    this->FlushMessages();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SendMessage(vtkMultiProcessController** controllers,
+  int num_controllers, std::vector<unsigned char>& message, const unsigned char* payload,
+  size_t payloadSize, bool hasPayload)
+{
+  bool queue = this->BatchMessages && this->BatchDepth > 0;
+  if (!queue)
+  {
+    // Batching may have been disabled while messages were queued.
+    this->FlushMessages();
+  }
+
+  for (int cc = 0; cc < num_controllers; cc++)
+  {
+    vtkMultiProcessController* controller = controllers[cc];
+    if (controller == NULL)
+    {
+      continue;
+    }
+    if (!queue)
+    {
+      controller->TriggerRMIOnAllChildren(&message[0], static_cast<int>(message.size()),
+        vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      if (hasPayload)
+      {
+        controller->Send(
+          payload, static_cast<int>(payloadSize), 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      }
+      this->NumberOfMessagesSent++;
+      continue;
+    }
+
+    vtkMessageBatch* batch = this->Batches[controller == this->DataServerController ? 0 : 1];
+    batch->Append(message, payload, payloadSize, hasPayload);
+    if (batch->GetNumberOfMessages() >= this->MaximumBatchSize)
+    {
+      this->FlushMessages();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushMessages()
+{
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  for (int cc = 0; cc < 2; cc++)
+  {
+    vtkMessageBatch* batch = this->Batches[cc];
+    int count = batch->GetNumberOfMessages();
+    vtkMultiProcessController* controller = controllers[cc];
+    if (count == 0 || controller == NULL)
+    {
+      batch->Clear();
+      continue;
+    }
+
+    if (count == 1)
+    {
+      // Not worth the batch header, send the message as is.
+      controller->TriggerRMIOnAllChildren(
+        &batch->Data[0], batch->Lengths[0], vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      if (batch->HasPayload[0])
+      {
+        controller->Send(&batch->Data[0] + batch->Lengths[0], batch->Lengths[1], 1,
+          vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      }
+    }
+    else
+    {
+      vtkMultiProcessStream stream;
+      stream << static_cast<int>(vtkPVSessionServer::BATCH) << count;
+      for (size_t kk = 0; kk < batch->Lengths.size(); kk++)
+      {
+        stream << batch->Lengths[kk];
+      }
+      std::vector<unsigned char> raw_message;
+      stream.GetRawData(raw_message);
+      controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
+        vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      controller->Send(&batch->Data[0], static_cast<vtkIdType>(batch->Data.size()), 1,
+        vtkPVSessionServer::BATCH_TAG);
+
+      this->NumberOfBatches++;
+      this->NumberOfBatchedMessages += count;
+      this->LargestBatchSize = std::max(this->LargestBatchSize, static_cast<vtkIdType>(count));
+    }
+    this->NumberOfMessagesSent++;
+    batch->Clear();
+  }
 }
 //----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMSessionClient::GetNextGlobalUniqueIdentifier()
@@ -931,6 +1094,8 @@ vtkTypeUInt32 vtkSMSessionClient::GetNextChunkGlobalUniqueIdentifier(vtkTypeUInt
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::OnServerNotificationMessageRMI(void* message, int message_length)
 {
+  this->NumberOfNotificationsReceived++;
+
   // Setup load state context
   std::string data;
   data.append(reinterpret_cast<char*>(message), message_length);
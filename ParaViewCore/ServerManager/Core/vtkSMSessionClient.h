@@ -26,6 +26,8 @@
 #include "vtkPVServerManagerCoreModule.h" //needed for exports
 #include "vtkSMSession.h"
 
+#include <vector> // needed for std::vector
+
 class vtkMultiProcessController;
 class vtkPVServerInformation;
 class vtkSMCollaborationManager;
@@ -199,6 +201,64 @@ public:
    */
   virtual vtkTypeUInt32 GetNextChunkGlobalUniqueIdentifier(vtkTypeUInt32 chunkSize) VTK_OVERRIDE;
 
+  //---------------------------------------------------------------------------
+  // API for message batching
+  //---------------------------------------------------------------------------
+
+  //@{
+  /**
+   * Between StartBatch() and EndBatch(), PushState(), ExecuteStream(),
+   * RegisterSIObject() and UnRegisterSIObject() messages targeting only the
+   * server processes are queued and sent to each server as a single message
+   * when a synchronization point is reached i.e. PullState(),
+   * GatherInformation(), GetLastResult(), an ExecuteStream() that is also
+   * executed on the client (such as a render), the outermost EndBatch() or
+   * when the queue reaches MaximumBatchSize messages.
+   */
+  virtual void StartBatch() VTK_OVERRIDE;
+  virtual void EndBatch() VTK_OVERRIDE;
+  virtual void FlushMessages() VTK_OVERRIDE;
+  //@}
+
+  //@{
+  /**
+   * Enable/disable message batching. When disabled, StartBatch() and
+   * EndBatch() have no effect. Enabled by default.
+   */
+  vtkSetMacro(BatchMessages, bool);
+  vtkGetMacro(BatchMessages, bool);
+  vtkBooleanMacro(BatchMessages, bool);
+  //@}
+
+  //@{
+  /**
+   * Maximum number of messages queued for a server before they are flushed.
+   * Default is 1024.
+   */
+  vtkSetClampMacro(MaximumBatchSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumBatchSize, int);
+  //@}
+
+  //@{
+  /**
+   * Session statistics. NumberOfMessagesSent is the number of messages
+   * (including batches) actually sent to the server processes,
+   * NumberOfBatchedMessages the number of messages that were sent as part of
+   * a batch of NumberOfBatches batches, LargestBatchSize the largest number of
+   * messages in a batch, NumberOfRoundTrips the number of requests that
+   * blocked waiting for a server reply and NumberOfNotificationsReceived the
+   * number of notifications received from the server, in a multi-clients
+   * session.
+   */
+  vtkGetMacro(NumberOfMessagesSent, vtkIdType);
+  vtkGetMacro(NumberOfBatches, vtkIdType);
+  vtkGetMacro(NumberOfBatchedMessages, vtkIdType);
+  vtkGetMacro(LargestBatchSize, vtkIdType);
+  vtkGetMacro(NumberOfRoundTrips, vtkIdType);
+  vtkGetMacro(NumberOfNotificationsReceived, vtkIdType);
+  void ResetStatistics();
+  //@}
+
   void OnServerNotificationMessageRMI(void* message, int message_length);
 
 protected:
@@ -261,6 +321,25 @@ protected:
    */
   virtual void OnConnectionLost(vtkObject* caller, unsigned long eventid, void* calldata);
 
+  /**
+   * Sends a message to the given controllers or queues it if batching is
+   * active. \c payload is sent after the message using EXECUTE_STREAM_TAG
+   * when \c hasPayload is true.
+   */
+  void SendMessage(vtkMultiProcessController** controllers, int num_controllers,
+    std::vector<unsigned char>& message, const unsigned char* payload = NULL,
+    size_t payloadSize = 0, bool hasPayload = false);
+
+  bool BatchMessages;
+  int MaximumBatchSize;
+  int BatchDepth;
+  vtkIdType NumberOfMessagesSent;
+  vtkIdType NumberOfBatches;
+  vtkIdType NumberOfBatchedMessages;
+  vtkIdType LargestBatchSize;
+  vtkIdType NumberOfRoundTrips;
+  vtkIdType NumberOfNotificationsReceived;
+
 private:
   vtkSMSessionClient(const vtkSMSessionClient&) VTK_DELETE_FUNCTION;
   void operator=(const vtkSMSessionClient&) VTK_DELETE_FUNCTION;
@@ -268,6 +347,9 @@ private:
   int NotBusy;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
+
+  class vtkMessageBatch;
+  vtkMessageBatch* Batches[2];
 };
 
 #endif
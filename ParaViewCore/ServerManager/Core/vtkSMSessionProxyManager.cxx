@@ -22,6 +22,7 @@
 #include "vtkPVConfig.h" // for PARAVIEW_VERSION_*
 #include "vtkPVInstantiator.h"
 #include "vtkPVProxyDefinitionIterator.h"
+#include "vtkPVXMLBinarySerializer.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
 #include "vtkProcessModule.h"
@@ -41,6 +42,7 @@
 #include "vtkSMProxyProperty.h"
 #include "vtkSMProxySelectionModel.h"
 #include "vtkSMSessionClient.h"
+#include "vtkSMSourceProxy.h"
 #include "vtkSMStateLoader.h"
 #include "vtkSMStateLocator.h"
 #include "vtkSMUndoStack.h"
@@ -135,6 +137,7 @@ vtkSMSessionProxyManager::vtkSMSessionProxyManager(vtkSMSession* session)
   this->UpdateInputProxies = 0;
   this->Internals = new vtkSMSessionProxyManagerInternals;
   this->Internals->ProxyManager = this;
+  this->Internals->DeferDomainUpdatesCount = 0;
 
   this->Observer = vtkSMProxyManagerObserver::New();
   this->Observer->SetTarget(this);
@@ -859,6 +862,9 @@ void vtkSMSessionProxyManager::RegisterProxy(
 void vtkSMSessionProxyManager::UpdateRegisteredProxies(
   const char* groupname, int modified_only /*=1*/)
 {
+  // The pipeline information of the sources is updated at once, after all
+  // proxies were updated.
+  vtkNew<vtkCollection> sources;
   vtkSMSessionProxyManagerInternals::ProxyGroupType::iterator it =
     this->Internals->RegisteredProxyMap.find(groupname);
   if (it != this->Internals->RegisteredProxyMap.end())
@@ -874,12 +880,21 @@ void vtkSMSessionProxyManager::UpdateRegisteredProxies(
           this->Internals->ModifiedProxies.find(it3->GetPointer()->Proxy.GetPointer()) !=
             this->Internals->ModifiedProxies.end())
         {
-          it3->GetPointer()->Proxy.GetPointer()->UpdateVTKObjects();
-          it3->GetPointer()->Proxy.GetPointer()->UpdatePipelineInformation();
+          vtkSMProxy* proxy = it3->GetPointer()->Proxy.GetPointer();
+          proxy->UpdateVTKObjects();
+          if (!vtkSMSourceProxy::SafeDownCast(proxy))
+          {
+            proxy->UpdatePipelineInformation();
+          }
+          else if (!sources->IsItemPresent(proxy))
+          {
+            sources->AddItem(proxy);
+          }
         }
       }
     }
   }
+  vtkSMSourceProxy::UpdatePipelineInformation(sources.GetPointer());
 }
 
 //---------------------------------------------------------------------------
@@ -887,6 +902,9 @@ void vtkSMSessionProxyManager::UpdateRegisteredProxies(int modified_only /*=1*/)
 {
   vtksys::RegularExpression prototypesRe("_prototypes$");
 
+  // The pipeline information of the sources is updated at once, after all
+  // proxies were updated.
+  vtkNew<vtkCollection> sources;
   vtkSMSessionProxyManagerInternals::ProxyGroupType::iterator it =
     this->Internals->RegisteredProxyMap.begin();
   for (; it != this->Internals->RegisteredProxyMap.end(); it++)
@@ -909,12 +927,21 @@ void vtkSMSessionProxyManager::UpdateRegisteredProxies(int modified_only /*=1*/)
           this->Internals->ModifiedProxies.find(it3->GetPointer()->Proxy.GetPointer()) !=
             this->Internals->ModifiedProxies.end())
         {
-          it3->GetPointer()->Proxy.GetPointer()->UpdateVTKObjects();
-          it3->GetPointer()->Proxy.GetPointer()->UpdatePipelineInformation();
+          vtkSMProxy* proxy = it3->GetPointer()->Proxy.GetPointer();
+          proxy->UpdateVTKObjects();
+          if (!vtkSMSourceProxy::SafeDownCast(proxy))
+          {
+            proxy->UpdatePipelineInformation();
+          }
+          else if (!sources->IsItemPresent(proxy))
+          {
+            sources->AddItem(proxy);
+          }
         }
       }
     }
   }
+  vtkSMSourceProxy::UpdatePipelineInformation(sources.GetPointer());
 }
 
 //---------------------------------------------------------------------------
@@ -1152,6 +1179,13 @@ int vtkSMSessionProxyManager::AreProxiesModified()
 void vtkSMSessionProxyManager::LoadXMLState(
   const char* filename, vtkSMStateLoader* loader /*=NULL*/)
 {
+  if (vtkPVXMLBinarySerializer::IsBinary(filename))
+  {
+    vtkSmartPointer<vtkPVXMLElement> root = vtkPVXMLBinarySerializer::Read(filename);
+    this->LoadXMLState(root, loader);
+    return;
+  }
+
   vtkPVXMLParser* parser = vtkPVXMLParser::New();
   parser->SetFileName(filename);
   parser->Parse();
@@ -1179,7 +1213,12 @@ void vtkSMSessionProxyManager::LoadXMLState(
   {
     spLoader = loader;
   }
-  if (spLoader->LoadState(rootElement, keepOriginalIds))
+  // Loading a state pushes the state of every proxy, let the session send
+  // those together.
+  this->GetSession()->StartBatch();
+  bool loaded = spLoader->LoadState(rootElement, keepOriginalIds) != 0;
+  this->GetSession()->EndBatch();
+  if (loaded)
   {
     vtkSMProxyManager::LoadStateInformation info;
     info.RootElement = rootElement;
@@ -1197,6 +1236,14 @@ void vtkSMSessionProxyManager::SaveXMLState(const char* filename)
   rootElement->Delete();
 }
 
+//---------------------------------------------------------------------------
+bool vtkSMSessionProxyManager::SaveBinaryState(const char* filename)
+{
+  vtkSmartPointer<vtkPVXMLElement> rootElement;
+  rootElement.TakeReference(this->SaveXMLState());
+  return vtkPVXMLBinarySerializer::Write(rootElement, filename);
+}
+
 //---------------------------------------------------------------------------
 vtkPVXMLElement* vtkSMSessionProxyManager::SaveXMLState()
 {
@@ -1802,6 +1849,53 @@ void vtkSMSessionProxyManager::TriggerStateUpdate()
   }
 }
 
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::StartDeferDomainUpdates()
+{
+  ++this->Internals->DeferDomainUpdatesCount;
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::EndDeferDomainUpdates()
+{
+  if (this->Internals->DeferDomainUpdatesCount == 0 ||
+    --this->Internals->DeferDomainUpdatesCount > 0)
+  {
+    return;
+  }
+
+  // Updating domains may modify other properties, which are then updated
+  // immediately since we are no longer deferring.
+  std::vector<vtkWeakPointer<vtkSMProperty> > properties;
+  properties.swap(this->Internals->DeferredDomainUpdates);
+  this->Internals->DeferredDomainUpdatesIndex.clear();
+  for (size_t cc = 0; cc < properties.size(); ++cc)
+  {
+    if (vtkSMProperty* property = properties[cc])
+    {
+      property->UpdateDomains();
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+bool vtkSMSessionProxyManager::DeferDomainUpdate(vtkSMProperty* property)
+{
+  if (this->Internals->DeferDomainUpdatesCount == 0)
+  {
+    return false;
+  }
+  std::map<vtkSMProperty*, size_t>& index = this->Internals->DeferredDomainUpdatesIndex;
+  std::map<vtkSMProperty*, size_t>::iterator iter = index.find(property);
+  if (iter == index.end() ||
+    this->Internals->DeferredDomainUpdates[iter->second].GetPointer() != property)
+  {
+    index[property] = this->Internals->DeferredDomainUpdates.size();
+    this->Internals->DeferredDomainUpdates.push_back(property);
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 vtkSMProxy* vtkSMSessionProxyManager::FindProxy(
   const char* reggroup, const char* xmlgroup, const char* xmltype)
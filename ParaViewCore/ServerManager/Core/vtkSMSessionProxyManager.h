@@ -403,6 +403,8 @@ public:
   /**
    * Loads the state of the server manager from XML.
    * If loader is not specified, a vtkSMStateLoader instance is used.
+   * The file may also be a binary state file (see SaveBinaryState()), which
+   * is detected automatically.
    */
   void LoadXMLState(const char* filename, vtkSMStateLoader* loader = NULL);
   void LoadXMLState(
@@ -415,6 +417,14 @@ public:
    */
   void SaveXMLState(const char* filename);
 
+  /**
+   * Save the state of the server manager in a file using the compact binary
+   * format of vtkPVXMLBinarySerializer. This is the same state as saved by
+   * SaveXMLState() but is faster to save and load and smaller for large
+   * states. Returns false on failure.
+   */
+  bool SaveBinaryState(const char* filename);
+
   /**
    * Saves the state of the server manager as XML, and returns the
    * vtkPVXMLElement for the root of the state.
@@ -537,6 +547,26 @@ public:
   void TriggerStateUpdate();
   //@}
 
+  //@{
+  /**
+   * Between StartDeferDomainUpdates() and EndDeferDomainUpdates(),
+   * vtkSMProperty::UpdateDomains() on properties of proxies of this proxy
+   * manager only records the property. The dependent domains of all recorded
+   * properties are updated, once per property, when the outermost
+   * EndDeferDomainUpdates() is called. This is used when loading state to
+   * avoid updating domains after every property set while the proxies they
+   * depend on are still being created. Calls can be nested.
+   */
+  void StartDeferDomainUpdates();
+  void EndDeferDomainUpdates();
+  //@}
+
+  /**
+   * Records that the dependent domains of the property need to be updated.
+   * Returns false, recording nothing, when domain updates are not deferred.
+   */
+  bool DeferDomainUpdate(vtkSMProperty* property);
+
   /**
    * This method returns the full object state that can be used to create that
    * object from scratch.
@@ -24,6 +24,7 @@
 #include "vtkSMLink.h"
 #include "vtkSMMessage.h"
 #include "vtkSMOutputPort.h"
+#include "vtkSMProperty.h"
 #include "vtkSMProxyLocator.h"
 #include "vtkSMProxyManager.h"
 #include "vtkSMProxySelectionModel.h"
@@ -33,6 +34,7 @@
 #include "vtkSMSourceProxy.h"
 #include "vtkSmartPointer.h"
 #include "vtkStdString.h"
+#include "vtkWeakPointer.h"
 
 #include <map>
 #include <set>
@@ -216,6 +218,14 @@ struct vtkSMSessionProxyManagerInternals
   // Keep ref to the proxyManager to access the session
   vtkSMSessionProxyManager* ProxyManager;
 
+  // Properties whose dependent domains need to be updated at the end of
+  // vtkSMSessionProxyManager::EndDeferDomainUpdates().
+  int DeferDomainUpdatesCount;
+  std::vector<vtkWeakPointer<vtkSMProperty> > DeferredDomainUpdates;
+  // Index of each property in DeferredDomainUpdates. The weak pointer is
+  // checked too since a deleted property's address may be reused.
+  std::map<vtkSMProperty*, size_t> DeferredDomainUpdatesIndex;
+
   // Helper methods -----------------------------------------------------------
   void FindProxyTuples(vtkSMProxy* proxy, std::set<vtkSMProxyManagerEntry>& tuplesFounds)
   {
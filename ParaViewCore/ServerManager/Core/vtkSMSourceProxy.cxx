@@ -18,11 +18,13 @@
 #include "vtkCollection.h"
 #include "vtkCommand.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVAlgorithmPortsInformation.h"
 #include "vtkPVArrayInformation.h"
 #include "vtkPVDataInformation.h"
 #include "vtkPVDataSetAttributesInformation.h"
+#include "vtkPVProxyInformation.h"
 #include "vtkPVXMLElement.h"
 #include "vtkProcessModule.h"
 #include "vtkSMDocumentation.h"
@@ -32,6 +34,7 @@
 #include "vtkSMIntVectorProperty.h"
 #include "vtkSMMessage.h"
 #include "vtkSMOutputPort.h"
+#include "vtkSMProxyInternals.h"
 #include "vtkSMProxyLocator.h"
 #include "vtkSMSession.h"
 #include "vtkSMSessionProxyManager.h"
@@ -39,8 +42,11 @@
 #include "vtkSmartPointer.h"
 
 #include <assert.h>
+#include <map>
+#include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #define OUTPUT_PORTNAME_PREFIX "Output-"
@@ -214,6 +220,222 @@ void vtkSMSourceProxy::UpdatePipelineInformation()
   this->InvokeEvent(vtkCommand::UpdateInformationEvent);
   // this->MarkModified(this);
 }
+
+//---------------------------------------------------------------------------
+namespace
+{
+// Adds the information properties of the proxy to the information request.
+// Returns false if it has none.
+bool AddProxyInformationRequest(
+  vtkPVProxyInformation* info, vtkSMProxy* proxy, vtkSMProxyInternals* internals)
+{
+  bool added = false;
+  vtkSMProxyInternals::PropertyInfoMap::iterator it;
+  for (it = internals->Properties.begin(); it != internals->Properties.end(); ++it)
+  {
+    if (it->second.Property->GetInformationOnly())
+    {
+      if (!added)
+      {
+        info->AddProxy(proxy->GetGlobalID(), internals->InformationMTime, false);
+        added = true;
+      }
+      info->AddPropertyName(it->first.c_str());
+    }
+  }
+  return added;
+}
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSourceProxy::AddInformationRequests(
+  vtkSMProxy* proxy, vtkPVProxyInformation* info, vtkCollection* requested)
+{
+  // Same order as UpdatePipelineInformation(): the pipeline information of
+  // the source is updated first, then the information properties of the
+  // subproxies and finally those of the proxy itself.
+  vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(proxy);
+  bool updatePipeline = source && source->ObjectsCreated;
+  if (updatePipeline)
+  {
+    info->AddProxy(proxy->GetGlobalID(), 0, true);
+  }
+  vtkSMProxyInternals::ProxyMap::iterator it = proxy->Internals->SubProxies.begin();
+  for (; it != proxy->Internals->SubProxies.end(); ++it)
+  {
+    vtkSMSourceProxy::AddInformationRequests(it->second.GetPointer(), info, requested);
+  }
+  if (proxy->ObjectsCreated && proxy->Location != 0 &&
+    AddProxyInformationRequest(info, proxy, proxy->Internals))
+  {
+    requested->AddItem(proxy);
+  }
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSourceProxy::AddDataInformationRequests(
+  vtkSMSourceProxy* source, vtkPVProxyInformation* info, vtkCollection* ports)
+{
+  // The data information is only gathered ahead of time when the output is up
+  // to date, otherwise the next update would invalidate it again.
+  if (!source->OutputPortsCreated || source->NeedsUpdate)
+  {
+    return;
+  }
+  vtkSMSourceProxyInternals::VectorOfPorts::iterator it = source->PInternals->OutputPorts.begin();
+  for (; it != source->PInternals->OutputPorts.end(); ++it)
+  {
+    vtkSMOutputPort* port = it->Port.GetPointer();
+    if (port && !port->DataInformationValid && !ports->IsItemPresent(port))
+    {
+      info->AddDataInformation(port->GetSourceProxy()->GetGlobalID(), port->GetPortIndex());
+      ports->AddItem(port);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSourceProxy::UpdatePipelineInformation(vtkCollection* sources)
+{
+  if (!sources)
+  {
+    return;
+  }
+
+  // Proxies are grouped by the session and location the requests are sent
+  // to, keeping their order.
+  typedef std::pair<vtkSMSession*, vtkTypeUInt32> LocationType;
+  std::vector<LocationType> locations;
+  std::map<LocationType, std::vector<vtkSMSourceProxy*> > proxies;
+  for (int cc = 0; cc < sources->GetNumberOfItems(); ++cc)
+  {
+    vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(sources->GetItemAsObject(cc));
+    if (!source)
+    {
+      continue;
+    }
+    source->CreateVTKObjects();
+    if (!source->ObjectsCreated || source->Location == 0 || !source->GetSession())
+    {
+      source->UpdatePipelineInformation();
+      continue;
+    }
+    LocationType location(source->GetSession(), source->Location);
+    if (proxies.find(location) == proxies.end())
+    {
+      locations.push_back(location);
+    }
+    proxies[location].push_back(source);
+  }
+
+  for (size_t cc = 0; cc < locations.size(); ++cc)
+  {
+    const std::vector<vtkSMSourceProxy*>& group = proxies[locations[cc]];
+    vtkNew<vtkPVProxyInformation> info;
+    vtkNew<vtkCollection> requested;
+    for (size_t i = 0; i < group.size(); ++i)
+    {
+      vtkSMSourceProxy::AddInformationRequests(
+        group[i], info.GetPointer(), requested.GetPointer());
+    }
+
+    // Domains of the sources query the data information of their inputs when
+    // the information properties change: gather it in the same request rather
+    // than port by port.
+    vtkNew<vtkCollection> ports;
+    for (size_t i = 0; i < group.size(); ++i)
+    {
+      vtkSMSourceProxy::AddDataInformationRequests(group[i], info.GetPointer(), ports.GetPointer());
+      for (unsigned int j = 0; j < group[i]->GetNumberOfProducers(); ++j)
+      {
+        vtkSMSourceProxy* producer = vtkSMSourceProxy::SafeDownCast(group[i]->GetProducerProxy(j));
+        if (producer && producer->GetSession() == locations[cc].first &&
+          producer->Location == locations[cc].second)
+        {
+          vtkSMSourceProxy::AddDataInformationRequests(
+            producer, info.GetPointer(), ports.GetPointer());
+        }
+      }
+    }
+
+    if (!locations[cc].first->GatherInformation(locations[cc].second, info.GetPointer(), 0))
+    {
+      continue;
+    }
+    for (int i = 0; i < ports->GetNumberOfItems(); ++i)
+    {
+      vtkSMOutputPort* port = vtkSMOutputPort::SafeDownCast(ports->GetItemAsObject(i));
+      vtkPVDataInformation* dataInfo =
+        info->GetDataInformation(port->GetSourceProxy()->GetGlobalID(), port->GetPortIndex());
+      if (dataInfo)
+      {
+        port->DataInformation->DeepCopy(dataInfo);
+        port->DataInformation->SetPortNumber(port->GetPortIndex());
+        port->DataInformationValid = true;
+      }
+    }
+    for (int i = 0; i < requested->GetNumberOfItems(); ++i)
+    {
+      vtkSMProxy* proxy = vtkSMProxy::SafeDownCast(requested->GetItemAsObject(i));
+      if (const vtkSMMessage* state = info->GetState(proxy->GetGlobalID()))
+      {
+        proxy->LoadState(state, proxy->GetSession()->GetProxyLocator());
+      }
+      proxy->Internals->InformationMTime = info->GetMTime(proxy->GetGlobalID());
+    }
+    for (size_t i = 0; i < group.size(); ++i)
+    {
+      group[i]->InvokeEvent(vtkCommand::UpdateInformationEvent);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSourceProxy::UpdateDownstreamPipelineInformation()
+{
+  vtkNew<vtkCollection> sources;
+  sources->AddItem(this);
+  vtkSMSourceProxy::UpdateDownstreamPipelineInformation(sources.GetPointer());
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSourceProxy::UpdateDownstreamPipelineInformation(vtkCollection* roots)
+{
+  if (!roots)
+  {
+    return;
+  }
+
+  // Breadth-first traversal of the consumers connected to the output ports,
+  // skipping sinks such as representations.
+  vtkNew<vtkCollection> sources;
+  std::set<vtkSMProxy*> visited;
+  std::vector<vtkSMSourceProxy*> queue;
+  for (int cc = 0; cc < roots->GetNumberOfItems(); ++cc)
+  {
+    vtkSMSourceProxy* root = vtkSMSourceProxy::SafeDownCast(roots->GetItemAsObject(cc));
+    if (root && visited.insert(root).second)
+    {
+      queue.push_back(root);
+    }
+  }
+  for (size_t cc = 0; cc < queue.size(); ++cc)
+  {
+    vtkSMSourceProxy* source = queue[cc];
+    sources->AddItem(source);
+    for (unsigned int i = 0; i < source->GetNumberOfConsumers(); ++i)
+    {
+      vtkSMSourceProxy* consumer = vtkSMSourceProxy::SafeDownCast(source->GetConsumerProxy(i));
+      if (consumer && consumer->GetNumberOfOutputPorts() > 0 &&
+        vtkSMInputProperty::SafeDownCast(source->GetConsumerProperty(i)) &&
+        visited.insert(consumer).second)
+      {
+        queue.push_back(consumer);
+      }
+    }
+  }
+  vtkSMSourceProxy::UpdatePipelineInformation(sources.GetPointer());
+}
 //---------------------------------------------------------------------------
 int vtkSMSourceProxy::ReadXMLAttributes(vtkSMSessionProxyManager* pm, vtkPVXMLElement* element)
 {
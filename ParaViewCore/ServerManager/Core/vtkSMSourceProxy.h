@@ -36,9 +36,11 @@
 #include "vtkPVServerManagerCoreModule.h" //needed for exports
 #include "vtkSMProxy.h"
 
+class vtkCollection;
 class vtkPVArrayInformation;
 class vtkPVDataInformation;
 class vtkPVDataSetAttributesInformation;
+class vtkPVProxyInformation;
 
 struct vtkSMSourceProxyInternals;
 
@@ -58,6 +60,27 @@ public:
    */
   virtual void UpdatePipelineInformation() VTK_OVERRIDE;
 
+  /**
+   * Same as calling UpdatePipelineInformation() on each vtkSMSourceProxy of
+   * the collection, in order, but with a single request to the server per
+   * session and location. Information properties that did not change on the
+   * server since they were last updated this way are not loaded again.
+   * The invalid data information of the output ports of these sources and of
+   * their inputs, which domains query when the information properties
+   * change, is gathered in the same request when their pipeline is up to
+   * date.
+   */
+  static void UpdatePipelineInformation(vtkCollection* sources);
+
+  //@{
+  /**
+   * Calls UpdatePipelineInformation(vtkCollection*) for this proxy, or the
+   * sources of the collection, and all the filters downstream of them.
+   */
+  void UpdateDownstreamPipelineInformation();
+  static void UpdateDownstreamPipelineInformation(vtkCollection* sources);
+  //@}
+
   /**
    * Calls Update() on all sources. It also creates output ports if
    * they are not already created.
@@ -225,6 +248,22 @@ public:
   virtual void MarkDirty(vtkSMProxy* modifiedProxy) VTK_OVERRIDE;
 
 protected:
+  /**
+   * Used by UpdatePipelineInformation(vtkCollection*) to add the proxy and
+   * its subproxies to the information request. The proxies whose
+   * information properties are requested are added to `requested`.
+   */
+  static void AddInformationRequests(
+    vtkSMProxy* proxy, vtkPVProxyInformation* info, vtkCollection* requested);
+
+  /**
+   * Used by UpdatePipelineInformation(vtkCollection*) to add the output ports
+   * of the source whose data information must be gathered to the information
+   * request and to `ports`.
+   */
+  static void AddDataInformationRequests(
+    vtkSMSourceProxy* source, vtkPVProxyInformation* info, vtkCollection* ports);
+
   vtkSMSourceProxy();
   ~vtkSMSourceProxy();
 
@@ -14,6 +14,8 @@
 =========================================================================*/
 #include "vtkSMStateLoader.h"
 
+#include "vtkCollection.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVInstantiator.h"
 #include "vtkPVXMLElement.h"
@@ -70,6 +72,7 @@ vtkSMStateLoader::vtkSMStateLoader()
   this->Internal = new vtkSMStateLoaderInternals;
   this->ServerManagerStateElement = 0;
   this->KeepIdMapping = 0;
+  this->BulkLoad = true;
   this->ProxyLocator = vtkSMProxyLocator::New();
 }
 
@@ -172,8 +175,11 @@ void vtkSMStateLoader::CreatedNewProxy(vtkTypeUInt32 id, vtkSMProxy* proxy)
   }
 
   // Calling UpdateVTKObjects() will assign the proxy a GlobalId, if needed.
+  // When loading in bulk, the pipeline information is updated once all
+  // proxies have been created (see LoadStateInternal()).
   proxy->UpdateVTKObjects();
-  if (proxy->IsA("vtkSMSourceProxy"))
+  bool bulk = this->BulkLoad && this->Internal->DeferProxyRegistration;
+  if (!bulk && proxy->IsA("vtkSMSourceProxy"))
   {
     vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
   }
@@ -557,9 +563,18 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
   // registered. That way, when properties on TimeKeeper or AnimationScene
   // start getting modified, the proxies they may refer to are already
   // present and registered.
+  // In bulk mode, the state of all these proxies is pushed in one batch and
+  // domain updates are deferred till the pipeline information is available.
+  vtkSMSession* session = this->GetSessionProxyManager()->GetSession();
+  if (this->BulkLoad)
+  {
+    session->StartBatch();
+    this->GetSessionProxyManager()->StartDeferDomainUpdates();
+  }
   std::vector<vtkSmartPointer<vtkPVXMLElement> > deferredCollections;
   this->Internal->DeferProxyRegistration = true;
-  for (i = 0; i < numElems; i++)
+  bool status = true;
+  for (i = 0; status && i < numElems; i++)
   {
     vtkPVXMLElement* currentElement = rootElement->GetNestedElement(i);
     const char* name = currentElement->GetName();
@@ -572,10 +587,33 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
       }
       else if (!this->HandleProxyCollection(currentElement))
       {
-        return 0;
+        status = false;
       }
     }
   }
+  if (this->BulkLoad)
+  {
+    session->EndBatch();
+    // Update the pipeline information of all sources with a single request.
+    vtkNew<vtkCollection> sources;
+    for (vtkSMStateLoaderInternals::ProxyCreationOrderType::const_iterator iter =
+           this->Internal->ProxyCreationOrder.begin();
+         status && iter != this->Internal->ProxyCreationOrder.end(); ++iter)
+    {
+      if (vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(iter->second))
+      {
+        sources->AddItem(source);
+      }
+    }
+    vtkSMSourceProxy::UpdatePipelineInformation(sources.GetPointer());
+    this->GetSessionProxyManager()->EndDeferDomainUpdates();
+  }
+  if (!status)
+  {
+    this->Internal->ProxyCreationOrder.clear();
+    this->Internal->DeferProxyRegistration = false;
+    return 0;
+  }
 
   // Register proxies in order they were created (as that's a good dependency
   // order).
@@ -640,6 +678,7 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
 void vtkSMStateLoader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "BulkLoad: " << this->BulkLoad << endl;
 }
 
 //---------------------------------------------------------------------------
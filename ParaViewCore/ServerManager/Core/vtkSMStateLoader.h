@@ -68,6 +68,20 @@ public:
   vtkBooleanMacro(KeepIdMapping, int);
   //@}
 
+  //@{
+  /**
+   * When set (default), proxies are loaded in bulk: all proxies are created
+   * and their state pushed in a single batch (see vtkSMSession::StartBatch()),
+   * and the pipeline information of source proxies as well as domain updates
+   * are deferred until all proxies have been created, just before the proxies
+   * are registered. Otherwise each proxy updates its pipeline information as
+   * soon as it is created.
+   */
+  vtkSetMacro(BulkLoad, bool);
+  vtkGetMacro(BulkLoad, bool);
+  vtkBooleanMacro(BulkLoad, bool);
+  //@}
+
   //@{
   /**
    * Return an array of ids. The ids are stored in the following order
@@ -165,6 +179,7 @@ protected:
   vtkPVXMLElement* ServerManagerStateElement;
   vtkSMProxyLocator* ProxyLocator;
   int KeepIdMapping;
+  bool BulkLoad;
 
 private:
   vtkSMStateLoader(const vtkSMStateLoader&) VTK_DELETE_FUNCTION;
@@ -33,8 +33,34 @@
 
 #include "vtkNew.h"
 #include <set>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
+namespace
+{
+// Compacts the vtkSMRemoteObjectUpdateUndoElement of the set, if requested,
+// and returns the memory they use.
+vtkTypeInt64 CompactUndoSet(vtkUndoSet* undoSet, bool compact)
+{
+  vtkTypeInt64 size = 0;
+  int max = undoSet->GetNumberOfElements();
+  for (int cc = 0; cc < max; ++cc)
+  {
+    vtkSMRemoteObjectUpdateUndoElement* elem =
+      vtkSMRemoteObjectUpdateUndoElement::SafeDownCast(undoSet->GetElement(cc));
+    if (elem)
+    {
+      if (compact)
+      {
+        elem->Compact();
+      }
+      size += static_cast<vtkTypeInt64>(elem->GetMemorySize());
+    }
+  }
+  return size;
+}
+}
+
 //*****************************************************************************
 class vtkSMUndoStack::vtkInternal
 {
@@ -63,6 +89,7 @@ public:
 
       if (elem)
       {
+        elem->Expand();
         elem->SetProxyLocator(this->UndoSetProxyLocator.GetPointer());
         if (useBeforeState)
         {
@@ -130,6 +157,8 @@ vtkStandardNewMacro(vtkSMUndoStack);
 vtkSMUndoStack::vtkSMUndoStack()
 {
   this->Internal = new vtkInternal();
+  this->MemoryLimit = 64 * 1024 * 1024;
+  this->NumberOfUncompactedSets = 2;
 }
 
 //-----------------------------------------------------------------------------
@@ -143,6 +172,7 @@ vtkSMUndoStack::~vtkSMUndoStack()
 void vtkSMUndoStack::Push(const char* label, vtkUndoSet* changeSet)
 {
   this->Superclass::Push(label, changeSet);
+  this->CompactAndTrim();
   this->InvokeEvent(PushUndoSetEvent, changeSet);
 }
 
@@ -162,6 +192,7 @@ int vtkSMUndoStack::Undo()
 
   int retValue = this->Superclass::Undo();
   this->Internal->Clear();
+  this->CompactAndTrim();
 
   return retValue;
 }
@@ -182,6 +213,7 @@ int vtkSMUndoStack::Redo()
 
   int retValue = this->Superclass::Redo();
   this->Internal->Clear();
+  this->CompactAndTrim();
 
   return retValue;
 }
@@ -196,8 +228,75 @@ void vtkSMUndoStack::FillWithRemoteObjects(vtkUndoSet* undoSet, vtkCollection* c
   this->Internal->FillSessionsRemoteObjects(collection);
 }
 
+//-----------------------------------------------------------------------------
+vtkTypeInt64 vtkSMUndoStack::GetMemorySize()
+{
+  vtkUndoStackInternal* stacks = this->vtkUndoStack::Internal;
+  vtkTypeInt64 size = 0;
+  for (size_t cc = 0; cc < stacks->UndoStack.size(); ++cc)
+  {
+    size += CompactUndoSet(stacks->UndoStack[cc].UndoSet, false);
+  }
+  for (size_t cc = 0; cc < stacks->RedoStack.size(); ++cc)
+  {
+    size += CompactUndoSet(stacks->RedoStack[cc].UndoSet, false);
+  }
+  return size;
+}
+
+//-----------------------------------------------------------------------------
+void vtkSMUndoStack::CompactAndTrim()
+{
+  // The top of the stacks are at the end of the vectors.
+  vtkUndoStackInternal::VectorOfElements& undoStack = this->vtkUndoStack::Internal->UndoStack;
+  vtkUndoStackInternal::VectorOfElements& redoStack = this->vtkUndoStack::Internal->RedoStack;
+  std::vector<vtkTypeInt64> undoSizes(undoStack.size());
+  std::vector<vtkTypeInt64> redoSizes(redoStack.size());
+  vtkTypeInt64 size = 0;
+  for (size_t cc = 0; cc < undoStack.size(); ++cc)
+  {
+    bool compact = cc + static_cast<size_t>(this->NumberOfUncompactedSets) < undoStack.size();
+    undoSizes[cc] = CompactUndoSet(undoStack[cc].UndoSet, compact);
+    size += undoSizes[cc];
+  }
+  for (size_t cc = 0; cc < redoStack.size(); ++cc)
+  {
+    bool compact = cc + static_cast<size_t>(this->NumberOfUncompactedSets) < redoStack.size();
+    redoSizes[cc] = CompactUndoSet(redoStack[cc].UndoSet, compact);
+    size += redoSizes[cc];
+  }
+
+  if (this->MemoryLimit <= 0)
+  {
+    return;
+  }
+  size_t undoRemoved = 0, redoRemoved = 0;
+  for (; size > this->MemoryLimit && undoRemoved + 1 < undoStack.size(); ++undoRemoved)
+  {
+    size -= undoSizes[undoRemoved];
+  }
+  for (; size > this->MemoryLimit && redoRemoved + 1 < redoStack.size(); ++redoRemoved)
+  {
+    size -= redoSizes[redoRemoved];
+  }
+  if (undoRemoved + redoRemoved == 0)
+  {
+    return;
+  }
+
+  undoStack.erase(undoStack.begin(), undoStack.begin() + undoRemoved);
+  redoStack.erase(redoStack.begin(), redoStack.begin() + redoRemoved);
+  for (size_t cc = 0; cc < undoRemoved + redoRemoved; ++cc)
+  {
+    this->InvokeEvent(vtkUndoStack::UndoSetRemovedEvent);
+  }
+  this->Modified();
+}
+
 //-----------------------------------------------------------------------------
 void vtkSMUndoStack::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "MemoryLimit: " << this->MemoryLimit << endl;
+  os << indent << "NumberOfUncompactedSets: " << this->NumberOfUncompactedSets << endl;
 }
@@ -29,6 +29,11 @@
  * server. GUI can use this to push its own changes that is undoable across
  * connections.
  *
+ * To bound the memory used by the stack, the states kept by the
+ * vtkSMRemoteObjectUpdateUndoElement of all but the most recent sets are
+ * compacted (see NumberOfUncompactedSets) and the oldest sets are removed
+ * once the stack uses more than MemoryLimit bytes.
+ *
  * @sa
  * vtkSMUndoStackBuilder
 */
@@ -82,6 +87,34 @@ public:
 
   };
 
+  //@{
+  /**
+   * Get/Set the maximum memory, in bytes, used by the undo and redo sets. When
+   * it is exceeded, the oldest undo sets are removed, then the last redo sets.
+   * The next undo and redo sets are never removed. 0 means no limit.
+   * Default is 64 MiB.
+   */
+  vtkSetMacro(MemoryLimit, vtkTypeInt64);
+  vtkGetMacro(MemoryLimit, vtkTypeInt64);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the number of sets, on top of each of the undo and redo stacks,
+   * whose states are not compacted. Older sets are compacted, which makes
+   * them smaller but slower to undo/redo. Default is 2.
+   */
+  vtkSetClampMacro(NumberOfUncompactedSets, int, 0, 100);
+  vtkGetMacro(NumberOfUncompactedSets, int);
+  //@}
+
+  /**
+   * Returns an estimate of the memory used by the undo and redo sets, in
+   * bytes. Only the states kept by vtkSMRemoteObjectUpdateUndoElement are
+   * accounted for.
+   */
+  vtkTypeInt64 GetMemorySize();
+
 protected:
   vtkSMUndoStack();
   ~vtkSMUndoStack();
@@ -95,6 +128,13 @@ protected:
   // is supposed to happen.
   void FillWithRemoteObjects(vtkUndoSet* undoSet, vtkCollection* collection);
 
+  // Compacts the old sets and removes sets until the memory used by the stack
+  // is within MemoryLimit.
+  void CompactAndTrim();
+
+  vtkTypeInt64 MemoryLimit;
+  int NumberOfUncompactedSets;
+
 private:
   vtkSMUndoStack(const vtkSMUndoStack&) VTK_DELETE_FUNCTION;
   void operator=(const vtkSMUndoStack&) VTK_DELETE_FUNCTION;
@@ -77,3 +77,61 @@ void vtkSMUndoStackTest::StackDepth()
   QCOMPARE(stack->GetStackDepth(), 10);
   stack->Delete();
 }
+
+void vtkSMUndoStackTest::MemoryLimit()
+{
+  vtkSMSession* session = vtkSMSession::New();
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSMProxy* sphere = pxm->NewProxy("sources", "SphereSource");
+  sphere->UpdateVTKObjects();
+
+  vtkSMUndoStack* undoStack = vtkSMUndoStack::New();
+  undoStack->SetNumberOfUncompactedSets(1);
+  vtkSMRemoteObjectUpdateUndoElement* firstElement = NULL;
+  for (int cc = 1; cc <= 3; ++cc)
+  {
+    vtkSMMessage before;
+    before.CopyFrom(*sphere->GetFullState());
+    vtkSMPropertyHelper(sphere, "Radius").Set(cc);
+    sphere->UpdateVTKObjects();
+    vtkSMMessage after;
+    after.CopyFrom(*sphere->GetFullState());
+
+    vtkUndoSet* undoSet = vtkUndoSet::New();
+    vtkSMRemoteObjectUpdateUndoElement* undoElement = vtkSMRemoteObjectUpdateUndoElement::New();
+    undoElement->SetSession(session);
+    undoElement->SetUndoRedoState(&before, &after);
+    undoSet->AddElement(undoElement);
+    if (cc == 1)
+    {
+      firstElement = undoElement;
+    }
+    undoElement->Delete();
+    undoStack->Push("ChangeRadius", undoSet);
+    undoSet->Delete();
+  }
+
+  // Only the most recent set is not compacted.
+  QVERIFY(firstElement->IsCompacted());
+  QVERIFY(undoStack->GetMemorySize() > 0);
+
+  undoStack->Undo();
+  undoStack->Undo();
+  undoStack->Undo();
+  sphere->UpdateVTKObjects();
+  QCOMPARE(vtkSMPropertyHelper(sphere, "Radius").GetAsDouble(), 0.5);
+  undoStack->Redo();
+  sphere->UpdateVTKObjects();
+  QCOMPARE(vtkSMPropertyHelper(sphere, "Radius").GetAsDouble(), 1.0);
+
+  // With a tiny limit, only the next undo and redo sets are kept.
+  undoStack->SetMemoryLimit(1);
+  undoStack->Redo();
+  QCOMPARE(undoStack->GetNumberOfUndoSets(), 1u);
+  QCOMPARE(undoStack->GetNumberOfRedoSets(), 1u);
+
+  undoStack->Delete();
+  sphere->Delete();
+  session->Delete();
+}
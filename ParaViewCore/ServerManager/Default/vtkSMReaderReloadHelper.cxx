@@ -175,7 +175,7 @@ bool vtkSMReaderReloadHelper::ReloadFiles(vtkSMSourceProxy* proxy)
   {
     proxy->RecreateVTKObjects();
   }
-  proxy->UpdatePipelineInformation();
+  proxy->UpdateDownstreamPipelineInformation();
   return true;
 }
 
@@ -208,7 +208,7 @@ bool vtkSMReaderReloadHelper::ExtendFileSeries(vtkSMSourceProxy* proxy)
   {
     svp->SetElements(files);
     proxy->UpdateVTKObjects();
-    proxy->UpdatePipelineInformation();
+    proxy->UpdateDownstreamPipelineInformation();
     return true;
   }
   return false;
@@ -381,6 +381,26 @@ public:
     }
   }
   //-----------------------------------------------------------------
+  bool TriggerRMI2Controller(int controllerId, void* data, int argLength, int tag)
+  {
+    std::vector<Controller>::iterator iter = this->Controllers.begin();
+    for (; iter != this->Controllers.end(); ++iter)
+    {
+      if (iter->Id == controllerId)
+      {
+        vtkSocketCommunicator* comm =
+          vtkSocketCommunicator::SafeDownCast(iter->MultiProcessController->GetCommunicator());
+        if (!comm->GetIsConnected())
+        {
+          return false;
+        }
+        iter->MultiProcessController->TriggerRMI(1, data, argLength, tag);
+        return true;
+      }
+    }
+    return false;
+  }
+  //-----------------------------------------------------------------
   int GetNumberOfControllers() { return static_cast<int>(this->Controllers.size()); }
   //-----------------------------------------------------------------
   int GetControllerId(int idx) { return this->Controllers.at(idx).Id; }
@@ -550,6 +570,12 @@ void vtkCompositeMultiProcessController::TriggerRMI2All(
   this->Internal->TriggerRMI2All(1, data, length, tag, sendToActiveToo);
 }
 //----------------------------------------------------------------------------
+bool vtkCompositeMultiProcessController::TriggerRMI2Controller(
+  int controllerId, void* data, int length, int tag)
+{
+  return this->Internal->TriggerRMI2Controller(controllerId, data, length, tag);
+}
+//----------------------------------------------------------------------------
 int vtkCompositeMultiProcessController::GetActiveControllerID()
 {
   return this->Internal->GetActiveControllerID();
@@ -100,6 +100,12 @@ public:
    */
   virtual void TriggerRMI2All(int remote, void* data, int length, int tag, bool sendToActiveToo);
 
+  /**
+   * Allow server to send data to a single client, given the id of its
+   * controller. Returns false if that client is not connected anymore.
+   */
+  virtual bool TriggerRMI2Controller(int controllerId, void* data, int length, int tag);
+
   //  --------------- vtkMultiProcessController API ----------------------
   // Make sure inner vtkSocketController are initialized
   virtual void Initialize();
@@ -0,0 +1,247 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGenericIOReadBenchmark.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a synthetic GenericIO file with vtkPGenericIOMultiBlockWriter and
+// reads it back with vtkPGenericIOMultiBlockReader, sequentially and with
+// worker threads, checking that both give the same data. Use the --blocks,
+// --points and --variables arguments to use this for benchmarking.
+
+#include <mpi.h>
+
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPGenericIOMultiBlockReader.h"
+#include "vtkPGenericIOMultiBlockWriter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedLongLongArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+float SyntheticValue(int block, vtkIdType point, int variable)
+{
+  return static_cast<float>(block) + 0.25f * static_cast<float>(point % 1024) +
+    static_cast<float>(variable);
+}
+
+std::string VariableName(int variable)
+{
+  std::ostringstream name;
+  name << "v" << variable;
+  return name.str();
+}
+
+vtkSmartPointer<vtkMultiBlockDataSet> CreateSyntheticData(
+  int numberOfBlocks, int numberOfPoints, int numberOfVariables, int rank, int numberOfRanks)
+{
+  vtkSmartPointer<vtkMultiBlockDataSet> data = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  data->SetNumberOfBlocks(numberOfBlocks);
+
+  double zero[3] = { 0.0, 0.0, 0.0 };
+  double one[3] = { 1.0, 1.0, 1.0 };
+  vtkNew<vtkDoubleArray> origin;
+  origin->SetName("genericio_phys_origin");
+  origin->SetNumberOfComponents(3);
+  origin->InsertNextTypedTuple(zero);
+  data->GetFieldData()->AddArray(origin.GetPointer());
+  vtkNew<vtkDoubleArray> scale;
+  scale->SetName("genericio_phys_scale");
+  scale->SetNumberOfComponents(3);
+  scale->InsertNextTypedTuple(one);
+  data->GetFieldData()->AddArray(scale.GetPointer());
+  unsigned long long dims[3] = { 1, 1, static_cast<unsigned long long>(numberOfBlocks) };
+  vtkNew<vtkUnsignedLongLongArray> dimensions;
+  dimensions->SetName("genericio_global_dimensions");
+  dimensions->SetNumberOfComponents(3);
+  dimensions->InsertNextTypedTuple(dims);
+  data->GetFieldData()->AddArray(dimensions.GetPointer());
+
+  for (int block = rank; block < numberOfBlocks; block += numberOfRanks)
+  {
+    vtkNew<vtkUnstructuredGrid> grid;
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(numberOfPoints);
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+      points->SetPoint(i, static_cast<double>(i % 16), static_cast<double>(i % 32), block);
+    }
+    grid->SetPoints(points.GetPointer());
+
+    for (int v = 0; v < numberOfVariables; ++v)
+    {
+      vtkNew<vtkFloatArray> array;
+      array->SetName(VariableName(v).c_str());
+      array->SetNumberOfTuples(numberOfPoints);
+      for (vtkIdType i = 0; i < numberOfPoints; ++i)
+      {
+        array->SetValue(i, SyntheticValue(block, i, v));
+      }
+      grid->GetPointData()->AddArray(array.GetPointer());
+    }
+
+    unsigned long long coords[3] = { 0, 0, static_cast<unsigned long long>(block) };
+    vtkNew<vtkUnsignedLongLongArray> blockCoords;
+    blockCoords->SetName("genericio_block_coords");
+    blockCoords->SetNumberOfComponents(3);
+    blockCoords->InsertNextTypedTuple(coords);
+    grid->GetFieldData()->AddArray(blockCoords.GetPointer());
+
+    data->SetBlock(block, grid.GetPointer());
+  }
+  return data;
+}
+
+bool ReadAndCheck(const std::string& fileName, int numberOfThreads, int numberOfBlocks,
+  int numberOfPoints, int numberOfVariables, double& elapsed)
+{
+  vtkNew<vtkPGenericIOMultiBlockReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetGenericIOType(vtkPGenericIOMultiBlockReader::IOTYPEPOSIX);
+  reader->SetNumberOfReadThreads(numberOfThreads);
+  reader->UpdateInformation();
+  for (int v = 0; v < numberOfVariables; ++v)
+  {
+    reader->SetPointArrayStatus(VariableName(v).c_str(), 1);
+  }
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  reader->Update();
+  timer->StopTimer();
+  elapsed = timer->GetElapsedTime();
+
+  vtkMultiBlockDataSet* output = reader->GetOutput();
+  if (static_cast<int>(output->GetNumberOfBlocks()) != numberOfBlocks)
+  {
+    std::cerr << "Expected " << numberOfBlocks << " blocks, got " << output->GetNumberOfBlocks()
+              << std::endl;
+    return false;
+  }
+  for (int block = 0; block < numberOfBlocks; ++block)
+  {
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(output->GetBlock(block));
+    if (grid == NULL)
+    {
+      continue; // block is read by another process
+    }
+    if (grid->GetNumberOfPoints() != numberOfPoints)
+    {
+      std::cerr << "Block " << block << " has " << grid->GetNumberOfPoints() << " points"
+                << std::endl;
+      return false;
+    }
+    for (int v = 0; v < numberOfVariables; ++v)
+    {
+      vtkDataArray* array = grid->GetPointData()->GetArray(VariableName(v).c_str());
+      if (array == NULL)
+      {
+        std::cerr << "Block " << block << " is missing " << VariableName(v) << std::endl;
+        return false;
+      }
+      for (vtkIdType i = 0; i < numberOfPoints; ++i)
+      {
+        if (array->GetTuple1(i) != SyntheticValue(block, i, v))
+        {
+          std::cerr << "Wrong value for " << VariableName(v) << " in block " << block
+                    << " at point " << i << " with " << numberOfThreads << " threads"
+                    << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+int runGenericIOReadBenchmark(int argc, char* argv[], vtkMultiProcessController* controller)
+{
+  int numberOfBlocks = 8;
+  int numberOfPoints = 1000;
+  int numberOfVariables = 10;
+
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument("--blocks", argT::EQUAL_ARGUMENT, &numberOfBlocks,
+    "Number of blocks in the synthetic file.");
+  arg.AddArgument(
+    "--points", argT::EQUAL_ARGUMENT, &numberOfPoints, "Number of points in each block.");
+  arg.AddArgument("--variables", argT::EQUAL_ARGUMENT, &numberOfVariables,
+    "Number of variables in each block.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse())
+  {
+    std::cerr << "Problem parsing arguments" << std::endl;
+    return 0;
+  }
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestGenericIOReadBenchmark.gio";
+  delete[] tempDir;
+
+  vtkSmartPointer<vtkMultiBlockDataSet> data =
+    CreateSyntheticData(numberOfBlocks, numberOfPoints, numberOfVariables,
+      controller->GetLocalProcessId(), controller->GetNumberOfProcesses());
+  vtkNew<vtkPGenericIOMultiBlockWriter> writer;
+  writer->SetInputData(data);
+  writer->SetFileName(fileName.c_str());
+  writer->Write();
+
+  double sequential = 0.0;
+  double threaded = 0.0;
+  if (!ReadAndCheck(
+        fileName, 1, numberOfBlocks, numberOfPoints, numberOfVariables, sequential) ||
+    !ReadAndCheck(fileName, 0, numberOfBlocks, numberOfPoints, numberOfVariables, threaded))
+  {
+    return 0;
+  }
+
+  if (controller->GetLocalProcessId() == 0)
+  {
+    std::cout << "Read " << numberOfBlocks << " blocks of " << numberOfPoints << " points and "
+              << numberOfVariables << " variables" << std::endl;
+    std::cout << "  sequential: " << sequential << "s" << std::endl;
+    std::cout << "  threaded:   " << threaded << "s" << std::endl;
+  }
+  return 1;
+}
+}
+
+int TestGenericIOReadBenchmark(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize();
+  vtkMultiProcessController::SetGlobalController(controller.GetPointer());
+
+  int retVal = runGenericIOReadBenchmark(argc, argv, controller.GetPointer());
+
+  controller->Finalize();
+  return !retVal;
+}
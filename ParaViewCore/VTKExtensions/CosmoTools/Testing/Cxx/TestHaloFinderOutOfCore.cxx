@@ -0,0 +1,112 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHaloFinderOutOfCore.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include <mpi.h>
+
+#include "HaloFinderTestHelpers.h"
+
+#include "vtkDataArray.h"
+#include "vtkMPIController.h"
+
+namespace
+{
+int runHaloFinderTest(int argc, char* argv[])
+{
+  HaloFinderTestHelpers::HaloFinderTestVTKObjects to =
+    HaloFinderTestHelpers::SetupHaloFinderTest(argc, argv);
+
+  vtkNew<vtkUnstructuredGrid> inCore;
+  inCore->DeepCopy(to.haloFinder->GetOutput(0));
+  vtkNew<vtkUnstructuredGrid> inCoreSummaries;
+  inCoreSummaries->DeepCopy(to.haloFinder->GetOutput(1));
+
+  // A budget of a few hundred particles so that the particles are split in
+  // many slabs, including slabs with neighbors on both sides.
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  to.haloFinder->SetOutOfCore(true);
+  to.haloFinder->SetMemoryBudget(0.02);
+  to.haloFinder->SetScratchDirectory(tempDir);
+  to.haloFinder->Update();
+  delete[] tempDir;
+
+  if (to.haloFinder->GetNumberOfSlabs() < 3)
+  {
+    std::cerr << "Expected several slabs, got " << to.haloFinder->GetNumberOfSlabs() << std::endl;
+    return 0;
+  }
+
+  vtkUnstructuredGrid* outOfCore = to.haloFinder->GetOutput(0);
+  if (!HaloFinderTestHelpers::pointDataHasTheseArrays(
+        outOfCore->GetPointData(), HaloFinderTestHelpers::getFirstOutputArrays()))
+  {
+    std::cerr << "Error at line: " << __LINE__ << std::endl;
+    return 0;
+  }
+  vtkUnstructuredGrid* outOfCoreSummaries = to.haloFinder->GetOutput(1);
+  if (outOfCoreSummaries->GetNumberOfPoints() != inCoreSummaries->GetNumberOfPoints())
+  {
+    std::cerr << "Found " << outOfCoreSummaries->GetNumberOfPoints() << " halos instead of "
+              << inCoreSummaries->GetNumberOfPoints() << std::endl;
+    return 0;
+  }
+  if (outOfCore->GetNumberOfPoints() != inCore->GetNumberOfPoints())
+  {
+    std::cerr << "Error at line: " << __LINE__ << std::endl;
+    return 0;
+  }
+
+  vtkDataArray* inCoreTags = inCore->GetPointData()->GetArray("fof_halo_tag");
+  vtkDataArray* outOfCoreTags = outOfCore->GetPointData()->GetArray("fof_halo_tag");
+  for (vtkIdType i = 0; i < inCore->GetNumberOfPoints(); ++i)
+  {
+    if (inCoreTags->GetTuple1(i) != outOfCoreTags->GetTuple1(i))
+    {
+      std::cerr << "Particle " << i << " is in halo " << outOfCoreTags->GetTuple1(i)
+                << " instead of " << inCoreTags->GetTuple1(i) << std::endl;
+      return 0;
+    }
+  }
+
+  vtkDataArray* inCoreCounts = inCoreSummaries->GetPointData()->GetArray("fof_halo_count");
+  vtkDataArray* outOfCoreCounts = outOfCoreSummaries->GetPointData()->GetArray("fof_halo_count");
+  vtkDataArray* inCoreHaloTags = inCoreSummaries->GetPointData()->GetArray("fof_halo_tag");
+  vtkDataArray* outOfCoreHaloTags = outOfCoreSummaries->GetPointData()->GetArray("fof_halo_tag");
+  for (vtkIdType i = 0; i < inCoreSummaries->GetNumberOfPoints(); ++i)
+  {
+    if (inCoreHaloTags->GetTuple1(i) != outOfCoreHaloTags->GetTuple1(i) ||
+      inCoreCounts->GetTuple1(i) != outOfCoreCounts->GetTuple1(i))
+    {
+      std::cerr << "Halo " << i << " differs from the in-core halo" << std::endl;
+      return 0;
+    }
+  }
+  return 1;
+}
+}
+
+int TestHaloFinderOutOfCore(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize();
+  vtkMultiProcessController::SetGlobalController(controller.GetPointer());
+
+  int retVal = runHaloFinderTest(argc, argv);
+
+  controller->Finalize();
+  return !retVal;
+}
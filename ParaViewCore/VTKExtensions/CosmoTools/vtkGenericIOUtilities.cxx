@@ -13,7 +13,10 @@
 #include "GenericIOPosixReader.h"
 
 // C/C++ includes
+#include <algorithm>
 #include <cassert>
+#include <exception>
+#include <thread>
 
 // MPI
 #include <mpi.h>
@@ -226,6 +229,96 @@ gio::GenericIOReader* GetReader(
   return (reader);
 }
 
+//==============================================================================
+int GetNumberOfReadThreads(int requested, int numberOfVariables)
+{
+  int numberOfThreads =
+    requested > 0 ? requested : static_cast<int>(std::thread::hardware_concurrency());
+  return std::max(std::min(numberOfThreads, numberOfVariables), 1);
+}
+
+//==============================================================================
+void ResizeReaderPool(std::vector<gio::GenericIOReader*>& pool, size_t size, MPI_Comm comm,
+  int distribution, const std::string& fileName)
+{
+  while (pool.size() > size)
+  {
+    pool.back()->Close();
+    delete pool.back();
+    pool.pop_back();
+  }
+  while (pool.size() < size)
+  {
+    gio::GenericIOReader* reader = GetReader(comm, true, distribution, fileName);
+    reader->OpenAndReadHeader();
+    pool.push_back(reader);
+  }
+}
+
+//==============================================================================
+void ClearReaderPool(std::vector<gio::GenericIOReader*>& pool)
+{
+  for (size_t i = 0; i < pool.size(); ++i)
+  {
+    pool[i]->Close();
+    delete pool[i];
+  }
+  pool.clear();
+}
+
+//==============================================================================
+static void ReadVariables(gio::GenericIOReader* reader, int blockId, std::string* error)
+{
+  try
+  {
+    if (blockId < 0)
+    {
+      reader->ReadData();
+    }
+    else
+    {
+      reader->ReadBlock(blockId);
+    }
+  }
+  catch (std::exception& e)
+  {
+    *error = e.what();
+  }
+  catch (...)
+  {
+    *error = "unknown error";
+  }
+}
+
+//==============================================================================
+bool ReadConcurrently(
+  const std::vector<gio::GenericIOReader*>& readers, int blockId, std::string& error)
+{
+  std::vector<std::string> errors(readers.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < readers.size(); ++i)
+  {
+    threads.push_back(std::thread(ReadVariables, readers[i], blockId, &errors[i]));
+  }
+  if (!readers.empty())
+  {
+    ReadVariables(readers[0], blockId, &errors[0]);
+  }
+  for (size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i].join();
+  }
+  for (size_t i = 0; i < errors.size(); ++i)
+  {
+    if (!errors[i].empty())
+    {
+      error = errors[i];
+      return false;
+    }
+  }
+  return true;
+}
+
 //==============================================================================
 gio::GenericIOWriter* GetWriter(MPI_Comm comm, const std::string& fileName)
 {
@@ -28,6 +28,7 @@
 #include <algorithm>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "mpi.h"
 
@@ -124,6 +125,39 @@ gio::GenericIOReader* GetReader(
  */
 gio::GenericIOWriter* GetWriter(MPI_Comm comm, const std::string& fileName);
 
+//==============================================================================
+/**
+ * Returns the number of threads to use to read `numberOfVariables`
+ * variables, given the number of threads requested by the user (0 for one
+ * per hardware thread).
+ */
+int GetNumberOfReadThreads(int requested, int numberOfVariables);
+
+//==============================================================================
+/**
+ * Grows or shrinks the pool of POSIX readers used to read variables
+ * concurrently. New readers are opened and have their header read. This
+ * should be called on the main thread.
+ */
+void ResizeReaderPool(std::vector<gio::GenericIOReader*>& pool, size_t size, MPI_Comm comm,
+  int distribution, const std::string& fileName);
+
+/**
+ * Closes and deletes all the readers of the pool.
+ */
+void ClearReaderPool(std::vector<gio::GenericIOReader*>& pool);
+
+//==============================================================================
+/**
+ * Reads the variables registered with each of the given readers
+ * concurrently, one thread per reader, the first reader on the calling
+ * thread. Reads the block `blockId` when it is not negative, otherwise all
+ * the blocks assigned to this process. Returns false and sets `error` if one
+ * of the reads failed.
+ */
+bool ReadConcurrently(
+  const std::vector<gio::GenericIOReader*>& readers, int blockId, std::string& error);
+
 //==============================================================================
 //@{
 /**
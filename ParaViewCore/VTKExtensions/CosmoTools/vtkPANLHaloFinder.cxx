@@ -16,6 +16,7 @@
 
 #include "vtkCellType.h"
 #include "vtkDataArray.h"
+#include "vtkEquivalenceSet.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkIntArray.h"
@@ -28,6 +29,7 @@
 #include "vtkTypeInt64Array.h"
 #include "vtkUnstructuredGrid.h"
 
+#include "CosmoHaloFinder.h"
 #include "CosmoHaloFinderP.h"
 #include "FOFHaloProperties.h"
 #include "HaloCenterFinder.h"
@@ -36,7 +38,14 @@
 #include "Partition.h"
 #include "SubHaloFinder.h"
 
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
 #include <cassert>
+#include <ctime>
+#include <fstream>
+#include <limits>
+#include <sstream>
 #include <vector>
 
 namespace
@@ -46,6 +55,29 @@ static const double GRAVITY_C = 43.015e-10;
 static const ID_T MBP_THRESHOLD = 100;
 static const ID_T MCP_THRESHOLD = 100;
 
+// Approximate memory used per particle by the out-of-core friends-of-friends
+// pass: the gathered positions, the bounds, k-d tree and halo arrays of
+// cosmotk::CosmoHaloFinder, the index of the particle and the smallest index
+// of its group.
+static const vtkIdType OOC_BYTES_PER_PARTICLE =
+  5 * sizeof(POSVEL_T) + 5 * sizeof(int) + 2 * sizeof(int);
+// Number of bins used to find the bounds of the out-of-core slabs.
+static const int OOC_BINS_PER_SLAB = 64;
+
+// Orders particle indices along x.
+class CompareParticlesAlongX
+{
+public:
+  CompareParticlesAlongX(const std::vector<POSVEL_T>& xx)
+    : XX(xx)
+  {
+  }
+  bool operator()(int a, int b) const { return this->XX[a] < this->XX[b]; }
+
+private:
+  const std::vector<POSVEL_T>& XX;
+};
+
 class ExtractHalo
 {
 public:
@@ -153,10 +185,32 @@ public:
   std::vector<POSVEL_T> fofZVel;
   std::vector<POSVEL_T> fofVelDisp;
 
+  // Halos found on this process, either by haloFinder or by
+  // vtkPANLHaloFinder::ExecuteOutOfCoreFOF().
+  int numberOfHalos;
+  int* halos;
+  int* haloCount;
+  int* haloList;
+
+  // Results of the out-of-core pass, laid out as in CosmoHaloFinderP.
+  // oocHaloTag is the smallest index of the particles in the same group and
+  // oocHaloSize is the size of a group, indexed by its smallest index.
+  int pmin;
+  std::vector<int> oocHaloTag;
+  std::vector<int> oocHaloSize;
+  std::vector<int> oocHalos;
+  std::vector<int> oocHaloCount;
+  std::vector<int> oocHaloList;
+
   vtkInternals()
   {
     this->fof = NULL;
     this->haloFinder = NULL;
+    this->numberOfHalos = 0;
+    this->halos = NULL;
+    this->haloCount = NULL;
+    this->haloList = NULL;
+    this->pmin = 0;
   }
 
   ~vtkInternals()
@@ -184,6 +238,112 @@ public:
       this->tag.resize(numPts);
     }
   }
+  ID_T getHaloID(int i)
+  {
+    if (this->haloFinder)
+    {
+      return this->haloFinder->getHaloID(i);
+    }
+    return this->tag[this->oocHaloTag[this->halos[i]]];
+  }
+
+  ID_T getHaloIDForParticle(vtkIdType p)
+  {
+    if (this->haloFinder)
+    {
+      return this->haloFinder->getHaloIDForParticle(p);
+    }
+    int h = this->oocHaloTag[p];
+    return this->oocHaloSize[h] < this->pmin ? -1 : this->tag[h];
+  }
+
+  // Builds the halos from oocHaloTag following the same rules as
+  // cosmotk::CosmoHaloFinderP::buildHaloStructure() and processMixedHalos():
+  // halos with only alive particles are kept, halos with only dead particles
+  // are left to the neighbors and halos with both are arbitrated.
+  void buildOutOfCoreHalos()
+  {
+    const int numParticles = static_cast<int>(this->xx.size());
+    std::vector<int> aliveSize(numParticles, 0);
+    std::vector<int> start(numParticles, -1);
+    this->oocHaloSize.assign(numParticles, 0);
+    this->oocHaloList.assign(numParticles, -1);
+    for (int p = numParticles - 1; p >= 0; --p)
+    {
+      int h = this->oocHaloTag[p];
+      this->oocHaloSize[h]++;
+      if (this->status[p] == ALIVE)
+      {
+        aliveSize[h]++;
+      }
+      this->oocHaloList[p] = start[h];
+      start[h] = p;
+    }
+
+    this->oocHalos.clear();
+    this->oocHaloCount.clear();
+    std::vector<int> mixedHalos;
+    for (int h = 0; h < numParticles; ++h)
+    {
+      if (this->oocHaloSize[h] < this->pmin || aliveSize[h] == 0)
+      {
+        continue;
+      }
+      if (aliveSize[h] == this->oocHaloSize[h])
+      {
+        this->oocHalos.push_back(start[h]);
+        this->oocHaloCount.push_back(aliveSize[h]);
+      }
+      else
+      {
+        mixedHalos.push_back(h);
+      }
+    }
+
+    int neighbors[NUM_OF_NEIGHBORS];
+    cosmotk::Partition::getNeighbors(neighbors);
+    const int myProc = cosmotk::Partition::getMyProc();
+    const int numProc = cosmotk::Partition::getNumProc();
+    std::vector<vtkTypeInt64> arbiter;
+    for (size_t i = 0; i < mixedHalos.size(); ++i)
+    {
+      int h = mixedHalos[i];
+      bool mine = aliveSize[h] > this->oocHaloSize[h] / 2;
+      if (!mine)
+      {
+        // The process with the most particles of the halo keeps it.
+        int counts[NUM_OF_NEIGHBORS + 1] = { 0 };
+        for (int p = start[h]; p >= 0; p = this->oocHaloList[p])
+        {
+          counts[this->status[p] >= 0 ? this->status[p] : NUM_OF_NEIGHBORS]++;
+        }
+        arbiter.clear();
+        arbiter.push_back(myProc + static_cast<vtkTypeInt64>(numProc) * counts[NUM_OF_NEIGHBORS]);
+        for (int n = 0; n < NUM_OF_NEIGHBORS; ++n)
+        {
+          arbiter.push_back(neighbors[n] + static_cast<vtkTypeInt64>(numProc) * counts[n]);
+        }
+        std::sort(arbiter.begin(), arbiter.end());
+        mine = (arbiter.back() % numProc) == myProc;
+      }
+
+      for (int p = start[h]; p >= 0; p = this->oocHaloList[p])
+      {
+        this->status[p] = mine ? ALIVE : MIXED;
+      }
+      if (mine)
+      {
+        this->oocHalos.push_back(start[h]);
+        this->oocHaloCount.push_back(this->oocHaloSize[h]);
+      }
+    }
+
+    this->numberOfHalos = static_cast<int>(this->oocHalos.size());
+    this->halos = this->oocHalos.empty() ? NULL : &this->oocHalos[0];
+    this->haloCount = this->oocHaloCount.empty() ? NULL : &this->oocHaloCount[0];
+    this->haloList = this->oocHaloList.empty() ? NULL : &this->oocHaloList[0];
+  }
+
   void clear()
   {
     this->xx.clear();
@@ -227,16 +387,27 @@ vtkStandardNewMacro(vtkPANLHaloFinder)
   this->Deut = 0.02258;
   this->Hubble = 0.673;
   this->RedShift = 0.0;
+
+  this->OutOfCore = false;
+  this->MemoryBudget = 1024;
+  this->ScratchDirectory = NULL;
+  this->NumberOfSlabs = 0;
 }
 
 vtkPANLHaloFinder::~vtkPANLHaloFinder()
 {
   delete this->Internal;
+  this->SetScratchDirectory(NULL);
 }
 
 void vtkPANLHaloFinder::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "OutOfCore: " << this->OutOfCore << endl;
+  os << indent << "MemoryBudget: " << this->MemoryBudget << endl;
+  os << indent << "ScratchDirectory: "
+     << (this->ScratchDirectory ? this->ScratchDirectory : "(none)") << endl;
+  os << indent << "NumberOfSlabs: " << this->NumberOfSlabs << endl;
 }
 
 int vtkPANLHaloFinder::RequestInformation(
@@ -367,23 +538,282 @@ void vtkPANLHaloFinder::CreateGhostParticles()
   }
 }
 
+void vtkPANLHaloFinder::ExecuteOutOfCoreFOF()
+{
+  vtkInternals* internal = this->Internal;
+  const vtkIdType numParticles = static_cast<vtkIdType>(internal->xx.size());
+  const POSVEL_T linkingLength = this->BB * this->RL / this->NP;
+  const int myProc = cosmotk::Partition::getMyProc();
+
+  // Split the particles in slabs along x with about the same number of
+  // particles. Half of the budget is left for the particles a slab gathers
+  // from its neighbors.
+  const vtkIdType budget = static_cast<vtkIdType>(this->MemoryBudget * 1024 * 1024);
+  const vtkIdType maxParticles = std::max<vtkIdType>(budget / OOC_BYTES_PER_PARTICLE / 2, 1);
+  const int numberOfSlabs = static_cast<int>(
+    std::max<vtkIdType>((numParticles + maxParticles - 1) / maxParticles, 1));
+
+  std::vector<POSVEL_T> cuts(numberOfSlabs + 1);
+  cuts[0] = -std::numeric_limits<POSVEL_T>::max();
+  cuts[numberOfSlabs] = std::numeric_limits<POSVEL_T>::max();
+  if (numberOfSlabs > 1)
+  {
+    POSVEL_T range[2] = { internal->xx[0], internal->xx[0] };
+    for (vtkIdType i = 1; i < numParticles; ++i)
+    {
+      range[0] = std::min(range[0], internal->xx[i]);
+      range[1] = std::max(range[1], internal->xx[i]);
+    }
+    const int numberOfBins = OOC_BINS_PER_SLAB * numberOfSlabs;
+    const POSVEL_T binWidth = (range[1] - range[0]) / numberOfBins;
+    std::vector<vtkIdType> bins(numberOfBins, 0);
+    for (vtkIdType i = 0; i < numParticles; ++i)
+    {
+      int bin = binWidth > 0 ? static_cast<int>((internal->xx[i] - range[0]) / binWidth) : 0;
+      bins[std::min(bin, numberOfBins - 1)]++;
+    }
+    vtkIdType count = 0;
+    int slab = 1;
+    for (int bin = 0; bin < numberOfBins && slab < numberOfSlabs; ++bin)
+    {
+      count += bins[bin];
+      while (slab < numberOfSlabs && count >= numParticles * slab / numberOfSlabs)
+      {
+        cuts[slab++] = range[0] + (bin + 1) * binWidth;
+      }
+    }
+  }
+
+  this->NumberOfSlabs = numberOfSlabs;
+
+  // Bucket the particles by slab once. Each bucket is sorted along x so that
+  // the particles a slab gathers from its neighbors are at the ends of the
+  // neighboring buckets.
+  std::vector<int> order(numParticles);
+  std::vector<vtkIdType> bucketStart(numberOfSlabs + 1, 0);
+  for (vtkIdType i = 0; i < numParticles; ++i)
+  {
+    int slab = static_cast<int>(
+      std::upper_bound(cuts.begin() + 1, cuts.end() - 1, internal->xx[i]) - (cuts.begin() + 1));
+    bucketStart[slab + 1]++;
+  }
+  for (int slab = 0; slab < numberOfSlabs; ++slab)
+  {
+    bucketStart[slab + 1] += bucketStart[slab];
+  }
+  {
+    std::vector<vtkIdType> next(bucketStart.begin(), bucketStart.end() - 1);
+    for (vtkIdType i = 0; i < numParticles; ++i)
+    {
+      int slab = static_cast<int>(
+        std::upper_bound(cuts.begin() + 1, cuts.end() - 1, internal->xx[i]) - (cuts.begin() + 1));
+      order[next[slab]++] = static_cast<int>(i);
+    }
+  }
+  for (int slab = 0; slab < numberOfSlabs; ++slab)
+  {
+    std::sort(order.begin() + bucketStart[slab], order.begin() + bucketStart[slab + 1],
+      CompareParticlesAlongX(internal->xx));
+  }
+
+  std::ostringstream spillName;
+  spillName << (this->ScratchDirectory && *this->ScratchDirectory ? this->ScratchDirectory : ".")
+            << "/vtkPANLHaloFinder_" << std::time(NULL) << "_" << myProc << "_"
+            << static_cast<void*>(this) << ".fof";
+  std::ofstream spill(spillName.str().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!spill)
+  {
+    vtkErrorMacro("Could not open " << spillName.str() << " for writing.");
+  }
+
+  // Run the serial halo finder on each slab. Particles within the linking
+  // length of a slab are included so that every pair of friends is seen by at
+  // least one slab. A particle is tagged with the smallest index of its group
+  // in its own slab. Groups of different slabs can only be linked through
+  // particles within the linking length of a slab boundary: for these, the
+  // particle and the smallest index of its group are spilled.
+  internal->oocHaloTag.resize(numParticles);
+  for (int slab = 0; slab < numberOfSlabs && spill; ++slab)
+  {
+    const POSVEL_T low = cuts[slab] - linkingLength;
+    const POSVEL_T high = cuts[slab + 1] + linkingLength;
+    std::vector<int> index(
+      order.begin() + bucketStart[slab], order.begin() + bucketStart[slab + 1]);
+    const int numberOfOwned = static_cast<int>(index.size());
+    if (numberOfOwned == 0)
+    {
+      continue;
+    }
+    for (int neighbor = slab - 1; neighbor >= 0; --neighbor)
+    {
+      vtkIdType i = bucketStart[neighbor + 1];
+      while (i > bucketStart[neighbor] && internal->xx[order[i - 1]] >= low)
+      {
+        index.push_back(order[--i]);
+      }
+      if (i > bucketStart[neighbor])
+      {
+        break;
+      }
+    }
+    for (int neighbor = slab + 1; neighbor < numberOfSlabs; ++neighbor)
+    {
+      vtkIdType i = bucketStart[neighbor];
+      while (i < bucketStart[neighbor + 1] && internal->xx[order[i]] <= high)
+      {
+        index.push_back(order[i++]);
+      }
+      if (i < bucketStart[neighbor + 1])
+      {
+        break;
+      }
+    }
+
+    const int slabParticles = static_cast<int>(index.size());
+    std::vector<POSVEL_T> x(slabParticles), y(slabParticles), z(slabParticles);
+    for (int i = 0; i < slabParticles; ++i)
+    {
+      x[i] = internal->xx[index[i]];
+      y[i] = internal->yy[index[i]];
+      z[i] = internal->zz[index[i]];
+    }
+
+    std::vector<int> haloTag(slabParticles);
+    std::vector<int> haloStart(slabParticles);
+    std::vector<int> haloList(slabParticles);
+    cosmotk::CosmoHaloFinder finder;
+    finder.np = this->NP;
+    finder.rL = this->RL;
+    finder.bb = linkingLength;
+    finder.pmin = this->PMin;
+    finder.nmin = this->NMin;
+    finder.periodic = false;
+    finder.textmode = "ascii";
+    finder.setParticleLocations(&x[0], &y[0], &z[0]);
+    finder.setHaloLocations(&haloTag[0], &haloStart[0], &haloList[0]);
+    finder.setNumberOfParticles(slabParticles);
+    finder.setMyProc(myProc);
+    finder.Finding();
+
+    // Smallest index of each group, indexed by the tag of the group.
+    std::vector<int> groupMin(slabParticles, std::numeric_limits<int>::max());
+    for (int i = 0; i < slabParticles; ++i)
+    {
+      groupMin[haloTag[i]] = std::min(groupMin[haloTag[i]], index[i]);
+    }
+
+    std::vector<int> links;
+    for (int i = 0; i < slabParticles; ++i)
+    {
+      const int tag = groupMin[haloTag[i]];
+      const POSVEL_T xi = x[i];
+      if (i < numberOfOwned)
+      {
+        internal->oocHaloTag[index[i]] = tag;
+        if ((slab == 0 || xi >= cuts[slab] + linkingLength) &&
+          (slab == numberOfSlabs - 1 || xi <= cuts[slab + 1] - linkingLength))
+        {
+          continue;
+        }
+      }
+      links.push_back(index[i]);
+      links.push_back(tag);
+    }
+    if (!links.empty())
+    {
+      spill.write(reinterpret_cast<const char*>(&links[0]), links.size() * sizeof(int));
+    }
+  }
+  bool spillFailed = !spill;
+  spill.close();
+  if (spillFailed)
+  {
+    vtkErrorMacro("Could not write the halo links to " << spillName.str() << ".");
+  }
+  std::vector<int>().swap(order);
+
+  // Resolve the groups crossing slab boundaries. The equivalence set only
+  // holds the particles near the boundaries and the smallest indices of their
+  // groups. The smallest index of a group is its tag, as in CosmoHaloFinderP.
+  {
+    std::vector<int> links;
+    std::ifstream linkFile(spillName.str().c_str(), std::ios::in | std::ios::binary);
+    std::vector<int> buffer(1 << 16);
+    while (linkFile && !spillFailed)
+    {
+      linkFile.read(reinterpret_cast<char*>(&buffer[0]), buffer.size() * sizeof(int));
+      size_t numberOfValues = static_cast<size_t>(linkFile.gcount()) / sizeof(int);
+      links.insert(links.end(), buffer.begin(), buffer.begin() + (numberOfValues & ~size_t(1)));
+    }
+    linkFile.close();
+    vtksys::SystemTools::RemoveFile(spillName.str());
+
+    std::vector<int> members(links);
+    std::sort(members.begin(), members.end());
+    members.erase(std::unique(members.begin(), members.end()), members.end());
+    vtkNew<vtkEquivalenceSet> groups;
+    groups->SetNumberOfMembers(static_cast<vtkIdType>(members.size()));
+    for (size_t i = 0; i + 1 < links.size(); i += 2)
+    {
+      groups->AddEquivalence(
+        std::lower_bound(members.begin(), members.end(), links[i]) - members.begin(),
+        std::lower_bound(members.begin(), members.end(), links[i + 1]) - members.begin());
+    }
+    std::vector<int>().swap(links);
+
+    // Members are sorted, so the smallest member of a set is the smallest
+    // particle index.
+    if (!members.empty())
+    {
+      for (vtkIdType i = 0; i < numParticles; ++i)
+      {
+        std::vector<int>::iterator member =
+          std::lower_bound(members.begin(), members.end(), internal->oocHaloTag[i]);
+        if (member != members.end() && *member == internal->oocHaloTag[i])
+        {
+          internal->oocHaloTag[i] =
+            members[groups->GetEquivalentSetId(member - members.begin())];
+        }
+      }
+    }
+  }
+
+  internal->pmin = this->PMin;
+  internal->buildOutOfCoreHalos();
+}
+
 void vtkPANLHaloFinder::ExecuteHaloFinder(
   vtkUnstructuredGrid* allParticles, vtkUnstructuredGrid* fofProperties)
 {
-  this->Internal->haloFinder = new cosmotk::CosmoHaloFinderP();
-  this->Internal->haloFinder->setParameters(
-    "", this->RL, this->DeadSize, this->NP, this->PMin, this->BB, this->NMin);
-  this->Internal->haloFinder->setParticles(this->Internal->xx.size(), &this->Internal->xx[0],
-    &this->Internal->yy[0], &this->Internal->zz[0], &this->Internal->vx[0], &this->Internal->vy[0],
-    &this->Internal->vz[0], &this->Internal->potential[0], &this->Internal->tag[0],
-    &this->Internal->mask[0], &this->Internal->status[0]);
-  this->Internal->haloFinder->executeHaloFinder();
-  this->Internal->haloFinder->collectHalos(false);
+  delete this->Internal->haloFinder;
+  this->Internal->haloFinder = NULL;
+  delete this->Internal->fof;
+  this->Internal->fof = NULL;
+  if (this->OutOfCore)
+  {
+    this->ExecuteOutOfCoreFOF();
+  }
+  else
+  {
+    this->Internal->haloFinder = new cosmotk::CosmoHaloFinderP();
+    this->Internal->haloFinder->setParameters(
+      "", this->RL, this->DeadSize, this->NP, this->PMin, this->BB, this->NMin);
+    this->Internal->haloFinder->setParticles(this->Internal->xx.size(), &this->Internal->xx[0],
+      &this->Internal->yy[0], &this->Internal->zz[0], &this->Internal->vx[0],
+      &this->Internal->vy[0], &this->Internal->vz[0], &this->Internal->potential[0],
+      &this->Internal->tag[0], &this->Internal->mask[0], &this->Internal->status[0]);
+    this->Internal->haloFinder->executeHaloFinder();
+    this->Internal->haloFinder->collectHalos(false);
+    this->Internal->numberOfHalos = this->Internal->haloFinder->getNumberOfHalos();
+    this->Internal->halos = this->Internal->haloFinder->getHalos();
+    this->Internal->haloCount = this->Internal->haloFinder->getHaloCount();
+    this->Internal->haloList = this->Internal->haloFinder->getHaloList();
+  }
   this->Internal->fof = new cosmotk::FOFHaloProperties();
-  int numberOfFOFHalos = this->Internal->haloFinder->getNumberOfHalos();
-  int* fofHalos = this->Internal->haloFinder->getHalos();
-  int* fofHaloCount = this->Internal->haloFinder->getHaloCount();
-  int* fofHaloList = this->Internal->haloFinder->getHaloList();
+  int numberOfFOFHalos = this->Internal->numberOfHalos;
+  int* fofHalos = this->Internal->halos;
+  int* fofHaloCount = this->Internal->haloCount;
+  int* fofHaloList = this->Internal->haloList;
   this->Internal->fof->setHalos(numberOfFOFHalos, fofHalos, fofHaloCount, fofHaloList);
   this->Internal->fof->setParameters("", this->RL, this->DeadSize, this->BB);
   this->Internal->fof->setParticles(this->Internal->xx.size(), &this->Internal->xx[0],
@@ -425,7 +855,7 @@ void vtkPANLHaloFinder::ExecuteHaloFinder(
     velocityY->SetValue(i, this->Internal->vy[i]);
     velocityZ->SetValue(i, this->Internal->vz[i]);
     particleId->SetValue(i, this->Internal->tag[i]);
-    haloTags->SetValue(i, this->Internal->haloFinder->getHaloIDForParticle(i));
+    haloTags->SetValue(i, this->Internal->getHaloIDForParticle(i));
     allParticles->InsertNextCell(VTK_VERTEX, 1, &i);
   }
   allParticles->GetPointData()->AddArray(velocityX.GetPointer());
@@ -484,7 +914,7 @@ void vtkPANLHaloFinder::ExecuteHaloFinder(
     velocityDispersion->SetValue(i, this->Internal->fofVelDisp[i]);
     mass->SetValue(i, this->Internal->fofMass[i]);
     count->SetValue(i, fofHaloCount[i]);
-    tag->SetValue(i, this->Internal->haloFinder->getHaloID(i));
+    tag->SetValue(i, this->Internal->getHaloID(i));
     fofProperties->InsertNextCell(VTK_VERTEX, 1, &i);
   }
 }
@@ -508,8 +938,8 @@ void vtkPANLHaloFinder::ExecuteSubHaloFinder(
     subhaloId->SetValue(i, -1);
   }
 
-  int numberOfFOFHalos = this->Internal->haloFinder->getNumberOfHalos();
-  int* fofHaloCount = this->Internal->haloFinder->getHaloCount();
+  int numberOfFOFHalos = this->Internal->numberOfHalos;
+  int* fofHaloCount = this->Internal->haloCount;
   ExtractHalo haloData(numberOfFOFHalos, fofHaloCount, this->Internal->fof);
 
   for (int halo = 0; halo < numberOfFOFHalos; ++halo)
@@ -560,7 +990,7 @@ void vtkPANLHaloFinder::ExecuteSubHaloFinder(
 
       for (int sidx = 0; sidx < numberOfSubHalos; ++sidx)
       {
-        parentHaloTag.push_back(this->Internal->haloFinder->getHaloID(halo));
+        parentHaloTag.push_back(this->Internal->getHaloID(halo));
         parentFOFCount.push_back(particleCount);
         subHaloTag.push_back(sidx);
         subCount.push_back(fofSubHaloCount[sidx]);
@@ -578,7 +1008,7 @@ void vtkPANLHaloFinder::ExecuteSubHaloFinder(
       }
 
       size_t pointsBefore = shX.size();
-      subFinder.getSubhaloCosmoData(this->Internal->haloFinder->getHaloID(halo), shX, shY, shZ,
+      subFinder.getSubhaloCosmoData(this->Internal->getHaloID(halo), shX, shY, shZ,
         shVX, shVY, shVZ, shTag, shHID, shID);
 
       for (size_t i = 0; pointsBefore + i < shX.size(); ++i)
@@ -661,8 +1091,8 @@ void vtkPANLHaloFinder::FindCenters(
   {
     return;
   }
-  int numberOfFOFHalos = this->Internal->haloFinder->getNumberOfHalos();
-  int* fofHaloCount = this->Internal->haloFinder->getHaloCount();
+  int numberOfFOFHalos = this->Internal->numberOfHalos;
+  int* fofHaloCount = this->Internal->haloCount;
   double OmegaBar = this->Deut / this->Hubble / this->Hubble;
   double OmegaCB = OmegaDM + OmegaBar;
   double OmegaMatter = OmegaCB + this->OmegaNU;
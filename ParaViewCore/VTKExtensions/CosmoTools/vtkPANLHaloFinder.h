@@ -34,6 +34,9 @@
  * The third output is empty unless subhalo finding is turned on.  If subhalo
  * finding is on, this output is similar to the second output except with data
  * for each subhalo rather than each halo.  It contains one point per subhalo.
+ *
+ * For inputs that are too large for the friends-of-friends pass to fit in
+ * memory, see OutOfCore.
 */
 
 #include "vtkPVVTKExtensionsCosmoToolsModule.h" // For export macro
@@ -255,6 +258,48 @@ class VTKPVVTKEXTENSIONSCOSMOTOOLS_EXPORT vtkPANLHaloFinder : public vtkUnstruct
     vtkSetMacro(RedShift, double) vtkGetMacro(RedShift, double)
     //@}
 
+    //@{
+    /**
+     * Turns on/off the out-of-core mode.  When on, the friends-of-friends pass
+     * runs on spatial sub-domains of each process's particles one at a time so
+     * that its working set stays within MemoryBudget.  The links between
+     * groups of particles near the sub-domain boundaries are spilled to
+     * ScratchDirectory and halos crossing sub-domains are resolved in a final
+     * pass whose size depends on the number of these particles only.  The
+     * particles and their halo tags (as in the default mode) are not part of
+     * the budget.  When NMin is 1, the halos found are the same as in the
+     * default mode.
+     * Default: Off
+     */
+    vtkSetMacro(OutOfCore, bool) vtkGetMacro(OutOfCore, bool) vtkBooleanMacro(OutOfCore, bool)
+    //@}
+
+    //@{
+    /**
+     * Gets/Sets the memory, in MiB, the friends-of-friends pass may use on
+     * each process in out-of-core mode.
+     * Default: 1024
+     */
+    vtkSetClampMacro(MemoryBudget, double, 0.01, VTK_DOUBLE_MAX)
+      vtkGetMacro(MemoryBudget, double)
+    //@}
+
+    /**
+     * Returns the number of sub-domains the last out-of-core execution split
+     * the particles of this process into.
+     */
+    vtkGetMacro(NumberOfSlabs, int)
+
+    //@{
+    /**
+     * Gets/Sets the directory the halo links are spilled to in out-of-core
+     * mode.  This should be node-local storage.  When not set, the current
+     * working directory is used.
+     * Default: NULL
+     */
+    vtkSetStringMacro(ScratchDirectory) vtkGetStringMacro(ScratchDirectory)
+    //@}
+
     protected : vtkPANLHaloFinder();
   virtual ~vtkPANLHaloFinder();
 
@@ -289,6 +334,12 @@ class VTKPVVTKEXTENSIONSCOSMOTOOLS_EXPORT vtkPANLHaloFinder : public vtkUnstruct
   double Hubble;
   double RedShift;
 
+  // Out-of-core parameters
+  bool OutOfCore;
+  double MemoryBudget;
+  char* ScratchDirectory;
+  int NumberOfSlabs;
+
   vtkMultiProcessController* Controller;
 
   class vtkInternals;
@@ -301,6 +352,7 @@ private:
   void ExtractDataArrays(vtkUnstructuredGrid* input, vtkIdType offset);
   void DistributeInput();
   void CreateGhostParticles();
+  void ExecuteOutOfCoreFOF();
   void ExecuteHaloFinder(vtkUnstructuredGrid* allParticles, vtkUnstructuredGrid* fofProperties);
   void ExecuteSubHaloFinder(
     vtkUnstructuredGrid* allParticles, vtkUnstructuredGrid* subFofProperties);
@@ -41,9 +41,11 @@
 #include "GenericIOReader.h"
 #include "GenericIOUtilities.h"
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <stdexcept>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -85,6 +87,9 @@ public:
   std::map<std::string, gio::VariableInfo> VariableInformation;
   std::map<std::string, int> VariableGenericIOType;
   std::map<int, block_t> Blocks;
+  std::vector<std::string> PendingVariables;
+  std::vector<gio::GenericIOReader*> ReaderPool;
+  std::string ReadError;
 
   /**
    * @brief Metadata constructor.
@@ -147,6 +152,9 @@ public:
     this->NumberOfBlocks = 0;
     this->VariableGenericIOType.clear();
     this->VariableInformation.clear();
+    this->PendingVariables.clear();
+    this->ReadError.clear();
+    vtkGenericIOUtilities::ClearReaderPool(this->ReaderPool);
 
     for (std::map<int, block_t>::iterator blockItr = this->Blocks.begin();
          blockItr != this->Blocks.end(); ++blockItr)
@@ -180,6 +188,7 @@ vtkStandardNewMacro(vtkPGenericIOMultiBlockReader)
   this->HaloIdVariableName = NULL;
   this->GenericIOType = IOTYPEMPI;
   this->BlockAssignment = ROUND_ROBIN;
+  this->NumberOfReadThreads = 0;
   this->BuildMetaData = false;
 
   this->SetXAxisVariableName("x");
@@ -237,6 +246,7 @@ void vtkPGenericIOMultiBlockReader::PrintSelf(std::ostream& os, vtkIndent indent
   os << indent << "z-axis: " << this->ZAxisVariableName << endl;
   os << indent << "GenericIOType: " << this->GenericIOType << endl;
   os << indent << "BlockAssignment: " << this->BlockAssignment << endl;
+  os << indent << "NumberOfReadThreads: " << this->NumberOfReadThreads << endl;
   os << indent << "ArrayList: " << endl;
   this->ArrayList->PrintSelf(os, indent.GetNextIndent());
   os << indent << "PointDataSelection: " << endl;
@@ -586,8 +596,7 @@ void vtkPGenericIOMultiBlockReader::LoadRawVariableDataForBlock(
   dataBlock.RawCache[varName] = gio::GenericIOUtilities::AllocateVariableArray(
     this->MetaData->VariableInformation[varName], dataBlock.NumberOfElements);
 
-  this->Reader->AddVariable(
-    this->MetaData->VariableInformation[varName], dataBlock.RawCache[varName]);
+  this->MetaData->PendingVariables.push_back(varName);
 
   dataBlock.VariableStatus[varName] = true;
 
@@ -606,10 +615,6 @@ void vtkPGenericIOMultiBlockReader::LoadRawDataForBlock(int blockId)
   assert("pre: metadata is corrupt!" && (this->MetaData->SanityCheck()));
   assert("pre: block is not owned by this process!" && this->MetaData->HasBlock(blockId));
 
-  // This method is called for every block, so we must clear any previously
-  // registered variables
-  this->Reader->ClearVariables();
-
   std::string xaxis = std::string(this->XAxisVariableName);
   xaxis = vtkGenericIOUtilities::trim(xaxis);
 
@@ -666,7 +671,44 @@ void vtkPGenericIOMultiBlockReader::LoadRawDataForBlock(int blockId)
   std::cout << "\t[INFO]: Reading data...";
 #endif
 
-  this->Reader->ReadBlock(blockId);
+  std::vector<std::string>& variables = this->MetaData->PendingVariables;
+  block_t& dataBlock = this->MetaData->Blocks[blockId];
+  std::vector<gio::GenericIOReader*>& pool = this->MetaData->ReaderPool;
+  if (pool.empty())
+  {
+    // This method is called for every block, so we must clear any previously
+    // registered variables
+    this->Reader->ClearVariables();
+    for (size_t i = 0; i < variables.size(); ++i)
+    {
+      this->Reader->AddVariable(
+        this->MetaData->VariableInformation[variables[i]], dataBlock.RawCache[variables[i]]);
+    }
+    this->Reader->ReadBlock(blockId);
+  }
+  else
+  {
+    // Each worker reader reads, checks and decompresses its own subset of the
+    // variables on a separate thread. This may run on the read-ahead thread,
+    // hence errors are reported later by ReportReadErrors().
+    std::vector<gio::GenericIOReader*> readers(
+      pool.begin(), pool.begin() + std::min(pool.size(), variables.size()));
+    for (size_t i = 0; i < variables.size(); ++i)
+    {
+      readers[i % readers.size()]->AddVariable(
+        this->MetaData->VariableInformation[variables[i]], dataBlock.RawCache[variables[i]]);
+    }
+    std::string error;
+    if (!vtkGenericIOUtilities::ReadConcurrently(readers, blockId, error))
+    {
+      this->MetaData->ReadError = error;
+    }
+    for (size_t i = 0; i < readers.size(); ++i)
+    {
+      readers[i]->ClearVariables();
+    }
+  }
+  variables.clear();
 
 #ifdef DEBUG
   std::cout << "[DONE]\n";
@@ -674,6 +716,38 @@ void vtkPGenericIOMultiBlockReader::LoadRawDataForBlock(int blockId)
 #endif
 }
 
+//------------------------------------------------------------------------------
+void vtkPGenericIOMultiBlockReader::UpdateReaderPool()
+{
+  int numberOfThreads = 1;
+  if (this->GenericIOType == IOTYPEPOSIX)
+  {
+    // the coordinates and halo ids may not be among the enabled arrays
+    int numberOfVariables = this->PointDataArraySelection->GetNumberOfArraysEnabled() + 4;
+    numberOfThreads =
+      vtkGenericIOUtilities::GetNumberOfReadThreads(this->NumberOfReadThreads, numberOfVariables);
+  }
+
+  if (numberOfThreads < 2)
+  {
+    vtkGenericIOUtilities::ClearReaderPool(this->MetaData->ReaderPool);
+    return;
+  }
+  vtkGenericIOUtilities::ResizeReaderPool(this->MetaData->ReaderPool, numberOfThreads,
+    vtkGenericIOUtilities::GetMPICommunicator(this->Controller),
+    this->Reader->GetBlockAssignmentStrategy(), std::string(this->FileName));
+}
+
+//------------------------------------------------------------------------------
+void vtkPGenericIOMultiBlockReader::ReportReadErrors()
+{
+  if (!this->MetaData->ReadError.empty())
+  {
+    vtkErrorMacro("Failed to read " << this->FileName << ": " << this->MetaData->ReadError);
+    this->MetaData->ReadError.clear();
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkPGenericIOMultiBlockReader::GetPointFromRawData(int xType, void* xBuffer, int yType,
   void* yBuffer, int zType, void* zBuffer, vtkIdType idx, double pnt[3])
@@ -849,6 +923,16 @@ vtkUnstructuredGrid* vtkPGenericIOMultiBlockReader::LoadBlock(int blockId)
   assert("pre: block is not owned by this process!" && this->MetaData->HasBlock(blockId));
   // STEP 1: Load raw data
   this->LoadRawDataForBlock(blockId);
+  this->ReportReadErrors();
+
+  return this->CreateBlockFromRawData(blockId);
+}
+
+//------------------------------------------------------------------------------
+vtkUnstructuredGrid* vtkPGenericIOMultiBlockReader::CreateBlockFromRawData(int blockId)
+{
+  assert("pre: metadata is null" && (this->MetaData != NULL));
+  assert("pre: block is not owned by this process!" && this->MetaData->HasBlock(blockId));
 
   vtkUnstructuredGrid* grid = vtkUnstructuredGrid::New();
   std::set<vtkIdType> pointsInSelectedHalos;
@@ -974,18 +1058,16 @@ int vtkPGenericIOMultiBlockReader::RequestData(vtkInformation* vtkNotUsed(reques
 
   int myProcessId = this->Controller->GetLocalProcessId();
 
+  std::vector<int> blockIds;
   if (outInfo->Has(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS()))
   {
     int size = outInfo->Length(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES());
     int* ids = outInfo->Get(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES());
     for (int i = 0; i < size; ++i)
     {
-      int blockId = ids[i];
-      if (this->MetaData->BlockIsOnMyProcess(blockId, myProcessId))
+      if (this->MetaData->BlockIsOnMyProcess(ids[i], myProcessId))
       {
-        vtkSmartPointer<vtkUnstructuredGrid> grid =
-          vtkSmartPointer<vtkUnstructuredGrid>::Take(this->LoadBlock(blockId));
-        output->SetBlock(blockId, grid);
+        blockIds.push_back(ids[i]);
       }
     }
   }
@@ -996,12 +1078,43 @@ int vtkPGenericIOMultiBlockReader::RequestData(vtkInformation* vtkNotUsed(reques
     {
       if (blockItr->second.ProcessId == myProcessId)
       {
-        vtkSmartPointer<vtkUnstructuredGrid> grid =
-          vtkSmartPointer<vtkUnstructuredGrid>::Take(this->LoadBlock(blockItr->first));
-        output->SetBlock(blockItr->first, grid);
+        blockIds.push_back(blockItr->first);
       }
     }
   }
 
+  // When worker readers are available, the raw data of the next block is
+  // read on a separate thread while the current block is being converted.
+  this->UpdateReaderPool();
+  bool readAhead = !this->MetaData->ReaderPool.empty();
+  if (!blockIds.empty())
+  {
+    this->LoadRawDataForBlock(blockIds[0]);
+  }
+  for (size_t i = 0; i < blockIds.size(); ++i)
+  {
+    this->ReportReadErrors();
+
+    std::thread readAheadThread;
+    if (readAhead && i + 1 < blockIds.size())
+    {
+      readAheadThread =
+        std::thread(&vtkPGenericIOMultiBlockReader::LoadRawDataForBlock, this, blockIds[i + 1]);
+    }
+
+    vtkSmartPointer<vtkUnstructuredGrid> grid =
+      vtkSmartPointer<vtkUnstructuredGrid>::Take(this->CreateBlockFromRawData(blockIds[i]));
+    output->SetBlock(blockIds[i], grid);
+
+    if (readAheadThread.joinable())
+    {
+      readAheadThread.join();
+    }
+    else if (i + 1 < blockIds.size())
+    {
+      this->LoadRawDataForBlock(blockIds[i + 1]);
+    }
+  }
+
   return 1;
 }
@@ -104,6 +104,19 @@ public:
     vtkSetMacro(BlockAssignment, int) vtkGetMacro(BlockAssignment, int)
     //@}
 
+    //@{
+    /**
+     * Set/Get the number of threads used to read, check and decompress the
+     * variables of a block. Each thread reads a subset of the variables with
+     * its own reader and the next block assigned to this process is read while
+     * the current one is being converted, hence this is only used when
+     * GenericIOType is POSIX. 0 uses one thread per hardware thread and 1
+     * reads all blocks sequentially on the calling thread. Default is 0.
+     */
+    vtkSetClampMacro(NumberOfReadThreads, int, 0, VTK_INT_MAX)
+      vtkGetMacro(NumberOfReadThreads, int)
+    //@}
+
     //@{
     /**
      * Returns the list of arrays used to select the variables to be used
@@ -219,6 +232,7 @@ protected:
   char* FileName;
   int GenericIOType;
   int BlockAssignment;
+  int NumberOfReadThreads;
 
   bool BuildMetaData;
 
@@ -252,6 +266,24 @@ protected:
 
   vtkUnstructuredGrid* LoadBlock(int blockId);
 
+  /**
+   * Builds the grid of a block whose raw data has been loaded with
+   * LoadRawDataForBlock().
+   */
+  vtkUnstructuredGrid* CreateBlockFromRawData(int blockId);
+
+  /**
+   * Opens or closes the worker readers used to read the variables of a block
+   * concurrently, according to GenericIOType and NumberOfReadThreads.
+   */
+  void UpdateReaderPool();
+
+  /**
+   * Reports, on the calling thread, any error that occurred while reading
+   * raw data on worker threads.
+   */
+  void ReportReadErrors();
+
   /**
    * Call-back registered with the SelectionObserver.
    */
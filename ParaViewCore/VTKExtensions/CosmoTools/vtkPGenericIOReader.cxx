@@ -71,6 +71,8 @@ public:
   std::map<std::string, void*> RawCache;
   MPI_Comm MPICommunicator;
   std::set<int> RanksToLoad;
+  std::vector<std::string> PendingVariables;
+  std::vector<gio::GenericIOReader*> ReaderPool;
 
   /**
    * @brief Metadata constructor.
@@ -134,6 +136,8 @@ public:
     this->VariableStatus.clear();
     this->Information.clear();
     this->RanksToLoad.clear();
+    this->PendingVariables.clear();
+    vtkGenericIOUtilities::ClearReaderPool(this->ReaderPool);
 
     std::map<std::string, void*>::iterator iter;
     for (iter = this->RawCache.begin(); iter != this->RawCache.end(); ++iter)
@@ -162,6 +166,7 @@ vtkPGenericIOReader::vtkPGenericIOReader()
   this->HaloIdVariableName = NULL;
   this->GenericIOType = IOTYPEMPI;
   this->BlockAssignment = ROUND_ROBIN;
+  this->NumberOfReadThreads = 0;
   this->BuildMetaData = false;
   this->AppendBlockCoordinates = true;
 
@@ -223,6 +228,7 @@ void vtkPGenericIOReader::PrintSelf(std::ostream& os, vtkIndent indent)
   os << indent << "z-axis: " << this->ZAxisVariableName << endl;
   os << indent << "GenericIOType: " << this->GenericIOType << endl;
   os << indent << "BlockAssignment: " << this->BlockAssignment << endl;
+  os << indent << "NumberOfReadThreads: " << this->NumberOfReadThreads << endl;
   os << indent << "ArrayList: " << endl;
   this->ArrayList->PrintSelf(os, indent.GetNextIndent());
   os << indent << "PointDataSelection: " << endl;
@@ -507,8 +513,7 @@ void vtkPGenericIOReader::LoadRawVariableData(std::string varName)
   this->MetaData->RawCache[varName] = gio::GenericIOUtilities::AllocateVariableArray(
     this->MetaData->Information[varName], this->MetaData->NumberOfElements);
 
-  this->Reader->AddVariable(
-    this->MetaData->Information[varName], this->MetaData->RawCache[varName]);
+  this->MetaData->PendingVariables.push_back(varName);
 
   this->MetaData->VariableStatus[varName] = true;
 
@@ -579,7 +584,7 @@ void vtkPGenericIOReader::LoadRawData()
   std::cout << "\t[INFO]: Reading data...";
 #endif
 
-  this->Reader->ReadData();
+  this->ReadRawData();
 
 #ifdef DEBUG
   std::cout << "[DONE]\n";
@@ -587,6 +592,49 @@ void vtkPGenericIOReader::LoadRawData()
 #endif
 }
 
+//------------------------------------------------------------------------------
+void vtkPGenericIOReader::ReadRawData()
+{
+  std::vector<std::string>& variables = this->MetaData->PendingVariables;
+  int numberOfThreads = vtkGenericIOUtilities::GetNumberOfReadThreads(
+    this->NumberOfReadThreads, static_cast<int>(variables.size()));
+
+  if (this->GenericIOType != IOTYPEPOSIX || numberOfThreads < 2)
+  {
+    for (size_t i = 0; i < variables.size(); ++i)
+    {
+      this->Reader->AddVariable(
+        this->MetaData->Information[variables[i]], this->MetaData->RawCache[variables[i]]);
+    }
+    this->Reader->ReadData();
+    variables.clear();
+    return;
+  }
+
+  // Each reader of the pool reads, checks and decompresses its own subset of
+  // the variables on a separate thread.
+  std::vector<gio::GenericIOReader*>& pool = this->MetaData->ReaderPool;
+  vtkGenericIOUtilities::ResizeReaderPool(pool, numberOfThreads, this->MetaData->MPICommunicator,
+    this->Reader->GetBlockAssignmentStrategy(), std::string(this->FileName));
+  for (size_t i = 0; i < variables.size(); ++i)
+  {
+    pool[i % pool.size()]->AddVariable(
+      this->MetaData->Information[variables[i]], this->MetaData->RawCache[variables[i]]);
+  }
+
+  std::string error;
+  if (!vtkGenericIOUtilities::ReadConcurrently(pool, -1, error))
+  {
+    vtkErrorMacro("Failed to read " << this->FileName << ": " << error);
+  }
+
+  for (size_t i = 0; i < pool.size(); ++i)
+  {
+    pool[i]->ClearVariables();
+  }
+  variables.clear();
+}
+
 //------------------------------------------------------------------------------
 void vtkPGenericIOReader::GetPointFromRawData(int xType, void* xBuffer, int yType, void* yBuffer,
   int zType, void* zBuffer, vtkIdType idx, double pnt[3])
@@ -115,6 +115,18 @@ public:
   vtkGetMacro(BlockAssignment, int);
   //@}
 
+  //@{
+  /**
+   * Set/Get the number of threads used to read, check and decompress the
+   * variables. Each thread reads a subset of the variables with its own
+   * reader, hence this is only used when GenericIOType is POSIX. 0 uses one
+   * thread per hardware thread and 1 reads all variables on the calling
+   * thread. Default is 0.
+   */
+  vtkSetClampMacro(NumberOfReadThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfReadThreads, int);
+  //@}
+
   //@{
   /**
    * Set/Get the RankInQuery. Used in combination with SetQueryRankNeighbors(1)
@@ -290,6 +302,12 @@ protected:
    */
   void LoadRawData();
 
+  /**
+   * Reads the variables queued by LoadRawVariableData(), concurrently when
+   * NumberOfReadThreads allows it.
+   */
+  void ReadRawData();
+
   /**
    * Loads the particle coordinates
    */
@@ -319,6 +337,7 @@ protected:
   char* FileName;
   int GenericIOType;
   int BlockAssignment;
+  int NumberOfReadThreads;
 
   int QueryRankNeighbors;
   int RankInQuery;
@@ -20,6 +20,14 @@
  * different resolutions on different parts of the dataset.  It has the
  * concept of a resolution level with 0 being the lowest resolution and the
  * resolution increases as the level number increases.
+ *
+ * When no particular blocks are requested, only the blocks of level 0 are
+ * read so that a coarse version of the whole dataset can be rendered right
+ * away. The composite meta-data provides the bounds and amount of detail of
+ * every block of every level, so a streaming representation (e.g. the
+ * StreamingParticles plugin) can then request higher resolution blocks in
+ * view priority order. The block with composite index `level *
+ * NumberOfBlocksPerLevel + i` is block `i` at resolution `level`.
 */
 
 #ifndef vtkPMultiResolutionGenericIOReader_h
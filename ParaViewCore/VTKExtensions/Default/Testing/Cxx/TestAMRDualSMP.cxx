@@ -0,0 +1,259 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestAMRDualSMP.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkAMRDualContour and vtkAMRDualClip generate the same output
+// whether blocks are processed concurrently (EnableSMP) or serially.
+#include "vtkAMRDualClip.h"
+#include "vtkAMRDualContour.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkUniformGrid.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+const int BLOCK_CELLS = 8;
+const int BLOCKS_PER_AXIS = 3;
+
+// One level of 3x3x3 blocks of 8^3 cells.  As with the SpyPlot reader,
+// blocks have a ghost layer on their sides shared with another block only.
+// The array is the signed distance to a sphere that crosses many blocks and
+// two faces of the domain.
+void CreateAMR(vtkNonOverlappingAMR* amr)
+{
+  const int numCells = BLOCK_CELLS * BLOCKS_PER_AXIS;
+  const double center[3] = { 11.3, 12.1, 12.7 };
+  int blocksPerLevel[1] = { BLOCKS_PER_AXIS * BLOCKS_PER_AXIS * BLOCKS_PER_AXIS };
+  amr->Initialize(1, blocksPerLevel);
+
+  int blockId = 0;
+  for (int bz = 0; bz < BLOCKS_PER_AXIS; ++bz)
+  {
+    for (int by = 0; by < BLOCKS_PER_AXIS; ++by)
+    {
+      for (int bx = 0; bx < BLOCKS_PER_AXIS; ++bx, ++blockId)
+      {
+        int blockIdx[3] = { bx, by, bz };
+        int lo[3];
+        int dims[3];
+        for (int ii = 0; ii < 3; ++ii)
+        {
+          lo[ii] = std::max(0, BLOCK_CELLS * blockIdx[ii] - 1);
+          int hi = std::min(numCells, BLOCK_CELLS * (blockIdx[ii] + 1) + 1);
+          dims[ii] = hi - lo[ii];
+        }
+        vtkNew<vtkUniformGrid> grid;
+        grid->SetOrigin(lo[0], lo[1], lo[2]);
+        grid->SetSpacing(1.0, 1.0, 1.0);
+        grid->SetDimensions(dims[0] + 1, dims[1] + 1, dims[2] + 1);
+
+        vtkNew<vtkDoubleArray> distance;
+        distance->SetName("Distance");
+        distance->SetNumberOfTuples(dims[0] * dims[1] * dims[2]);
+        vtkIdType cellId = 0;
+        for (int z = 0; z < dims[2]; ++z)
+        {
+          for (int y = 0; y < dims[1]; ++y)
+          {
+            for (int x = 0; x < dims[0]; ++x, ++cellId)
+            {
+              double pt[3] = { lo[0] + x + 0.5, lo[1] + y + 0.5, lo[2] + z + 0.5 };
+              double d = std::sqrt(vtkMath::Distance2BetweenPoints(pt, center));
+              distance->SetValue(cellId, 13.0 - d);
+            }
+          }
+        }
+        grid->GetCellData()->AddArray(distance.GetPointer());
+        amr->SetDataSet(0, blockId, grid.GetPointer());
+      }
+    }
+  }
+}
+
+vtkPointSet* GetMesh(vtkAlgorithm* filter)
+{
+  vtkMultiBlockDataSet* output =
+    vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  vtkMultiPieceDataSet* pieces =
+    output ? vtkMultiPieceDataSet::SafeDownCast(output->GetBlock(0)) : NULL;
+  return pieces ? vtkPointSet::SafeDownCast(pieces->GetPiece(0)) : NULL;
+}
+
+std::vector<double> SortedPoints(vtkPointSet* mesh)
+{
+  std::vector<std::vector<double> > points(mesh->GetNumberOfPoints(), std::vector<double>(3));
+  for (vtkIdType ptId = 0; ptId < mesh->GetNumberOfPoints(); ++ptId)
+  {
+    mesh->GetPoint(ptId, &points[ptId][0]);
+  }
+  std::sort(points.begin(), points.end());
+  std::vector<double> result;
+  for (size_t ii = 0; ii < points.size(); ++ii)
+  {
+    result.insert(result.end(), points[ii].begin(), points[ii].end());
+  }
+  return result;
+}
+
+bool SamePoints(vtkPointSet* serial, vtkPointSet* smp)
+{
+  std::vector<double> serialPoints = SortedPoints(serial);
+  std::vector<double> smpPoints = SortedPoints(smp);
+  for (size_t ii = 0; ii < serialPoints.size(); ++ii)
+  {
+    if (std::abs(serialPoints[ii] - smpPoints[ii]) > 1e-6)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareCounts(const char* name, vtkPointSet* serial, vtkPointSet* smp)
+{
+  if (!serial || !smp || serial->GetNumberOfCells() == 0)
+  {
+    cerr << "ERROR: " << name << " did not generate any cell." << endl;
+    return false;
+  }
+  if (serial->GetNumberOfPoints() != smp->GetNumberOfPoints() ||
+    serial->GetNumberOfCells() != smp->GetNumberOfCells())
+  {
+    cerr << "ERROR: " << name << " generated " << smp->GetNumberOfPoints() << " points and "
+         << smp->GetNumberOfCells() << " cells with SMP, " << serial->GetNumberOfPoints()
+         << " points and " << serial->GetNumberOfCells() << " cells without." << endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestContour(vtkNonOverlappingAMR* amr)
+{
+  vtkNew<vtkAMRDualContour> serial;
+  vtkNew<vtkAMRDualContour> smp;
+  vtkAMRDualContour* filters[2] = { serial.GetPointer(), smp.GetPointer() };
+  for (int ii = 0; ii < 2; ++ii)
+  {
+    filters[ii]->SetInputData(amr);
+    filters[ii]->SetInputArrayToProcess(
+      0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "Distance");
+    filters[ii]->SetIsoValue(0.0);
+    filters[ii]->SetEnableMergePoints(1);
+    filters[ii]->SetEnableMultiProcessCommunication(0);
+    filters[ii]->SetEnableSMP(ii);
+    filters[ii]->Update();
+  }
+
+  vtkPointSet* serialMesh = GetMesh(serial.GetPointer());
+  vtkPointSet* smpMesh = GetMesh(smp.GetPointer());
+  if (!CompareCounts("vtkAMRDualContour", serialMesh, smpMesh))
+  {
+    return false;
+  }
+  // Points are merged differently, so they may not be in the same order.
+  if (!SamePoints(serialMesh, smpMesh))
+  {
+    cerr << "ERROR: vtkAMRDualContour generated other points with SMP." << endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestClip(vtkNonOverlappingAMR* amr)
+{
+  vtkNew<vtkAMRDualClip> serial;
+  vtkNew<vtkAMRDualClip> smp;
+  vtkAMRDualClip* filters[2] = { serial.GetPointer(), smp.GetPointer() };
+  for (int ii = 0; ii < 2; ++ii)
+  {
+    filters[ii]->SetInputData(amr);
+    filters[ii]->SetInputArrayToProcess(
+      0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "Distance");
+    filters[ii]->SetIsoValue(0.0);
+    filters[ii]->SetEnableMergePoints(0);
+    filters[ii]->SetEnableMultiProcessCommunication(0);
+    filters[ii]->SetEnableSMP(ii);
+    filters[ii]->Update();
+  }
+
+  vtkUnstructuredGrid* serialMesh =
+    vtkUnstructuredGrid::SafeDownCast(GetMesh(serial.GetPointer()));
+  vtkUnstructuredGrid* smpMesh = vtkUnstructuredGrid::SafeDownCast(GetMesh(smp.GetPointer()));
+  if (!CompareCounts("vtkAMRDualClip", serialMesh, smpMesh))
+  {
+    return false;
+  }
+
+  // Blocks are appended in the serial order: the outputs are the same.
+  vtkDataArray* serialDistance = serialMesh->GetPointData()->GetArray("Distance");
+  vtkDataArray* smpDistance = smpMesh->GetPointData()->GetArray("Distance");
+  if (!serialDistance || !smpDistance)
+  {
+    cerr << "ERROR: vtkAMRDualClip did not pass the cell array to the points." << endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < serialMesh->GetNumberOfPoints(); ++ptId)
+  {
+    double serialPt[3];
+    double smpPt[3];
+    serialMesh->GetPoint(ptId, serialPt);
+    smpMesh->GetPoint(ptId, smpPt);
+    if (serialPt[0] != smpPt[0] || serialPt[1] != smpPt[1] || serialPt[2] != smpPt[2] ||
+      serialDistance->GetTuple1(ptId) != smpDistance->GetTuple1(ptId))
+    {
+      cerr << "ERROR: vtkAMRDualClip generated another point " << ptId << " with SMP." << endl;
+      return false;
+    }
+  }
+  vtkCellArray* serialCells = serialMesh->GetCells();
+  vtkCellArray* smpCells = smpMesh->GetCells();
+  vtkIdType serialNpts, smpNpts;
+  vtkIdType *serialPts, *smpPts;
+  serialCells->InitTraversal();
+  smpCells->InitTraversal();
+  while (serialCells->GetNextCell(serialNpts, serialPts))
+  {
+    if (!smpCells->GetNextCell(smpNpts, smpPts) || serialNpts != smpNpts ||
+      !std::equal(serialPts, serialPts + serialNpts, smpPts))
+    {
+      cerr << "ERROR: vtkAMRDualClip generated other cells with SMP." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestAMRDualSMP(int, char* [])
+{
+  vtkNew<vtkNonOverlappingAMR> amr;
+  CreateAMR(amr.GetPointer());
+
+  bool success = TestContour(amr.GetPointer());
+  success = TestClip(amr.GetPointer()) && success;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCellIntegratorBatch.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares vtkCellIntegrator::IntegrateCells() with the per cell
+// vtkCellIntegrator::Integrate() and reports the time taken by both.
+
+#include "vtkCellIntegrator.h"
+#include "vtkCellType.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+const double HexPoints[8][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+  { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+const double WedgePoints[6][3] = { { 0, 0, 0 }, { 0, 1, 0 }, { 1, 0, 0 }, { 0, 0, 1 },
+  { 0, 1, 1 }, { 1, 0, 1 } };
+const double PyramidPoints[5][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 },
+  { 0.5, 0.5, 1 } };
+const double TetraPoints[4][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+// Creates `numberOfCells` affine images of the reference cell.
+void CreateCells(int cellType, const double (*reference)[3], int numberOfPoints,
+  vtkIdType numberOfCells, vtkUnstructuredGrid* grid, std::vector<double>& coordinates,
+  std::vector<vtkIdType>& connectivity)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  grid->Allocate(numberOfCells);
+  connectivity.resize(numberOfCells * numberOfPoints);
+  for (vtkIdType ii = 0; ii < numberOfCells; ++ii)
+  {
+    double shear = 0.1 * (ii % 7);
+    double scale = 1.0 + 0.01 * (ii % 13);
+    for (int pp = 0; pp < numberOfPoints; ++pp)
+    {
+      const double* x = reference[pp];
+      vtkIdType ptId = points->InsertNextPoint(scale * x[0] + shear * x[1] + ii,
+        x[1] + shear * x[2], (2.0 - shear) * x[2] + 0.5 * shear * x[0]);
+      connectivity[ii * numberOfPoints + pp] = ptId;
+    }
+    grid->InsertNextCell(cellType, numberOfPoints, &connectivity[ii * numberOfPoints]);
+  }
+  grid->SetPoints(points.GetPointer());
+  double* data = static_cast<double*>(points->GetVoidPointer(0));
+  coordinates.assign(data, data + 3 * points->GetNumberOfPoints());
+}
+
+bool TestCellType(const char* name, int cellType, const double (*reference)[3],
+  int numberOfPoints, vtkIdType numberOfCells)
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  std::vector<double> coordinates;
+  std::vector<vtkIdType> connectivity;
+  CreateCells(cellType, reference, numberOfPoints, numberOfCells, grid.GetPointer(), coordinates,
+    connectivity);
+
+  vtkNew<vtkTimerLog> timer;
+  std::vector<double> expected(numberOfCells);
+  timer->StartTimer();
+  for (vtkIdType ii = 0; ii < numberOfCells; ++ii)
+  {
+    expected[ii] = vtkCellIntegrator::Integrate(grid.GetPointer(), ii);
+  }
+  timer->StopTimer();
+  double perCell = timer->GetElapsedTime();
+
+  std::vector<double> measures(numberOfCells);
+  std::vector<double> centroids(3 * numberOfCells);
+  timer->StartTimer();
+  if (!vtkCellIntegrator::IntegrateCells(cellType, numberOfCells, &connectivity[0],
+        &coordinates[0], &measures[0], &centroids[0]))
+  {
+    cerr << "ERROR: " << name << " not supported" << endl;
+    return false;
+  }
+  timer->StopTimer();
+  double batched = timer->GetElapsedTime();
+
+  cout << name << ": " << numberOfCells << " cells, per cell " << perCell << "s, batched "
+       << batched << "s" << endl;
+
+  for (vtkIdType ii = 0; ii < numberOfCells; ++ii)
+  {
+    if (fabs(fabs(measures[ii]) - fabs(expected[ii])) > 1e-9 * fabs(expected[ii]) ||
+      measures[ii] <= 0.0)
+    {
+      cerr << "ERROR: " << name << " " << ii << " measure is " << measures[ii] << " instead of "
+           << expected[ii] << endl;
+      return false;
+    }
+  }
+
+  // The centroid of the first cell is the affine image of the reference
+  // centroid, the average of the points except for pyramids.
+  double center[3] = { 0.0, 0.0, 0.0 };
+  for (int pp = 0; pp < numberOfPoints; ++pp)
+  {
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      center[cc] += coordinates[3 * connectivity[pp] + cc] / numberOfPoints;
+    }
+  }
+  if (cellType == VTK_PYRAMID)
+  {
+    // A quarter of the way from the base center to the apex.
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      double base = (center[cc] * 5.0 - coordinates[3 * connectivity[4] + cc]) / 4.0;
+      center[cc] = base + 0.25 * (coordinates[3 * connectivity[4] + cc] - base);
+    }
+  }
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    if (fabs(centroids[cc] - center[cc]) > 1e-9)
+    {
+      cerr << "ERROR: " << name << " centroid is wrong" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestCellIntegratorBatch(int, char* [])
+{
+  const vtkIdType numberOfCells = 100000;
+  const double triangle[3][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 } };
+  const double quad[4][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } };
+
+  bool success = TestCellType("triangles", VTK_TRIANGLE, triangle, 3, numberOfCells);
+  success = TestCellType("quads", VTK_QUAD, quad, 4, numberOfCells) && success;
+  success = TestCellType("tetrahedra", VTK_TETRA, TetraPoints, 4, numberOfCells) && success;
+  success = TestCellType("hexahedra", VTK_HEXAHEDRON, HexPoints, 8, numberOfCells) && success;
+  success = TestCellType("wedges", VTK_WEDGE, WedgePoints, 6, numberOfCells) && success;
+  success = TestCellType("pyramids", VTK_PYRAMID, PyramidPoints, 5, numberOfCells) && success;
+
+  // Unsupported cell types are reported.
+  double measure;
+  vtkIdType ids[2] = { 0, 1 };
+  double points[6] = { 0, 0, 0, 1, 0, 0 };
+  if (vtkCellIntegrator::IntegrateCells(VTK_LINE, 1, ids, points, &measure))
+  {
+    cerr << "ERROR: lines are not supported" << endl;
+    success = false;
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,94 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestEquivalenceSet.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkEquivalenceSet.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+
+namespace
+{
+// Members i and i + stride are equivalent within even blocks of `block`
+// members; members of odd blocks are only equivalent to themselves.
+const vtkIdType numMembers = 200000;
+const vtkIdType stride = 10;
+const vtkIdType block = 1000;
+
+class AddEquivalences
+{
+public:
+  vtkEquivalenceSet* Set;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ii = begin; ii < end && ii + stride < numMembers; ++ii)
+    {
+      if ((ii / block) % 2 == 0 && ((ii + stride) / block) % 2 == 0)
+      {
+        this->Set->AddEquivalence(ii + stride, ii);
+      }
+    }
+  }
+};
+}
+
+int TestEquivalenceSet(int, char* [])
+{
+  vtkNew<vtkEquivalenceSet> set;
+  set->SetNumberOfMembers(numMembers);
+
+  // Small grains so that many unions race on the same sets.
+  AddEquivalences functor;
+  functor.Set = set.GetPointer();
+  vtkSMPTools::For(0, numMembers, 64, functor);
+
+  // Before resolution, every member must map to the smallest member of its set.
+  for (vtkIdType ii = 0; ii < numMembers; ++ii)
+  {
+    vtkIdType expected = ((ii / block) % 2 == 0) ? (ii / block) * block + ii % stride : ii;
+    if (set->GetEquivalentSetId(ii) != expected)
+    {
+      cerr << "ERROR: member " << ii << " maps to " << set->GetEquivalentSetId(ii)
+           << " instead of " << expected << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const vtkIdType numBlocks = numMembers / block;
+  const vtkIdType expectedSets = (numBlocks / 2) * stride + (numBlocks / 2) * block;
+  vtkIdType numSets = set->ResolveEquivalences();
+  if (numSets != expectedSets || set->GetNumberOfResolvedSets() != expectedSets)
+  {
+    cerr << "ERROR: expected " << expectedSets << " sets, got " << numSets << endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType ii = 0; ii < numMembers; ++ii)
+  {
+    if (set->GetEquivalentSetId(ii) < 0 || set->GetEquivalentSetId(ii) >= numSets)
+    {
+      cerr << "ERROR: resolved id out of range for member " << ii << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The set grows on demand when not sized beforehand.
+  vtkNew<vtkEquivalenceSet> small;
+  small->AddEquivalence(5, 3);
+  small->AddEquivalence(7, 5);
+  if (small->GetNumberOfMembers() != 8 || small->GetEquivalentSetId(7) != 3)
+  {
+    cerr << "ERROR: unexpected growth/equivalence." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,110 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVConnectivityFilter.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPVConnectivityFilter.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+// Adds a strip of `numQuads` connected quads at height `y`.
+void AddStrip(vtkUnstructuredGrid* grid, vtkPoints* points, double y, vtkIdType numQuads)
+{
+  vtkIdType first = points->GetNumberOfPoints();
+  for (vtkIdType i = 0; i <= numQuads; ++i)
+  {
+    points->InsertNextPoint(i, y, 0.0);
+    points->InsertNextPoint(i, y + 1.0, 0.0);
+  }
+  for (vtkIdType i = 0; i < numQuads; ++i)
+  {
+    vtkIdType ids[4] = { first + 2 * i, first + 2 * i + 2, first + 2 * i + 3, first + 2 * i + 1 };
+    grid->InsertNextCell(VTK_QUAD, 4, ids);
+  }
+}
+}
+
+int TestPVConnectivityFilter(int, char* [])
+{
+  // Three disjoint strips of 5, 2 and 9 quads.
+  const vtkIdType sizes[3] = { 5, 2, 9 };
+  vtkNew<vtkUnstructuredGrid> grid;
+  vtkNew<vtkPoints> points;
+  grid->Allocate(16);
+  for (int i = 0; i < 3; ++i)
+  {
+    AddStrip(grid.GetPointer(), points.GetPointer(), 3.0 * i, sizes[i]);
+  }
+  grid->SetPoints(points.GetPointer());
+
+  vtkNew<vtkConnectivityFilter> reference;
+  reference->SetInputData(grid.GetPointer());
+  reference->SetExtractionModeToAllRegions();
+  reference->Update();
+
+  vtkNew<vtkPVConnectivityFilter> filter;
+  filter->SetInputData(grid.GetPointer());
+  filter->GlobalRegionIdsOn();
+  filter->SortRegionsBySizeOn();
+  filter->Update();
+
+  if (filter->GetNumberOfExtractedRegions() != reference->GetNumberOfExtractedRegions() ||
+    filter->GetNumberOfExtractedRegions() != 3)
+  {
+    cerr << "ERROR: found " << filter->GetNumberOfExtractedRegions() << " regions instead of "
+         << reference->GetNumberOfExtractedRegions() << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Regions are sorted by decreasing size.
+  vtkUnstructuredGrid* output = filter->GetOutput();
+  vtkDataArray* regionIds = output->GetCellData()->GetArray("RegionId");
+  if (output->GetNumberOfCells() != 16 || regionIds == NULL)
+  {
+    cerr << "ERROR: unexpected output" << endl;
+    return EXIT_FAILURE;
+  }
+  const vtkIdType expectedIds[3] = { 1, 2, 0 };
+  vtkIdType cellId = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    for (vtkIdType j = 0; j < sizes[i]; ++j, ++cellId)
+    {
+      if (regionIds->GetTuple1(cellId) != expectedIds[i])
+      {
+        cerr << "ERROR: cell " << cellId << " is in region " << regionIds->GetTuple1(cellId)
+             << " instead of " << expectedIds[i] << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Only the 9 quads strip must be extracted.
+  filter->SetExtractionModeToLargestRegion();
+  filter->SortRegionsBySizeOff();
+  filter->Update();
+  if (filter->GetOutput()->GetNumberOfCells() != 9 ||
+    filter->GetOutput()->GetNumberOfPoints() != 20)
+  {
+    cerr << "ERROR: largest region has " << filter->GetOutput()->GetNumberOfCells()
+         << " cells" << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVConnectivityFilterMPI.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPVConnectivityFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "mpi.h"
+
+namespace
+{
+// Adds a strip of quads from x = `first` to x = `first + numQuads` at height
+// `y`. Point global ids are `idOffset + 2 * x + (0|1)`.
+void AddStrip(vtkUnstructuredGrid* grid, vtkPoints* points, vtkIdTypeArray* globalIds,
+  vtkIdType first, vtkIdType numQuads, double y, vtkIdType idOffset)
+{
+  vtkIdType firstPt = points->GetNumberOfPoints();
+  for (vtkIdType i = first; i <= first + numQuads; ++i)
+  {
+    points->InsertNextPoint(i, y, 0.0);
+    points->InsertNextPoint(i, y + 1.0, 0.0);
+    globalIds->InsertNextValue(idOffset + 2 * i);
+    globalIds->InsertNextValue(idOffset + 2 * i + 1);
+  }
+  for (vtkIdType i = 0; i < numQuads; ++i)
+  {
+    vtkIdType ids[4] = { firstPt + 2 * i, firstPt + 2 * i + 2, firstPt + 2 * i + 3,
+      firstPt + 2 * i + 1 };
+    grid->InsertNextCell(VTK_QUAD, 4, ids);
+  }
+}
+
+// Each process has 4 quads of a strip shared by all the processes, the
+// strips of neighbor processes share their end points. Each process also has
+// a strip of 2 quads of its own. All the processes must agree that the
+// shared strip is the largest region, region 0, and find 1 + numProcs
+// regions.
+bool TestFilter(vtkMultiProcessController* controller, bool useGlobalIds)
+{
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdTypeArray> globalIds;
+  globalIds->SetName("GlobalIds");
+  grid->Allocate(6);
+  AddStrip(grid.GetPointer(), points.GetPointer(), globalIds.GetPointer(), 4 * myId, 4, 0.0, 0);
+  AddStrip(grid.GetPointer(), points.GetPointer(), globalIds.GetPointer(), 4 * myId, 2, 3.0,
+    2 * (4 * numProcs + 1));
+  grid->SetPoints(points.GetPointer());
+  if (useGlobalIds)
+  {
+    grid->GetPointData()->SetGlobalIds(globalIds.GetPointer());
+  }
+
+  vtkNew<vtkPVConnectivityFilter> filter;
+  filter->SetController(controller);
+  filter->SetInputData(grid.GetPointer());
+  filter->GlobalRegionIdsOn();
+  filter->SortRegionsBySizeOn();
+  filter->Update();
+
+  // Failures do not return early, the next Update() is collective.
+  bool success = true;
+  if (filter->GetNumberOfExtractedRegions() != 1 + numProcs)
+  {
+    cerr << "ERROR: process " << myId << " found " << filter->GetNumberOfExtractedRegions()
+         << " regions instead of " << 1 + numProcs << endl;
+    success = false;
+  }
+
+  vtkUnstructuredGrid* output = filter->GetOutput();
+  vtkDataArray* regionIds = output->GetCellData()->GetArray("RegionId");
+  if (output->GetNumberOfCells() != 6 || regionIds == NULL)
+  {
+    cerr << "ERROR: unexpected output on process " << myId << endl;
+    success = false;
+  }
+  for (vtkIdType cellId = 0; success && cellId < 6; ++cellId)
+  {
+    bool shared = cellId < 4;
+    if ((regionIds->GetTuple1(cellId) == 0) != shared)
+    {
+      cerr << "ERROR: cell " << cellId << " of process " << myId << " is in region "
+           << regionIds->GetTuple1(cellId) << endl;
+      success = false;
+    }
+  }
+
+  // Only the shared strip must be extracted, on every process.
+  filter->SetExtractionModeToLargestRegion();
+  filter->Update();
+  if (filter->GetOutput()->GetNumberOfCells() != 4)
+  {
+    cerr << "ERROR: largest region has " << filter->GetOutput()->GetNumberOfCells()
+         << " cells on process " << myId << endl;
+    success = false;
+  }
+  return success;
+}
+}
+
+int TestPVConnectivityFilterMPI(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv, 1);
+
+  bool withGlobalIds = TestFilter(controller, true);
+  bool withCoordinates = TestFilter(controller, false);
+  int retVal = withGlobalIds && withCoordinates ? 1 : 0;
+
+  int allRetVal = 0;
+  controller->AllReduce(&retVal, &allRetVal, 1, vtkCommunicator::MIN_OP);
+
+  controller->Finalize();
+  controller->Delete();
+
+  return !allRetVal;
+}
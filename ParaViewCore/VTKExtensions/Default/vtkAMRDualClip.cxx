@@ -35,12 +35,16 @@
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataSet.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedCharArray.h"
@@ -1912,6 +1916,7 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->EnableDegenerateCells = 1;
   this->EnableMultiProcessCommunication = 0;
   this->EnableMergePoints = 0;
+  this->EnableSMP = 0;
 
   this->Controller = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -1946,6 +1951,7 @@ void vtkAMRDualClip::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableInternalDecimation: " << this->EnableInternalDecimation << endl;
   os << indent << "EnableDegenerateCells: " << this->EnableDegenerateCells << endl;
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
+  os << indent << "EnableSMP: " << this->EnableSMP << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -2090,19 +2096,26 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   this->Mesh = mesh;
   this->InitializeCopyAttributes(hbdsInput, this->Mesh);
 
-  // Loop through blocks
-  int numLevels = hbdsInput->GetNumberOfLevels();
-  int numBlocks;
-  int blockId;
-
-  // Add each block.
-  for (int level = 0; level < numLevels; ++level)
+  if (this->EnableSMP && !this->EnableMergePoints)
   {
-    numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
-    for (blockId = 0; blockId < numBlocks; ++blockId)
+    this->ProcessBlocksSMP(hbdsInput, arrayNameToProcess);
+  }
+  else
+  {
+    // Loop through blocks
+    int numLevels = hbdsInput->GetNumberOfLevels();
+    int numBlocks;
+    int blockId;
+
+    // Add each block.
+    for (int level = 0; level < numLevels; ++level)
     {
-      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+      for (blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+        this->ProcessBlock(block, blockId, arrayNameToProcess);
+      }
     }
   }
 
@@ -2127,6 +2140,204 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   return mbdsOutput0;
 }
 
+//----------------------------------------------------------------------------
+// Clips a range of blocks for vtkAMRDualClip::ProcessBlocksSMP().  Each
+// thread uses its own vtkAMRDualClip for the locator and the output ivars.
+// Each block gets its own output so that outputs can be appended in block
+// order afterwards.
+class vtkAMRDualClipBlockWorker
+{
+public:
+  vtkAMRDualClip* Self;
+  const char* ArrayName;
+  vtkCellData* TemplateCellData;
+  std::vector<vtkAMRDualGridHelperBlock*> Blocks;
+  std::vector<int> BlockIds;
+  std::vector<vtkSmartPointer<vtkUnstructuredGrid> > Outputs;
+  std::vector<vtkSmartPointer<vtkCellArray> > OutputCells;
+  std::vector<vtkSmartPointer<vtkIntArray> > OutputBlockIds;
+  vtkSMPThreadLocalObject<vtkAMRDualClip> Workers;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkAMRDualClip* worker = this->Workers.Local();
+    worker->IsoValue = this->Self->IsoValue;
+    worker->EnableInternalDecimation = this->Self->EnableInternalDecimation;
+    worker->EnableDegenerateCells = this->Self->EnableDegenerateCells;
+    worker->EnableMergePoints = 0;
+    worker->Helper = this->Self->Helper;
+
+    for (vtkIdType idx = begin; idx < end; ++idx)
+    {
+      vtkUnstructuredGrid* mesh = vtkUnstructuredGrid::New();
+      vtkPoints* points = vtkPoints::New();
+      vtkCellArray* cells = vtkCellArray::New();
+      vtkIntArray* blockIds = vtkIntArray::New();
+      vtkUnsignedCharArray* levelMask = vtkUnsignedCharArray::New();
+      mesh->SetPoints(points);
+      // Same point arrays, in the same order, as the output mesh.
+      levelMask->SetName("LevelMask");
+      mesh->GetPointData()->AddArray(levelMask);
+      mesh->GetPointData()->CopyAllocate(this->TemplateCellData);
+
+      worker->Mesh = mesh;
+      worker->Points = points;
+      worker->Cells = cells;
+      worker->BlockIdCellArray = blockIds;
+      worker->LevelMaskPointArray = levelMask;
+      worker->ProcessBlock(this->Blocks[idx], this->BlockIds[idx], this->ArrayName);
+
+      this->Outputs[idx].TakeReference(mesh);
+      this->OutputCells[idx].TakeReference(cells);
+      this->OutputBlockIds[idx].TakeReference(blockIds);
+      points->Delete();
+      levelMask->Delete();
+    }
+
+    worker->Mesh = 0;
+    worker->Points = 0;
+    worker->Cells = 0;
+    worker->BlockIdCellArray = 0;
+    worker->LevelMaskPointArray = 0;
+    worker->Helper = 0;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Appends the block outputs of vtkAMRDualClip::ProcessBlocksSMP() in block
+// order.  Each block writes its own range of the (preallocated) output
+// arrays.  All cells are tetrahedra.
+class vtkAMRDualClipAppendWorker
+{
+public:
+  vtkAMRDualClipBlockWorker* Blocks;
+  // Index of the first point and cell of each block in the output.
+  std::vector<vtkIdType> PointOffsets;
+  std::vector<vtkIdType> CellOffsets;
+
+  vtkPoints* OutPoints;
+  vtkPointData* OutPointData;
+  vtkIdType* OutConnectivity;
+  int* OutBlockIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    int numArrays = this->OutPointData->GetNumberOfArrays();
+    for (vtkIdType idx = begin; idx < end; ++idx)
+    {
+      vtkUnstructuredGrid* mesh = this->Blocks->Outputs[idx];
+      vtkIdType pointOffset = this->PointOffsets[idx];
+      vtkDataArray* inPoints = mesh->GetPoints()->GetData();
+      vtkDataArray* outPoints = this->OutPoints->GetData();
+      vtkPointData* inPD = mesh->GetPointData();
+      vtkIdType numPoints = inPoints->GetNumberOfTuples();
+      for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+      {
+        outPoints->SetTuple(pointOffset + ptId, ptId, inPoints);
+        for (int ii = 0; ii < numArrays; ++ii)
+        {
+          this->OutPointData->GetAbstractArray(ii)->SetTuple(
+            pointOffset + ptId, ptId, inPD->GetAbstractArray(ii));
+        }
+      }
+
+      vtkCellArray* cells = this->Blocks->OutputCells[idx];
+      vtkIntArray* blockIds = this->Blocks->OutputBlockIds[idx];
+      vtkIdType* out = this->OutConnectivity + 5 * this->CellOffsets[idx];
+      int* outBlockIds = this->OutBlockIds + this->CellOffsets[idx];
+      vtkIdType npts;
+      vtkIdType* pts;
+      vtkIdType cellId = 0;
+      for (cells->InitTraversal(); cells->GetNextCell(npts, pts); ++cellId)
+      {
+        *out++ = npts;
+        for (vtkIdType ii = 0; ii < npts; ++ii)
+        {
+          *out++ = pointOffset + pts[ii];
+        }
+        outBlockIds[cellId] = blockIds->GetValue(cellId);
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::ProcessBlocksSMP(
+  vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
+{
+  // All blocks are expected to have the same cell arrays.
+  vtkCompositeDataIterator* iter = hbdsInput->NewIterator();
+  iter->InitTraversal();
+  vtkDataSet* firstBlock =
+    iter->IsDoneWithTraversal() ? 0 : vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+  iter->Delete();
+  if (firstBlock == 0)
+  { // Empty input
+    return;
+  }
+
+  vtkAMRDualClipBlockWorker worker;
+  worker.Self = this;
+  worker.ArrayName = arrayNameToProcess;
+  worker.TemplateCellData = firstBlock->GetCellData();
+
+  // Same order as the serial path. Remote blocks do not generate anything.
+  int numLevels = this->Helper->GetNumberOfLevels();
+  for (int level = 0; level < numLevels; ++level)
+  {
+    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    for (int blockId = 0; blockId < numBlocks; ++blockId)
+    {
+      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+      if (block->Image)
+      {
+        worker.Blocks.push_back(block);
+        worker.BlockIds.push_back(blockId);
+      }
+    }
+  }
+  vtkIdType numBlocks = static_cast<vtkIdType>(worker.Blocks.size());
+  worker.Outputs.resize(numBlocks);
+  worker.OutputCells.resize(numBlocks);
+  worker.OutputBlockIds.resize(numBlocks);
+  vtkSMPTools::For(0, numBlocks, 1, worker);
+
+  // Append the block outputs in block order so that the result does not
+  // depend on the scheduling of the threads.
+  vtkAMRDualClipAppendWorker append;
+  append.Blocks = &worker;
+  append.PointOffsets.resize(numBlocks + 1, 0);
+  append.CellOffsets.resize(numBlocks + 1, 0);
+  for (vtkIdType idx = 0; idx < numBlocks; ++idx)
+  {
+    append.PointOffsets[idx + 1] =
+      append.PointOffsets[idx] + worker.Outputs[idx]->GetNumberOfPoints();
+    append.CellOffsets[idx + 1] =
+      append.CellOffsets[idx] + worker.OutputCells[idx]->GetNumberOfCells();
+  }
+  vtkIdType numPoints = append.PointOffsets[numBlocks];
+  vtkIdType numCells = append.CellOffsets[numBlocks];
+
+  vtkPointData* outPD = this->Mesh->GetPointData();
+  this->Points->SetNumberOfPoints(numPoints);
+  for (int ii = 0; ii < outPD->GetNumberOfArrays(); ++ii)
+  {
+    outPD->GetAbstractArray(ii)->SetNumberOfTuples(numPoints);
+  }
+  vtkIdTypeArray* connectivity = vtkIdTypeArray::New();
+  connectivity->SetNumberOfTuples(5 * numCells);
+  this->BlockIdCellArray->SetNumberOfTuples(numCells);
+
+  append.OutPoints = this->Points;
+  append.OutPointData = outPD;
+  append.OutConnectivity = connectivity->GetPointer(0);
+  append.OutBlockIds = this->BlockIdCellArray->GetPointer(0);
+  vtkSMPTools::For(0, numBlocks, 1, append);
+
+  this->Cells->SetCells(numCells, connectivity);
+  connectivity->Delete();
+}
+
 //----------------------------------------------------------------------------
 // The only data specific stuff we need to do for the contour.
 //----------------------------------------------------------------------------
@@ -2750,8 +2961,10 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
         ptIdPtr = this->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
         levelMaskValue = this->BlockLocator->GetLevelMaskValue(
           x + ((casePtId & 1) ? 1 : 0), y + ((casePtId & 2) ? 1 : 0), z + ((casePtId & 4) ? 1 : 0));
-        if (levelMaskValue == 0)
+        if (levelMaskValue == 0 || levelMaskValue == 255)
         { // bug !!!!! trying to figure out what is going on.
+          // 255 is an uninitialized mask value: the level mask is only
+          // computed when EnableMergePoints is on.
           levelMaskValue = 1;
         }
         if (*ptIdPtr == -1)
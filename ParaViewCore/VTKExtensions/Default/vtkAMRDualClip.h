@@ -47,6 +47,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualClipLocator;
+class vtkAMRDualClipBlockWorker;
 
 class VTKPVVTKEXTENSIONSDEFAULT_EXPORT vtkAMRDualClip : public vtkMultiBlockDataSetAlgorithm
 {
@@ -85,6 +86,19 @@ public:
   vtkBooleanMacro(EnableMergePoints, int);
   //@}
 
+  //@{
+  /**
+   * When on, blocks are clipped concurrently using vtkSMPTools.  Off by
+   * default.  Each thread uses its own locator and the block outputs are
+   * appended in block order, so the result is the same as the serial one.
+   * Only used when EnableMergePoints is off: merging points shares level
+   * masks and locators between neighboring blocks, in block order.
+   */
+  vtkSetMacro(EnableSMP, int);
+  vtkGetMacro(EnableSMP, int);
+  vtkBooleanMacro(EnableSMP, int);
+  //@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -99,6 +113,7 @@ protected:
   int EnableDegenerateCells;
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
+  int EnableSMP;
 
   // Needed for copying cell data to point data.
   vtkUnstructuredGrid* Mesh;
@@ -121,6 +136,12 @@ protected:
 
   void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
 
+  /**
+   * Clips all local blocks concurrently and appends the results to
+   * Mesh / Points / Cells.  See EnableSMP.
+   */
+  void ProcessBlocksSMP(vtkNonOverlappingAMR* input, const char* arrayName);
+
   void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
     vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
 
@@ -152,6 +173,8 @@ protected:
   vtkAMRDualClipLocator* BlockLocator;
 
 private:
+  friend class vtkAMRDualClipBlockWorker;
+
   vtkAMRDualClip(const vtkAMRDualClip&) VTK_DELETE_FUNCTION;
   void operator=(const vtkAMRDualClip&) VTK_DELETE_FUNCTION;
 };
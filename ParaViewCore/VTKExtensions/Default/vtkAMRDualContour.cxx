@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkAMRDualContour.h"
 #include "vtkAMRDualGridHelper.h"
+#include <algorithm>
 #include <vector>
 
 // Pipeline & VTK
@@ -35,12 +36,16 @@
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -608,6 +613,74 @@ void vtkAMRDualContourEdgeLocator::ShareBlockLocatorWithNeighbor(
   }
 }
 
+//============================================================================
+// A point that may also be generated by a neighboring block.  The key is the
+// dual grid edge the point lies on: the two dual points at the ends of the
+// edge, each given as its level and its global index in that level.  Capping
+// points lie on a dual point and use it for both ends.  Blocks generate the
+// same point for the same edge, whatever their level.
+struct vtkAMRDualContourSharedPoint
+{
+  int Key[8];
+  vtkIdType PointId;
+
+  bool SameKey(const vtkAMRDualContourSharedPoint& other) const
+  {
+    return std::equal(this->Key, this->Key + 8, other.Key);
+  }
+  bool operator<(const vtkAMRDualContourSharedPoint& other) const
+  {
+    for (int ii = 0; ii < 8; ++ii)
+    {
+      if (this->Key[ii] != other.Key[ii])
+      {
+        return this->Key[ii] < other.Key[ii];
+      }
+    }
+    return this->PointId < other.PointId;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Collects the shared points of one block.  Points are only recorded when
+// one of the ends of their edge is in, or next to, the ghost layer of the
+// block.  Other points cannot be generated by a neighbor.
+class vtkAMRDualContourSharedPoints
+{
+public:
+  // Level and global index of the 8 corners of the current dual cell.
+  // Set by ProcessDualCell, in the same order as the corner points.
+  int CornerKeys[32];
+  // Bit c is set when corner c is in or next to the ghost layer.
+  int NearGhostCorners;
+  std::vector<vtkAMRDualContourSharedPoint> Points;
+
+  void AddEdgePoint(int corner0, int corner1, vtkIdType pointId)
+  {
+    if ((this->NearGhostCorners & ((1 << corner0) | (1 << corner1))) == 0)
+    {
+      return;
+    }
+    const int* key0 = this->CornerKeys + (corner0 << 2);
+    const int* key1 = this->CornerKeys + (corner1 << 2);
+    // The edge does not depend on the order of its ends.
+    if (std::lexicographical_compare(key1, key1 + 4, key0, key0 + 4))
+    {
+      std::swap(key0, key1);
+    }
+    vtkAMRDualContourSharedPoint point;
+    std::copy(key0, key0 + 4, point.Key);
+    std::copy(key1, key1 + 4, point.Key + 4);
+    point.PointId = pointId;
+    this->Points.push_back(point);
+  }
+
+  void AddCornerPoint(int corner, vtkIdType pointId)
+  {
+    this->AddEdgePoint(corner, corner, pointId);
+  }
+};
+
 //============================================================================
 //----------------------------------------------------------------------------
 // Description:
@@ -623,6 +696,7 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->EnableMultiProcessCommunication = 1;
   this->EnableMergePoints = 1;
   this->TriangulateCap = 1;
+  this->EnableSMP = 0;
 
   this->Controller = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -635,6 +709,7 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->Helper = 0;
 
   this->BlockLocator = 0;
+  this->SharedPoints = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -661,6 +736,7 @@ void vtkAMRDualContour::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
   os << indent << "TriangulateCap: " << this->TriangulateCap << endl;
   os << indent << "SkipGhostCopy: " << this->SkipGhostCopy << endl;
+  os << indent << "EnableSMP: " << this->EnableSMP << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -783,7 +859,8 @@ void vtkAMRDualContour::FinalizeRequest()
 vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
 {
-  this->Helper->SetupData(hbdsInput, arrayNameToProcess);
+  // Remote ghost regions are received while local blocks are processed.
+  this->Helper->BeginSetupData(hbdsInput, arrayNameToProcess);
 
   vtkMultiBlockDataSet* mbdsOutput0 = vtkMultiBlockDataSet::New();
   mbdsOutput0->SetNumberOfBlocks(1);
@@ -799,25 +876,35 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   this->Mesh->SetPolys(this->Faces);
   mpds->SetPiece(0, this->Mesh);
 
-  this->InitializeCopyAttributes(hbdsInput, this->Mesh);
-
   // For debugging.
   this->BlockIdCellArray = vtkIntArray::New();
   this->BlockIdCellArray->SetName("BlockIds");
   this->Mesh->GetCellData()->AddArray(this->BlockIdCellArray);
 
-  // Loop through blocks
-  int numLevels = hbdsInput->GetNumberOfLevels();
-
-  // Add each block.
-  for (int level = 0; level < numLevels; ++level)
+  if (this->EnableSMP)
   {
-    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
-    for (int blockId = 0; blockId < numBlocks; ++blockId)
+    this->ProcessBlocksSMP(hbdsInput, arrayNameToProcess);
+    this->Helper->FinishRegionRemoteCopyQueue();
+  }
+  else
+  {
+    this->InitializeCopyAttributes(hbdsInput, this->Mesh);
+
+    // Loop through blocks
+    int numLevels = hbdsInput->GetNumberOfLevels();
+
+    // Add each block.
+    for (int level = 0; level < numLevels; ++level)
     {
-      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+      for (int blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+        this->Helper->WaitForBlockRegionCopies(block);
+        this->ProcessBlock(block, blockId, arrayNameToProcess);
+      }
     }
+    this->Helper->FinishRegionRemoteCopyQueue();
   }
 
   this->FinalizeCopyAttributes(this->Mesh);
@@ -836,6 +923,341 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   return mbdsOutput0;
 }
 
+//----------------------------------------------------------------------------
+// Contours a batch of blocks for vtkAMRDualContour::ProcessBlocksSMP().  Each
+// thread uses its own vtkAMRDualContour for the locator and the output ivars.
+// Each block gets its own output so that outputs can be appended in block
+// order afterwards.
+class vtkAMRDualContourBlockWorker
+{
+public:
+  vtkAMRDualContour* Self;
+  const char* ArrayName;
+  vtkCellData* TemplateCellData;
+  std::vector<vtkAMRDualGridHelperBlock*> Blocks;
+  std::vector<int> BlockIds;
+  std::vector<vtkSmartPointer<vtkPolyData> > Outputs;
+  std::vector<vtkSmartPointer<vtkIntArray> > OutputBlockIds;
+  std::vector<vtkAMRDualContourSharedPoints> SharedPoints;
+  // Indices (in Blocks) of the blocks to contour in this pass.
+  std::vector<vtkIdType> Batch;
+  vtkSMPThreadLocalObject<vtkAMRDualContour> Workers;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkAMRDualContour* worker = this->Workers.Local();
+    worker->IsoValue = this->Self->IsoValue;
+    worker->EnableCapping = this->Self->EnableCapping;
+    worker->EnableDegenerateCells = this->Self->EnableDegenerateCells;
+    worker->TriangulateCap = this->Self->TriangulateCap;
+    // Locators cannot be shared between threads. Points of neighboring
+    // blocks are merged when the outputs are appended instead.
+    worker->EnableMergePoints = 0;
+    worker->Helper = this->Self->Helper;
+
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      vtkIdType idx = this->Batch[ii];
+      vtkPolyData* mesh = vtkPolyData::New();
+      vtkPoints* points = vtkPoints::New();
+      vtkCellArray* faces = vtkCellArray::New();
+      vtkIntArray* blockIds = vtkIntArray::New();
+      mesh->SetPoints(points);
+      mesh->SetPolys(faces);
+      mesh->GetPointData()->CopyAllocate(this->TemplateCellData);
+
+      worker->Mesh = mesh;
+      worker->Points = points;
+      worker->Faces = faces;
+      worker->BlockIdCellArray = blockIds;
+      worker->SharedPoints = this->Self->EnableMergePoints ? &this->SharedPoints[idx] : 0;
+      worker->ProcessBlock(this->Blocks[idx], this->BlockIds[idx], this->ArrayName);
+
+      this->Outputs[idx].TakeReference(mesh);
+      this->OutputBlockIds[idx].TakeReference(blockIds);
+      points->Delete();
+      faces->Delete();
+    }
+
+    worker->Mesh = 0;
+    worker->Points = 0;
+    worker->Faces = 0;
+    worker->BlockIdCellArray = 0;
+    worker->SharedPoints = 0;
+    worker->Helper = 0;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Appends the block outputs of vtkAMRDualContour::ProcessBlocksSMP() in block
+// order.  The first pass counts the faces left after merging points, the
+// second pass copies the points, attributes and faces.  Each block writes
+// its own range of the (preallocated) output arrays.
+class vtkAMRDualContourAppendWorker
+{
+public:
+  vtkAMRDualContourBlockWorker* Blocks;
+  // Index of the first point of each block in the appended points.
+  std::vector<vtkIdType> PointOffsets;
+  // Appended point id to output point id.
+  std::vector<vtkIdType> PointMap;
+  // Set for the appended points that are copied to the output.
+  std::vector<unsigned char> KeepPoint;
+  // Number of output faces and connectivity entries of each block; turned
+  // into offsets between the two passes.
+  std::vector<vtkIdType> FaceOffsets;
+  std::vector<vtkIdType> ConnectivityOffsets;
+  bool CopyPass;
+
+  vtkPoints* OutPoints;
+  vtkPointData* OutPointData;
+  vtkIdType* OutConnectivity;
+  int* OutBlockIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType idx = begin; idx < end; ++idx)
+    {
+      vtkPolyData* mesh = this->Blocks->Outputs[idx];
+      const vtkIdType* pointMap = &this->PointMap[0] + this->PointOffsets[idx];
+      if (this->CopyPass)
+      {
+        this->CopyPoints(mesh, idx, pointMap);
+      }
+
+      vtkCellArray* faces = mesh->GetPolys();
+      vtkIntArray* blockIds = this->Blocks->OutputBlockIds[idx];
+      vtkIdType numFaces = 0;
+      vtkIdType connectivitySize = 0;
+      vtkIdType npts;
+      vtkIdType* pts;
+      vtkIdType cellId = 0;
+      for (faces->InitTraversal(); faces->GetNextCell(npts, pts); ++cellId)
+      {
+        // Merging can make triangles degenerate.
+        if (npts == 3 &&
+          (pointMap[pts[0]] == pointMap[pts[1]] || pointMap[pts[0]] == pointMap[pts[2]] ||
+            pointMap[pts[1]] == pointMap[pts[2]]))
+        {
+          continue;
+        }
+        if (this->CopyPass)
+        {
+          vtkIdType* out =
+            this->OutConnectivity + this->ConnectivityOffsets[idx] + connectivitySize;
+          out[0] = npts;
+          for (vtkIdType ii = 0; ii < npts; ++ii)
+          {
+            out[ii + 1] = pointMap[pts[ii]];
+          }
+          this->OutBlockIds[this->FaceOffsets[idx] + numFaces] = blockIds->GetValue(cellId);
+        }
+        ++numFaces;
+        connectivitySize += npts + 1;
+      }
+      if (!this->CopyPass)
+      {
+        this->FaceOffsets[idx] = numFaces;
+        this->ConnectivityOffsets[idx] = connectivitySize;
+      }
+    }
+  }
+
+  void CopyPoints(vtkPolyData* mesh, vtkIdType idx, const vtkIdType* pointMap)
+  {
+    const unsigned char* keep = &this->KeepPoint[0] + this->PointOffsets[idx];
+    vtkDataArray* inPoints = mesh->GetPoints()->GetData();
+    vtkDataArray* outPoints = this->OutPoints->GetData();
+    vtkPointData* inPD = mesh->GetPointData();
+    int numArrays = this->OutPointData->GetNumberOfArrays();
+    vtkIdType numPoints = inPoints->GetNumberOfTuples();
+    for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+    {
+      if (!keep[ptId])
+      {
+        continue;
+      }
+      vtkIdType outId = pointMap[ptId];
+      outPoints->SetTuple(outId, ptId, inPoints);
+      for (int ii = 0; ii < numArrays; ++ii)
+      {
+        this->OutPointData->GetAbstractArray(ii)->SetTuple(
+          outId, ptId, inPD->GetAbstractArray(ii));
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::ProcessBlocksSMP(
+  vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
+{
+  // All blocks are expected to have the same cell arrays.
+  vtkCompositeDataIterator* iter = hbdsInput->NewIterator();
+  iter->InitTraversal();
+  vtkDataSet* firstBlock =
+    iter->IsDoneWithTraversal() ? 0 : vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+  iter->Delete();
+  if (firstBlock == 0)
+  { // Empty input
+    return;
+  }
+
+  vtkAMRDualContourBlockWorker worker;
+  worker.Self = this;
+  worker.ArrayName = arrayNameToProcess;
+  worker.TemplateCellData = firstBlock->GetCellData();
+  this->Mesh->GetPointData()->CopyAllocate(worker.TemplateCellData);
+
+  // Same order as the serial path. Remote blocks do not generate anything.
+  int numLevels = this->Helper->GetNumberOfLevels();
+  for (int level = 0; level < numLevels; ++level)
+  {
+    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    for (int blockId = 0; blockId < numBlocks; ++blockId)
+    {
+      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+      if (block->Image)
+      {
+        worker.Blocks.push_back(block);
+        worker.BlockIds.push_back(blockId);
+      }
+    }
+  }
+  vtkIdType numBlocks = static_cast<vtkIdType>(worker.Blocks.size());
+  worker.Outputs.resize(numBlocks);
+  worker.OutputBlockIds.resize(numBlocks);
+  worker.SharedPoints.resize(numBlocks);
+
+  // Contour the blocks whose ghost regions are complete while the remote
+  // copies for the other blocks are still in flight.  Then wait for the
+  // first block still missing data (which also unpacks whatever else has
+  // arrived) and contour the blocks that became ready.
+  std::vector<vtkIdType> waiting(numBlocks);
+  for (vtkIdType idx = 0; idx < numBlocks; ++idx)
+  {
+    waiting[idx] = idx;
+  }
+  while (!waiting.empty())
+  {
+    worker.Batch.clear();
+    std::vector<vtkIdType> stillWaiting;
+    for (size_t ii = 0; ii < waiting.size(); ++ii)
+    {
+      if (this->Helper->IsBlockRegionCopyPending(worker.Blocks[waiting[ii]]))
+      {
+        stillWaiting.push_back(waiting[ii]);
+      }
+      else
+      {
+        worker.Batch.push_back(waiting[ii]);
+      }
+    }
+    vtkSMPTools::For(0, static_cast<vtkIdType>(worker.Batch.size()), 1, worker);
+    waiting.swap(stillWaiting);
+    if (!waiting.empty())
+    {
+      this->Helper->WaitForBlockRegionCopies(worker.Blocks[waiting[0]]);
+    }
+  }
+
+  // Append the block outputs in block order so that the result does not
+  // depend on the scheduling of the threads.
+  vtkAMRDualContourAppendWorker append;
+  append.Blocks = &worker;
+  append.PointOffsets.resize(numBlocks + 1, 0);
+  for (vtkIdType idx = 0; idx < numBlocks; ++idx)
+  {
+    append.PointOffsets[idx + 1] =
+      append.PointOffsets[idx] + worker.Outputs[idx]->GetNumberOfPoints();
+  }
+  vtkIdType numPoints = append.PointOffsets[numBlocks];
+  append.PointMap.resize(numPoints + 1);
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    append.PointMap[ptId] = ptId;
+  }
+
+  if (this->EnableMergePoints)
+  {
+    // Only points on edges next to block boundaries were recorded.  Points
+    // with the same edge are merged into the one of the first block.
+    std::vector<vtkAMRDualContourSharedPoint> shared;
+    for (vtkIdType idx = 0; idx < numBlocks; ++idx)
+    {
+      std::vector<vtkAMRDualContourSharedPoint>& points = worker.SharedPoints[idx].Points;
+      for (size_t ii = 0; ii < points.size(); ++ii)
+      {
+        shared.push_back(points[ii]);
+        shared.back().PointId += append.PointOffsets[idx];
+      }
+      std::vector<vtkAMRDualContourSharedPoint>().swap(points);
+    }
+    std::sort(shared.begin(), shared.end());
+    for (size_t ii = 1; ii < shared.size(); ++ii)
+    {
+      if (shared[ii].SameKey(shared[ii - 1]))
+      {
+        append.PointMap[shared[ii].PointId] = append.PointMap[shared[ii - 1].PointId];
+      }
+    }
+  }
+
+  // Number the points that are kept.  Merged points always map to a lower
+  // id, which is already renumbered.
+  append.KeepPoint.resize(numPoints + 1, 0);
+  vtkIdType numOutPoints = 0;
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    if (append.PointMap[ptId] == ptId)
+    {
+      append.KeepPoint[ptId] = 1;
+      append.PointMap[ptId] = numOutPoints++;
+    }
+    else
+    {
+      append.PointMap[ptId] = append.PointMap[append.PointMap[ptId]];
+    }
+  }
+
+  append.FaceOffsets.resize(numBlocks + 1, 0);
+  append.ConnectivityOffsets.resize(numBlocks + 1, 0);
+  append.CopyPass = false;
+  vtkSMPTools::For(0, numBlocks, 1, append);
+
+  vtkIdType numFaces = 0;
+  vtkIdType connectivitySize = 0;
+  for (vtkIdType idx = 0; idx <= numBlocks; ++idx)
+  {
+    vtkIdType blockFaces = append.FaceOffsets[idx];
+    vtkIdType blockConnectivitySize = append.ConnectivityOffsets[idx];
+    append.FaceOffsets[idx] = numFaces;
+    append.ConnectivityOffsets[idx] = connectivitySize;
+    numFaces += blockFaces;
+    connectivitySize += blockConnectivitySize;
+  }
+
+  vtkPointData* outPD = this->Mesh->GetPointData();
+  this->Points->SetNumberOfPoints(numOutPoints);
+  for (int ii = 0; ii < outPD->GetNumberOfArrays(); ++ii)
+  {
+    outPD->GetAbstractArray(ii)->SetNumberOfTuples(numOutPoints);
+  }
+  vtkIdTypeArray* connectivity = vtkIdTypeArray::New();
+  connectivity->SetNumberOfTuples(connectivitySize);
+  this->BlockIdCellArray->SetNumberOfTuples(numFaces);
+
+  append.OutPoints = this->Points;
+  append.OutPointData = outPD;
+  append.OutConnectivity = connectivity->GetPointer(0);
+  append.OutBlockIds = this->BlockIdCellArray->GetPointer(0);
+  append.CopyPass = true;
+  vtkSMPTools::For(0, numBlocks, 1, append);
+
+  this->Faces->SetCells(numFaces, connectivity);
+  connectivity->Delete();
+}
+
 //----------------------------------------------------------------------------
 void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block)
 {
@@ -1193,6 +1615,10 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
 
   double dx, dy, dz;       // Chop cells in half at boundary.
   double cornerPoints[32]; // 4 is easier to optimize than 3.
+  if (this->SharedPoints)
+  {
+    this->SharedPoints->NearGhostCorners = 0;
+  }
   // Loop over the corners.
   for (int c = 0; c < 8; ++c)
   {
@@ -1272,9 +1698,11 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
       nz = 1;
     }
 
+    int cornerLevel = block->Level;
     if (block->RegionBits[nx][ny][nz] & vtkAMRRegionBitsDegenerateMask)
     { // point lies in lower level neighbor.
       int levelDiff = block->RegionBits[nx][ny][nz] & vtkAMRRegionBitsDegenerateMask;
+      cornerLevel -= levelDiff;
       px = px >> levelDiff;
       py = py >> levelDiff;
       pz = pz >> levelDiff;
@@ -1302,6 +1730,23 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
       cornerPoints[(c << 2) | 1] = tmp[1] + spacing[1] * ((double)(py) + dy);
       cornerPoints[(c << 2) | 2] = tmp[2] + spacing[2] * ((double)(pz) + dz);
     }
+
+    if (this->SharedPoints)
+    {
+      int* cornerKey = this->SharedPoints->CornerKeys + (c << 2);
+      cornerKey[0] = cornerLevel;
+      cornerKey[1] = px;
+      cornerKey[2] = py;
+      cornerKey[3] = pz;
+      // Degenerate corners are always in the ghost layer.
+      if (nx != 1 || ny != 1 || nz != 1 || px == ghostDualPointIndexRange[0] + 1 ||
+        px == ghostDualPointIndexRange[1] - 1 || py == ghostDualPointIndexRange[2] + 1 ||
+        py == ghostDualPointIndexRange[3] - 1 || pz == ghostDualPointIndexRange[4] + 1 ||
+        pz == ghostDualPointIndexRange[5] - 1)
+      {
+        this->SharedPoints->NearGhostCorners |= (1 << c);
+      }
+    }
   }
 
   // We have the points, now contour the cell.
@@ -1358,6 +1803,11 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
         pt[2] =
           cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
         *ptIdPtr = this->Points->InsertNextPoint(pt);
+        if (this->SharedPoints)
+        {
+          this->SharedPoints->AddEdgePoint(vtkAMRDualIsoEdgeToPointsTable[*edge][0],
+            vtkAMRDualIsoEdgeToPointsTable[*edge][1], *ptIdPtr);
+        }
         // Interpolate attributes
         // Find the offsets of the two attributes to interpolate
         vtkIdType offset0 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][0]];
@@ -1478,6 +1928,10 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
             *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
               inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            if (this->SharedPoints)
+            {
+              this->SharedPoints->AddCornerPoint(cornerIdx, *ptIdPtr);
+            }
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1514,6 +1968,10 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
             *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
               inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            if (this->SharedPoints)
+            {
+              this->SharedPoints->AddCornerPoint(cornerIdx, *ptIdPtr);
+            }
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1551,6 +2009,10 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
             *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
               inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            if (this->SharedPoints)
+            {
+              this->SharedPoints->AddCornerPoint(cornerIdx, *ptIdPtr);
+            }
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1588,6 +2050,10 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
             *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
               inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            if (this->SharedPoints)
+            {
+              this->SharedPoints->AddCornerPoint(cornerIdx, *ptIdPtr);
+            }
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1624,6 +2090,10 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
             *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
               inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            if (this->SharedPoints)
+            {
+              this->SharedPoints->AddCornerPoint(cornerIdx, *ptIdPtr);
+            }
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1661,6 +2131,10 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
             *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
               inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            if (this->SharedPoints)
+            {
+              this->SharedPoints->AddCornerPoint(cornerIdx, *ptIdPtr);
+            }
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
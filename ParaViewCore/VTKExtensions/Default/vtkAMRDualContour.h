@@ -54,6 +54,8 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualContourEdgeLocator;
+class vtkAMRDualContourBlockWorker;
+class vtkAMRDualContourSharedPoints;
 
 class VTKPVVTKEXTENSIONSDEFAULT_EXPORT vtkAMRDualContour : public vtkMultiBlockDataSetAlgorithm
 {
@@ -114,6 +116,21 @@ public:
   vtkBooleanMacro(SkipGhostCopy, int);
   //@}
 
+  //@{
+  /**
+   * When on, blocks are contoured concurrently using vtkSMPTools.  Off by
+   * default.  Each block is contoured with its own locator and the block
+   * outputs are appended in block order, so the result does not depend on
+   * thread scheduling.  Blocks are contoured as soon as their remote ghost
+   * regions have arrived.  When EnableMergePoints is on, points of
+   * neighboring blocks lying on the same dual grid edge are merged while
+   * appending the block outputs.
+   */
+  vtkSetMacro(EnableSMP, int);
+  vtkGetMacro(EnableSMP, int);
+  vtkBooleanMacro(EnableSMP, int);
+  //@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -130,6 +147,7 @@ protected:
   int EnableMergePoints;
   int TriangulateCap;
   int SkipGhostCopy;
+  int EnableSMP;
 
   virtual int RequestData(
     vtkInformation*, vtkInformationVector**, vtkInformationVector*) VTK_OVERRIDE;
@@ -157,6 +175,12 @@ protected:
 
   void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
 
+  /**
+   * Contours all local blocks concurrently and appends the results to
+   * Mesh / Points / Faces.  See EnableSMP.
+   */
+  void ProcessBlocksSMP(vtkNonOverlappingAMR* input, const char* arrayName);
+
   void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
     vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
 
@@ -199,6 +223,10 @@ protected:
 
   vtkAMRDualContourEdgeLocator* BlockLocator;
 
+  // When set, the dual grid edges of points that may be shared with
+  // neighboring blocks are recorded (see ProcessBlocksSMP).
+  vtkAMRDualContourSharedPoints* SharedPoints;
+
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
   void InterpolateAttributes(vtkDataSet* uGrid, vtkIdType offset0, vtkIdType offset1, double k,
@@ -207,6 +235,8 @@ protected:
   void FinalizeCopyAttributes(vtkDataSet* mesh);
 
 private:
+  friend class vtkAMRDualContourBlockWorker;
+
   vtkAMRDualContour(const vtkAMRDualContour&) VTK_DELETE_FUNCTION;
   void operator=(const vtkAMRDualContour&) VTK_DELETE_FUNCTION;
 };
@@ -34,6 +34,7 @@
 #include "vtkSmartPointer.h"
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
+#include <algorithm>
 #include <list>
 #include <vector>
 
@@ -60,6 +61,7 @@ class vtkAMRDualGridHelperSeed;
 //=============================================================================
 // Tags used in communication.
 static const int SHARED_BLOCK_TAG = 2392734;
+static const int SHARED_BLOCK_LENGTH_TAG = 2392735;
 static const int DEGENERATE_REGION_TAG = 879015;
 
 //=============================================================================
@@ -187,26 +189,52 @@ public:
       i->Request.Wait();
   }
   // Description:
+  // If one of the communications has completed, removes it from the list,
+  // stores it in retval and returns true.  Does not block.
+  bool TestAny(value_type& retval)
+  {
+    for (iterator i = this->begin(); i != this->end(); i++)
+    {
+      if (i->Request.Test())
+      {
+        retval = *i;
+        this->erase(i);
+        return true;
+      }
+    }
+    return false;
+  }
+  // Description:
   // Waits for one of the communications to complete, removes it from the list,
   // and returns it.
   value_type WaitAny()
   {
+    value_type retval;
     while (!this->empty())
     {
-      for (iterator i = this->begin(); i != this->end(); i++)
+      if (this->TestAny(retval))
       {
-        if (i->Request.Test())
-        {
-          value_type retval = *i;
-          this->erase(i);
-          return retval;
-        }
+        return retval;
       }
       vtksys::SystemTools::Delay(1);
     }
     vtkGenericWarningMacro(<< "Nothing to wait for.");
     return value_type();
   }
+  // Description:
+  // Returns true if a communication with the given sending process is still
+  // pending.
+  bool HasRequestFrom(int sendProcess)
+  {
+    for (iterator i = this->begin(); i != this->end(); i++)
+    {
+      if (i->SendProcess == sendProcess)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
 };
 #endif // VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
 
@@ -720,6 +748,10 @@ vtkAMRDualGridHelper::vtkAMRDualGridHelper()
   this->ArrayName = 0;
   this->EnableDegenerateCells = 1;
   this->EnableAsynchronousCommunication = 1;
+  this->ShareBlocksWithSpatialNeighbors = 1;
+  this->PendingRegionSends = NULL;
+  this->PendingRegionReceives = NULL;
+  this->PendingRegionHackLevelFlag = false;
   this->NumberOfBlocksInThisProcess = 0;
   for (ii = 0; ii < 3; ++ii)
   {
@@ -744,6 +776,9 @@ vtkAMRDualGridHelper::~vtkAMRDualGridHelper()
   int ii;
   int numberOfLevels = (int)(this->Levels.size());
 
+  // Do not leave communication in flight.
+  this->FinishRegionRemoteCopyQueue();
+
   this->SetArrayName(0);
 
   for (ii = 0; ii < numberOfLevels; ++ii)
@@ -769,6 +804,8 @@ void vtkAMRDualGridHelper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableDegenerateCells: " << this->EnableDegenerateCells << endl;
   os << indent << "EnableAsynchronousCommunication: " << this->EnableAsynchronousCommunication
      << endl;
+  os << indent << "ShareBlocksWithSpatialNeighbors: " << this->ShareBlocksWithSpatialNeighbors
+     << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -1950,6 +1987,16 @@ void vtkAMRDualGridHelper::UnmarshalDegenerateRegionMessage(const void* messageP
 // step of initialization.
 void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueue(bool hackLevelFlag)
 {
+  this->BeginRegionRemoteCopyQueue(hackLevelFlag);
+  this->FinishRegionRemoteCopyQueue();
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualGridHelper::BeginRegionRemoteCopyQueue(bool hackLevelFlag)
+{
+  // Complete any previous exchange first.
+  this->FinishRegionRemoteCopyQueue();
+
   if (this->SkipGhostCopy)
   {
     return;
@@ -1958,7 +2005,7 @@ void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueue(bool hackLevelFlag)
 #ifdef VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
   if (this->EnableAsynchronousCommunication && this->Controller->IsA("vtkMPIController"))
   {
-    this->ProcessRegionRemoteCopyQueueMPIAsynchronous(hackLevelFlag);
+    this->BeginRegionRemoteCopyQueueMPIAsynchronous(hackLevelFlag);
     return;
   }
 #endif // VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
@@ -1966,6 +2013,105 @@ void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueue(bool hackLevelFlag)
   this->ProcessRegionRemoteCopyQueueSynchronous(hackLevelFlag);
 }
 
+//----------------------------------------------------------------------------
+void vtkAMRDualGridHelper::FinishRegionRemoteCopyQueue()
+{
+#ifdef VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
+  if (!this->PendingRegionReceives)
+  {
+    return;
+  }
+
+  vtkTimerLogSmartMarkEvent markevent("FinishRegionRemoteCopyQueue");
+  this->FinishDegenerateRegionsCommMPIAsynchronous(
+    this->PendingRegionHackLevelFlag, *this->PendingRegionSends, *this->PendingRegionReceives);
+
+  delete this->PendingRegionSends;
+  delete this->PendingRegionReceives;
+  this->PendingRegionSends = NULL;
+  this->PendingRegionReceives = NULL;
+  this->PendingRegionSources.clear();
+#endif // VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualGridHelper::WaitForBlockRegionCopies(vtkAMRDualGridHelperBlock* block)
+{
+#ifdef VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
+  if (!this->PendingRegionReceives)
+  {
+    return;
+  }
+
+  std::map<vtkAMRDualGridHelperBlock*, std::vector<int> >::iterator sources =
+    this->PendingRegionSources.find(block);
+  for (;;)
+  {
+    vtkAMRDualGridHelperCommRequest request;
+    if (!this->PendingRegionReceives->TestAny(request))
+    {
+      // Nothing has arrived.  Only wait if this block still needs data.
+      bool blockIsPending = false;
+      if (sources != this->PendingRegionSources.end())
+      {
+        std::vector<int>::iterator proc;
+        for (proc = sources->second.begin(); proc != sources->second.end(); ++proc)
+        {
+          if (this->PendingRegionReceives->HasRequestFrom(*proc))
+          {
+            blockIsPending = true;
+            break;
+          }
+        }
+      }
+      if (!blockIsPending)
+      {
+        break;
+      }
+      request = this->PendingRegionReceives->WaitAny();
+    }
+    vtkCharArray* recvBuffer = vtkCharArray::SafeDownCast(request.Buffer);
+    this->UnmarshalDegenerateRegionMessage(recvBuffer->GetPointer(0),
+      recvBuffer->GetNumberOfTuples(), request.SendProcess, this->PendingRegionHackLevelFlag);
+  }
+  if (sources != this->PendingRegionSources.end())
+  {
+    this->PendingRegionSources.erase(sources);
+  }
+#else
+  (void)block;
+#endif // VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
+}
+
+//----------------------------------------------------------------------------
+bool vtkAMRDualGridHelper::IsBlockRegionCopyPending(vtkAMRDualGridHelperBlock* block)
+{
+#ifdef VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
+  if (!this->PendingRegionReceives)
+  {
+    return false;
+  }
+
+  std::map<vtkAMRDualGridHelperBlock*, std::vector<int> >::iterator sources =
+    this->PendingRegionSources.find(block);
+  if (sources == this->PendingRegionSources.end())
+  {
+    return false;
+  }
+  std::vector<int>::iterator proc;
+  for (proc = sources->second.begin(); proc != sources->second.end(); ++proc)
+  {
+    if (this->PendingRegionReceives->HasRequestFrom(*proc))
+    {
+      return true;
+    }
+  }
+#else
+  (void)block;
+#endif // VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
+  return false;
+}
+
 void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueueSynchronous(bool hackLevelFlag)
 {
   vtkTimerLogSmartMarkEvent markevent("ProcessRegionRemoteCopyQueueSynchronous", this->Controller);
@@ -2084,9 +2230,16 @@ void vtkAMRDualGridHelper::ReceiveDegenerateRegionsFromQueueSynchronous(
 
 //-----------------------------------------------------------------------------
 void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueueMPIAsynchronous(bool hackLevelFlag)
+{
+  this->BeginRegionRemoteCopyQueueMPIAsynchronous(hackLevelFlag);
+  this->FinishRegionRemoteCopyQueue();
+}
+
+//-----------------------------------------------------------------------------
+void vtkAMRDualGridHelper::BeginRegionRemoteCopyQueueMPIAsynchronous(bool hackLevelFlag)
 {
   vtkTimerLogSmartMarkEvent markevent(
-    "ProcessRegionRemoteCopyQueueMPIAsynchronous", this->Controller);
+    "BeginRegionRemoteCopyQueueMPIAsynchronous", this->Controller);
 
   vtkMPIController* controller = vtkMPIController::SafeDownCast(this->Controller);
   if (!controller)
@@ -2100,8 +2253,28 @@ void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueueMPIAsynchronous(bool hack
   int numProcs = controller->GetNumberOfProcesses();
   int myProc = controller->GetLocalProcessId();
 
-  vtkAMRDualGridHelperCommRequestList sendList;
-  vtkAMRDualGridHelperCommRequestList receiveList;
+  this->PendingRegionSends = new vtkAMRDualGridHelperCommRequestList;
+  this->PendingRegionReceives = new vtkAMRDualGridHelperCommRequestList;
+  this->PendingRegionHackLevelFlag = hackLevelFlag;
+  vtkAMRDualGridHelperCommRequestList& sendList = *this->PendingRegionSends;
+  vtkAMRDualGridHelperCommRequestList& receiveList = *this->PendingRegionReceives;
+
+  // Remember which processes each local block receives regions from so that
+  // blocks can be processed as soon as their own regions have arrived.
+  std::vector<vtkAMRDualGridHelperDegenerateRegion>::iterator region;
+  for (region = this->DegenerateRegionQueue.begin(); region != this->DegenerateRegionQueue.end();
+       ++region)
+  {
+    int sendProc = region->SourceBlock->ProcessId;
+    if (region->ReceivingBlock->ProcessId == myProc && sendProc != myProc)
+    {
+      std::vector<int>& sources = this->PendingRegionSources[region->ReceivingBlock];
+      if (std::find(sources.begin(), sources.end(), sendProc) == sources.end())
+      {
+        sources.push_back(sendProc);
+      }
+    }
+  }
 
   VTK_CREATE(vtkIdTypeArray, srcProcs);
   srcProcs->SetNumberOfValues(numProcs);
@@ -2143,8 +2316,8 @@ void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueueMPIAsynchronous(bool hack
     }
   }
 
-  // Finally, finish all communications as they come in.
-  this->FinishDegenerateRegionsCommMPIAsynchronous(hackLevelFlag, sendList, receiveList);
+  // The communications are finished by WaitForBlockRegionCopies() and
+  // FinishRegionRemoteCopyQueue() as they come in.
 }
 
 void vtkAMRDualGridHelper::ReceiveDegenerateRegionsFromQueueMPIAsynchronous(
@@ -2333,7 +2506,15 @@ int vtkAMRDualGridHelper::Initialize(vtkNonOverlappingAMR* input)
 
 int vtkAMRDualGridHelper::SetupData(vtkNonOverlappingAMR* input, const char* arrayName)
 {
-  vtkTimerLogSmartMarkEvent markevent("vtkAMRDualGridHelper::SetupData", this->Controller);
+  int retVal = this->BeginSetupData(input, arrayName);
+  this->FinishRegionRemoteCopyQueue();
+  return retVal;
+}
+
+//----------------------------------------------------------------------------
+int vtkAMRDualGridHelper::BeginSetupData(vtkNonOverlappingAMR* input, const char* arrayName)
+{
+  vtkTimerLogSmartMarkEvent markevent("vtkAMRDualGridHelper::BeginSetupData", this->Controller);
 
   int blockId, numBlocks;
   int numLevels = input->GetNumberOfLevels();
@@ -2380,8 +2561,9 @@ int vtkAMRDualGridHelper::SetupData(vtkNonOverlappingAMR* input, const char* arr
   // Plan for meshing between blocks.
   this->AssignSharedRegions();
 
-  // Copy regions on level boundaries between processes.
-  this->ProcessRegionRemoteCopyQueue(false);
+  // Copy regions on level boundaries between processes.  This is completed
+  // by WaitForBlockRegionCopies() / FinishRegionRemoteCopyQueue().
+  this->BeginRegionRemoteCopyQueue(false);
 
   // Setup faces for seeding connectivity between blocks.
   // this->CreateFaces();
@@ -2401,6 +2583,15 @@ void vtkAMRDualGridHelper::ShareBlocks()
     return;
   }
 
+  if (this->ShareBlocksWithSpatialNeighbors)
+  {
+    // Only exchange blocks with the processes that can share regions with us.
+    VTK_CREATE(vtkIntArray, neighbors);
+    this->ComputeSpatialNeighbors(neighbors);
+    this->ShareBlocksWithNeighbors(neighbors);
+    return;
+  }
+
   VTK_CREATE(vtkIntArray, sendBuffer);
   // sendBuffer->SetNumberOfValues (4096);
   VTK_CREATE(vtkIntArray, recvBuffer);
@@ -2412,6 +2603,71 @@ void vtkAMRDualGridHelper::ShareBlocks()
   this->UnmarshalBlocks(recvBuffer);
 }
 
+//----------------------------------------------------------------------------
+// Finds the processes whose blocks touch (share a face, edge or corner with)
+// the bounding box of the blocks of this process.  This is a superset of the
+// processes we may have to share regions with.  Only the bounding boxes are
+// gathered, the block meta data is exchanged with the neighbors afterwards.
+void vtkAMRDualGridHelper::ComputeSpatialNeighbors(vtkIntArray* neighbors)
+{
+  int numProcs = this->Controller->GetNumberOfProcesses();
+  int myProc = this->Controller->GetLocalProcessId();
+
+  // Bounds of the local blocks in units of level 0 blocks.  Only local blocks
+  // have been added at this point.  These values are exact since the scale
+  // factors are powers of two.
+  double bounds[6];
+  bounds[0] = bounds[2] = bounds[4] = VTK_DOUBLE_MAX;
+  bounds[1] = bounds[3] = bounds[5] = -VTK_DOUBLE_MAX;
+  int numLevels = this->GetNumberOfLevels();
+  for (int levelIdx = 0; levelIdx < numLevels; ++levelIdx)
+  {
+    vtkAMRDualGridHelperLevel* level = this->Levels[levelIdx];
+    double scale = 1.0 / (double)(1 << levelIdx);
+    int numBlocks = static_cast<int>(level->Blocks.size());
+    for (int blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+    {
+      vtkAMRDualGridHelperBlock* block = level->Blocks[blockIdx];
+      for (int ii = 0; ii < 3; ++ii)
+      {
+        double lo = scale * (double)(block->GridIndex[ii]);
+        double hi = scale * (double)(block->GridIndex[ii] + 1);
+        if (bounds[2 * ii] > lo)
+        {
+          bounds[2 * ii] = lo;
+        }
+        if (bounds[2 * ii + 1] < hi)
+        {
+          bounds[2 * ii + 1] = hi;
+        }
+      }
+    }
+  }
+
+  std::vector<double> allBounds(6 * numProcs);
+  this->Controller->AllGather(bounds, &allBounds[0], 6);
+
+  neighbors->Initialize();
+  if (bounds[0] > bounds[1])
+  { // No blocks, no neighbors.
+    return;
+  }
+  for (int proc = 0; proc < numProcs; ++proc)
+  {
+    const double* other = &allBounds[6 * proc];
+    if (proc == myProc || other[0] > other[1])
+    {
+      continue;
+    }
+    if (other[0] <= bounds[1] && other[1] >= bounds[0] && other[2] <= bounds[3] &&
+      other[3] >= bounds[2] && other[4] <= bounds[5] && other[5] >= bounds[4])
+    {
+      neighbors->InsertNextValue(proc);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
 void vtkAMRDualGridHelper::ShareBlocksWithNeighbors(vtkIntArray* neighbors)
 {
 // Intentionally sharing twice so that we can get agreement with neighbors of neighbors
@@ -2439,6 +2695,7 @@ void vtkAMRDualGridHelper::ShareBlocksWithNeighborsAsynchronous(vtkIntArray* nei
   }
 
   vtkAMRDualGridHelperCommRequestList sendList;
+  vtkAMRDualGridHelperCommRequestList lengthList;
   vtkAMRDualGridHelperCommRequestList receiveList;
 
   int myProc = this->Controller->GetLocalProcessId();
@@ -2447,53 +2704,84 @@ void vtkAMRDualGridHelper::ShareBlocksWithNeighborsAsynchronous(vtkIntArray* nei
   if (!controller)
   {
     vtkErrorMacro("Internal error:"
-                  " ProcessRegionRemoteCopyQueueMPIAsynchronous called without"
+                  " ShareBlocksWithNeighborsAsynchronous called without"
                   " MPI controller.");
     return;
   }
 
-  for (vtkIdType i = 0; i < neighbors->GetNumberOfTuples(); i++)
+  // The message is the same for all neighbors.
+  vtkSmartPointer<vtkIntArray> sendBuffer = vtkSmartPointer<vtkIntArray>::New();
+  this->MarshalBlocks(sendBuffer);
+  vtkSmartPointer<vtkIntArray> sendLength = vtkSmartPointer<vtkIntArray>::New();
+  sendLength->InsertNextValue(sendBuffer->GetNumberOfTuples());
+
+  // Message lengths are exchanged first so that receive buffers can be sized
+  // exactly.
+  vtkIdType numNeighbors = neighbors->GetNumberOfTuples();
+  for (vtkIdType i = 0; i < numNeighbors; i++)
   {
     int neighborProc = neighbors->GetValue(i);
 
-    vtkSmartPointer<vtkIntArray> recvBuffer = vtkSmartPointer<vtkIntArray>::New();
-    // Set this large enough to capture the number of blocks contained in neighbors
-    recvBuffer->SetNumberOfValues(131072);
+    vtkSmartPointer<vtkIntArray> recvLength = vtkSmartPointer<vtkIntArray>::New();
+    recvLength->SetNumberOfValues(1);
 
     vtkAMRDualGridHelperCommRequest request;
     request.SendProcess = neighborProc;
     request.ReceiveProcess = myProc;
-    request.Buffer = recvBuffer;
+    request.Buffer = recvLength;
 
     controller->NoBlockReceive(
-      recvBuffer->GetPointer(0), 131072, neighborProc, SHARED_BLOCK_TAG, request.Request);
+      recvLength->GetPointer(0), 1, neighborProc, SHARED_BLOCK_LENGTH_TAG, request.Request);
 
-    receiveList.push_back(request);
+    lengthList.push_back(request);
   }
 
-  for (vtkIdType i = 0; i < neighbors->GetNumberOfTuples(); i++)
+  for (vtkIdType i = 0; i < numNeighbors; i++)
   {
     int neighborProc = neighbors->GetValue(i);
 
-    vtkSmartPointer<vtkIntArray> sendBuffer = vtkSmartPointer<vtkIntArray>::New();
-    this->MarshalBlocks(sendBuffer);
-
     vtkAMRDualGridHelperCommRequest request;
     request.SendProcess = myProc;
     request.ReceiveProcess = neighborProc;
-    request.Buffer = sendBuffer;
 
+    request.Buffer = sendLength;
+    controller->NoBlockSend(
+      sendLength->GetPointer(0), 1, neighborProc, SHARED_BLOCK_LENGTH_TAG, request.Request);
+    sendList.push_back(request);
+
+    request.Buffer = sendBuffer;
     controller->NoBlockSend(sendBuffer->GetPointer(0), sendBuffer->GetNumberOfTuples(),
       neighborProc, SHARED_BLOCK_TAG, request.Request);
-
     sendList.push_back(request);
   }
 
-  while (!receiveList.empty())
+  // Post the receive of a neighbor's blocks as soon as its length is known
+  // and unmarshal blocks as they arrive.
+  while (!lengthList.empty() || !receiveList.empty())
   {
-    vtkAMRDualGridHelperCommRequest request = receiveList.WaitAny();
-    vtkIntArray* buffer = vtkIntArray::SafeDownCast(request.Buffer);
-    this->UnmarshalBlocksFromOne(buffer, request.SendProcess);
+    vtkAMRDualGridHelperCommRequest request;
+    if (lengthList.TestAny(request))
+    {
+      int messageLength = vtkIntArray::SafeDownCast(request.Buffer)->GetValue(0);
+
+      vtkSmartPointer<vtkIntArray> recvBuffer = vtkSmartPointer<vtkIntArray>::New();
+      recvBuffer->SetNumberOfValues(messageLength);
+      request.Buffer = recvBuffer;
+
+      controller->NoBlockReceive(recvBuffer->GetPointer(0), messageLength, request.SendProcess,
+        SHARED_BLOCK_TAG, request.Request);
+
+      receiveList.push_back(request);
+    }
+    else if (receiveList.TestAny(request))
+    {
+      vtkIntArray* buffer = vtkIntArray::SafeDownCast(request.Buffer);
+      this->UnmarshalBlocksFromOne(buffer, request.SendProcess);
+    }
+    else
+    {
+      vtksys::SystemTools::Delay(1);
+    }
   }
 
   sendList.WaitAll();
@@ -2509,25 +2797,33 @@ void vtkAMRDualGridHelper::ShareBlocksWithNeighborsSynchronous(vtkIntArray* neig
 
   VTK_CREATE(vtkIntArray, sendBuffer);
   VTK_CREATE(vtkIntArray, recvBuffer);
-  recvBuffer->SetNumberOfValues(131072);
 
   int myProc = this->Controller->GetLocalProcessId();
 
   this->MarshalBlocks(sendBuffer);
   int messageLength = sendBuffer->GetNumberOfTuples();
+  int recvLength = 0;
 
   for (vtkIdType i = 0; i < neighbors->GetNumberOfTuples(); i++)
   {
     int neighborProc = neighbors->GetValue(i);
     if (neighborProc < myProc)
     {
+      this->Controller->Send(&messageLength, 1, neighborProc, SHARED_BLOCK_LENGTH_TAG);
       this->Controller->Send(
         sendBuffer->GetPointer(0), messageLength, neighborProc, SHARED_BLOCK_TAG);
-      this->Controller->Receive(recvBuffer->GetPointer(0), 131072, neighborProc, SHARED_BLOCK_TAG);
+      this->Controller->Receive(&recvLength, 1, neighborProc, SHARED_BLOCK_LENGTH_TAG);
+      recvBuffer->SetNumberOfValues(recvLength);
+      this->Controller->Receive(
+        recvBuffer->GetPointer(0), recvLength, neighborProc, SHARED_BLOCK_TAG);
     }
     else
     {
-      this->Controller->Receive(recvBuffer->GetPointer(0), 131072, neighborProc, SHARED_BLOCK_TAG);
+      this->Controller->Receive(&recvLength, 1, neighborProc, SHARED_BLOCK_LENGTH_TAG);
+      recvBuffer->SetNumberOfValues(recvLength);
+      this->Controller->Receive(
+        recvBuffer->GetPointer(0), recvLength, neighborProc, SHARED_BLOCK_TAG);
+      this->Controller->Send(&messageLength, 1, neighborProc, SHARED_BLOCK_LENGTH_TAG);
       this->Controller->Send(
         sendBuffer->GetPointer(0), messageLength, neighborProc, SHARED_BLOCK_TAG);
     }
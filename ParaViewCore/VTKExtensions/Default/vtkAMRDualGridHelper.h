@@ -87,6 +87,20 @@ public:
   vtkBooleanMacro(EnableAsynchronousCommunication, int);
   //@}
 
+  //@{
+  /**
+   * When this option is on (the default) and the input does not provide a
+   * "Neighbors" array, block meta data is only exchanged with processes whose
+   * blocks are spatially adjacent to the blocks of this process.  The
+   * neighboring processes are found from the bounding boxes of the blocks of
+   * all processes, which are much smaller than the blocks themselves.  When
+   * off, every process receives the meta data of all blocks.
+   */
+  vtkGetMacro(ShareBlocksWithSpatialNeighbors, int);
+  vtkSetMacro(ShareBlocksWithSpatialNeighbors, int);
+  vtkBooleanMacro(ShareBlocksWithSpatialNeighbors, int);
+  //@}
+
   //@{
   /**
    * The controller to use for communication.
@@ -97,6 +111,29 @@ public:
 
   int Initialize(vtkNonOverlappingAMR* input);
   int SetupData(vtkNonOverlappingAMR* input, const char* arrayName);
+
+  /**
+   * Same as SetupData() except that, when asynchronous communication is used,
+   * the copies of degenerate regions from remote processes are left in flight.
+   * This makes it possible to overlap the communication with the processing
+   * of local blocks.  Call WaitForBlockRegionCopies() before processing a
+   * block and FinishRegionRemoteCopyQueue() once all blocks are processed.
+   */
+  int BeginSetupData(vtkNonOverlappingAMR* input, const char* arrayName);
+
+  /**
+   * Completes the pending remote region copies `block` depends on (if any).
+   * Messages that arrived in the meantime for other blocks are processed as
+   * well.
+   */
+  void WaitForBlockRegionCopies(vtkAMRDualGridHelperBlock* block);
+
+  /**
+   * Returns true when remote region copies `block` depends on are still in
+   * flight.  Unlike WaitForBlockRegionCopies(), this neither waits nor
+   * processes the messages that arrived.
+   */
+  bool IsBlockRegionCopyPending(vtkAMRDualGridHelperBlock* block);
   const double* GetGlobalOrigin() { return this->GlobalOrigin; }
   const double* GetRootSpacing() { return this->RootSpacing; }
   int GetNumberOfBlocks() { return this->NumberOfBlocksInThisProcess; }
@@ -131,6 +168,13 @@ public:
    * It sends and copies the regions into blocks.
    */
   void ProcessRegionRemoteCopyQueue(bool hackLevelFlag);
+  /**
+   * Split version of ProcessRegionRemoteCopyQueue().  Begin starts the
+   * communication and Finish waits for it to complete.  When asynchronous
+   * communication is not available, Begin does all the work.
+   */
+  void BeginRegionRemoteCopyQueue(bool hackLevelFlag);
+  void FinishRegionRemoteCopyQueue();
   /**
    * Call this before adding regions to the queue.  It clears the queue.
    */
@@ -156,6 +200,7 @@ private:
   void ShareBlocksWithNeighbors(vtkIntArray* neighbors);
   void ShareBlocksWithNeighborsAsynchronous(vtkIntArray* neighbors);
   void ShareBlocksWithNeighborsSynchronous(vtkIntArray* neighbors);
+  void ComputeSpatialNeighbors(vtkIntArray* neighbors);
   void MarshalBlocks(vtkIntArray* buffer);
   void UnmarshalBlocks(vtkIntArray* buffer);
   void UnmarshalBlocksFromOne(vtkIntArray* buffer, int blockProc);
@@ -200,6 +245,7 @@ private:
 
   // NOTE: These methods are NOT DEFINED if not compiled with MPI.
   void ProcessRegionRemoteCopyQueueMPIAsynchronous(bool hackLevelFlag);
+  void BeginRegionRemoteCopyQueueMPIAsynchronous(bool hackLevelFlag);
   void SendDegenerateRegionsFromQueueMPIAsynchronous(
     int recvProc, vtkIdType messageLength, vtkAMRDualGridHelperCommRequestList& sendList);
   void ReceiveDegenerateRegionsFromQueueMPIAsynchronous(
@@ -223,6 +269,15 @@ private:
   int SkipGhostCopy;
 
   int EnableAsynchronousCommunication;
+  int ShareBlocksWithSpatialNeighbors;
+
+  // Remote region copies left in flight by BeginRegionRemoteCopyQueue().
+  // PendingRegionSources maps local receiving blocks to the processes
+  // sending them degenerate regions.
+  vtkAMRDualGridHelperCommRequestList* PendingRegionSends;
+  vtkAMRDualGridHelperCommRequestList* PendingRegionReceives;
+  bool PendingRegionHackLevelFlag;
+  std::map<vtkAMRDualGridHelperBlock*, std::vector<int> > PendingRegionSources;
 
 private:
   vtkAMRDualGridHelper(const vtkAMRDualGridHelper&) VTK_DELETE_FUNCTION;
@@ -15,6 +15,7 @@
 #include "vtkCellIntegrator.h"
 
 #include "vtkCell.h"
+#include "vtkCellType.h"
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
 #include "vtkMath.h"
@@ -400,6 +401,291 @@ double vtkCellIntegrator::Integrate(vtkDataSet* input, vtkIdType cellId)
   return sum;
 }
 
+//-----------------------------------------------------------------------------
+// Batched kernels.
+//
+// Volumes use the divergence theorem: the volume of a cell is the sum of the
+// signed volumes of the tetrahedra joining point 0 to the triangles of the
+// boundary of the cell. Each quad face contributes both of its
+// triangulations with a weight of 1/2, which is exact for bilinear faces.
+// Triangles containing point 0 are degenerate and left out.
+//
+// The coordinates of a batch of cells are first gathered, relative to the
+// first point of each cell, in structure of arrays form. The kernels then
+// loop over the cells of the batch without branches or indirections so that
+// the compiler can vectorize them.
+namespace
+{
+const int VTK_CELL_INTEGRATOR_BATCH_SIZE = 64;
+const int VTK_CELL_INTEGRATOR_MAX_POINTS = 8;
+
+struct vtkCellIntegratorTriangle
+{
+  int Ids[3];
+  double Weight;
+};
+
+const vtkCellIntegratorTriangle vtkCellIntegratorTetraTriangles[] = { { { 1, 2, 3 }, 1.0 } };
+
+const vtkCellIntegratorTriangle vtkCellIntegratorHexTriangles[] = {
+  { { 4, 7, 3 }, 0.5 }, // face 0 4 7 3
+  { { 1, 2, 6 }, 0.5 }, // face 1 2 6 5
+  { { 1, 6, 5 }, 0.5 },
+  { { 1, 2, 5 }, 0.5 },
+  { { 2, 6, 5 }, 0.5 },
+  { { 1, 5, 4 }, 0.5 }, // face 0 1 5 4
+  { { 3, 7, 6 }, 0.5 }, // face 3 7 6 2
+  { { 3, 6, 2 }, 0.5 },
+  { { 3, 7, 2 }, 0.5 },
+  { { 7, 6, 2 }, 0.5 },
+  { { 3, 2, 1 }, 0.5 }, // face 0 3 2 1
+  { { 4, 5, 6 }, 0.5 }, // face 4 5 6 7
+  { { 4, 6, 7 }, 0.5 },
+  { { 4, 5, 7 }, 0.5 },
+  { { 5, 6, 7 }, 0.5 }
+};
+
+const vtkCellIntegratorTriangle vtkCellIntegratorWedgeTriangles[] = {
+  { { 3, 5, 4 }, 1.0 }, // face 3 5 4
+  { { 3, 4, 1 }, 0.5 }, // face 0 3 4 1
+  { { 1, 4, 5 }, 0.5 }, // face 1 4 5 2
+  { { 1, 5, 2 }, 0.5 },
+  { { 1, 4, 2 }, 0.5 },
+  { { 4, 5, 2 }, 0.5 },
+  { { 2, 5, 3 }, 0.5 } // face 2 5 3 0
+};
+
+const vtkCellIntegratorTriangle vtkCellIntegratorPyramidTriangles[] = {
+  { { 3, 2, 1 }, 0.5 }, // face 0 3 2 1
+  { { 1, 2, 4 }, 1.0 }, // face 1 2 4
+  { { 2, 3, 4 }, 1.0 }  // face 2 3 4
+};
+
+// Coordinates of a batch of cells, relative to the first point of each cell.
+struct vtkCellIntegratorBatch
+{
+  double X[VTK_CELL_INTEGRATOR_MAX_POINTS][3][VTK_CELL_INTEGRATOR_BATCH_SIZE];
+  double Origin[3][VTK_CELL_INTEGRATOR_BATCH_SIZE];
+  double Measure[VTK_CELL_INTEGRATOR_BATCH_SIZE];
+  double Center[3][VTK_CELL_INTEGRATOR_BATCH_SIZE];
+};
+
+template <typename TPoint>
+void vtkCellIntegratorGather(vtkCellIntegratorBatch& batch, int numberOfPoints,
+  const vtkIdType* connectivity, const TPoint* points, int size)
+{
+  for (int ll = 0; ll < size; ++ll)
+  {
+    const vtkIdType* cellPts = connectivity + ll * numberOfPoints;
+    const TPoint* origin = points + 3 * cellPts[0];
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      batch.Origin[cc][ll] = origin[cc];
+    }
+    for (int pp = 0; pp < numberOfPoints; ++pp)
+    {
+      const TPoint* pt = points + 3 * cellPts[pp];
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        batch.X[pp][cc][ll] = static_cast<double>(pt[cc]) - static_cast<double>(origin[cc]);
+      }
+    }
+  }
+}
+
+// Sums the signed volumes, and first moments, of the tetrahedra.
+void vtkCellIntegratorVolumes(vtkCellIntegratorBatch& batch,
+  const vtkCellIntegratorTriangle* triangles, int numberOfTriangles, int size)
+{
+  double* measure = batch.Measure;
+  double* cx = batch.Center[0];
+  double* cy = batch.Center[1];
+  double* cz = batch.Center[2];
+  for (int ll = 0; ll < size; ++ll)
+  {
+    measure[ll] = cx[ll] = cy[ll] = cz[ll] = 0.0;
+  }
+  for (int tt = 0; tt < numberOfTriangles; ++tt)
+  {
+    const double(*a)[VTK_CELL_INTEGRATOR_BATCH_SIZE] = batch.X[triangles[tt].Ids[0]];
+    const double(*b)[VTK_CELL_INTEGRATOR_BATCH_SIZE] = batch.X[triangles[tt].Ids[1]];
+    const double(*c)[VTK_CELL_INTEGRATOR_BATCH_SIZE] = batch.X[triangles[tt].Ids[2]];
+    const double weight = triangles[tt].Weight / 6.0;
+    for (int ll = 0; ll < size; ++ll)
+    {
+      double v = weight *
+        (a[0][ll] * (b[1][ll] * c[2][ll] - b[2][ll] * c[1][ll]) +
+          a[1][ll] * (b[2][ll] * c[0][ll] - b[0][ll] * c[2][ll]) +
+          a[2][ll] * (b[0][ll] * c[1][ll] - b[1][ll] * c[0][ll]));
+      measure[ll] += v;
+      cx[ll] += v * (a[0][ll] + b[0][ll] + c[0][ll]);
+      cy[ll] += v * (a[1][ll] + b[1][ll] + c[1][ll]);
+      cz[ll] += v * (a[2][ll] + b[2][ll] + c[2][ll]);
+    }
+  }
+  // The centroid of a tetrahedron is the average of its points, the first
+  // one being the origin.
+  for (int ll = 0; ll < size; ++ll)
+  {
+    cx[ll] *= 0.25;
+    cy[ll] *= 0.25;
+    cz[ll] *= 0.25;
+  }
+}
+
+// Sums the areas, and first moments, of the triangles (0, pt1, pt2).
+void vtkCellIntegratorAreas(vtkCellIntegratorBatch& batch, const int (*triangles)[2],
+  int numberOfTriangles, int size)
+{
+  double* measure = batch.Measure;
+  double* cx = batch.Center[0];
+  double* cy = batch.Center[1];
+  double* cz = batch.Center[2];
+  for (int ll = 0; ll < size; ++ll)
+  {
+    measure[ll] = cx[ll] = cy[ll] = cz[ll] = 0.0;
+  }
+  for (int tt = 0; tt < numberOfTriangles; ++tt)
+  {
+    const double(*a)[VTK_CELL_INTEGRATOR_BATCH_SIZE] = batch.X[triangles[tt][0]];
+    const double(*b)[VTK_CELL_INTEGRATOR_BATCH_SIZE] = batch.X[triangles[tt][1]];
+    for (int ll = 0; ll < size; ++ll)
+    {
+      double nx = a[1][ll] * b[2][ll] - a[2][ll] * b[1][ll];
+      double ny = a[2][ll] * b[0][ll] - a[0][ll] * b[2][ll];
+      double nz = a[0][ll] * b[1][ll] - a[1][ll] * b[0][ll];
+      double area = 0.5 * sqrt(nx * nx + ny * ny + nz * nz);
+      measure[ll] += area;
+      cx[ll] += area * (a[0][ll] + b[0][ll]);
+      cy[ll] += area * (a[1][ll] + b[1][ll]);
+      cz[ll] += area * (a[2][ll] + b[2][ll]);
+    }
+  }
+  for (int ll = 0; ll < size; ++ll)
+  {
+    cx[ll] /= 3.0;
+    cy[ll] /= 3.0;
+    cz[ll] /= 3.0;
+  }
+}
+
+const int vtkCellIntegratorTriangleTriangles[][2] = { { 1, 2 } };
+// Same split as Integrate().
+const int vtkCellIntegratorQuadTriangles[][2] = { { 1, 2 }, { 3, 2 } };
+
+template <typename TPoint>
+bool vtkCellIntegratorIntegrateCells(int cellType, vtkIdType numberOfCells,
+  const vtkIdType* connectivity, const TPoint* points, double* measures, double* centroids)
+{
+  int numberOfPoints = vtkCellIntegrator::GetNumberOfCellPoints(cellType);
+  if (numberOfPoints == 0)
+  {
+    return false;
+  }
+
+  vtkCellIntegratorBatch batch;
+  for (vtkIdType first = 0; first < numberOfCells; first += VTK_CELL_INTEGRATOR_BATCH_SIZE)
+  {
+    int size = static_cast<int>(numberOfCells - first < VTK_CELL_INTEGRATOR_BATCH_SIZE
+        ? numberOfCells - first
+        : VTK_CELL_INTEGRATOR_BATCH_SIZE);
+    vtkCellIntegratorGather(
+      batch, numberOfPoints, connectivity + first * numberOfPoints, points, size);
+
+    switch (cellType)
+    {
+      case VTK_TRIANGLE:
+        vtkCellIntegratorAreas(batch, vtkCellIntegratorTriangleTriangles, 1, size);
+        break;
+      case VTK_QUAD:
+        vtkCellIntegratorAreas(batch, vtkCellIntegratorQuadTriangles, 2, size);
+        break;
+      case VTK_TETRA:
+        vtkCellIntegratorVolumes(batch, vtkCellIntegratorTetraTriangles, 1, size);
+        break;
+      case VTK_HEXAHEDRON:
+        vtkCellIntegratorVolumes(batch, vtkCellIntegratorHexTriangles, 15, size);
+        break;
+      case VTK_WEDGE:
+        vtkCellIntegratorVolumes(batch, vtkCellIntegratorWedgeTriangles, 7, size);
+        break;
+      case VTK_PYRAMID:
+        vtkCellIntegratorVolumes(batch, vtkCellIntegratorPyramidTriangles, 3, size);
+        break;
+    }
+
+    for (int ll = 0; ll < size; ++ll)
+    {
+      measures[first + ll] = batch.Measure[ll];
+    }
+    if (!centroids)
+    {
+      continue;
+    }
+    for (int ll = 0; ll < size; ++ll)
+    {
+      double* centroid = centroids + 3 * (first + ll);
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        double offset = 0.0;
+        if (batch.Measure[ll] != 0.0)
+        {
+          offset = batch.Center[cc][ll] / batch.Measure[ll];
+        }
+        else
+        {
+          // Degenerate cell, use the average of its points.
+          for (int pp = 0; pp < numberOfPoints; ++pp)
+          {
+            offset += batch.X[pp][cc][ll];
+          }
+          offset /= numberOfPoints;
+        }
+        centroid[cc] = batch.Origin[cc][ll] + offset;
+      }
+    }
+  }
+  return true;
+}
+}
+
+//-----------------------------------------------------------------------------
+int vtkCellIntegrator::GetNumberOfCellPoints(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_TRIANGLE:
+      return 3;
+    case VTK_QUAD:
+    case VTK_TETRA:
+      return 4;
+    case VTK_PYRAMID:
+      return 5;
+    case VTK_WEDGE:
+      return 6;
+    case VTK_HEXAHEDRON:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkCellIntegrator::IntegrateCells(int cellType, vtkIdType numberOfCells,
+  const vtkIdType* connectivity, const float* points, double* measures, double* centroids)
+{
+  return vtkCellIntegratorIntegrateCells(
+    cellType, numberOfCells, connectivity, points, measures, centroids);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkCellIntegrator::IntegrateCells(int cellType, vtkIdType numberOfCells,
+  const vtkIdType* connectivity, const double* points, double* measures, double* centroids)
+{
+  return vtkCellIntegratorIntegrateCells(
+    cellType, numberOfCells, connectivity, points, measures, centroids);
+}
+
 //----------------------------------------------------------------------------
 void vtkCellIntegrator::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -21,6 +21,12 @@
  * lines, polylines, triangles, triangle strips, pixels, voxels, convex
  * polygons, quads and tetrahedra. All other 3D cells are triangulated
  * during volume calculation. In such cases, the result may not be exact.
+ *
+ * IntegrateCells() is a batched alternative for the common linear cells
+ * (triangles, quads, tetrahedra, hexahedra, wedges and pyramids). It works
+ * on raw connectivity and point coordinates instead of vtkCell objects and
+ * computes many cells of the same type at once, in a layout the compiler
+ * can vectorize. It can also compute the centroids of the cells.
 */
 
 #ifndef vtkCellIntegrator_h
@@ -45,6 +51,36 @@ public:
    */
   static double Integrate(vtkDataSet* input, vtkIdType cellId);
 
+  //@{
+  /**
+   * Computes the length/area/volume of `numberOfCells` cells of type
+   * `cellType` and, if `centroids` is not NULL, their centroids.
+   * `connectivity` holds the point ids of each cell one after the other,
+   * without cell sizes, i.e. `numberOfCells * GetNumberOfCellPoints(cellType)`
+   * ids. `points` holds 3 coordinates per point. `measures` receives one
+   * value per cell, `centroids` 3 values per cell.
+   *
+   * Volumes are signed, positive for cells following the VTK point
+   * ordering, as for tetrahedra with Integrate(). The volume of hexahedra,
+   * wedges and pyramids is exact for trilinear cells, including cells with
+   * non planar faces. Centroids are the centers of mass of the cells.
+   * Returns false, leaving the outputs untouched, if the cell type is not
+   * supported.
+   */
+  static bool IntegrateCells(int cellType, vtkIdType numberOfCells,
+    const vtkIdType* connectivity, const float* points, double* measures,
+    double* centroids = NULL);
+  static bool IntegrateCells(int cellType, vtkIdType numberOfCells,
+    const vtkIdType* connectivity, const double* points, double* measures,
+    double* centroids = NULL);
+  //@}
+
+  /**
+   * Returns the number of points of cells of type `cellType` when the type
+   * is supported by IntegrateCells(), 0 otherwise.
+   */
+  static int GetNumberOfCellPoints(int cellType);
+
 protected:
   vtkCellIntegrator(){};
   ~vtkCellIntegrator(){};
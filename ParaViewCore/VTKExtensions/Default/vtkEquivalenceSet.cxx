@@ -13,34 +13,132 @@
 
 =========================================================================*/
 #include "vtkEquivalenceSet.h"
-#include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
 
+#include <algorithm>
+#include <atomic>
+
 vtkStandardNewMacro(vtkEquivalenceSet);
 
 //============================================================================
 // A class that implements an equivalent set.  It is used to combine fragments
 // from different processes.
 //
-// I believe that this class is a strictly ordered tree of equivalences.
-// Every member points to its own id or an id smaller than itself.
+// This is a strictly ordered tree of equivalences: every member points to its
+// own id or an id smaller than itself. Roots are only ever linked to smaller
+// roots using compare-and-swap, so concurrent unions can't create cycles and
+// the root of a tree is always its smallest member.
+class vtkEquivalenceSet::vtkInternals
+{
+public:
+  std::atomic<vtkIdType>* References;
+  vtkIdType Size;
+  vtkIdType Allocated;
+
+  vtkInternals()
+    : References(NULL)
+    , Size(0)
+    , Allocated(0)
+  {
+  }
+
+  ~vtkInternals() { delete[] this->References; }
+
+  // Not thread safe.
+  void Reallocate(vtkIdType allocated)
+  {
+    std::atomic<vtkIdType>* references =
+      allocated > 0 ? new std::atomic<vtkIdType>[allocated] : NULL;
+    for (vtkIdType ii = 0; ii < this->Size; ++ii)
+    {
+      references[ii].store(this->References[ii].load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    }
+    delete[] this->References;
+    this->References = references;
+    this->Allocated = allocated;
+  }
+
+  // Not thread safe.
+  void Resize(vtkIdType size)
+  {
+    if (size <= this->Size)
+    {
+      return;
+    }
+    if (size > this->Allocated)
+    {
+      this->Reallocate(std::max(size, 2 * this->Allocated));
+    }
+    for (vtkIdType ii = this->Size; ii < size; ++ii)
+    {
+      // All values inserted are equivalent to only themselves.
+      this->References[ii].store(ii, std::memory_order_relaxed);
+    }
+    this->Size = size;
+  }
+
+  // Finds the root while halving the path. A failed compare-and-swap is
+  // harmless: grandparents are ancestors no matter what other threads do.
+  vtkIdType Find(vtkIdType id)
+  {
+    for (;;)
+    {
+      vtkIdType parent = this->References[id].load(std::memory_order_acquire);
+      if (parent == id)
+      {
+        return id;
+      }
+      vtkIdType grandParent = this->References[parent].load(std::memory_order_acquire);
+      if (grandParent != parent)
+      {
+        this->References[id].compare_exchange_weak(parent, grandParent, std::memory_order_release,
+          std::memory_order_relaxed);
+      }
+      id = grandParent;
+    }
+  }
+
+  void Union(vtkIdType id1, vtkIdType id2)
+  {
+    for (;;)
+    {
+      id1 = this->Find(id1);
+      id2 = this->Find(id2);
+      if (id1 == id2)
+      {
+        return;
+      }
+      // Link the larger root to the smaller one.
+      if (id1 < id2)
+      {
+        std::swap(id1, id2);
+      }
+      vtkIdType expected = id1;
+      if (this->References[id1].compare_exchange_strong(
+            expected, id2, std::memory_order_acq_rel, std::memory_order_relaxed))
+      {
+        return;
+      }
+      // id1 was linked by another thread meanwhile, try again.
+    }
+  }
+};
 
 //----------------------------------------------------------------------------
 vtkEquivalenceSet::vtkEquivalenceSet()
 {
   this->Resolved = 0;
-  this->EquivalenceArray = vtkIntArray::New();
+  this->NumberOfResolvedSets = 0;
+  this->Internals = new vtkInternals();
 }
 
 //----------------------------------------------------------------------------
 vtkEquivalenceSet::~vtkEquivalenceSet()
 {
   this->Resolved = 0;
-  if (this->EquivalenceArray)
-  {
-    this->EquivalenceArray->Delete();
-    this->EquivalenceArray = 0;
-  }
+  delete this->Internals;
+  this->Internals = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -48,14 +146,23 @@ void vtkEquivalenceSet::Initialize()
 {
   this->Resolved = 0;
   this->NumberOfResolvedSets = 0;
-  this->EquivalenceArray->Initialize();
+  this->Internals->Size = 0;
+  this->Internals->Reallocate(0);
 }
 
 //----------------------------------------------------------------------------
 void vtkEquivalenceSet::DeepCopy(vtkEquivalenceSet* in)
 {
   this->Resolved = in->Resolved;
-  this->EquivalenceArray->DeepCopy(in->EquivalenceArray);
+  this->NumberOfResolvedSets = in->NumberOfResolvedSets;
+  this->Internals->Size = 0;
+  this->Internals->Reallocate(in->Internals->Size);
+  this->Internals->Size = in->Internals->Size;
+  for (vtkIdType ii = 0; ii < in->Internals->Size; ++ii)
+  {
+    this->Internals->References[ii].store(
+      in->Internals->References[ii].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -74,36 +181,35 @@ void vtkEquivalenceSet::PrintSelf(ostream& os, vtkIndent indent)
 
 //----------------------------------------------------------------------------
 // Return the id of the equivalent set.
-int vtkEquivalenceSet::GetEquivalentSetId(int memberId)
+vtkIdType vtkEquivalenceSet::GetEquivalentSetId(vtkIdType memberId)
 {
-  int ref;
-
-  ref = this->GetReference(memberId);
-  while (!this->Resolved && ref != memberId)
+  if (memberId >= this->Internals->Size)
+  { // We might consider this an error ...
+    return memberId;
+  }
+  if (this->Resolved)
   {
-    memberId = ref;
-    ref = this->GetReference(memberId);
+    return this->GetReference(memberId);
   }
-
-  return ref;
+  return this->Internals->Find(memberId);
 }
 
 //----------------------------------------------------------------------------
 // Return the id of the equivalent set.
-int vtkEquivalenceSet::GetReference(int memberId)
+vtkIdType vtkEquivalenceSet::GetReference(vtkIdType memberId)
 {
-  if (memberId >= this->EquivalenceArray->GetNumberOfTuples())
+  if (memberId >= this->Internals->Size)
   { // We might consider this an error ...
     return memberId;
   }
-  return this->EquivalenceArray->GetValue(memberId);
+  return this->Internals->References[memberId].load(std::memory_order_acquire);
 }
 
 //----------------------------------------------------------------------------
 // Makes two new or existing ids equivalent.
 // If the array is too small, the range of ids is increased until it contains
 // both the ids.  Negative ids are not allowed.
-void vtkEquivalenceSet::AddEquivalence(int id1, int id2)
+void vtkEquivalenceSet::AddEquivalence(vtkIdType id1, vtkIdType id2)
 {
   if (this->Resolved)
   {
@@ -111,117 +217,58 @@ void vtkEquivalenceSet::AddEquivalence(int id1, int id2)
     return;
   }
 
-  int num = this->EquivalenceArray->GetNumberOfTuples();
-
   // Expand the range to include both ids.
-  while (num <= id1 || num <= id2)
-  {
-    // All values inserted are equivalent to only themselves.
-    this->EquivalenceArray->InsertNextTuple1(num);
-    ++num;
-  }
-
-  // Our rule for references in the equivalent set is that
-  // all elements must point to a member equal to or smaller
-  // than itself.
-
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-
-  // Replace the larger references.
-  if (id1 < id2)
-  {
-    // We could follow the references to the smallest.  It might
-    // make this processing more efficient.  This is a compromise.
-    // The referenced id will always be smaller than the id so
-    // order does not change.
-    this->EquateInternal(this->GetReference(id1), id2);
-  }
-  else
-  {
-    this->EquateInternal(this->GetReference(id2), id1);
-  }
+  this->Internals->Resize(std::max(id1, id2) + 1);
+  this->Internals->Union(id1, id2);
 }
 
 //----------------------------------------------------------------------------
-int vtkEquivalenceSet::GetNumberOfMembers()
+vtkIdType vtkEquivalenceSet::GetNumberOfMembers()
 {
-  return this->EquivalenceArray->GetNumberOfTuples();
+  return this->Internals->Size;
 }
 
 //----------------------------------------------------------------------------
-int* vtkEquivalenceSet::GetPointer()
+void vtkEquivalenceSet::SetNumberOfMembers(vtkIdType num)
 {
-  return this->EquivalenceArray->GetPointer(0);
+  this->Internals->Resize(num);
 }
 
 //----------------------------------------------------------------------------
 void vtkEquivalenceSet::Squeeze()
 {
-  this->EquivalenceArray->Squeeze();
+  this->Internals->Reallocate(this->Internals->Size);
 }
 
 //----------------------------------------------------------------------------
 vtkIdType vtkEquivalenceSet::Capacity()
 {
-  return this->EquivalenceArray->Capacity();
-}
-
-//----------------------------------------------------------------------------
-// id1 must be less than or equal to id2.
-void vtkEquivalenceSet::EquateInternal(int id1, int id2)
-{
-  // This is the reference that might be orphaned in this process.
-  int oldRef = this->GetEquivalentSetId(id2);
-
-  // The two ids are already equal (not the only way they might be equal).
-  if (oldRef == id1)
-  {
-    return;
-  }
-
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-  if (oldRef == id2)
-  {
-    this->EquivalenceArray->SetValue(id2, id1);
-  }
-  else if (oldRef > id1)
-  {
-    this->EquivalenceArray->SetValue(id2, id1);
-    this->EquateInternal(id1, oldRef);
-  }
-  else
-  { // oldRef < id1
-    this->EquateInternal(oldRef, id1);
-  }
+  return this->Internals->Allocated;
 }
 
 //----------------------------------------------------------------------------
 // Returns the number of merged sets.
-int vtkEquivalenceSet::ResolveEquivalences()
+vtkIdType vtkEquivalenceSet::ResolveEquivalences()
 {
   // Go through the equivalence array collapsing chains
   // and assigning consecutive ids.
-  int count = 0;
-  int id;
-  int newId;
-
-  int numIds = this->EquivalenceArray->GetNumberOfTuples();
-  for (int ii = 0; ii < numIds; ++ii)
+  vtkIdType count = 0;
+  std::atomic<vtkIdType>* references = this->Internals->References;
+  vtkIdType numIds = this->Internals->Size;
+  for (vtkIdType ii = 0; ii < numIds; ++ii)
   {
-    id = this->EquivalenceArray->GetValue(ii);
+    vtkIdType id = references[ii].load(std::memory_order_relaxed);
     if (id == ii)
     { // This is a new equivalence set.
-      this->EquivalenceArray->SetValue(ii, count);
+      references[ii].store(count, std::memory_order_relaxed);
       ++count;
     }
     else
     {
       // All earlier ids will be resolved already.
       // This array only point to less than or equal ids. (id <= ii).
-      newId = this->EquivalenceArray->GetValue(id);
-      this->EquivalenceArray->SetValue(ii, newId);
+      references[ii].store(references[id].load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
     }
   }
   this->Resolved = 1;
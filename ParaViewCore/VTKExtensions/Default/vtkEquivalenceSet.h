@@ -18,6 +18,13 @@
  *
  * Useful for connectivity on multiple processes.  Run connectivity
  * on each processes, then make touching fragments equivalent.
+ *
+ * The set is a union-find structure over 64-bit ids (vtkIdType) where every
+ * member references a member equal to or smaller than itself, hence the
+ * representative of each group is its smallest member. Paths are compressed
+ * as they are traversed. Unions and lookups use atomic compare-and-swap so
+ * that many threads can add equivalences concurrently, provided the set was
+ * grown beforehand (see SetNumberOfMembers()).
 */
 
 #ifndef vtkEquivalenceSet_h
@@ -25,7 +32,6 @@
 
 #include "vtkObject.h"
 #include "vtkPVVTKExtensionsDefaultModule.h" //needed for exports
-class vtkIntArray;
 
 class VTKPVVTKEXTENSIONSDEFAULT_EXPORT vtkEquivalenceSet : public vtkObject
 {
@@ -35,30 +41,36 @@ public:
   static vtkEquivalenceSet* New();
 
   void Initialize();
-  void AddEquivalence(int id1, int id2);
+
+  // Makes two new or existing ids equivalent. Negative ids are not allowed.
+  // This may be called concurrently from multiple threads as long as both ids
+  // are less than GetNumberOfMembers(). Otherwise the set has to grow, which
+  // must not happen concurrently with any other call.
+  void AddEquivalence(vtkIdType id1, vtkIdType id2);
 
   // The length of the equivalent array...
   // The Domain of the equivalance map is [0, numberOfMembers).
-  int GetNumberOfMembers();
+  vtkIdType GetNumberOfMembers();
+
+  // Grows the set so that its domain is [0, num), new members being
+  // equivalent to only themselves. Call this before adding equivalences
+  // from multiple threads. The set never shrinks.
+  void SetNumberOfMembers(vtkIdType num);
 
   // Valid only after set is resolved.
   // The range of the map is [0 numberOfResolvedSets)
-  int GetNumberOfResolvedSets() { return this->NumberOfResolvedSets; }
+  vtkIdType GetNumberOfResolvedSets() { return this->NumberOfResolvedSets; }
 
-  // Return the id of the equivalent set.
-  int GetEquivalentSetId(int memberId);
+  // Return the id of the equivalent set. Before the set is resolved, this is
+  // the smallest member of the set. Thread safe.
+  vtkIdType GetEquivalentSetId(vtkIdType memberId);
 
   // Equivalent set ids are reassinged to be sequential.
   // You cannot add anymore equivalences after this is called.
-  virtual int ResolveEquivalences();
+  virtual vtkIdType ResolveEquivalences();
 
   void DeepCopy(vtkEquivalenceSet* in);
 
-  // Needed for sending the set over MPI.
-  // Be very careful with the pointer.
-  // I guess this means do not write to the memory.
-  int* GetPointer();
-
   // Free unused memory
   void Squeeze();
 
@@ -68,20 +80,16 @@ public:
   // We should fix the pointer API and hide this ivar.
   int Resolved;
 
-  int GetReference(int memberId);
+  vtkIdType GetReference(vtkIdType memberId);
 
 protected:
   vtkEquivalenceSet();
   ~vtkEquivalenceSet();
 
-  int NumberOfResolvedSets;
-
-  // To merge connected framgments that have different ids because they were
-  // traversed by different processes or passes.
-  vtkIntArray* EquivalenceArray;
+  vtkIdType NumberOfResolvedSets;
 
-  // Return the id of the equivalent set.
-  void EquateInternal(int id1, int id2);
+  class vtkInternals;
+  vtkInternals* Internals;
 
 private:
   vtkEquivalenceSet(const vtkEquivalenceSet&) VTK_DELETE_FUNCTION;
@@ -24,6 +24,8 @@
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkEquivalenceSet.h"
+#include "vtkGenericCell.h"
+#include "vtkHexahedron.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
@@ -36,12 +38,18 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkTetra.h"
+#include "vtkTimerLog.h"
 #include "vtkTriangle.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkVoxel.h"
+
+#include <algorithm>
 
 // Distributed:
-// Find the max process global point id (face hash).
 // Create a map of fragment id/process.
 // Send face structures to process 0.
 // Add remote faces to face hash (mapping fragment ids).
@@ -49,6 +57,9 @@
 // Arbitrary maximum.  Cells are 3D.
 #define VTK_MAX_FACES_PER_CELL 12
 
+// Number of consecutive cells labeled by a single thread.
+#define VTK_GRID_CONNECTIVITY_CHUNK_SIZE 65536
+
 /*
 Fragment with integration that works on distributed unstrucutred grids.
 
@@ -105,7 +116,7 @@ public:
   unsigned char FaceId;
   // There is no need to keep an array of cell fragemnts.
   // Storing it in the face should be good enough.
-  int FragmentId;
+  vtkIdType FragmentId;
 
   // This is used for merging hashes from multiple processes.
   // It is the index of the face in the original process.
@@ -115,8 +126,9 @@ public:
   // Linked list.
   vtkGridConnectivityFace* NextFace;
 
-  // The three smallest ids for indexing the face.
-  // First id is implicit in the hash.  These are global point ids.
+  // The three smallest ids for indexing the face, sorted.
+  // These are global point ids.
+  vtkIdType CornerId1;
   vtkIdType CornerId2;
   vtkIdType CornerId3;
 };
@@ -221,6 +233,7 @@ vtkGridConnectivityFace* vtkGridConnectivityFaceHeap::NewFace()
     }
     face = this->Heap + this->NextFaceIndex++;
   }
+  face->CornerId1 = 0;
   face->CornerId2 = 0;
   face->CornerId3 = 0;
   // We only need one cell id, because we delete from the hash
@@ -244,9 +257,9 @@ public:
   // Returns the number of faces in the hash (faces returned by iteration).
   vtkIdType GetNumberOfFaces() { return this->NumberOfFaces; }
 
-  // This creates a hash that expects at most "numberOfPoint" points
-  // as indexes.
-  void Initialize(vtkIdType numberOfPoints);
+  // This allocates the hash for about "numberOfFaces" faces.  The hash
+  // grows as needed, so this is only a hint.
+  void Initialize(vtkIdType numberOfFaces);
 
   // These methods ass a face to the hash.  The four point method is for convenience.
   // The points do not need to be sorted.
@@ -263,19 +276,25 @@ public:
   void InitTraversal();
   // Return 0 when finished.
   vtkGridConnectivityFace* GetNextFace();
-  // Since the face does not store the first point id explicitley,
-  // this returns the id from the iterator state.
-  vtkIdType GetFirstPointIndex() { return this->IteratorIndex; }
+  // Returns the smallest corner id of the current face.
+  vtkIdType GetFirstPointIndex()
+  {
+    return this->IteratorCurrent ? this->IteratorCurrent->CornerId1 : -1;
+  }
 
 private:
   // Keep track of the number of faces in the hash for convenience.
   // The user does not need to iterate over all faces to count them.
   vtkIdType NumberOfFaces;
 
-  // Array indexed by faces smallest corner id.
-  // Each element is a linked list of faces that share the point.
+  // Array of buckets indexed by a hash of the three corner ids.
+  // Each element is a linked list of faces.  The number of buckets is a
+  // power of two and follows the number of faces, not the largest point id.
   vtkGridConnectivityFace** Hash;
-  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfBuckets;
+
+  vtkIdType GetBucket(vtkIdType pt1, vtkIdType pt2, vtkIdType pt3);
+  void Rehash(vtkIdType numberOfBuckets);
 
   // Allocates faces efficiently.
   vtkGridConnectivityFaceHeap* Heap;
@@ -288,7 +307,7 @@ private:
 vtkGridConnectivityFaceHash::vtkGridConnectivityFaceHash()
 {
   this->Hash = 0;
-  this->NumberOfPoints = 0;
+  this->NumberOfBuckets = 0;
   this->Heap = new vtkGridConnectivityFaceHeap;
 
   this->IteratorIndex = -1;
@@ -322,7 +341,7 @@ void vtkGridConnectivityFaceHash::InitTraversal()
 
 vtkGridConnectivityFace* vtkGridConnectivityFaceHash::GetNextFace()
 {
-  if (this->IteratorIndex >= this->NumberOfPoints)
+  if (this->IteratorIndex >= this->NumberOfBuckets)
   { // Past the end of the hash.  User must not have initialized.
     return 0;
   }
@@ -336,7 +355,7 @@ vtkGridConnectivityFace* vtkGridConnectivityFaceHash::GetNextFace()
   while (this->IteratorCurrent == 0)
   {
     ++this->IteratorIndex;
-    if (this->IteratorIndex >= this->NumberOfPoints)
+    if (this->IteratorIndex >= this->NumberOfBuckets)
     {
       return 0;
     }
@@ -346,16 +365,54 @@ vtkGridConnectivityFace* vtkGridConnectivityFaceHash::GetNextFace()
   return this->IteratorCurrent;
 }
 
-void vtkGridConnectivityFaceHash::Initialize(vtkIdType numberOfPoints)
+void vtkGridConnectivityFaceHash::Initialize(vtkIdType numberOfFaces)
 {
   if (this->Hash)
   {
     vtkGenericWarningMacro("You can only initialize once.\n");
     return;
   }
-  this->Hash = new vtkGridConnectivityFace*[numberOfPoints];
-  this->NumberOfPoints = numberOfPoints;
-  memset(this->Hash, 0, sizeof(vtkGridConnectivityFace*) * numberOfPoints);
+  vtkIdType numberOfBuckets = 1024;
+  while (numberOfBuckets < numberOfFaces)
+  {
+    numberOfBuckets *= 2;
+  }
+  this->Hash = new vtkGridConnectivityFace*[numberOfBuckets];
+  this->NumberOfBuckets = numberOfBuckets;
+  memset(this->Hash, 0, sizeof(vtkGridConnectivityFace*) * numberOfBuckets);
+}
+
+vtkIdType vtkGridConnectivityFaceHash::GetBucket(vtkIdType pt1, vtkIdType pt2, vtkIdType pt3)
+{
+  // Combine the (sorted) ids so that neighboring faces spread over buckets.
+  vtkTypeUInt64 key = static_cast<vtkTypeUInt64>(pt1) * 0x9E3779B97F4A7C15ULL;
+  key ^= static_cast<vtkTypeUInt64>(pt2) + 0x9E3779B97F4A7C15ULL + (key << 6) + (key >> 2);
+  key ^= static_cast<vtkTypeUInt64>(pt3) + 0x9E3779B97F4A7C15ULL + (key << 6) + (key >> 2);
+  key ^= key >> 29;
+  return static_cast<vtkIdType>(key & static_cast<vtkTypeUInt64>(this->NumberOfBuckets - 1));
+}
+
+void vtkGridConnectivityFaceHash::Rehash(vtkIdType numberOfBuckets)
+{
+  // Faces are relinked, not copied, so pointers to faces stay valid.
+  vtkGridConnectivityFace** oldHash = this->Hash;
+  vtkIdType oldNumberOfBuckets = this->NumberOfBuckets;
+  this->Hash = new vtkGridConnectivityFace*[numberOfBuckets];
+  this->NumberOfBuckets = numberOfBuckets;
+  memset(this->Hash, 0, sizeof(vtkGridConnectivityFace*) * numberOfBuckets);
+  for (vtkIdType ii = 0; ii < oldNumberOfBuckets; ++ii)
+  {
+    vtkGridConnectivityFace* face = oldHash[ii];
+    while (face)
+    {
+      vtkGridConnectivityFace* next = face->NextFace;
+      vtkIdType bucket = this->GetBucket(face->CornerId1, face->CornerId2, face->CornerId3);
+      face->NextFace = this->Hash[bucket];
+      this->Hash[bucket] = face;
+      face = next;
+    }
+  }
+  delete[] oldHash;
 }
 
 vtkGridConnectivityFace* vtkGridConnectivityFaceHash::AddFace(
@@ -401,14 +458,17 @@ vtkGridConnectivityFace* vtkGridConnectivityFaceHash::AddFace(
     pt3 = tmp;
   }
 
-  // Note: We do not check if the point index is out of bounds.
+  if (this->Hash == 0)
+  {
+    this->Initialize(0);
+  }
 
   // Now look for the face in the hash.
-  vtkGridConnectivityFace** ref = this->Hash + pt1; // Keep old ref for editing.
+  vtkGridConnectivityFace** ref = this->Hash + this->GetBucket(pt1, pt2, pt3);
   vtkGridConnectivityFace* face = *ref;
   while (face)
   {
-    if (face->CornerId2 == pt2 && face->CornerId3 == pt3)
+    if (face->CornerId1 == pt1 && face->CornerId2 == pt2 && face->CornerId3 == pt3)
     {
       // Found the face.
       // Remove it from the hash.
@@ -424,12 +484,17 @@ vtkGridConnectivityFace* vtkGridConnectivityFaceHash::AddFace(
   }
   // This is a new face.
   face = this->Heap->NewFace();
+  face->CornerId1 = pt1;
   face->CornerId2 = pt2;
   face->CornerId3 = pt3;
   // Add the face to the hash.
   *ref = face;
 
-  ++this->NumberOfFaces;
+  // Keep the chains short.
+  if (++this->NumberOfFaces > 2 * this->NumberOfBuckets)
+  {
+    this->Rehash(4 * this->NumberOfBuckets);
+  }
 
   return face;
 }
@@ -455,6 +520,7 @@ vtkGridConnectivity::vtkGridConnectivity()
   this->EquivalenceSet = 0;
   this->FragmentVolumes = 0;
   this->FaceHash = 0;
+  this->GlobalPointIdType = VTK_ID_TYPE;
   this->Controller = vtkMultiProcessController::GetGlobalController();
   this->ProcessId = this->Controller ? this->Controller->GetLocalProcessId() : 0;
 }
@@ -507,34 +573,65 @@ int vtkGridConnectivity::CheckInput(vtkUnstructuredGrid* input)
 // pass through the cells (looking at neighbors).  I expect that the number
 // of partial fragments will be close to the number of final fragments.
 // The equivalence set will be used to merge partial fragments that touch.
-// This method also integrates arrays for partial fragments.
-template <class T>
-void vtkGridConnectivityExecuteProcess(vtkGridConnectivity* self, vtkUnstructuredGrid* inputs[],
-  int numberOfInputs, int processId, vtkGridConnectivityFaceHash* faceHash,
-  vtkEquivalenceSet* equivalenceSet, T* globalPtIdPtr)
+//----------------------------------------------------------------------------
+// Cells of the inputs are split in chunks of consecutive cells.  Each chunk
+// computes partial fragments with its own face hash and equivalence set, so
+// chunks can be processed concurrently.  The chunks are then merged into the
+// face hash and equivalence set of the filter (see MergeChunks()).  Fragment
+// ids of a chunk are local to the chunk and start at 1.
+class vtkGridConnectivityChunk
+{
+public:
+  vtkGridConnectivityChunk()
+    : InputIndex(0)
+    , Begin(0)
+    , End(0)
+    , Ghosts(0)
+    , Status(0)
+    , NumberOfFragments(0)
+    , FragmentOffset(0)
+    , NumberOfIgnoredFaces(0)
+    , NumberOfUnhandledCells(0)
+    , MissingArrays(false)
+  {
+    this->Equivalences = vtkEquivalenceSet::New();
+  }
+  ~vtkGridConnectivityChunk() { this->Equivalences->Delete(); }
+
+  int InputIndex;
+  vtkIdType Begin;
+  vtkIdType End;
+  // Ghost and status masks of the input, if any.
+  unsigned char* Ghosts;
+  double* Status;
+
+  vtkGridConnectivityFaceHash Hash;
+  vtkEquivalenceSet* Equivalences;
+  // Local fragment id of each cell of the chunk, 0 for skipped cells.
+  std::vector<vtkIdType> CellFragments;
+  vtkIdType NumberOfFragments;
+  // Offset of the local fragment ids in the fragment ids of the process.
+  vtkIdType FragmentOffset;
+
+  // Problems are counted and reported once all chunks are done.
+  vtkIdType NumberOfIgnoredFaces;
+  vtkIdType NumberOfUnhandledCells;
+  bool MissingArrays;
+
+private:
+  vtkGridConnectivityChunk(const vtkGridConnectivityChunk&) VTK_DELETE_FUNCTION;
+  void operator=(const vtkGridConnectivityChunk&) VTK_DELETE_FUNCTION;
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Splits the cells of all inputs in chunks.
+void vtkGridConnectivityCreateChunks(vtkUnstructuredGrid* inputs[], int numberOfInputs,
+  std::vector<vtkGridConnectivityChunk*>& chunks)
 {
-  // Essentially a count of the fragment ids we have used so far.
-  // We start counting from 1 so 0 can be a special value used to remove faces.
-  int nextFragmentId = 1;
-
-  // I used to allocate a cell array for fragment ids but
-  // THIS ARRAY WAS NOT NECESSARY.  WE JUST KEEP THE FRAGMENT IDS
-  // IN THE FACE STRUCTURES!
-  // The only issue we would have is that we do not assign the fragment id
-  // unitl after all the faces fragemntId pointser have been set.
-  // The pointer sets the face fragment id after the fact.
-  // We could loop over the faces twice.
-  // int* cellFragments = new int[totalNumberOfCellsInProcess];
-  // int* cellFragmentPtr = cellFragments;
-
-  // Loop through all cells of all inputs adding all faces to hash.
-  // Select fragment id for each cell based on neighbors.  We are hoping that
-  // cell order will be spatial and will not be random.
   for (int ii = 0; ii < numberOfInputs; ++ii)
   {
-    vtkDataArray* a = inputs[ii]->GetPointData()->GetGlobalIds();
-    void* ptr = a->GetVoidPointer(0);
-    globalPtIdPtr = static_cast<T*>(ptr);
     vtkIdType numCells = inputs[ii]->GetNumberOfCells();
     // The status array is a mask that identifies unused cells.
     vtkDoubleArray* statusArray =
@@ -548,175 +645,539 @@ void vtkGridConnectivityExecuteProcess(vtkGridConnectivity* self, vtkUnstructure
       vtkGenericWarningMacro("Poorly formed ghost cells. Ignoring them.");
       ghostArray = NULL;
     }
-    double* statusPtr = 0;
-    if (statusArray)
+    for (vtkIdType begin = 0; begin < numCells; begin += VTK_GRID_CONNECTIVITY_CHUNK_SIZE)
+    {
+      vtkGridConnectivityChunk* chunk = new vtkGridConnectivityChunk;
+      chunk->InputIndex = ii;
+      chunk->Begin = begin;
+      chunk->End = std::min(numCells, begin + VTK_GRID_CONNECTIVITY_CHUNK_SIZE);
+      chunk->Ghosts = ghostArray ? ghostArray->GetPointer(0) : 0;
+      chunk->Status = statusArray ? statusArray->GetPointer(0) : 0;
+      chunk->Hash.Initialize((chunk->End - chunk->Begin) / 8);
+      chunks.push_back(chunk);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Gets the global point ids of the faces of a cell.  Tetrahedra, hexahedra
+// and voxels, the cells found in CTH derived grids, are read directly from
+// the connectivity.  Other cells go through the (slower) vtkCell API.
+// Returns the number of faces.
+template <class T>
+int vtkGridConnectivityGetCellFaces(vtkUnstructuredGrid* input, vtkIdType cellId,
+  vtkGenericCell* cell, const T* globalPtIds, vtkIdType faces[][4], int faceSizes[])
+{
+  int numFaces = 0;
+  int faceSize = 0;
+  int* (*faceArray)(int) = 0;
+  switch (input->GetCellType(cellId))
+  {
+    case VTK_TETRA:
+      numFaces = 4;
+      faceSize = 3;
+      faceArray = vtkTetra::GetFaceArray;
+      break;
+    case VTK_HEXAHEDRON:
+      numFaces = 6;
+      faceSize = 4;
+      faceArray = vtkHexahedron::GetFaceArray;
+      break;
+    case VTK_VOXEL:
+      numFaces = 6;
+      faceSize = 4;
+      faceArray = vtkVoxel::GetFaceArray;
+      break;
+  }
+
+  if (faceArray)
+  {
+    vtkIdType npts;
+    vtkIdType* pts;
+    input->GetCellPoints(cellId, npts, pts);
+    for (int kk = 0; kk < numFaces; ++kk)
+    {
+      const int* facePts = faceArray(kk);
+      for (int ll = 0; ll < faceSize; ++ll)
+      {
+        faces[kk][ll] = static_cast<vtkIdType>(globalPtIds[pts[facePts[ll]]]);
+      }
+      faceSizes[kk] = faceSize;
+    }
+    return numFaces;
+  }
+
+  input->GetCell(cellId, cell);
+  numFaces = std::min(cell->GetNumberOfFaces(), VTK_MAX_FACES_PER_CELL);
+  for (int kk = 0; kk < numFaces; ++kk)
+  {
+    vtkCell* faceCell = cell->GetFace(kk);
+    faceSizes[kk] = static_cast<int>(faceCell->GetNumberOfPoints());
+    for (int ll = 0; ll < faceSizes[kk] && ll < 4; ++ll)
     {
-      statusPtr = statusArray->GetPointer(0);
+      faces[kk][ll] = static_cast<vtkIdType>(globalPtIds[faceCell->GetPointId(ll)]);
     }
-    for (vtkIdType jj = 0; jj < numCells; ++jj)
+  }
+  return numFaces;
+}
+
+//----------------------------------------------------------------------------
+// This computes partial fragments for chunks of cells.
+// Partial fragments are connected cells that are discovered by a simple
+// pass through the cells (looking at neighbors).  I expect that the number
+// of partial fragments will be close to the number of final fragments.
+// The equivalence set will be used to merge partial fragments that touch.
+template <class T>
+class vtkGridConnectivityLabelCells
+{
+public:
+  vtkUnstructuredGrid** Inputs;
+  vtkGridConnectivityChunk** Chunks;
+  int ProcessId;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      this->LabelChunk(this->Chunks[ii]);
+    }
+  }
+
+  void Reduce() {}
+
+  void LabelChunk(vtkGridConnectivityChunk* chunk)
+  {
+    vtkUnstructuredGrid* input = this->Inputs[chunk->InputIndex];
+    const T* globalPtIds =
+      static_cast<T*>(input->GetPointData()->GetGlobalIds()->GetVoidPointer(0));
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkGridConnectivityFaceHash* faceHash = &chunk->Hash;
+    vtkEquivalenceSet* equivalenceSet = chunk->Equivalences;
+    chunk->CellFragments.assign(chunk->End - chunk->Begin, 0);
+
+    // Essentially a count of the fragment ids we have used so far.
+    // We start counting from 1 so 0 can be a special value used to remove faces.
+    vtkIdType nextFragmentId = 1;
+
+    // Select fragment id for each cell based on neighbors.  We are hoping that
+    // cell order will be spatial and will not be random.
+    vtkIdType faces[VTK_MAX_FACES_PER_CELL][4];
+    int faceSizes[VTK_MAX_FACES_PER_CELL];
+    for (vtkIdType jj = chunk->Begin; jj < chunk->End; ++jj)
     {
-      if (ghostArray && ghostArray->GetValue(jj) & vtkDataSetAttributes::DUPLICATECELL)
+      if (chunk->Ghosts && chunk->Ghosts[jj] & vtkDataSetAttributes::DUPLICATECELL)
       {
         continue;
       }
-      if (statusPtr == 0 || *statusPtr++ == 0.0)
+      if (chunk->Status && chunk->Status[jj] != 0.0)
       {
-        // Loop through faces of the cell.
-        // This might be an performance bottle neck. (cell api)
-        vtkCell* cell = inputs[ii]->GetCell(jj);
-        int numFaces = cell->GetNumberOfFaces();
-        vtkGridConnectivityFace* newFaces[VTK_MAX_FACES_PER_CELL];
-        int numNewFaces = 0;
-        // As we create / find faces, keep track of the smallest fragment id.
-        int minFragmentId = nextFragmentId;
-        for (int kk = 0; kk < numFaces; ++kk)
+        continue;
+      }
+      // Loop through faces of the cell.
+      int numFaces =
+        vtkGridConnectivityGetCellFaces(input, jj, cell, globalPtIds, faces, faceSizes);
+      vtkGridConnectivityFace* newFaces[VTK_MAX_FACES_PER_CELL];
+      int numNewFaces = 0;
+      // As we create / find faces, keep track of the smallest fragment id.
+      vtkIdType minFragmentId = nextFragmentId;
+      for (int kk = 0; kk < numFaces; ++kk)
+      {
+        vtkGridConnectivityFace* face;
+        if (faceSizes[kk] == 3)
         {
-          vtkGridConnectivityFace* face;
-          vtkCell* faceCell = cell->GetFace(kk);
-          vtkIdType numPoints = faceCell->GetNumberOfPoints();
-          if (numPoints == 3)
-          {
-            vtkIdType ptId1 = static_cast<vtkIdType>(globalPtIdPtr[faceCell->GetPointId(0)]);
-            vtkIdType ptId2 = static_cast<vtkIdType>(globalPtIdPtr[faceCell->GetPointId(1)]);
-            vtkIdType ptId3 = static_cast<vtkIdType>(globalPtIdPtr[faceCell->GetPointId(2)]);
-            face = faceHash->AddFace(ptId1, ptId2, ptId3);
-          }
-          else if (numPoints == 4)
-          {
-            vtkIdType ptId1 = static_cast<vtkIdType>(globalPtIdPtr[faceCell->GetPointId(0)]);
-            vtkIdType ptId2 = static_cast<vtkIdType>(globalPtIdPtr[faceCell->GetPointId(1)]);
-            vtkIdType ptId3 = static_cast<vtkIdType>(globalPtIdPtr[faceCell->GetPointId(2)]);
-            vtkIdType ptId4 = static_cast<vtkIdType>(globalPtIdPtr[faceCell->GetPointId(3)]);
-            face = faceHash->AddFace(ptId1, ptId2, ptId3, ptId4);
-          }
-          else
-          {
-            vtkGenericWarningMacro("Face ignored.");
-            face = 0;
-          }
-          if (face)
-          {
-            if (face->FragmentId > 0)
-            { // face is attached to another cell.
-              // It has been removed from the hash because it is internal.
-              // It is valid until we create another face. (recycle bin)
-              if (face->FragmentId != minFragmentId && minFragmentId < nextFragmentId)
-              {
-                // This cell connects two fragments, we need
-                // to make the fragment ids equivalent.
-                equivalenceSet->AddEquivalence(minFragmentId, face->FragmentId);
-              }
-              // Keep track of the smallest fragment id to use for this cell.
-              if (minFragmentId > face->FragmentId)
-              {
-                minFragmentId = face->FragmentId;
-              }
-            } // end if shared face removed from hash.
-            else
-            { // Face is new.  Add our cell info.
-              // These are needed to create the surface in the second stage.
-              face->ProcessId = processId;
-              face->BlockId = ii;
-              face->CellId = jj;
-              face->FaceId = kk;
-              // We need to save all new faces until we know the final fragment id.
-              if (numNewFaces >= VTK_MAX_FACES_PER_CELL)
-              {
-                vtkGenericWarningMacro("Too many faces.");
-              }
-              else
-              {
-                newFaces[numNewFaces++] = face;
-              }
-            } // end if new face added to hash.
-          }   // end if valid input face
-        }     // Faces
-        // Is this the start of a new fragment?
-        if (minFragmentId == nextFragmentId)
-        { // Cell has no neighbors (traversed yet). New fragment id.
-          // Make sure the equivalence set has the correct number of members.
-          equivalenceSet->AddEquivalence(nextFragmentId, nextFragmentId);
-          nextFragmentId++;
+          face = faceHash->AddFace(faces[kk][0], faces[kk][1], faces[kk][2]);
         }
-        // I do not think that the equivalence set has a more upto date id,
-        // but it cannot hurt to check/
-        minFragmentId = equivalenceSet->GetEquivalentSetId(minFragmentId);
-        // Label the faces with the fragment id we computed.
-        for (int kk = 0; kk < numNewFaces; ++kk)
+        else if (faceSizes[kk] == 4)
         {
-          newFaces[kk]->FragmentId = minFragmentId;
+          face = faceHash->AddFace(faces[kk][0], faces[kk][1], faces[kk][2], faces[kk][3]);
         }
-        // Integrare volume of cell into fragemnt volume array.
-        self->IntegrateCellVolume(cell, minFragmentId, inputs[ii], jj);
-      } // if status
-    }   // for cells
-  }     // for input
-}
+        else
+        {
+          ++chunk->NumberOfIgnoredFaces;
+          face = 0;
+        }
+        if (face)
+        {
+          if (face->FragmentId > 0)
+          { // face is attached to another cell.
+            // It has been removed from the hash because it is internal.
+            // It is valid until we create another face. (recycle bin)
+            if (face->FragmentId != minFragmentId && minFragmentId < nextFragmentId)
+            {
+              // This cell connects two fragments, we need
+              // to make the fragment ids equivalent.
+              equivalenceSet->AddEquivalence(minFragmentId, face->FragmentId);
+            }
+            // Keep track of the smallest fragment id to use for this cell.
+            if (minFragmentId > face->FragmentId)
+            {
+              minFragmentId = face->FragmentId;
+            }
+          } // end if shared face removed from hash.
+          else
+          { // Face is new.  Add our cell info.
+            // These are needed to create the surface in the second stage.
+            face->ProcessId = this->ProcessId;
+            face->BlockId = chunk->InputIndex;
+            face->CellId = jj;
+            face->FaceId = kk;
+            // We need to save all new faces until we know the final fragment id.
+            newFaces[numNewFaces++] = face;
+          } // end if new face added to hash.
+        }   // end if valid input face
+      }     // Faces
+      // Is this the start of a new fragment?
+      if (minFragmentId == nextFragmentId)
+      { // Cell has no neighbors (traversed yet). New fragment id.
+        // Make sure the equivalence set has the correct number of members.
+        equivalenceSet->AddEquivalence(nextFragmentId, nextFragmentId);
+        nextFragmentId++;
+      }
+      // I do not think that the equivalence set has a more upto date id,
+      // but it cannot hurt to check/
+      minFragmentId = equivalenceSet->GetEquivalentSetId(minFragmentId);
+      // Label the faces with the fragment id we computed.
+      for (int kk = 0; kk < numNewFaces; ++kk)
+      {
+        newFaces[kk]->FragmentId = minFragmentId;
+      }
+      // The cell is integrated once the fragment ids of all chunks are known.
+      chunk->CellFragments[jj - chunk->Begin] = minFragmentId;
+    } // for cells
+    chunk->NumberOfFragments = nextFragmentId - 1;
+  }
+};
 
 //----------------------------------------------------------------------------
 template <class T>
-vtkIdType vtkGridConnectivityComputeMax(T* ptr, vtkIdType num)
+void vtkGridConnectivityLabelChunks(vtkUnstructuredGrid* inputs[],
+  std::vector<vtkGridConnectivityChunk*>& chunks, int processId, T*)
 {
-  T max = 0;
-  while (num-- > 0)
+  if (chunks.empty())
   {
-    if (*ptr > max)
-    {
-      max = *ptr;
-    }
-    ++ptr;
+    return;
   }
-  return static_cast<vtkIdType>(max);
+  vtkGridConnectivityLabelCells<T> functor;
+  functor.Inputs = inputs;
+  functor.Chunks = &chunks[0];
+  functor.ProcessId = processId;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), 1, functor);
 }
 
-//-----------------------------------------------------------------------------
-void vtkGridConnectivity::InitializeFaceHash(vtkUnstructuredGrid** inputs, int numberOfInputs)
+//----------------------------------------------------------------------------
+// Integrates the volume and attributes of cells into the partial fragment
+// arrays.  Points, connectivity and arrays are accessed directly.
+// Chunks have disjoint fragment ids, so they can be integrated concurrently.
+class vtkGridConnectivityIntegrator
 {
-  vtkIdType maxId = 0;
+public:
+  vtkGridConnectivityIntegrator(vtkUnstructuredGrid* input, double* volumes,
+    const std::vector<vtkSmartPointer<vtkDoubleArray> >& cellIntegration,
+    const std::vector<vtkSmartPointer<vtkDoubleArray> >& pointIntegration)
+    : Input(input)
+    , Points(input->GetPoints())
+    , Volumes(volumes)
+    , MissingArrays(false)
+  {
+    for (size_t ii = 0; ii < cellIntegration.size(); ++ii)
+    {
+      vtkDoubleArray* da = cellIntegration[ii];
+      vtkDoubleArray* inputArray =
+        vtkDoubleArray::SafeDownCast(input->GetCellData()->GetArray(da->GetName()));
+      if (inputArray == 0 || inputArray->GetNumberOfComponents() != 1)
+      {
+        this->MissingArrays = true;
+        continue;
+      }
+      this->CellInputs.push_back(inputArray->GetPointer(0));
+      this->CellOutputs.push_back(da->GetPointer(0));
+    }
+    for (size_t ii = 0; ii < pointIntegration.size(); ++ii)
+    {
+      vtkDoubleArray* da = pointIntegration[ii];
+      vtkDoubleArray* inputArray =
+        vtkDoubleArray::SafeDownCast(input->GetPointData()->GetArray(da->GetName()));
+      if (inputArray == 0 || inputArray->GetNumberOfComponents() != da->GetNumberOfComponents())
+      {
+        this->MissingArrays = true;
+        continue;
+      }
+      this->PointInputs.push_back(inputArray->GetPointer(0));
+      this->PointOutputs.push_back(da->GetPointer(0));
+      this->PointComponents.push_back(da->GetNumberOfComponents());
+    }
+  }
 
-  // We need to find the maximum global point Id to initialize the face hash.
-  for (int ii = 0; ii < numberOfInputs; ++ii)
+  // Returns false if the cell is not handled (its volume is 0).
+  bool IntegrateCell(vtkIdType cellId, vtkIdType fragmentId)
   {
-    vtkDataArray* a = inputs[ii]->GetPointData()->GetGlobalIds();
-    void* ptr = a->GetVoidPointer(0);
-    vtkIdType numIds = a->GetNumberOfTuples();
-    maxId = 0;
-    this->GlobalPointIdType = a->GetDataType();
-    switch (this->GlobalPointIdType)
+    vtkIdType npts;
+    vtkIdType* pts;
+    this->Input->GetCellPoints(cellId, npts, pts);
+
+    double volume = 0.0;
+    bool handled = true;
+    switch (this->Input->GetCellType(cellId))
     {
-      vtkTemplateMacro(maxId = vtkGridConnectivityComputeMax(static_cast<VTK_TT*>(ptr), numIds));
+      case VTK_TETRA:
+        volume = this->IntegrateTetrahedron(pts[0], pts[1], pts[2], pts[3], fragmentId);
+        break;
+      case VTK_HEXAHEDRON:
+        // For volume, I will tetrahedralize and add the volume of each tetra.
+        volume = this->IntegrateTetrahedron(pts[0], pts[1], pts[3], pts[4], fragmentId);
+        volume += this->IntegrateTetrahedron(pts[5], pts[6], pts[1], pts[4], fragmentId);
+        volume += this->IntegrateTetrahedron(pts[7], pts[6], pts[4], pts[3], fragmentId);
+        volume += this->IntegrateTetrahedron(pts[1], pts[6], pts[2], pts[3], fragmentId);
+        volume += this->IntegrateTetrahedron(pts[4], pts[6], pts[1], pts[3], fragmentId);
+        break;
+      case VTK_VOXEL:
+        volume = this->IntegrateTetrahedron(pts[0], pts[1], pts[2], pts[4], fragmentId);
+        volume += this->IntegrateTetrahedron(pts[5], pts[7], pts[1], pts[4], fragmentId);
+        volume += this->IntegrateTetrahedron(pts[6], pts[7], pts[4], pts[2], fragmentId);
+        volume += this->IntegrateTetrahedron(pts[1], pts[7], pts[3], pts[2], fragmentId);
+        volume += this->IntegrateTetrahedron(pts[4], pts[7], pts[1], pts[2], fragmentId);
+        break;
       default:
-        vtkErrorMacro("ThreadedRequestData: Unknown input ScalarType");
-        return;
+        // Complex cells are not handled.
+        handled = false;
     }
+
+    this->Volumes[fragmentId] += volume;
+    for (size_t ii = 0; ii < this->CellInputs.size(); ++ii)
+    {
+      this->CellOutputs[ii][fragmentId] += this->CellInputs[ii][cellId] * volume;
+    }
+    return handled;
   }
 
-  // Now we need to compute the maximum of all processes.
-  int numProcs = this->Controller->GetNumberOfProcesses();
-  if (this->Controller->GetLocalProcessId() != 0)
+  bool GetMissingArrays() { return this->MissingArrays; }
+
+private:
+  double IntegrateTetrahedron(
+    vtkIdType pt0Id, vtkIdType pt1Id, vtkIdType pt2Id, vtkIdType pt3Id, vtkIdType fragmentId)
   {
-    this->Controller->Send(&maxId, 1, 0, 897324);
-    // Only process 0 needs a hash to hold all procs faces.
+    double pts[4][3];
+    this->Points->GetPoint(pt0Id, pts[0]);
+    this->Points->GetPoint(pt1Id, pts[1]);
+    this->Points->GetPoint(pt2Id, pts[2]);
+    this->Points->GetPoint(pt3Id, pts[3]);
+
+    // Calulate the volume of the tet which is 1/6 * the box product
+    double a[3], b[3], c[3], n[3];
+    for (int i = 0; i < 3; i++)
+    {
+      a[i] = pts[1][i] - pts[0][i];
+      b[i] = pts[2][i] - pts[0][i];
+      c[i] = pts[3][i] - pts[0][i];
+    }
+    vtkMath::Cross(a, b, n);
+    double volume = fabs(vtkMath::Dot(c, n) / 6.0);
+
+    // Integrate all of the point arrays.
+    for (size_t ii = 0; ii < this->PointInputs.size(); ++ii)
+    {
+      const double* in = this->PointInputs[ii];
+      int numComps = this->PointComponents[ii];
+      double* out = this->PointOutputs[ii] + fragmentId * numComps;
+      for (int jj = 0; jj < numComps; ++jj)
+      {
+        double sum = in[pt0Id * numComps + jj] + in[pt1Id * numComps + jj] +
+          in[pt2Id * numComps + jj] + in[pt3Id * numComps + jj];
+        out[jj] += (sum * 0.25) * volume;
+      }
+    }
+    return volume;
   }
-  else
+
+  vtkUnstructuredGrid* Input;
+  vtkPoints* Points;
+  double* Volumes;
+  std::vector<const double*> CellInputs;
+  std::vector<double*> CellOutputs;
+  std::vector<const double*> PointInputs;
+  std::vector<double*> PointOutputs;
+  std::vector<int> PointComponents;
+  bool MissingArrays;
+};
+
+//----------------------------------------------------------------------------
+class vtkGridConnectivityIntegrateCells
+{
+public:
+  vtkUnstructuredGrid** Inputs;
+  vtkGridConnectivityChunk** Chunks;
+  double* Volumes;
+  const std::vector<vtkSmartPointer<vtkDoubleArray> >* CellIntegration;
+  const std::vector<vtkSmartPointer<vtkDoubleArray> >* PointIntegration;
+
+  void operator()(vtkIdType begin, vtkIdType end)
   {
-    for (int ii = 1; ii < numProcs; ++ii)
+    for (vtkIdType ii = begin; ii < end; ++ii)
     {
-      vtkIdType tmp;
-      this->Controller->Receive(&tmp, 1, ii, 897324);
-      if (tmp > maxId)
+      vtkGridConnectivityChunk* chunk = this->Chunks[ii];
+      vtkGridConnectivityIntegrator integrator(this->Inputs[chunk->InputIndex], this->Volumes,
+        *this->CellIntegration, *this->PointIntegration);
+      chunk->MissingArrays = integrator.GetMissingArrays();
+      for (vtkIdType jj = chunk->Begin; jj < chunk->End; ++jj)
       {
-        maxId = tmp;
+        vtkIdType fragmentId = chunk->CellFragments[jj - chunk->Begin];
+        if (fragmentId > 0 && !integrator.IntegrateCell(jj, chunk->FragmentOffset + fragmentId))
+        {
+          ++chunk->NumberOfUnhandledCells;
+        }
       }
     }
   }
+};
+}
+
+//-----------------------------------------------------------------------------
+void vtkGridConnectivity::InitializeFaceHash(vtkUnstructuredGrid** inputs, int numberOfInputs)
+{
+  // The hash is sized from the number of local cells, and grows as faces
+  // from other processes are merged.
+  // Global point ids of every input are read with the type of the first
+  // one, they must all have the same type.
+  this->GlobalPointIdType = VTK_ID_TYPE;
+  if (numberOfInputs > 0)
+  {
+    this->GlobalPointIdType = inputs[0]->GetPointData()->GetGlobalIds()->GetDataType();
+  }
+  vtkIdType numCells = 0;
+  for (int ii = 0; ii < numberOfInputs; ++ii)
+  {
+    if (inputs[ii]->GetPointData()->GetGlobalIds()->GetDataType() != this->GlobalPointIdType)
+    {
+      vtkErrorMacro("All blocks must have global point ids of the same type.");
+      this->GlobalPointIdType = VTK_VOID;
+    }
+    numCells += inputs[ii]->GetNumberOfCells();
+  }
 
   if (this->FaceHash)
   {
     delete this->FaceHash;
   }
   this->FaceHash = new vtkGridConnectivityFaceHash;
-  this->FaceHash->Initialize(maxId + 1);
+  this->FaceHash->Initialize(numCells / 16);
+}
+
+//-----------------------------------------------------------------------------
+// Adds the faces and equivalences of all chunks to the process face hash and
+// equivalence set, offsetting the fragment ids of each chunk.  Faces shared by
+// two chunks are internal: they are removed and their fragments made
+// equivalent.  Returns the number of partial fragments of the process.
+vtkIdType vtkGridConnectivity::MergeChunks(std::vector<vtkGridConnectivityChunk*>& chunks)
+{
+  vtkIdType numFragments = 0;
+  for (size_t ii = 0; ii < chunks.size(); ++ii)
+  {
+    chunks[ii]->FragmentOffset = numFragments;
+    numFragments += chunks[ii]->NumberOfFragments;
+  }
+  if (numFragments > 0)
+  {
+    // Make sure the equivalence set has the correct number of members.
+    this->EquivalenceSet->AddEquivalence(numFragments, numFragments);
+  }
+
+  for (size_t ii = 0; ii < chunks.size(); ++ii)
+  {
+    vtkGridConnectivityChunk* chunk = chunks[ii];
+    vtkIdType offset = chunk->FragmentOffset;
+    for (vtkIdType jj = 1; jj <= chunk->NumberOfFragments; ++jj)
+    {
+      vtkIdType setId = chunk->Equivalences->GetEquivalentSetId(jj);
+      if (setId != jj)
+      {
+        this->EquivalenceSet->AddEquivalence(offset + jj, offset + setId);
+      }
+    }
+
+    vtkGridConnectivityFace* chunkFace;
+    chunk->Hash.InitTraversal();
+    while ((chunkFace = chunk->Hash.GetNextFace()))
+    {
+      vtkIdType fragmentId = offset + chunkFace->FragmentId;
+      vtkGridConnectivityFace* face = this->FaceHash->AddFace(
+        chunk->Hash.GetFirstPointIndex(), chunkFace->CornerId2, chunkFace->CornerId3);
+      if (face->FragmentId > 0)
+      { // The face is shared with a previous chunk.
+        this->EquivalenceSet->AddEquivalence(fragmentId, face->FragmentId);
+      }
+      else
+      {
+        face->ProcessId = chunkFace->ProcessId;
+        face->BlockId = chunkFace->BlockId;
+        face->CellId = chunkFace->CellId;
+        face->FaceId = chunkFace->FaceId;
+        face->FragmentId = fragmentId;
+      }
+    }
+
+    if (chunk->NumberOfIgnoredFaces > 0)
+    {
+      vtkWarningMacro(<< chunk->NumberOfIgnoredFaces << " face(s) ignored.");
+    }
+  }
+  return numFragments;
+}
+
+//-----------------------------------------------------------------------------
+// Integrates the volume and attributes of all cells in the arrays indexed by
+// partial fragment ids.
+void vtkGridConnectivity::IntegrateCells(vtkUnstructuredGrid** inputs,
+  std::vector<vtkGridConnectivityChunk*>& chunks, vtkIdType numberOfFragments)
+{
+  // Fragment ids start at 1, entry 0 is not used.
+  vtkIdType numTuples = numberOfFragments > 0 ? numberOfFragments + 1 : 0;
+  this->FragmentVolumes->SetNumberOfTuples(numTuples);
+  this->FragmentVolumes->FillComponent(0, 0.0);
+  for (size_t ii = 0; ii < this->CellAttributesIntegration.size(); ++ii)
+  {
+    this->CellAttributesIntegration[ii]->SetNumberOfTuples(numTuples);
+    this->CellAttributesIntegration[ii]->FillComponent(0, 0.0);
+  }
+  for (size_t ii = 0; ii < this->PointAttributesIntegration.size(); ++ii)
+  {
+    vtkDoubleArray* da = this->PointAttributesIntegration[ii];
+    da->SetNumberOfTuples(numTuples);
+    for (int comp = 0; comp < da->GetNumberOfComponents(); ++comp)
+    {
+      da->FillComponent(comp, 0.0);
+    }
+  }
+  if (numTuples == 0)
+  {
+    return;
+  }
+
+  vtkGridConnectivityIntegrateCells functor;
+  functor.Inputs = inputs;
+  functor.Chunks = &chunks[0];
+  functor.Volumes = this->FragmentVolumes->GetPointer(0);
+  functor.CellIntegration = &this->CellAttributesIntegration;
+  functor.PointIntegration = &this->PointAttributesIntegration;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), 1, functor);
+
+  vtkIdType numUnhandledCells = 0;
+  bool missingArrays = false;
+  for (size_t ii = 0; ii < chunks.size(); ++ii)
+  {
+    numUnhandledCells += chunks[ii]->NumberOfUnhandledCells;
+    missingArrays = missingArrays || chunks[ii]->MissingArrays;
+  }
+  if (numUnhandledCells > 0)
+  {
+    vtkWarningMacro(<< numUnhandledCells << " complex cell(s) not handled.");
+  }
+  if (missingArrays)
+  {
+    vtkErrorMacro("Missing integration array.");
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -863,17 +1324,55 @@ int vtkGridConnectivity::RequestData(
   // integrated values for each attribute.  The arrays
   // are initialized to 0 and indexed by fragment id.
   this->InitializeIntegrationArrays(inputs, numberOfInputs);
-  // We need to know the maximum globalNodeId (across all processes)
-  // to initialize the face hash.  This methods computes it and initializes.
+  // The face hash is sized from the number of local cells.
   this->InitializeFaceHash(inputs, numberOfInputs);
 
+  // Label cells with partial fragment ids, chunks of cells being processed
+  // concurrently.
+  vtkTimerLog::MarkStartEvent("Labeling cells");
+  std::vector<vtkGridConnectivityChunk*> chunks;
+  vtkGridConnectivityCreateChunks(inputs, numberOfInputs, chunks);
+  int result = 1;
   switch (this->GlobalPointIdType)
   {
-    vtkTemplateMacro(vtkGridConnectivityExecuteProcess(this, inputs, numberOfInputs,
-      this->ProcessId, this->FaceHash, this->EquivalenceSet, static_cast<VTK_TT*>(0)));
+    vtkTemplateMacro(vtkGridConnectivityLabelChunks(
+      inputs, chunks, this->ProcessId, static_cast<VTK_TT*>(0)));
+    case VTK_VOID:
+      // Mixed global point id types, reported by InitializeFaceHash().
+      result = 0;
+      break;
     default:
       vtkErrorMacro("ExecuteProcess: Unknown input ScalarType");
-      return 0;
+      result = 0;
+  }
+  vtkTimerLog::MarkEndEvent("Labeling cells");
+
+  if (result)
+  {
+    vtkTimerLog::MarkStartEvent("Merging chunks");
+    vtkIdType numberOfFragments = this->MergeChunks(chunks);
+    vtkTimerLog::MarkEndEvent("Merging chunks");
+
+    vtkTimerLog::MarkStartEvent("Integrating cells");
+    this->IntegrateCells(inputs, chunks, numberOfFragments);
+    vtkTimerLog::MarkEndEvent("Integrating cells");
+  }
+  for (size_t ii = 0; ii < chunks.size(); ++ii)
+  {
+    delete chunks[ii];
+  }
+  if (!result)
+  {
+    delete[] inputs;
+    delete this->FaceHash;
+    this->FaceHash = 0;
+    this->EquivalenceSet->Delete();
+    this->EquivalenceSet = 0;
+    this->FragmentVolumes->Delete();
+    this->FragmentVolumes = 0;
+    this->CellAttributesIntegration.clear();
+    this->PointAttributesIntegration.clear();
+    return 0;
   }
 
   // Deal with distributed data. Send all polygons to a single process.
@@ -884,10 +1383,14 @@ int vtkGridConnectivity::RequestData(
   // into final volumes indexed by the resolved fragment ids.
   // Note: the ids start from 1.  This is because we started assigning partial fragment ids
   // from 1 so the equivalence set has a entry for 0 even though it is not used.
+  vtkTimerLog::MarkStartEvent("Resolving process faces");
   this->ResolveProcessesFaces();
+  vtkTimerLog::MarkEndEvent("Resolving process faces");
 
   // Use the face hash and integration data to generate the output surface.
+  vtkTimerLog::MarkStartEvent("Generating output");
   this->GenerateOutput(output, inputs);
+  vtkTimerLog::MarkEndEvent("Generating output");
 
   delete[] inputs;
   // The check is not necessary.  It will always be allocated by this point.
@@ -979,7 +1482,7 @@ void vtkGridConnectivity::GenerateOutput(vtkPolyData* output, vtkUnstructuredGri
         outCellPtIds[ii] = outPoints->InsertNextPoint(pt);
       }
       outCells->InsertNextCell(numFacePts, outCellPtIds);
-      cellFragmentIdArray->InsertNextValue(face->FragmentId);
+      cellFragmentIdArray->InsertNextValue(static_cast<int>(face->FragmentId));
 
       // There is no need to pass the fragment ids though the
       // equivalence set because the faces have been changed when
@@ -1061,114 +1564,6 @@ void vtkGridConnectivity::GenerateOutput(vtkPolyData* output, vtkUnstructuredGri
   outCells->Delete();
 }
 
-// To Extend this to integrate all arrays, we will first start with
-// Cell attributes.
-// We will have to make FragmentVolumes into an array with one entry
-// each attribute.
-// We will have to transmit each array around just like the volumes.
-//----------------------------------------------------------------------------
-// Compute the volume for this cell and add it to the fragment volume arrray.
-// Initialize or extend the array if necessary.
-void vtkGridConnectivity::IntegrateCellVolume(
-  vtkCell* cell, int fragmentId, vtkUnstructuredGrid* input, vtkIdType cellIndex)
-{
-  double* volumePtr;
-
-  if (cell->GetCellDimension() != 3)
-  {
-    vtkErrorMacro("Expecting only 3d cells.");
-    return;
-  }
-
-  // Make sure the fragment volume array is big enough.
-  vtkIdType length = this->FragmentVolumes->GetNumberOfTuples();
-  if (length <= fragmentId)
-  {
-    vtkIdType newLength = fragmentId * 2 + 200;
-    this->FragmentVolumes->Resize(newLength);
-    this->FragmentVolumes->SetNumberOfTuples(fragmentId + 1);
-    // Initialize new values to 0.0
-    volumePtr = this->FragmentVolumes->GetPointer(length);
-    for (vtkIdType ii = length; ii < newLength; ++ii)
-    {
-      *volumePtr++ = 0.0;
-    }
-    // Resize all of the integration arrays to be the same.
-    int numArrays = static_cast<int>(this->CellAttributesIntegration.size());
-    for (int ii = 0; ii < numArrays; ++ii)
-    {
-      vtkDoubleArray* da = this->CellAttributesIntegration[ii];
-      da->Resize(newLength);
-      da->SetNumberOfTuples(fragmentId + 1);
-      // Initialize new values to 0.0
-      volumePtr = da->GetPointer(length);
-      for (vtkIdType jj = length; jj < newLength; ++jj)
-      {
-        *volumePtr++ = 0.0;
-      }
-    }
-
-    // resize all of the point integration arrays
-    numArrays = static_cast<int>(this->PointAttributesIntegration.size());
-    for (int ii = 0; ii < numArrays; ++ii)
-    {
-      vtkDoubleArray* da = this->PointAttributesIntegration[ii];
-      da->Resize(newLength);
-      da->SetNumberOfTuples(fragmentId + 1);
-      // Initialize new values to 0.0
-      for (vtkIdType jj = length; jj < newLength; ++jj)
-      {
-        for (int comp = 0; comp < da->GetNumberOfComponents(); ++comp)
-        {
-          da->SetComponent(jj, comp, 0.0);
-        }
-      }
-    }
-  }
-
-  // Now compute the volume of the cell.
-  int cellType = cell->GetCellType();
-  double cellVolume = 0.0;
-  switch (cellType)
-  {
-    case VTK_HEXAHEDRON:
-      cellVolume = this->IntegrateHex(cell, input, fragmentId);
-      break;
-    case VTK_VOXEL:
-      cellVolume = this->IntegrateVoxel(cell, input, fragmentId);
-      break;
-    case VTK_TETRA:
-      cellVolume = this->IntegrateTetrahedron(cell, input, fragmentId);
-      break;
-    default:
-    {
-      cell->Triangulate(1, this->CellPointIds, this->CellPoints);
-      cellVolume = this->IntegrateGeneral3DCell(cell, input, fragmentId);
-    }
-  }
-
-  // update the volume integration
-  volumePtr = this->FragmentVolumes->GetPointer(fragmentId);
-  *volumePtr += cellVolume;
-
-  // Integrate all of the cell arrays.
-  int numArrays = static_cast<int>(this->CellAttributesIntegration.size());
-  for (int ii = 0; ii < numArrays; ++ii)
-  {
-    vtkDoubleArray* da = this->CellAttributesIntegration[ii];
-    vtkDoubleArray* inputArray =
-      vtkDoubleArray::SafeDownCast(input->GetCellData()->GetArray(da->GetName()));
-    if (inputArray == 0)
-    {
-      vtkErrorMacro("Missing integration array.");
-      continue;
-    }
-    double* ptr = da->GetPointer(fragmentId);
-    double attributeValue = inputArray->GetValue(cellIndex);
-    *ptr += attributeValue * cellVolume;
-  }
-}
-
 //----------------------------------------------------------------------------
 // This method expects that every process has raw (unresolved) equivalence set
 // faces and arrays.  At the end of this method, process 0 has face hash,
@@ -1183,7 +1578,7 @@ void vtkGridConnectivity::IntegrateCellVolume(
 // The function that maps the local fragment ids to global fragment ids
 // is returned in the array.
 void vtkGridConnectivity::CollectFacesAndArraysToRootProcess(
-  int* fragmentIdMap, int* fragmentNumFaces)
+  vtkIdType* fragmentIdMap, vtkIdType* fragmentNumFaces)
 {
   vtkIdType msg1[2];
   vtkIdType numFaces;
@@ -1193,7 +1588,7 @@ void vtkGridConnectivity::CollectFacesAndArraysToRootProcess(
   vtkIdType corner1, corner2, corner3;
   vtkIdType blockId, faceId, cellId, fragmentId;
   vtkGridConnectivityFace* face;
-  int numberOfFragments;
+  vtkIdType numberOfFragments;
 
   if (this->Controller->GetLocalProcessId() != 0)
   { // Remote process
@@ -1392,8 +1787,8 @@ void vtkGridConnectivity::ResolveProcessesFaces()
 {
   vtkIdType numFaces;
   int numProcs = this->Controller->GetNumberOfProcesses();
-  int* fragmentIdMap = new int[numProcs + 1];
-  int* fragmentNumFaces = new int[numProcs + 1];
+  vtkIdType* fragmentIdMap = new vtkIdType[numProcs + 1];
+  vtkIdType* fragmentNumFaces = new vtkIdType[numProcs + 1];
 
   this->CollectFacesAndArraysToRootProcess(fragmentIdMap, fragmentNumFaces);
 
@@ -1404,8 +1799,8 @@ void vtkGridConnectivity::ResolveProcessesFaces()
   { // Remote process
     // Now receive the triangles that survived the resolution process.
     numFaces = this->FaceHash->GetNumberOfFaces();
-    int* fragmentIds = new int[numFaces];
-    int* fragmentIdPtr = fragmentIds;
+    vtkIdType* fragmentIds = new vtkIdType[numFaces];
+    vtkIdType* fragmentIdPtr = fragmentIds;
     if (numFaces)
     {
       this->Controller->Receive(fragmentIds, numFaces, 0, 234301);
@@ -1458,11 +1853,11 @@ void vtkGridConnectivity::ResolveProcessesFaces()
       if (numFaces)
       { // just in case new or MPI does not like 0 length arrays.
         // Construct the mask / message
-        int* faceMask = new int[numFaces];
+        vtkIdType* faceMask = new vtkIdType[numFaces];
         // Initialize the mask to "empty set".
         // I am going to index the final fragments starting at 1
         // so I can use 0 as the special "remove face" value.
-        memset(faceMask, 0, numFaces * sizeof(int));
+        memset(faceMask, 0, numFaces * sizeof(vtkIdType));
         // Loop over the faces in the hash.
         this->FaceHash->InitTraversal();
         while ((face = this->FaceHash->GetNextFace()) != 0)
@@ -1552,12 +1947,12 @@ void vtkGridConnectivity::ResolveIntegrationArrays()
   }
 
   vtkDoubleArray* newVolumes = vtkDoubleArray::New();
-  int numSets = this->EquivalenceSet->GetNumberOfResolvedSets();
+  vtkIdType numSets = this->EquivalenceSet->GetNumberOfResolvedSets();
   newVolumes->SetNumberOfTuples(numSets);
   // Initialize all values to 0 to start sumation.
   memset(newVolumes->GetPointer(0), 0, numSets * sizeof(double));
   // Loop over all the partial fragments summing volumes.
-  int numMembers = this->EquivalenceSet->GetNumberOfMembers();
+  vtkIdType numMembers = this->EquivalenceSet->GetNumberOfMembers();
   if (this->FragmentVolumes->GetNumberOfTuples() < numMembers)
   {
     vtkErrorMacro("More partial fragments than volume entries.");
@@ -1565,9 +1960,9 @@ void vtkGridConnectivity::ResolveIntegrationArrays()
   }
   double* partialVolumePtr = this->FragmentVolumes->GetPointer(0);
   double* finalVolumePtr = newVolumes->GetPointer(0);
-  for (int ii = 0; ii < numMembers; ++ii)
+  for (vtkIdType ii = 0; ii < numMembers; ++ii)
   {
-    int setId = this->EquivalenceSet->GetEquivalentSetId(ii);
+    vtkIdType setId = this->EquivalenceSet->GetEquivalentSetId(ii);
     finalVolumePtr[setId] += *partialVolumePtr;
     // update to the next fragment volume
     ++partialVolumePtr;
@@ -1584,9 +1979,9 @@ void vtkGridConnectivity::ResolveIntegrationArrays()
   for (int j = 0; j < numArrays; ++j)
   {
     vtkDoubleArray* da = this->CellAttributesIntegration[j];
-    for (int i = 0; i < da->GetNumberOfTuples(); ++i)
+    for (vtkIdType i = 0; i < da->GetNumberOfTuples(); ++i)
     {
-      int setId = this->EquivalenceSet->GetEquivalentSetId(i);
+      vtkIdType setId = this->EquivalenceSet->GetEquivalentSetId(i);
       if (i != setId)
       {
         double* oldIntegrationPtr = da->GetPointer(i);
@@ -1603,9 +1998,9 @@ void vtkGridConnectivity::ResolveIntegrationArrays()
   for (int j = 0; j < numArrays; ++j)
   {
     vtkDoubleArray* da = this->PointAttributesIntegration[j];
-    for (int i = 0; i < da->GetNumberOfTuples(); ++i)
+    for (vtkIdType i = 0; i < da->GetNumberOfTuples(); ++i)
     {
-      int setId = this->EquivalenceSet->GetEquivalentSetId(i);
+      vtkIdType setId = this->EquivalenceSet->GetEquivalentSetId(i);
       if (i != setId)
       {
         for (int k = 0; k < da->GetNumberOfComponents(); ++k)
@@ -1636,221 +2031,3 @@ void vtkGridConnectivity::ResolveFaceFragmentIds()
     face->FragmentId = this->EquivalenceSet->GetEquivalentSetId(face->FragmentId);
   }
 }
-
-//-----------------------------------------------------------------------------
-double vtkGridConnectivity::ComputeTetrahedronVolume(
-  double* pts0, double* pts1, double* pts2, double* pts3)
-{
-  double a[3], b[3], c[3], n[3];
-  int i;
-  // Compute the principle vectors around pt0 and the
-  // centroid
-  for (i = 0; i < 3; i++)
-  {
-    a[i] = pts1[i] - pts0[i];
-    b[i] = pts2[i] - pts0[i];
-    c[i] = pts3[i] - pts0[i];
-  }
-
-  // Calulate the volume of the tet which is 1/6 * the box product
-  vtkMath::Cross(a, b, n);
-  return fabs(vtkMath::Dot(c, n) / 6.0);
-}
-//-----------------------------------------------------------------------------
-void vtkGridConnectivity::ComputePointIntegration(vtkUnstructuredGrid* input, vtkIdType pt0Id,
-  vtkIdType pt1Id, vtkIdType pt2Id, vtkIdType pt3Id, double volume, int fragmentId)
-{
-  // Integrate all of the point arrays.
-  int numArrays = static_cast<int>(this->PointAttributesIntegration.size());
-  for (int i = 0; i < numArrays; ++i)
-  {
-    vtkDoubleArray* da = this->PointAttributesIntegration[i];
-    vtkDoubleArray* inputArray =
-      vtkDoubleArray::SafeDownCast(input->GetPointData()->GetArray(da->GetName()));
-    if (inputArray == 0)
-    {
-      vtkErrorMacro("Missing integration array.");
-      continue;
-    }
-
-    double sum, outValue;
-    for (int j = 0; j < inputArray->GetNumberOfComponents(); ++j)
-    {
-      sum = inputArray->GetComponent(pt0Id, j);
-      sum += inputArray->GetComponent(pt1Id, j);
-      sum += inputArray->GetComponent(pt2Id, j);
-      sum += inputArray->GetComponent(pt3Id, j);
-
-      outValue = da->GetComponent(fragmentId, j);
-      outValue += ((sum * 0.25) * volume);
-      da->SetComponent(fragmentId, j, outValue);
-    }
-  }
-}
-
-//-----------------------------------------------------------------------------
-double vtkGridConnectivity::IntegrateTetrahedron(
-  vtkCell* tetra, vtkUnstructuredGrid* input, int fragmentId)
-{
-  double pts[4][3];
-  vtkPoints* points = tetra->GetPoints();
-  points->GetPoint(0, pts[0]);
-  points->GetPoint(1, pts[1]);
-  points->GetPoint(2, pts[2]);
-  points->GetPoint(3, pts[3]);
-
-  double volume = this->ComputeTetrahedronVolume(pts[0], pts[1], pts[2], pts[3]);
-
-  vtkIdType ptIds[4];
-  ptIds[0] = tetra->GetPointId(0);
-  ptIds[1] = tetra->GetPointId(1);
-  ptIds[2] = tetra->GetPointId(2);
-  ptIds[3] = tetra->GetPointId(3);
-  this->ComputePointIntegration(input, ptIds[0], ptIds[1], ptIds[2], ptIds[3], volume, fragmentId);
-  return volume;
-}
-
-//-----------------------------------------------------------------------------
-// For axis alligned hexahedral cells
-double vtkGridConnectivity::IntegrateHex(vtkCell* hex, vtkUnstructuredGrid* input, int fragmentId)
-{
-  vtkPoints* points = hex->GetPoints();
-  double pts[8][3];
-  points->GetPoint(0, pts[0]);
-  points->GetPoint(1, pts[1]);
-  points->GetPoint(2, pts[2]);
-  points->GetPoint(3, pts[3]);
-  points->GetPoint(4, pts[4]);
-  points->GetPoint(5, pts[5]);
-  points->GetPoint(6, pts[6]);
-  points->GetPoint(7, pts[7]);
-
-  vtkIdType ptIds[8];
-  ptIds[0] = hex->GetPointId(0);
-  ptIds[1] = hex->GetPointId(1);
-  ptIds[2] = hex->GetPointId(2);
-  ptIds[3] = hex->GetPointId(3);
-  ptIds[4] = hex->GetPointId(4);
-  ptIds[5] = hex->GetPointId(5);
-  ptIds[6] = hex->GetPointId(6);
-  ptIds[7] = hex->GetPointId(7);
-
-  // For volume, I will tetrahedralize and add the volume of each tetra.
-  double volume = 0.0, tetraVolume = 0.0;
-  tetraVolume = this->ComputeTetrahedronVolume(pts[0], pts[1], pts[3], pts[4]);
-  this->ComputePointIntegration(
-    input, ptIds[0], ptIds[1], ptIds[3], ptIds[4], tetraVolume, fragmentId);
-  volume += tetraVolume;
-
-  tetraVolume = this->ComputeTetrahedronVolume(pts[5], pts[6], pts[1], pts[4]);
-  this->ComputePointIntegration(
-    input, ptIds[5], ptIds[6], ptIds[1], ptIds[4], tetraVolume, fragmentId);
-  volume += tetraVolume;
-
-  tetraVolume = this->ComputeTetrahedronVolume(pts[7], pts[6], pts[4], pts[3]);
-  this->ComputePointIntegration(
-    input, ptIds[7], ptIds[6], ptIds[4], ptIds[3], tetraVolume, fragmentId);
-  volume += tetraVolume;
-
-  tetraVolume = this->ComputeTetrahedronVolume(pts[1], pts[6], pts[2], pts[3]);
-  this->ComputePointIntegration(
-    input, ptIds[1], ptIds[6], ptIds[2], ptIds[3], tetraVolume, fragmentId);
-  volume += tetraVolume;
-
-  tetraVolume = this->ComputeTetrahedronVolume(pts[4], pts[6], pts[1], pts[3]);
-  this->ComputePointIntegration(
-    input, ptIds[4], ptIds[6], ptIds[1], ptIds[3], tetraVolume, fragmentId);
-  volume += tetraVolume;
-
-  return volume;
-}
-
-//-----------------------------------------------------------------------------
-// For axis alligned hexahedral cells
-double vtkGridConnectivity::IntegrateVoxel(
-  vtkCell* voxel, vtkUnstructuredGrid* input, int fragmentId)
-{
-  vtkPoints* points = voxel->GetPoints();
-  double pts[8][3];
-  points->GetPoint(0, pts[0]);
-  points->GetPoint(1, pts[1]);
-  points->GetPoint(2, pts[2]);
-  points->GetPoint(3, pts[3]);
-  points->GetPoint(4, pts[4]);
-  points->GetPoint(5, pts[5]);
-  points->GetPoint(6, pts[6]);
-  points->GetPoint(7, pts[7]);
-
-  vtkIdType ptIds[8];
-  ptIds[0] = voxel->GetPointId(0);
-  ptIds[1] = voxel->GetPointId(1);
-  ptIds[2] = voxel->GetPointId(2);
-  ptIds[3] = voxel->GetPointId(3);
-  ptIds[4] = voxel->GetPointId(4);
-  ptIds[5] = voxel->GetPointId(5);
-  ptIds[6] = voxel->GetPointId(6);
-  ptIds[7] = voxel->GetPointId(7);
-
-  // For volume, I will tetrahedralize and add the volume of each tetra.
-  double volume = 0.0, tetraVolume = 0.0;
-  tetraVolume = this->ComputeTetrahedronVolume(pts[0], pts[1], pts[2], pts[4]);
-  this->ComputePointIntegration(
-    input, ptIds[0], ptIds[1], ptIds[2], ptIds[4], tetraVolume, fragmentId);
-  volume += tetraVolume;
-
-  tetraVolume = this->ComputeTetrahedronVolume(pts[5], pts[7], pts[1], pts[4]);
-  this->ComputePointIntegration(
-    input, ptIds[5], ptIds[7], ptIds[1], ptIds[4], tetraVolume, fragmentId);
-  volume += tetraVolume;
-
-  tetraVolume = this->ComputeTetrahedronVolume(pts[6], pts[7], pts[4], pts[2]);
-  this->ComputePointIntegration(
-    input, ptIds[6], ptIds[7], ptIds[4], ptIds[2], tetraVolume, fragmentId);
-  volume += tetraVolume;
-
-  tetraVolume = this->ComputeTetrahedronVolume(pts[1], pts[7], pts[3], pts[2]);
-  this->ComputePointIntegration(
-    input, ptIds[1], ptIds[7], ptIds[3], ptIds[2], tetraVolume, fragmentId);
-  volume += tetraVolume;
-
-  tetraVolume = this->ComputeTetrahedronVolume(pts[4], pts[7], pts[1], pts[2]);
-  this->ComputePointIntegration(
-    input, ptIds[4], ptIds[7], ptIds[1], ptIds[2], tetraVolume, fragmentId);
-  volume += tetraVolume;
-
-  return volume;
-}
-
-//-----------------------------------------------------------------------------
-double vtkGridConnectivity::IntegrateGeneral3DCell(
-  vtkCell* vtkNotUsed(cell), vtkUnstructuredGrid*, int)
-{
-  /*
-  vtkIdType nPnts = ptIds->GetNumberOfIds();
-  // There should be a number of points that is a multiple of 4
-  // from the triangulation
-  if (nPnts % 4)
-    {
-    vtkWarningMacro("Number of points ("
-                    << nPnts << ") is not divisiable by 4 - skipping "
-                    << " 3D Cell: " << cellId);
-    return;
-    }
-
-  vtkIdType tetIdx = 0;
-  vtkIdType pt1Id, pt2Id, pt3Id, pt4Id;
-
-  while (tetIdx < nPnts)
-    {
-    pt1Id = ptIds->GetId(tetIdx++);
-    pt2Id = ptIds->GetId(tetIdx++);
-    pt3Id = ptIds->GetId(tetIdx++);
-    pt4Id = ptIds->GetId(tetIdx++);
-    this->IntegrateTetrahedron(input, output, cellId, pt1Id, pt2Id, pt3Id,
-                               pt4Id);
-    }
-  */
-  vtkWarningMacro("Complex cell not handled.");
-
-  return 0.0;
-}
@@ -23,6 +23,12 @@
  * The output of this filter is a single point and vertex.  The attributes
  * for this point and cell will contain the integration results
  * for the corresponding input attributes.
+ *
+ * Faces are matched using global point ids in a hash sized by the number of
+ * faces rather than by the largest global point id.  Cells are labeled and
+ * integrated in chunks of consecutive cells processed concurrently with
+ * vtkSMPTools, tetrahedra, hexahedra and voxels being read directly from the
+ * connectivity.  The duration of each phase is recorded with vtkTimerLog.
 */
 
 #ifndef vtkGridConnectivity_h
@@ -33,13 +39,11 @@
 #include "vtkSmartPointer.h"                 // For ivars
 #include <vector>                            // For ivars
 
-class vtkCell;
-class vtkPoints;
 class vtkDoubleArray;
-class vtkIdList;
 class vtkInformation;
 class vtkInformationVector;
 class vtkMultiProcessController;
+class vtkGridConnectivityChunk;
 class vtkGridConnectivityFaceHash;
 class vtkEquivalenceSet;
 class vtkUnstructuredGrid;
@@ -52,10 +56,6 @@ public:
   void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
   static vtkGridConnectivity* New();
 
-  // Public so templated function can access this method.
-  void IntegrateCellVolume(
-    vtkCell* cell, int fragmentId, vtkUnstructuredGrid* input, vtkIdType cellIndex);
-
 protected:
   vtkGridConnectivity();
   ~vtkGridConnectivity();
@@ -79,29 +79,25 @@ protected:
   // This method returns 1 if the input has the necessary arrays for this filter.
   int CheckInput(vtkUnstructuredGrid* grid);
 
-  // Find the maximum global point id and allocate the hash.
+  // Allocate the face hash and find the type of the global point ids.
   void InitializeFaceHash(vtkUnstructuredGrid** inputs, int numberOfInputs);
   vtkGridConnectivityFaceHash* FaceHash;
 
   void InitializeIntegrationArrays(vtkUnstructuredGrid** inputs, int numberOfInputs);
 
+  // Merge the faces and fragments of the chunks labeled concurrently.
+  // Returns the number of partial fragments.
+  vtkIdType MergeChunks(std::vector<vtkGridConnectivityChunk*>& chunks);
+  // Integrate volume and attributes of the cells of all chunks.
+  void IntegrateCells(vtkUnstructuredGrid** inputs, std::vector<vtkGridConnectivityChunk*>& chunks,
+    vtkIdType numberOfFragments);
+
   vtkEquivalenceSet* EquivalenceSet;
   vtkDoubleArray* FragmentVolumes;
 
   std::vector<vtkSmartPointer<vtkDoubleArray> > CellAttributesIntegration;
   std::vector<vtkSmartPointer<vtkDoubleArray> > PointAttributesIntegration;
 
-  // Temporary structures to help integration.
-  vtkPoints* CellPoints;
-  vtkIdList* CellPointIds;
-  double IntegrateTetrahedron(vtkCell* tetra, vtkUnstructuredGrid* input, int fragmentId);
-  double IntegrateHex(vtkCell* hex, vtkUnstructuredGrid* input, int fragmentId);
-  double IntegrateVoxel(vtkCell* voxel, vtkUnstructuredGrid* input, int fragmentId);
-  double IntegrateGeneral3DCell(vtkCell* cell, vtkUnstructuredGrid* input, int fragmentId);
-  double ComputeTetrahedronVolume(double* pts0, double* pts1, double* pts2, double* pts3);
-  void ComputePointIntegration(vtkUnstructuredGrid* input, vtkIdType pt0Id, vtkIdType pt1Id,
-    vtkIdType pt2Id, vtkIdType pt3Id, double volume, int fragmentId);
-
   void ResolveIntegrationArrays();
   void ResolveFaceFragmentIds();
 
@@ -110,7 +106,7 @@ protected:
 
   void ResolveEquivalentFragments();
   void ResolveProcessesFaces();
-  void CollectFacesAndArraysToRootProcess(int* fragmentIdMap, int* fragmentNumFaces);
+  void CollectFacesAndArraysToRootProcess(vtkIdType* fragmentIdMap, vtkIdType* fragmentNumFaces);
 
 private:
   vtkGridConnectivity(const vtkGridConnectivity&) VTK_DELETE_FUNCTION;
@@ -54,6 +54,9 @@
 #include "vtkMaterialInterfaceToProcMap.h"
 #include "vtkPointAccumulator.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUnsignedIntArray.h"
 // IO & IPC
 #include "vtkDataSetWriter.h"
@@ -1540,6 +1543,110 @@ int vtkMaterialInterfaceFilterRingBuffer::Pop(vtkMaterialInterfaceFilterIterator
 
 //============================================================================
 
+//----------------------------------------------------------------------------
+// The fragment pieces found in a single block. Blocks are processed
+// concurrently, each with its own instance, so this also holds the
+// accumulators and the scratch space used while walking a piece.
+// Piece ids are local to the block until ProcessBlocks numbers them.
+class vtkMaterialInterfaceFilterBlockFragments
+{
+public:
+  vtkMaterialInterfaceFilterBlockFragments();
+  ~vtkMaterialInterfaceFilterBlockFragments();
+
+  // Save the accumulated attributes of the current piece and clear
+  // the accumulators.
+  void FinishFragment();
+
+  // Local id of current piece.
+  int FragmentId;
+  // Accumulators for the current piece.
+  vtkPolyData* CurrentFragmentMesh;
+  double FragmentVolume;
+  double ClipDepthMin;
+  double ClipDepthMax;
+  std::vector<double> FragmentMoment; // =(Myz, Mxz, Mxy, m)
+  std::vector<std::vector<double> > FragmentVolumeWtdAvg;
+  std::vector<std::vector<double> > FragmentMassWtdAvg;
+  std::vector<std::vector<double> > FragmentSum;
+
+  // Attributes of the finished pieces indexed by local id.
+  std::vector<vtkPolyData*> FragmentMeshes;
+  std::vector<double> FragmentVolumes;
+  std::vector<double> ClipDepthMinimums;
+  std::vector<double> ClipDepthMaximums;
+  std::vector<double> FragmentMoments;
+  std::vector<std::vector<double> > FragmentVolumeWtdAvgs;
+  std::vector<std::vector<double> > FragmentMassWtdAvgs;
+  std::vector<std::vector<double> > FragmentSums;
+
+  // Scratch space for computing the point on corners and edges of a face.
+  vtkMaterialInterfaceFilterIterator FaceNeighbors[32];
+  double FaceCornerPoints[12];
+  double FaceEdgePoints[12];
+  int FaceEdgeFlags[4];
+};
+
+//----------------------------------------------------------------------------
+vtkMaterialInterfaceFilterBlockFragments::vtkMaterialInterfaceFilterBlockFragments()
+{
+  this->FragmentId = 0;
+  this->CurrentFragmentMesh = 0;
+  this->FragmentVolume = 0.0;
+  this->ClipDepthMin = VTK_FLOAT_MAX;
+  this->ClipDepthMax = 0.0;
+}
+
+//----------------------------------------------------------------------------
+vtkMaterialInterfaceFilterBlockFragments::~vtkMaterialInterfaceFilterBlockFragments()
+{
+  // Meshes that were not handed over to the filter.
+  ClearVectorOfVtkPointers(this->FragmentMeshes);
+  if (this->CurrentFragmentMesh)
+  {
+    this->CurrentFragmentMesh->Delete();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceFilterBlockFragments::FinishFragment()
+{
+  this->CurrentFragmentMesh->Squeeze();
+  this->FragmentMeshes.push_back(this->CurrentFragmentMesh);
+  this->CurrentFragmentMesh = 0;
+
+  this->FragmentVolumes.push_back(this->FragmentVolume);
+  this->FragmentVolume = 0.0;
+  this->ClipDepthMaximums.push_back(this->ClipDepthMax);
+  this->ClipDepthMax = 0.0;
+  this->ClipDepthMinimums.push_back(this->ClipDepthMin);
+  this->ClipDepthMin = VTK_FLOAT_MAX;
+  this->FragmentMoments.insert(
+    this->FragmentMoments.end(), this->FragmentMoment.begin(), this->FragmentMoment.end());
+  FillVector(this->FragmentMoment, 0.0);
+  for (size_t i = 0; i < this->FragmentVolumeWtdAvg.size(); ++i)
+  {
+    this->FragmentVolumeWtdAvgs[i].insert(this->FragmentVolumeWtdAvgs[i].end(),
+      this->FragmentVolumeWtdAvg[i].begin(), this->FragmentVolumeWtdAvg[i].end());
+    FillVector(this->FragmentVolumeWtdAvg[i], 0.0);
+  }
+  for (size_t i = 0; i < this->FragmentMassWtdAvg.size(); ++i)
+  {
+    this->FragmentMassWtdAvgs[i].insert(this->FragmentMassWtdAvgs[i].end(),
+      this->FragmentMassWtdAvg[i].begin(), this->FragmentMassWtdAvg[i].end());
+    FillVector(this->FragmentMassWtdAvg[i], 0.0);
+  }
+  for (size_t i = 0; i < this->FragmentSum.size(); ++i)
+  {
+    this->FragmentSums[i].insert(
+      this->FragmentSums[i].end(), this->FragmentSum[i].begin(), this->FragmentSum[i].end());
+    FillVector(this->FragmentSum[i], 0.0);
+  }
+  ++this->FragmentId;
+}
+
+//============================================================================
+
 //----------------------------------------------------------------------------
 // Description:
 // Construct object with initial range (0,1) and single contour value
@@ -1608,17 +1715,13 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->RootSpacing[0] = this->RootSpacing[1] = this->RootSpacing[2] = 1.0;
 
   this->FragmentId = 0;
-  this->FragmentVolume = 0.0;
   this->FragmentVolumes = 0;
-  this->FragmentMoment.resize(4, 0.0);
   this->FragmentMoments = 0;
   this->FragmentAABBCenters = 0;
   this->FragmentOBBs = 0;
   this->FragmentSplitGeometry = 0;
 
   // Keep depth of crater along clip plane normal.
-  this->ClipDepthMax = 0.0;
-  this->ClipDepthMin = VTK_FLOAT_MAX;
   this->ClipDepthMaximums = 0;
   this->ClipDepthMinimums = 0;
 
@@ -1633,10 +1736,6 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->ResolvedFragmentCenters = 0;
   this->ResolvedFragmentOBBs = 0;
 
-  this->FaceNeighbors = new vtkMaterialInterfaceFilterIterator[32];
-
-  this->CurrentFragmentMesh = 0;
-
   this->NVolumeWtdAvgs = 0;
   this->NToSum = 0;
   this->ComputeMoments = false;
@@ -1679,9 +1778,6 @@ vtkMaterialInterfaceFilter::~vtkMaterialInterfaceFilter()
   this->RootSpacing[0] = this->RootSpacing[1] = this->RootSpacing[2] = 1.0;
 
   this->FragmentId = 0;
-  this->FragmentVolume = 0.0;
-  this->ClipDepthMax = 0.0;
-  this->ClipDepthMin = VTK_FLOAT_MAX;
 
   this->SetClipFunction(0);
 
@@ -1699,9 +1795,6 @@ vtkMaterialInterfaceFilter::~vtkMaterialInterfaceFilter()
   delete this->EquivalenceSet;
   this->EquivalenceSet = 0;
 
-  delete[] this->FaceNeighbors;
-  this->FaceNeighbors = 0;
-
   // clean up PV interface
   this->MaterialArraySelection->RemoveObserver(this->SelectionObserver);
   this->MaterialArraySelection->Delete();
@@ -1837,6 +1930,45 @@ void vtkMaterialInterfaceFilter::DeleteAllBlocks()
   }
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Initializes input blocks concurrently. Each block only reads its own
+// image and the (read-only) clipping function, so blocks are independent.
+class vtkMaterialInterfaceInitializeBlocksWorker
+{
+public:
+  vtkMaterialInterfaceFilterBlock** Blocks;
+  vector<vtkImageData*>* Images;
+  vector<int>* Levels;
+  double* GlobalOrigin;
+  double* RootSpacing;
+  string* MaterialFractionArrayName;
+  string* MassArrayName;
+  vector<string>* VolumeWtdAvgArrayNames;
+  vector<string>* MassWtdAvgArrayNames;
+  vector<string>* SummedArrayNames;
+  vector<string>* IntegratedArrayNames;
+  int InvertVolumeFraction;
+  vtkMaterialInterfaceFilterHalfSphere* Sphere;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      // Do we really need the block to know its id?
+      // We use it to find neighbors.  We should save pointers
+      // directly in neighbor array. We also use it for debugging.
+      this->Blocks[blockId]->Initialize(static_cast<int>(blockId), (*this->Images)[blockId],
+        (*this->Levels)[blockId], this->GlobalOrigin, this->RootSpacing,
+        *this->MaterialFractionArrayName, *this->MassArrayName, *this->VolumeWtdAvgArrayNames,
+        *this->MassWtdAvgArrayNames, *this->SummedArrayNames, *this->IntegratedArrayNames,
+        this->InvertVolumeFraction, this->Sphere);
+    }
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 // Initialize blocks from multi block input.
 int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
@@ -1896,7 +2028,42 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
   }
 
   // Initialize each block with the input image
-  // and global index coordinate system.
+  // and global index coordinate system. Blocks are independent of each other
+  // so the (expensive) volume fraction setup is done in parallel.
+  vector<vtkImageData*> blockImages;
+  vector<int> blockLevels;
+  blockImages.reserve(this->NumberOfInputBlocks);
+  blockLevels.reserve(this->NumberOfInputBlocks);
+  for (level = 0; level < numLevels; ++level)
+  {
+    int numBlocks = input->GetNumberOfDataSets(level);
+    for (int levelBlockId = 0; levelBlockId < numBlocks; ++levelBlockId)
+    {
+      vtkImageData* image = input->GetDataSet(level, levelBlockId);
+      if (image)
+      {
+        this->InputBlocks[blockImages.size()] = new vtkMaterialInterfaceFilterBlock;
+        blockImages.push_back(image);
+        blockLevels.push_back(level);
+      }
+    }
+  }
+  vtkMaterialInterfaceInitializeBlocksWorker initializer;
+  initializer.Blocks = this->InputBlocks;
+  initializer.Images = &blockImages;
+  initializer.Levels = &blockLevels;
+  initializer.GlobalOrigin = this->GlobalOrigin;
+  initializer.RootSpacing = this->RootSpacing;
+  initializer.MaterialFractionArrayName = &materialFractionArrayName;
+  initializer.MassArrayName = &massArrayName;
+  initializer.VolumeWtdAvgArrayNames = &volumeWtdAvgArrayNames;
+  initializer.MassWtdAvgArrayNames = &massWtdAvgArrayNames;
+  initializer.SummedArrayNames = &summedArrayNames;
+  initializer.IntegratedArrayNames = &integratedArrayNames;
+  initializer.InvertVolumeFraction = this->InvertVolumeFraction;
+  initializer.Sphere = sphere;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blockImages.size()), 1, initializer);
+
   int blockIndex = -1;
   this->Levels.resize(numLevels);
   for (level = 0; level < numLevels; ++level)
@@ -1917,13 +2084,8 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
 
       if (image)
       {
-        block = this->InputBlocks[++blockIndex] = new vtkMaterialInterfaceFilterBlock;
-        // Do we really need the block to know its id?
-        // We use it to find neighbors.  We should save pointers
-        // directly in neighbor array. We also use it for debugging.
-        block->Initialize(blockIndex, image, level, this->GlobalOrigin, this->RootSpacing,
-          materialFractionArrayName, massArrayName, volumeWtdAvgArrayNames, massWtdAvgArrayNames,
-          summedArrayNames, integratedArrayNames, this->InvertVolumeFraction, sphere);
+        // Initialized above.
+        block = this->InputBlocks[++blockIndex];
         // For debugging:
         block->LevelBlockId = levelBlockId;
 
@@ -3229,14 +3391,11 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
 {
   this->FragmentId = 0;
 
-  this->FragmentVolume = 0.0;
   ReNewVtkPointer(this->FragmentVolumes);
   this->FragmentVolumes->SetName("Volume");
 
   if (this->ClipWithPlane)
   {
-    this->ClipDepthMax = 0.0;
-    this->ClipDepthMin = VTK_FLOAT_MAX;
     ReNewVtkPointer(this->ClipDepthMaximums);
     ReNewVtkPointer(this->ClipDepthMinimums);
     this->ClipDepthMaximums->SetName("ClipDepthMax");
@@ -3245,8 +3404,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
 
   if (this->ComputeMoments)
   {
-    this->FragmentMoment.clear();
-    this->FragmentMoment.resize(4, 0.0);
     ReNewVtkPointer(this->FragmentMoments);
     this->FragmentMoments->SetNumberOfComponents(4);
     this->FragmentMoments->SetName("Moments");
@@ -3284,11 +3441,9 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
   // Configure data structures
   // 1) Volume weighted average of attribute over the
   // fragment set up containers
-  this->FragmentVolumeWtdAvg.clear();
-  this->FragmentVolumeWtdAvg.resize(this->NVolumeWtdAvgs);
   ClearVectorOfVtkPointers(this->FragmentVolumeWtdAvgs);
   this->FragmentVolumeWtdAvgs.resize(this->NVolumeWtdAvgs);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NVolumeWtdAvgs; ++j)
   {
     // data array
@@ -3307,16 +3462,12 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "VolumeWeightedAverage-" << thisArrayName;
     this->FragmentVolumeWtdAvgs[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentVolumeWtdAvg[j].resize(nComp, 0.0);
   }
   // 2) Mass weighted average of attribute over the fragment
   // set up containers
-  this->FragmentMassWtdAvg.clear();
-  this->FragmentMassWtdAvg.resize(this->NMassWtdAvgs);
   ClearVectorOfVtkPointers(this->FragmentMassWtdAvgs);
   this->FragmentMassWtdAvgs.resize(this->NMassWtdAvgs);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NMassWtdAvgs; ++j)
   {
     // data array
@@ -3335,16 +3486,12 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "MassWeightedAverage-" << thisArrayName;
     this->FragmentMassWtdAvgs[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentMassWtdAvg[j].resize(nComp, 0.0);
   }
   // 3) Summation of attribute over the fragment
   // set up containers
-  this->FragmentSum.clear();
-  this->FragmentSum.resize(this->NToSum);
   ClearVectorOfVtkPointers(this->FragmentSums);
   this->FragmentSums.resize(this->NToSum);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NToSum; ++j)
   {
     // data array
@@ -3363,8 +3510,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "Summation-" << thisArrayName;
     this->FragmentSums[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentSum[j].resize(nComp, 0.0);
   }
 
   // 4) Unique list of integrated attributes
@@ -3592,12 +3737,8 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StartTimer();
 #endif
-    int blockId;
-    for (blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
-    {
-      // build fragments
-      this->ProcessBlock(blockId);
-    }
+    // build fragments
+    this->ProcessBlocks();
 #ifdef vtkMaterialInterfaceFilterPROFILE
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StopTimer();
@@ -3741,23 +3882,192 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
 }
 
 //----------------------------------------------------------------------------
-int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
+// Processes a range of input blocks, each into its own set of pieces.
+class vtkMaterialInterfaceFilterProcessBlocksFunctor
 {
-#ifdef vtkMaterialInterfaceFilterDEBUG
-  ostringstream progressMesg;
-  progressMesg << "vtkMaterialInterfaceFilter::ProcessBlock(" << blockId << ") , Material "
-               << this->MaterialId;
-  this->SetProgressText(progressMesg.str().c_str());
-#endif
-  this->Progress += this->ProgressBlockInc;
+public:
+  vtkMaterialInterfaceFilter* Filter;
+  vtkMaterialInterfaceFilterBlockFragments** BlockFragments;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      this->Filter->ProcessBlock(static_cast<int>(blockId), this->BlockFragments[blockId]);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+namespace
+{
+// Converts the block local piece ids stored in the voxels to ids
+// local to the process.
+class vtkMaterialInterfaceRenumberFragmentsWorker
+{
+public:
+  vtkMaterialInterfaceFilterBlock** Blocks;
+  int* Offsets;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      vtkMaterialInterfaceFilterBlock* block = this->Blocks[blockId];
+      int offset = this->Offsets[blockId];
+      if (block == 0 || offset == 0)
+      {
+        continue;
+      }
+      const int* ext = block->GetBaseCellExtent();
+      const int* incs = block->GetCellIncrements();
+      int* pz = block->GetBaseFragmentIdPointer();
+      for (int iz = ext[4]; iz <= ext[5]; ++iz)
+      {
+        int* py = pz;
+        for (int iy = ext[2]; iy <= ext[3]; ++iy)
+        {
+          int* px = py;
+          for (int ix = ext[0]; ix <= ext[1]; ++ix)
+          {
+            if (*px >= 0)
+            {
+              *px += offset;
+            }
+            px += incs[0];
+          }
+          py += incs[1];
+        }
+        pz += incs[2];
+      }
+    }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceFilter::ProcessBlocks()
+{
+  const int nBlocks = this->NumberOfInputBlocks;
+  vector<vtkMaterialInterfaceFilterBlockFragments*> blockFragments(nBlocks);
+  for (int blockId = 0; blockId < nBlocks; ++blockId)
+  {
+    blockFragments[blockId] = new vtkMaterialInterfaceFilterBlockFragments;
+  }
+
+  // Find the pieces in each block. The walk does not leave the block,
+  // so blocks are independent.
+  if (nBlocks > 0)
+  {
+    vtkMaterialInterfaceFilterProcessBlocksFunctor processor;
+    processor.Filter = this;
+    processor.BlockFragments = &blockFragments[0];
+    vtkSMPTools::For(0, nBlocks, 1, processor);
+  }
+  this->Progress += this->ProgressBlockInc * nBlocks;
   this->UpdateProgress(this->Progress);
 
+  // Number the pieces in block order and append their attributes.
+  vector<int> offsets(nBlocks, 0);
+  for (int blockId = 0; blockId < nBlocks; ++blockId)
+  {
+    vtkMaterialInterfaceFilterBlockFragments* fragments = blockFragments[blockId];
+    offsets[blockId] = this->FragmentId;
+    for (int localId = 0; localId < fragments->FragmentId; ++localId)
+    {
+      this->EquivalenceSet->AddEquivalence(this->FragmentId, this->FragmentId);
+      // the id is implicit given by its position in the vector, but only
+      // until fragments are resolved. After resolution we add addributes such
+      // as id, volume, summations averages, etc..
+      this->FragmentMeshes.push_back(fragments->FragmentMeshes[localId]);
+      this->FragmentVolumes->InsertTuple1(this->FragmentId, fragments->FragmentVolumes[localId]);
+      if (this->ClipWithPlane)
+      {
+        this->ClipDepthMaximums->InsertTuple1(
+          this->FragmentId, fragments->ClipDepthMaximums[localId]);
+        this->ClipDepthMinimums->InsertTuple1(
+          this->FragmentId, fragments->ClipDepthMinimums[localId]);
+      }
+      if (this->ComputeMoments)
+      {
+        this->FragmentMoments->InsertTuple(
+          this->FragmentId, &fragments->FragmentMoments[4 * localId]);
+      }
+      for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+      {
+        int nComps = this->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents();
+        this->FragmentVolumeWtdAvgs[i]->InsertTuple(
+          this->FragmentId, &fragments->FragmentVolumeWtdAvgs[i][nComps * localId]);
+      }
+      for (int i = 0; i < this->NMassWtdAvgs; ++i)
+      {
+        int nComps = this->FragmentMassWtdAvgs[i]->GetNumberOfComponents();
+        this->FragmentMassWtdAvgs[i]->InsertTuple(
+          this->FragmentId, &fragments->FragmentMassWtdAvgs[i][nComps * localId]);
+      }
+      for (int i = 0; i < this->NToSum; ++i)
+      {
+        int nComps = this->FragmentSums[i]->GetNumberOfComponents();
+        this->FragmentSums[i]->InsertTuple(
+          this->FragmentId, &fragments->FragmentSums[i][nComps * localId]);
+      }
+      ++this->FragmentId;
+    }
+    // The filter owns the meshes now.
+    fragments->FragmentMeshes.clear();
+    delete fragments;
+  }
+
+  if (nBlocks > 0)
+  {
+    vtkMaterialInterfaceRenumberFragmentsWorker renumber;
+    renumber.Blocks = this->InputBlocks;
+    renumber.Offsets = &offsets[0];
+    vtkSMPTools::For(0, nBlocks, 1, renumber);
+  }
+
+  // Pieces that touch across block boundaries are the same fragment.
+  this->ConnectBlockFragments();
+}
+
+//----------------------------------------------------------------------------
+// Finds the fragments of a single block. Only voxels of this block are
+// labelled, so different blocks can be processed concurrently.
+// Pieces that continue in a neighboring block are connected afterwards
+// by ConnectBlockFragments.
+int vtkMaterialInterfaceFilter::ProcessBlock(
+  int blockId, vtkMaterialInterfaceFilterBlockFragments* fragments)
+{
   vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
   if (block == 0)
   {
     return 0;
   }
 
+  // Size the accumulators.
+  fragments->FragmentMoment.resize(4, 0.0);
+  fragments->FragmentVolumeWtdAvg.resize(this->NVolumeWtdAvgs);
+  fragments->FragmentVolumeWtdAvgs.resize(this->NVolumeWtdAvgs);
+  for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+  {
+    int nComps = this->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents();
+    fragments->FragmentVolumeWtdAvg[i].resize(nComps, 0.0);
+  }
+  fragments->FragmentMassWtdAvg.resize(this->NMassWtdAvgs);
+  fragments->FragmentMassWtdAvgs.resize(this->NMassWtdAvgs);
+  for (int i = 0; i < this->NMassWtdAvgs; ++i)
+  {
+    int nComps = this->FragmentMassWtdAvgs[i]->GetNumberOfComponents();
+    fragments->FragmentMassWtdAvg[i].resize(nComps, 0.0);
+  }
+  fragments->FragmentSum.resize(this->NToSum);
+  fragments->FragmentSums.resize(this->NToSum);
+  for (int i = 0; i < this->NToSum; ++i)
+  {
+    int nComps = this->FragmentSums[i]->GetNumberOfComponents();
+    fragments->FragmentSum[i].resize(nComps, 0.0);
+  }
+
   vtkMaterialInterfaceFilterIterator* xIterator = new vtkMaterialInterfaceFilterIterator;
   vtkMaterialInterfaceFilterIterator* yIterator = new vtkMaterialInterfaceFilterIterator;
   vtkMaterialInterfaceFilterIterator* zIterator = new vtkMaterialInterfaceFilterIterator;
@@ -3791,65 +4101,14 @@ int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
         if (*(xIterator->FragmentIdPointer) == -1 &&
           *(xIterator->VolumeFractionPointer) > this->scaledMaterialFractionThreshold)
         { // We have a new fragment.
-          this->CurrentFragmentMesh = this->NewFragmentMesh();
-          this->EquivalenceSet->AddEquivalence(this->FragmentId, this->FragmentId);
+          fragments->CurrentFragmentMesh = this->NewFragmentMesh();
           // We have to mark every voxel we push on the queue.
-          *(xIterator->FragmentIdPointer) = this->FragmentId;
+          *(xIterator->FragmentIdPointer) = fragments->FragmentId;
           // There should be no need to clear the queue.
           queue->Push(xIterator);
-          this->ConnectFragment(queue);
-          // save the current fragment mesh
-          // the id is implicit given by its position in the vector, but only
-          // until fragments are resolved. After resolution we add addributes such
-          // as id, volume, summations averages, etc..
-          this->CurrentFragmentMesh->Squeeze();
-          this->FragmentMeshes.push_back(this->CurrentFragmentMesh);
-          // Save the volume from the last fragment.
-          this->FragmentVolumes->InsertTuple1(this->FragmentId, this->FragmentVolume);
-          if (this->ClipWithPlane)
-          {
-            this->ClipDepthMaximums->InsertTuple1(this->FragmentId, this->ClipDepthMax);
-            this->ClipDepthMinimums->InsertTuple1(this->FragmentId, this->ClipDepthMin);
-          }
-          // clear the volume accumulator
-          this->FragmentVolume = 0.0;
-          this->ClipDepthMax = 0.0;
-          this->ClipDepthMin = VTK_FLOAT_MAX;
-          if (this->ComputeMoments)
-          {
-            // Save the moments from the last fragment
-            this->FragmentMoments->InsertTuple(this->FragmentId, &this->FragmentMoment[0]);
-            // clear the moment accumulator
-            FillVector(this->FragmentMoment, 0.0);
-          }
-          // for the volume weighted averaged scalars/vectors...
-          for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
-          {
-            // update the integrated value, independent of ncomps
-            this->FragmentVolumeWtdAvgs[i]->InsertTuple(
-              this->FragmentId, &this->FragmentVolumeWtdAvg[i][0]);
-            // clear the accumulator
-            FillVector(this->FragmentVolumeWtdAvg[i], 0.0);
-          }
-          // for the mass weighted averaged scalars/vectors...
-          for (int i = 0; i < this->NMassWtdAvgs; ++i)
-          {
-            // update the integrated value, independent of ncomps
-            this->FragmentMassWtdAvgs[i]->InsertTuple(
-              this->FragmentId, &this->FragmentMassWtdAvg[i][0]);
-            // clear the accumulator
-            FillVector(this->FragmentMassWtdAvg[i], 0.0);
-          }
-          // for the summed scalars/vectors...
-          for (int i = 0; i < this->NToSum; ++i)
-          {
-            // update the integrated value, independent of ncomps
-            this->FragmentSums[i]->InsertTuple(this->FragmentId, &this->FragmentSum[i][0]);
-            // clear the accumulator
-            FillVector(this->FragmentSum[i], 0.0);
-          }
-          // Move to next fragment.
-          ++this->FragmentId;
+          this->ConnectFragment(fragments, queue);
+          // Save the mesh and attributes and move to next fragment.
+          fragments->FinishFragment();
         }
         xIterator->FlatIndex += cellIncs[0]; // 1/ncomp
         xIterator->VolumeFractionPointer += cellIncs[0];
@@ -4249,7 +4508,8 @@ int vtkMaterialInterfaceFilter::ComputeDisplacementFactors(
 // It will be modified with the sub voxel displacement.
 // The return value indicates that an edge may be non manifold.
 // It returns the y or z axis index of the edge that may be non manifold.
-int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
+int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(
+  vtkMaterialInterfaceFilterBlockFragments* fragments, double* point,
   vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx, int faceAxis)
 {
   int retVal;
@@ -4298,13 +4558,13 @@ int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
     projection = (point[0] - this->ClipCenter[0]) * this->ClipPlaneNormal[0];
     projection += (point[1] - this->ClipCenter[1]) * this->ClipPlaneNormal[1];
     projection += (point[2] - this->ClipCenter[2]) * this->ClipPlaneNormal[2];
-    if (this->ClipDepthMax < projection)
+    if (fragments->ClipDepthMax < projection)
     {
-      this->ClipDepthMax = projection;
+      fragments->ClipDepthMax = projection;
     }
-    if (this->ClipDepthMin > projection)
+    if (fragments->ClipDepthMin > projection)
     {
-      this->ClipDepthMin = projection;
+      fragments->ClipDepthMin = projection;
     }
   }
 
@@ -4322,8 +4582,9 @@ int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
 // Now to fix cracks.  If neighbors are higher level,
 // I need to have more than 4 points for a face.
 // I am only going to support transitions of 1 level.
-void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterBlockFragments* fragments,
+  vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+  int outMaxFlag)
 {
   if (in->Block == 0 || in->Block->GetGhostFlag())
   {
@@ -4346,8 +4607,8 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   // Add points to the output.  Create separate points for each triangle.
   // We can worry about merging points later.
   vtkMaterialInterfaceFilterIterator* cornerNeighbors[8];
-  vtkPoints* points = this->CurrentFragmentMesh->GetPoints(); // TODO for performance store?
-  vtkCellArray* polys = this->CurrentFragmentMesh->GetPolys();
+  vtkPoints* points = fragments->CurrentFragmentMesh->GetPoints(); // TODO for performance store?
+  vtkCellArray* polys = fragments->CurrentFragmentMesh->GetPolys();
   vtkIdType quadCornerIds[4];
   vtkIdType quadMidIds[4];
   vtkIdType triPtIds[3];
@@ -4358,10 +4619,10 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 
   // Compute the corner and edge points (before subpixel positioning).
   // Store the results in ivars.
-  this->ComputeFacePoints(in, out, axis, outMaxFlag);
+  this->ComputeFacePoints(fragments, in, out, axis, outMaxFlag);
   // Find the neighbor iterators.
   // Store the results in ivars.
-  this->ComputeFaceNeighbors(in, out, axis, outMaxFlag);
+  this->ComputeFaceNeighbors(fragments, in, out, axis, outMaxFlag);
 
   // A word about indexing:
   // face neighbors 2x4x4 indexed face normal axis first, axis1, then axis2.
@@ -4396,55 +4657,59 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   // to perform connectivity on the 2x2x2 point neighbors.
   int inNeighborIdx;
 
-  cornerNeighbors[i0] = &(this->FaceNeighbors[0]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[1]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[2]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[3]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[8]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[9]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[10]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[11]);
+  cornerNeighbors[i0] = &(fragments->FaceNeighbors[0]);
+  cornerNeighbors[i1] = &(fragments->FaceNeighbors[1]);
+  cornerNeighbors[i2] = &(fragments->FaceNeighbors[2]);
+  cornerNeighbors[i3] = &(fragments->FaceNeighbors[3]);
+  cornerNeighbors[i4] = &(fragments->FaceNeighbors[8]);
+  cornerNeighbors[i5] = &(fragments->FaceNeighbors[9]);
+  cornerNeighbors[i6] = &(fragments->FaceNeighbors[10]);
+  cornerNeighbors[i7] = &(fragments->FaceNeighbors[11]);
   inNeighborIdx = outMaxFlag ? i6 : i7; // Face neighbor 10 or 11
   manifoldIssue[0] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints, cornerNeighbors, inNeighborIdx, axis);
+    this->SubVoxelPositionCorner(
+      fragments, fragments->FaceCornerPoints, cornerNeighbors, inNeighborIdx, axis);
   // 1 =>
-  quadCornerIds[0] = points->InsertNextPoint(this->FaceCornerPoints);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[4]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[5]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[6]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[7]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[12]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[13]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[14]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[15]);
+  quadCornerIds[0] = points->InsertNextPoint(fragments->FaceCornerPoints);
+  cornerNeighbors[i0] = &(fragments->FaceNeighbors[4]);
+  cornerNeighbors[i1] = &(fragments->FaceNeighbors[5]);
+  cornerNeighbors[i2] = &(fragments->FaceNeighbors[6]);
+  cornerNeighbors[i3] = &(fragments->FaceNeighbors[7]);
+  cornerNeighbors[i4] = &(fragments->FaceNeighbors[12]);
+  cornerNeighbors[i5] = &(fragments->FaceNeighbors[13]);
+  cornerNeighbors[i6] = &(fragments->FaceNeighbors[14]);
+  cornerNeighbors[i7] = &(fragments->FaceNeighbors[15]);
   inNeighborIdx = outMaxFlag ? i4 : i5; // Face neighbor 12 or 13
   manifoldIssue[1] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 3, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[1] = points->InsertNextPoint(this->FaceCornerPoints + 3);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[16]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[17]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[18]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[19]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[24]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[25]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[26]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[27]);
+    this->SubVoxelPositionCorner(
+      fragments, fragments->FaceCornerPoints + 3, cornerNeighbors, inNeighborIdx, axis);
+  quadCornerIds[1] = points->InsertNextPoint(fragments->FaceCornerPoints + 3);
+  cornerNeighbors[i0] = &(fragments->FaceNeighbors[16]);
+  cornerNeighbors[i1] = &(fragments->FaceNeighbors[17]);
+  cornerNeighbors[i2] = &(fragments->FaceNeighbors[18]);
+  cornerNeighbors[i3] = &(fragments->FaceNeighbors[19]);
+  cornerNeighbors[i4] = &(fragments->FaceNeighbors[24]);
+  cornerNeighbors[i5] = &(fragments->FaceNeighbors[25]);
+  cornerNeighbors[i6] = &(fragments->FaceNeighbors[26]);
+  cornerNeighbors[i7] = &(fragments->FaceNeighbors[27]);
   inNeighborIdx = outMaxFlag ? i2 : i3; // Face neighbor 18 or 19
   manifoldIssue[2] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 6, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[2] = points->InsertNextPoint(this->FaceCornerPoints + 6);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[20]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[21]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[22]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[23]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[28]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[29]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[30]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[31]);
+    this->SubVoxelPositionCorner(
+      fragments, fragments->FaceCornerPoints + 6, cornerNeighbors, inNeighborIdx, axis);
+  quadCornerIds[2] = points->InsertNextPoint(fragments->FaceCornerPoints + 6);
+  cornerNeighbors[i0] = &(fragments->FaceNeighbors[20]);
+  cornerNeighbors[i1] = &(fragments->FaceNeighbors[21]);
+  cornerNeighbors[i2] = &(fragments->FaceNeighbors[22]);
+  cornerNeighbors[i3] = &(fragments->FaceNeighbors[23]);
+  cornerNeighbors[i4] = &(fragments->FaceNeighbors[28]);
+  cornerNeighbors[i5] = &(fragments->FaceNeighbors[29]);
+  cornerNeighbors[i6] = &(fragments->FaceNeighbors[30]);
+  cornerNeighbors[i7] = &(fragments->FaceNeighbors[31]);
   inNeighborIdx = outMaxFlag ? i0 : i1; // Face neighbor 20 or 21
   manifoldIssue[3] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 9, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[3] = points->InsertNextPoint(this->FaceCornerPoints + 9);
+    this->SubVoxelPositionCorner(
+      fragments, fragments->FaceCornerPoints + 9, cornerNeighbors, inNeighborIdx, axis);
+  quadCornerIds[3] = points->InsertNextPoint(fragments->FaceCornerPoints + 9);
 
   // If both corners of an edge have an issue, the we need an extra
   // point on the edge to generate a hole.
@@ -4457,93 +4722,97 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   if (manifoldIssue[0] != 0 && manifoldIssue[1] != 0 && tmp[manifoldIssue[0]] == 1 &&
     tmp[manifoldIssue[1]] == 1)
   {
-    this->FaceEdgeFlags[0] = 1;
+    fragments->FaceEdgeFlags[0] = 1;
   }
 
   if (manifoldIssue[0] != 0 && manifoldIssue[2] != 0 && tmp[manifoldIssue[0]] == 2 &&
     tmp[manifoldIssue[2]] == 2)
   {
-    this->FaceEdgeFlags[1] = 1;
+    fragments->FaceEdgeFlags[1] = 1;
   }
   if (manifoldIssue[1] != 0 && manifoldIssue[3] != 0 && tmp[manifoldIssue[1]] == 2 &&
     tmp[manifoldIssue[3]] == 2)
   {
-    this->FaceEdgeFlags[2] = 1;
+    fragments->FaceEdgeFlags[2] = 1;
   }
   if (manifoldIssue[2] != 0 && manifoldIssue[3] && tmp[manifoldIssue[2]] == 1 &&
     tmp[manifoldIssue[3]] == 1)
   {
-    this->FaceEdgeFlags[3] = 1;
+    fragments->FaceEdgeFlags[3] = 1;
   }
 
   // Now for the mid edge point if the neighbors on that side are smaller.
-  if (this->FaceEdgeFlags[0])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[2]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[3]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[4]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[5]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[10]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[11]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[12]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[13]);
+  if (fragments->FaceEdgeFlags[0])
+  {
+    cornerNeighbors[i0] = &(fragments->FaceNeighbors[2]);
+    cornerNeighbors[i1] = &(fragments->FaceNeighbors[3]);
+    cornerNeighbors[i2] = &(fragments->FaceNeighbors[4]);
+    cornerNeighbors[i3] = &(fragments->FaceNeighbors[5]);
+    cornerNeighbors[i4] = &(fragments->FaceNeighbors[10]);
+    cornerNeighbors[i5] = &(fragments->FaceNeighbors[11]);
+    cornerNeighbors[i6] = &(fragments->FaceNeighbors[12]);
+    cornerNeighbors[i7] = &(fragments->FaceNeighbors[13]);
     // Two choices here (10, 12) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i4 : i5;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[0] = points->InsertNextPoint(this->FaceEdgePoints);
-  }
-  if (this->FaceEdgeFlags[1])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[8]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[9]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[10]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[11]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[16]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[17]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[18]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[19]);
+    this->SubVoxelPositionCorner(
+      fragments, fragments->FaceEdgePoints, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[0] = points->InsertNextPoint(fragments->FaceEdgePoints);
+  }
+  if (fragments->FaceEdgeFlags[1])
+  {
+    cornerNeighbors[i0] = &(fragments->FaceNeighbors[8]);
+    cornerNeighbors[i1] = &(fragments->FaceNeighbors[9]);
+    cornerNeighbors[i2] = &(fragments->FaceNeighbors[10]);
+    cornerNeighbors[i3] = &(fragments->FaceNeighbors[11]);
+    cornerNeighbors[i4] = &(fragments->FaceNeighbors[16]);
+    cornerNeighbors[i5] = &(fragments->FaceNeighbors[17]);
+    cornerNeighbors[i6] = &(fragments->FaceNeighbors[18]);
+    cornerNeighbors[i7] = &(fragments->FaceNeighbors[19]);
     // Two choices here (10, 18) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i2 : i3;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 3, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[1] = points->InsertNextPoint(this->FaceEdgePoints + 3);
-  }
-  if (this->FaceEdgeFlags[2])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[12]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[13]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[14]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[15]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[20]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[21]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[22]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[23]);
+    this->SubVoxelPositionCorner(
+      fragments, fragments->FaceEdgePoints + 3, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[1] = points->InsertNextPoint(fragments->FaceEdgePoints + 3);
+  }
+  if (fragments->FaceEdgeFlags[2])
+  {
+    cornerNeighbors[i0] = &(fragments->FaceNeighbors[12]);
+    cornerNeighbors[i1] = &(fragments->FaceNeighbors[13]);
+    cornerNeighbors[i2] = &(fragments->FaceNeighbors[14]);
+    cornerNeighbors[i3] = &(fragments->FaceNeighbors[15]);
+    cornerNeighbors[i4] = &(fragments->FaceNeighbors[20]);
+    cornerNeighbors[i5] = &(fragments->FaceNeighbors[21]);
+    cornerNeighbors[i6] = &(fragments->FaceNeighbors[22]);
+    cornerNeighbors[i7] = &(fragments->FaceNeighbors[23]);
     // Two choices here (12, 20) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i0 : i1;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 6, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[2] = points->InsertNextPoint(this->FaceEdgePoints + 6);
-  }
-  if (this->FaceEdgeFlags[3])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[18]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[19]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[20]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[21]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[26]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[27]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[28]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[29]);
+    this->SubVoxelPositionCorner(
+      fragments, fragments->FaceEdgePoints + 6, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[2] = points->InsertNextPoint(fragments->FaceEdgePoints + 6);
+  }
+  if (fragments->FaceEdgeFlags[3])
+  {
+    cornerNeighbors[i0] = &(fragments->FaceNeighbors[18]);
+    cornerNeighbors[i1] = &(fragments->FaceNeighbors[19]);
+    cornerNeighbors[i2] = &(fragments->FaceNeighbors[20]);
+    cornerNeighbors[i3] = &(fragments->FaceNeighbors[21]);
+    cornerNeighbors[i4] = &(fragments->FaceNeighbors[26]);
+    cornerNeighbors[i5] = &(fragments->FaceNeighbors[27]);
+    cornerNeighbors[i6] = &(fragments->FaceNeighbors[28]);
+    cornerNeighbors[i7] = &(fragments->FaceNeighbors[29]);
     // Two choices here (18, 20) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i0 : i1;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 9, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[3] = points->InsertNextPoint(this->FaceEdgePoints + 9);
+    this->SubVoxelPositionCorner(
+      fragments, fragments->FaceEdgePoints + 9, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[3] = points->InsertNextPoint(fragments->FaceEdgePoints + 9);
   }
 
   // Now there are 9 possibilities
   // (10 if you count the two ways to triangulate the simple quad).
   // No edges, $ cases with one mid point, 4 cases with two mid points.
   // That is all because the face is always the smallest of the two in/out voxels.
-  int caseIdx = this->FaceEdgeFlags[0] | (this->FaceEdgeFlags[1] << 1) |
-    (this->FaceEdgeFlags[2] << 2) | (this->FaceEdgeFlags[3] << 3);
+  int caseIdx = fragments->FaceEdgeFlags[0] | (fragments->FaceEdgeFlags[1] << 1) |
+    (fragments->FaceEdgeFlags[2] << 2) | (fragments->FaceEdgeFlags[3] << 3);
 
   // c2 e3 c3
   // e1    e2
@@ -4689,10 +4958,10 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
       // This will help us decide which way to split up the quad into triangles.
       double d0011 = 0.0;
       double d0110 = 0.0;
-      double* pt00 = this->FaceCornerPoints;
-      double* pt01 = this->FaceCornerPoints + 3;
-      double* pt10 = this->FaceCornerPoints + 6;
-      double* pt11 = this->FaceCornerPoints + 9;
+      double* pt00 = fragments->FaceCornerPoints;
+      double* pt01 = fragments->FaceCornerPoints + 3;
+      double* pt10 = fragments->FaceCornerPoints + 6;
+      double* pt11 = fragments->FaceCornerPoints + 9;
       for (int ii = 0; ii < 3; ++ii)
       {
         double tmp2 = pt00[ii] - pt11[ii];
@@ -4742,7 +5011,7 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 
     // fragment
     vtkDoubleArray* destArray =
-      dynamic_cast<vtkDoubleArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray(i));
+      dynamic_cast<vtkDoubleArray*>(fragments->CurrentFragmentMesh->GetCellData()->GetArray(i));
     for (vtkIdType ii = 0; ii < numTris; ++ii)
     {
       destArray->InsertNextTuple(&thisTup[0]);
@@ -4751,13 +5020,13 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 // Cell data attributes for debugging.
 #ifdef vtkMaterialInterfaceFilterDEBUG
   vtkIntArray* levelArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("Level"));
+    dynamic_cast<vtkIntArray*>(fragments->CurrentFragmentMesh->GetCellData()->GetArray("Level"));
 
   vtkIntArray* blockIdArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("BlockId"));
+    dynamic_cast<vtkIntArray*>(fragments->CurrentFragmentMesh->GetCellData()->GetArray("BlockId"));
 
   vtkIntArray* procIdArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("ProcId"));
+    dynamic_cast<vtkIntArray*>(fragments->CurrentFragmentMesh->GetCellData()->GetArray("ProcId"));
 
   for (vtkIdType ii = 0; ii < numTris; ++ii)
   {
@@ -4771,7 +5040,8 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 //----------------------------------------------------------------------------
 // Computes the face and edge middle points of the shared contact face
 // between the two iterators.
-void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterIterator* in,
+void vtkMaterialInterfaceFilter::ComputeFacePoints(
+  vtkMaterialInterfaceFilterBlockFragments* fragments, vtkMaterialInterfaceFilterIterator* in,
   vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
 {
   vtkMaterialInterfaceFilterIterator* smaller;
@@ -4812,42 +5082,44 @@ void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterIte
   // 6 9
   // 0 3
   // First set them all to the origin.
-  this->FaceCornerPoints[0] = this->FaceCornerPoints[3] = this->FaceCornerPoints[6] =
-    this->FaceCornerPoints[9] = faceOrigin[0];
-  this->FaceCornerPoints[1] = this->FaceCornerPoints[4] = this->FaceCornerPoints[7] =
-    this->FaceCornerPoints[10] = faceOrigin[1];
-  this->FaceCornerPoints[2] = this->FaceCornerPoints[5] = this->FaceCornerPoints[8] =
-    this->FaceCornerPoints[11] = faceOrigin[2];
+  fragments->FaceCornerPoints[0] = fragments->FaceCornerPoints[3] = fragments->FaceCornerPoints[6] =
+    fragments->FaceCornerPoints[9] = faceOrigin[0];
+  fragments->FaceCornerPoints[1] = fragments->FaceCornerPoints[4] = fragments->FaceCornerPoints[7] =
+    fragments->FaceCornerPoints[10] = faceOrigin[1];
+  fragments->FaceCornerPoints[2] = fragments->FaceCornerPoints[5] = fragments->FaceCornerPoints[8] =
+    fragments->FaceCornerPoints[11] = faceOrigin[2];
   // Now offset them to the corners.
-  this->FaceCornerPoints[3 + axis1] += spacing[axis1];
-  this->FaceCornerPoints[9 + axis1] += spacing[axis1];
-  this->FaceCornerPoints[6 + axis2] += spacing[axis2];
-  this->FaceCornerPoints[9 + axis2] += spacing[axis2];
+  fragments->FaceCornerPoints[3 + axis1] += spacing[axis1];
+  fragments->FaceCornerPoints[9 + axis1] += spacing[axis1];
+  fragments->FaceCornerPoints[6 + axis2] += spacing[axis2];
+  fragments->FaceCornerPoints[9 + axis2] += spacing[axis2];
 
   // Now do the same for the edge points
   //   3
   // 1   2
   //   0
   // First set them all to the origin.
-  this->FaceEdgePoints[0] = this->FaceEdgePoints[3] = this->FaceEdgePoints[6] =
-    this->FaceEdgePoints[9] = faceOrigin[0];
-  this->FaceEdgePoints[1] = this->FaceEdgePoints[4] = this->FaceEdgePoints[7] =
-    this->FaceEdgePoints[10] = faceOrigin[1];
-  this->FaceEdgePoints[2] = this->FaceEdgePoints[5] = this->FaceEdgePoints[8] =
-    this->FaceEdgePoints[11] = faceOrigin[2];
+  fragments->FaceEdgePoints[0] = fragments->FaceEdgePoints[3] = fragments->FaceEdgePoints[6] =
+    fragments->FaceEdgePoints[9] = faceOrigin[0];
+  fragments->FaceEdgePoints[1] = fragments->FaceEdgePoints[4] = fragments->FaceEdgePoints[7] =
+    fragments->FaceEdgePoints[10] = faceOrigin[1];
+  fragments->FaceEdgePoints[2] = fragments->FaceEdgePoints[5] = fragments->FaceEdgePoints[8] =
+    fragments->FaceEdgePoints[11] = faceOrigin[2];
   // Now offset the points to the middle of the edges.
-  this->FaceEdgePoints[axis1] += halfSpacing[axis1];
-  this->FaceEdgePoints[9 + axis1] += halfSpacing[axis1];
-  this->FaceEdgePoints[6 + axis1] += spacing[axis1];
-  this->FaceEdgePoints[3 + axis2] += halfSpacing[axis2];
-  this->FaceEdgePoints[6 + axis2] += halfSpacing[axis2];
-  this->FaceEdgePoints[9 + axis2] += spacing[axis2];
+  fragments->FaceEdgePoints[axis1] += halfSpacing[axis1];
+  fragments->FaceEdgePoints[9 + axis1] += halfSpacing[axis1];
+  fragments->FaceEdgePoints[6 + axis1] += spacing[axis1];
+  fragments->FaceEdgePoints[3 + axis2] += halfSpacing[axis2];
+  fragments->FaceEdgePoints[6 + axis2] += halfSpacing[axis2];
+  fragments->FaceEdgePoints[9 + axis2] += spacing[axis2];
 }
 
 //----------------------------------------------------------------------------
-void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilterIterator* in,
+void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(
+  vtkMaterialInterfaceFilterBlockFragments* fragments, vtkMaterialInterfaceFilterIterator* in,
   vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
 {
+  vtkMaterialInterfaceFilterIterator* faceNeighbors = fragments->FaceNeighbors;
   int axis1 = (axis + 1) % 3;
   int axis2 = (axis + 2) % 3;
 
@@ -4893,17 +5165,13 @@ void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilter
   // for subdivision.
   if (outMaxFlag)
   {
-    this->FaceNeighbors[10] = this->FaceNeighbors[12] = this->FaceNeighbors[18] =
-      this->FaceNeighbors[20] = *in;
-    this->FaceNeighbors[11] = this->FaceNeighbors[13] = this->FaceNeighbors[19] =
-      this->FaceNeighbors[21] = *out;
+    faceNeighbors[10] = faceNeighbors[12] = faceNeighbors[18] = faceNeighbors[20] = *in;
+    faceNeighbors[11] = faceNeighbors[13] = faceNeighbors[19] = faceNeighbors[21] = *out;
   }
   else
   {
-    this->FaceNeighbors[10] = this->FaceNeighbors[12] = this->FaceNeighbors[18] =
-      this->FaceNeighbors[20] = *out;
-    this->FaceNeighbors[11] = this->FaceNeighbors[13] = this->FaceNeighbors[19] =
-      this->FaceNeighbors[21] = *in;
+    faceNeighbors[10] = faceNeighbors[12] = faceNeighbors[18] = faceNeighbors[20] = *out;
+    faceNeighbors[11] = faceNeighbors[13] = faceNeighbors[19] = faceNeighbors[21] = *in;
   }
 
   // Ok, we have 24 neighbors to compute.
@@ -4913,91 +5181,91 @@ void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilter
   // increments: 1, 2, 8
   // Start at the corner and march around the edges.
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 3, this->FaceNeighbors + 11);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 3, faceNeighbors + 11);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 5, this->FaceNeighbors + 3);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 5, faceNeighbors + 3);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 7, this->FaceNeighbors + 5);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 7, faceNeighbors + 5);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 15, this->FaceNeighbors + 7);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 15, faceNeighbors + 7);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 23, this->FaceNeighbors + 15);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 23, faceNeighbors + 15);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 31, this->FaceNeighbors + 23);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 31, faceNeighbors + 23);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 29, this->FaceNeighbors + 31);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 29, faceNeighbors + 31);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 27, this->FaceNeighbors + 29);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 27, faceNeighbors + 29);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 25, this->FaceNeighbors + 27);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 25, faceNeighbors + 27);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 17, this->FaceNeighbors + 25);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 17, faceNeighbors + 25);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 9, this->FaceNeighbors + 17);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 9, faceNeighbors + 17);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 1, this->FaceNeighbors + 9);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 1, faceNeighbors + 9);
   // Now for the other side (min axis).
   faceIndex[axis] -= 1;  // Move to the other layer
   faceIndex[axis1] += 1; // Start below reference block.
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 2, this->FaceNeighbors + 10);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 2, faceNeighbors + 10);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 4, this->FaceNeighbors + 2);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 4, faceNeighbors + 2);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 6, this->FaceNeighbors + 4);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 6, faceNeighbors + 4);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 14, this->FaceNeighbors + 6);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 14, faceNeighbors + 6);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 22, this->FaceNeighbors + 14);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 22, faceNeighbors + 14);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 30, this->FaceNeighbors + 22);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 30, faceNeighbors + 22);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 28, this->FaceNeighbors + 30);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 28, faceNeighbors + 30);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 26, this->FaceNeighbors + 28);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 26, faceNeighbors + 28);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 24, this->FaceNeighbors + 26);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 24, faceNeighbors + 26);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 16, this->FaceNeighbors + 24);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 16, faceNeighbors + 24);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 8, this->FaceNeighbors + 16);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 8, faceNeighbors + 16);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 0, this->FaceNeighbors + 8);
+  this->FindNeighbor(faceIndex, faceLevel, faceNeighbors + 0, faceNeighbors + 8);
 
   // Split edges if neighbors are a higher level than face.
   --faceLevel;
-  this->FaceEdgeFlags[0] = 0;
+  fragments->FaceEdgeFlags[0] = 0;
   // Checking equivalences (this->FaceNeighbor[2] != this->FaceNeighbor[4])
   // May be faster and work fine.
-  if (this->FaceNeighbors[2].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[3].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[4].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[5].Block->GetLevel() > faceLevel)
+  if (faceNeighbors[2].Block->GetLevel() > faceLevel ||
+    faceNeighbors[3].Block->GetLevel() > faceLevel ||
+    faceNeighbors[4].Block->GetLevel() > faceLevel ||
+    faceNeighbors[5].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[0] = 1;
+    fragments->FaceEdgeFlags[0] = 1;
   }
-  this->FaceEdgeFlags[1] = 0;
-  if (this->FaceNeighbors[8].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[9].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[16].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[17].Block->GetLevel() > faceLevel)
+  fragments->FaceEdgeFlags[1] = 0;
+  if (faceNeighbors[8].Block->GetLevel() > faceLevel ||
+    faceNeighbors[9].Block->GetLevel() > faceLevel ||
+    faceNeighbors[16].Block->GetLevel() > faceLevel ||
+    faceNeighbors[17].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[1] = 1;
+    fragments->FaceEdgeFlags[1] = 1;
   }
-  this->FaceEdgeFlags[2] = 0;
-  if (this->FaceNeighbors[14].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[15].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[22].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[23].Block->GetLevel() > faceLevel)
+  fragments->FaceEdgeFlags[2] = 0;
+  if (faceNeighbors[14].Block->GetLevel() > faceLevel ||
+    faceNeighbors[15].Block->GetLevel() > faceLevel ||
+    faceNeighbors[22].Block->GetLevel() > faceLevel ||
+    faceNeighbors[23].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[2] = 1;
+    fragments->FaceEdgeFlags[2] = 1;
   }
-  this->FaceEdgeFlags[3] = 0;
-  if (this->FaceNeighbors[26].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[27].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[28].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[29].Block->GetLevel() > faceLevel)
+  fragments->FaceEdgeFlags[3] = 0;
+  if (faceNeighbors[26].Block->GetLevel() > faceLevel ||
+    faceNeighbors[27].Block->GetLevel() > faceLevel ||
+    faceNeighbors[28].Block->GetLevel() > faceLevel ||
+    faceNeighbors[29].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[3] = 1;
+    fragments->FaceEdgeFlags[3] = 1;
   }
 }
 
@@ -5478,8 +5746,10 @@ inline int vtkMaterialInterfaceFilter::AccumulateMoments(double* moments, // =(M
 // This integrates quantities at the same time.
 // This is called only when the voxel is part of a fragment.
 // I tried to create a generic API to replace the hard coded conditional ifs.
-void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* queue)
+void vtkMaterialInterfaceFilter::ConnectFragment(
+  vtkMaterialInterfaceFilterBlockFragments* fragments, vtkMaterialInterfaceFilterRingBuffer* queue)
 {
+  vtkMaterialInterfaceFilterIterator neighbors[4];
   while (queue->GetSize())
   {
     // Get the next voxel/iterator to search.
@@ -5498,14 +5768,14 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       double voxelVolumeFrac =
         dX[0] * dX[1] * dX[2] * (double)(*(iterator.VolumeFractionPointer)) / 255.0;
 #endif
-      this->FragmentVolume += voxelVolumeFrac;
+      fragments->FragmentVolume += voxelVolumeFrac;
       // The clip depth is accumulated in SubvoxelPositionCorner.
       // accumulate volume weighted average
       for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
       {
         vtkDataArray* arrayToIntegrate = iterator.Block->GetVolumeWtdAvgArray(i);
         int nComps = arrayToIntegrate->GetNumberOfComponents();
-        this->Accumulate(&this->FragmentVolumeWtdAvg[i][0], arrayToIntegrate, nComps,
+        this->Accumulate(&fragments->FragmentVolumeWtdAvg[i][0], arrayToIntegrate, nComps,
           iterator.FlatIndex, voxelVolumeFrac);
       }
       // accumulate mass weighted average
@@ -5517,7 +5787,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         const double* X0 = iterator.Block->GetOrigin();
         double X[3] = { X0[0] + dX[0] * (0.5 + iterator.Index[0]),
           X0[1] + dX[1] * (0.5 + iterator.Index[1]), X0[2] + dX[2] * (0.5 + iterator.Index[2]) };
-        this->AccumulateMoments(&this->FragmentMoment[0], massArray, iterator.FlatIndex, X);
+        this->AccumulateMoments(&fragments->FragmentMoment[0], massArray, iterator.FlatIndex, X);
         // mass weighted averages
         double voxelMass;
         massArray->GetTuple(iterator.FlatIndex, &voxelMass);
@@ -5525,7 +5795,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         {
           vtkDataArray* arrayToIntegrate = iterator.Block->GetMassWtdAvgArray(i);
           int nComps = arrayToIntegrate->GetNumberOfComponents();
-          this->Accumulate(&this->FragmentMassWtdAvg[i][0], arrayToIntegrate, nComps,
+          this->Accumulate(&fragments->FragmentMassWtdAvg[i][0], arrayToIntegrate, nComps,
             iterator.FlatIndex, voxelMass);
         }
       }
@@ -5535,211 +5805,178 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         vtkDataArray* arrayToIntegrate = iterator.Block->GetArrayToSum(i);
         int nComps = arrayToIntegrate->GetNumberOfComponents();
         this->Accumulate(
-          &this->FragmentSum[i][0], arrayToIntegrate, nComps, iterator.FlatIndex, 1.0);
+          &fragments->FragmentSum[i][0], arrayToIntegrate, nComps, iterator.FlatIndex, 1.0);
       }
     }
 
-    // Create another iterator on the stack for recursion.
-    vtkMaterialInterfaceFilterIterator next;
-
     // Look at the face connected neighbors and recurse.
     // We are not on the border and volume fraction of neighbor is high and
-    // we have not visited the voxel yet.
+    // we have not visited the voxel yet. The walk stays in this block so
+    // that blocks can be processed concurrently.
     for (int ii = 0; ii < 3; ++ii)
     {
-      // I would make these variables to make the computation more clear,
-      // but they would accumulate on the stack.
-      // axis0 = ii;
-      // axis1 = (ii+1)%3;
-      // axis2 = (ii+2)%3;
-      // idxMin = 2*ii;
-      // idxMax = 2*ii+1this->IndexMax+1;
-      // "Left"/min
-      this->GetNeighborIterator(&next, &iterator, ii, 0, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
-
-      if (next.VolumeFractionPointer == 0 ||
-        next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+      // "Left"/min then "Right"/max
+      for (int maxFlag = 0; maxFlag < 2; ++maxFlag)
       {
-        // Neighbor is outside of fragment.  Make a face.
-        this->CreateFace(&iterator, &next, ii, 0);
-      }
-      else if (next.FragmentIdPointer[0] == -1)
-      { // We have not visited this neighbor yet. Mark the voxel and recurse.
-        *(next.FragmentIdPointer) = this->FragmentId;
-        queue->Push(&next);
-      }
-      else
-      { // The last case is that we have already visited this voxel and it
-        // is in the same fragment.
-        this->AddEquivalence(&iterator, &next);
-      }
-
-      // Handle the case when the new iterator is a higher level.
-      // We need to loop over all the faces of the higher level that touch this face.
-      // We will restrict our case to 4 neighbors (max difference in levels is 1).
-      // If level skip, things should still work OK. Biggest issue is holes in surface.
-      // This also sort of assumes that at most one other block touches this face.
-      // Holes might appear if this is not true.
-      if (next.Block && next.Block->GetLevel() > iterator.Block->GetLevel())
-      {
-        vtkMaterialInterfaceFilterIterator next2;
-        bool threeDimFlag = next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
-        // Take the first neighbor found and move +Y
-        if (ii != 1 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next2.VolumeFractionPointer == 0 ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 0);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // Take the fist iterator found and move +Z
-        if (ii != 0 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
-          if (next2.VolumeFractionPointer == 0 ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 0);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
-        if (next2.Block && threeDimFlag)
+        int numNeighbors = this->GetFaceNeighborIterators(neighbors, &iterator, ii, maxFlag);
+        for (int k = 0; k < numNeighbors; ++k)
         {
-          this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next.VolumeFractionPointer == 0 ||
-            next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+          vtkMaterialInterfaceFilterIterator* next = neighbors + k;
+          if (next->VolumeFractionPointer == 0 ||
+            next->VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
           {
             // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next, ii, 0);
+            this->CreateFace(fragments, &iterator, next, ii, maxFlag);
           }
-          else if (next.FragmentIdPointer[0] == -1)
+          else if (next->Block == iterator.Block && next->FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+            *(next->FragmentIdPointer) = fragments->FragmentId;
+            queue->Push(next);
           }
+          // Otherwise the voxel is already in this fragment, or it is in
+          // another block and ConnectBlockFragments will connect the pieces.
         }
       }
+    }
+  }
+}
 
-      // "Right"/max
-      this->GetNeighborIterator(&next, &iterator, ii, 1, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
-      if (next.VolumeFractionPointer == 0 ||
-        next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-      { // Neighbor is outside of fragment.  Make a face.
-        this->CreateFace(&iterator, &next, ii, 1);
-      }
-      else if (next.FragmentIdPointer[0] == -1)
-      { // We have not visited this neighbor yet. Mark the voxel and recurse.
-        *(next.FragmentIdPointer) = this->FragmentId;
-        queue->Push(&next);
-      }
-      else
-      { // The last case is that we have already visited this voxel and it
-        // is in the same fragment.
-        this->AddEquivalence(&iterator, &next);
-      }
-      // Same case as above with the same logic to visit the
-      // four smaller cells that touch this face of the current block.
-      if (next.Block && next.Block->GetLevel() > iterator.Block->GetLevel())
+//----------------------------------------------------------------------------
+int vtkMaterialInterfaceFilter::GetFaceNeighborIterators(
+  vtkMaterialInterfaceFilterIterator neighbors[4], vtkMaterialInterfaceFilterIterator* iterator,
+  int axis, int maxFlag)
+{
+  int axis1 = (axis + 1) % 3;
+  int axis2 = (axis + 2) % 3;
+  vtkMaterialInterfaceFilterIterator* next = neighbors;
+  this->GetNeighborIterator(next, iterator, axis, maxFlag, axis1, 0, axis2, 0);
+  int numNeighbors = 1;
+
+  // Handle the case when the new iterator is a higher level.
+  // We need to loop over all the faces of the higher level that touch this face.
+  // We will restrict our case to 4 neighbors (max difference in levels is 1).
+  // If level skip, things should still work OK. Biggest issue is holes in surface.
+  // This also sort of assumes that at most one other block touches this face.
+  // Holes might appear if this is not true.
+  if (next->Block && next->Block->GetLevel() > iterator->Block->GetLevel())
+  {
+    vtkMaterialInterfaceFilterIterator* next2 = 0;
+    bool threeDimFlag = next->Block->GetBaseCellExtent()[4] < next->Block->GetBaseCellExtent()[5];
+    // Take the first neighbor found and move +Y
+    if (axis != 1 || threeDimFlag)
+    { // stupid after the fact way of dealing with 2d AMR input.
+      next2 = neighbors + numNeighbors++;
+      this->GetNeighborIterator(next2, next, axis1, 1, axis2, 0, axis, 0);
+    }
+    // Take the fist iterator found and move +Z
+    if (axis != 0 || threeDimFlag)
+    { // stupid after the fact way of dealing with 2d AMR input.
+      next2 = neighbors + numNeighbors++;
+      this->GetNeighborIterator(next2, next, axis2, 1, axis, 0, axis1, 0);
+    }
+    // To get the +Y+Z start with the +Z iterator and move +Y
+    if (next2 && next2->Block && threeDimFlag)
+    {
+      this->GetNeighborIterator(neighbors + numNeighbors++, next2, axis1, 1, axis2, 0, axis, 0);
+    }
+  }
+  return numNeighbors;
+}
+
+//----------------------------------------------------------------------------
+// The pieces found by ProcessBlock end at block boundaries. Add an
+// equivalence for every pair of pieces that touch across a boundary.
+// Ghost blocks are not processed, so their voxels are labelled here
+// by walking out of the local pieces. The ghost labels are used to
+// find equivalences with other processes.
+void vtkMaterialInterfaceFilter::ConnectBlockFragments()
+{
+  vtkMaterialInterfaceFilterRingBuffer queue;
+  vtkMaterialInterfaceFilterIterator iterator;
+  vtkMaterialInterfaceFilterIterator neighbors[4];
+
+  for (int blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+  {
+    vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
+    if (block == 0)
+    {
+      continue;
+    }
+    const int* ext = block->GetBaseCellExtent();
+    const int* incs = block->GetCellIncrements();
+    iterator.Block = block;
+    // Loop over the voxels on each face of the block.
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      int axis1 = (axis + 1) % 3;
+      int axis2 = (axis + 2) % 3;
+      for (int maxFlag = 0; maxFlag < 2; ++maxFlag)
       {
-        vtkMaterialInterfaceFilterIterator next2;
-        bool threeDimFlag = next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
-        // Take the first neighbor found and move +Y
-        if (ii != 1 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next2.VolumeFractionPointer == 0 ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 1);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // Take the fist iterator found and move +Z
-        if (ii != 0 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
-          if (next2.VolumeFractionPointer == 0 ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+        iterator.Index[axis] = ext[2 * axis + maxFlag];
+        for (int i2 = ext[2 * axis2]; i2 <= ext[2 * axis2 + 1]; ++i2)
+        {
+          iterator.Index[axis2] = i2;
+          for (int i1 = ext[2 * axis1]; i1 <= ext[2 * axis1 + 1]; ++i1)
           {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 1);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+            iterator.Index[axis1] = i1;
+            int offset = (iterator.Index[0] - ext[0]) * incs[0] +
+              (iterator.Index[1] - ext[2]) * incs[1] + (iterator.Index[2] - ext[4]) * incs[2];
+            iterator.FragmentIdPointer = block->GetBaseFragmentIdPointer() + offset;
+            if (*(iterator.FragmentIdPointer) == -1)
+            {
+              continue;
+            }
+            iterator.VolumeFractionPointer = block->GetBaseVolumeFractionPointer() + offset;
+            iterator.FlatIndex = block->GetBaseFlatIndex() + offset;
+            int numNeighbors = this->GetFaceNeighborIterators(neighbors, &iterator, axis, maxFlag);
+            for (int k = 0; k < numNeighbors; ++k)
+            {
+              this->ConnectNeighbor(&iterator, neighbors + k, &queue);
+            }
           }
         }
-        // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
-        if (next2.Block && threeDimFlag)
+      }
+    }
+  }
+
+  // Walk through the ghost voxels reached from the local pieces.
+  while (queue.GetSize())
+  {
+    queue.Pop(&iterator);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      for (int maxFlag = 0; maxFlag < 2; ++maxFlag)
+      {
+        int numNeighbors = this->GetFaceNeighborIterators(neighbors, &iterator, axis, maxFlag);
+        for (int k = 0; k < numNeighbors; ++k)
         {
-          this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next.VolumeFractionPointer == 0 ||
-            next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next, ii, 1);
-          }
-          else if (next.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
+          this->ConnectNeighbor(&iterator, neighbors + k, &queue);
         }
       }
     }
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceFilter::ConnectNeighbor(vtkMaterialInterfaceFilterIterator* iterator,
+  vtkMaterialInterfaceFilterIterator* neighbor, vtkMaterialInterfaceFilterRingBuffer* queue)
+{
+  if (neighbor->VolumeFractionPointer == 0 ||
+    neighbor->VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+  { // Neighbor is outside of fragment.
+    return;
+  }
+  if (*(neighbor->FragmentIdPointer) == -1)
+  { // Only ghost voxels are left unvisited. Mark the voxel and recurse.
+    *(neighbor->FragmentIdPointer) = *(iterator->FragmentIdPointer);
+    queue->Push(neighbor);
+  }
+  else
+  {
+    this->AddEquivalence(iterator, neighbor);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkMaterialInterfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -6448,6 +6685,44 @@ void vtkMaterialInterfaceFilter::ResolveLocalFragmentGeometry()
   vector<int>(resolvedFragmentIds).swap(resolvedFragmentIds);
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Cleans fragment meshes concurrently. Each thread owns its own
+// vtkCleanPolyData, each fragment is only touched by a single thread.
+class vtkMaterialInterfaceCleanFragmentsWorker
+{
+public:
+  vtkMultiPieceDataSet* Fragments;
+  vector<int>* FragmentIds;
+  vector<vtkSmartPointer<vtkPolyData> >* CleanedFragments;
+  vtkSMPThreadLocalObject<vtkCleanPolyData> Cleaner;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkCleanPolyData* cpd = this->Cleaner.Local();
+    for (vtkIdType localId = begin; localId < end; ++localId)
+    {
+      // get the fragment
+      int fragmentId = (*this->FragmentIds)[localId];
+      vtkPolyData* fragmentMesh =
+        dynamic_cast<vtkPolyData*>(this->Fragments->GetPiece(fragmentId));
+      // clean duplicate points
+      cpd->SetInputData(fragmentMesh);
+      cpd->Update();
+      vtkPolyData* cleanedFragmentMesh = cpd->GetOutput();
+      // Free unused resources
+      cleanedFragmentMesh->Squeeze();
+      // Copy so that the next fragment does not overwrite this one.
+      vtkPolyData* cleanedFragmentMeshOut = vtkPolyData::New();
+      cleanedFragmentMeshOut->ShallowCopy(cleanedFragmentMesh);
+      (*this->CleanedFragments)[localId].TakeReference(cleanedFragmentMeshOut);
+    }
+    cpd->SetInputData(0);
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 // Remove duplicate point from local meshes.
 void vtkMaterialInterfaceFilter::CleanLocalFragmentGeometry()
@@ -6473,47 +6748,36 @@ void vtkMaterialInterfaceFilter::CleanLocalFragmentGeometry()
   assert("Couldn't get the resolved fragnments." && resolvedFragments);
   resolvedFragments->SetNumberOfPieces(this->NumberOfResolvedFragments);
 
-  // Only need to merge points.
-  vtkCleanPolyData* cpd = vtkCleanPolyData::New();
-// These caused some visual effects(rounded corners etc...)
-// cpd->ConvertLinesToPointsOff();
-// cpd->ConvertPolysToLinesOff();
-// cpd->ConvertStripsToPolysOff();
-// cpd->PointMergingOn();
+  // Only need to merge points. Fragments are independent, they are
+  // cleaned in parallel.
+  // These caused some visual effects(rounded corners etc...)
+  // cpd->ConvertLinesToPointsOff();
+  // cpd->ConvertPolysToLinesOff();
+  // cpd->ConvertStripsToPolysOff();
+  // cpd->PointMergingOn();
+  int nLocal = static_cast<int>(resolvedFragmentIds.size());
+  vector<vtkSmartPointer<vtkPolyData> > cleanedFragments(nLocal);
+  vtkMaterialInterfaceCleanFragmentsWorker cleaner;
+  cleaner.Fragments = resolvedFragments;
+  cleaner.FragmentIds = &resolvedFragmentIds;
+  cleaner.CleanedFragments = &cleanedFragments;
+  vtkSMPTools::For(0, nLocal, cleaner);
 
 #ifdef vtkMaterialInterfaceFilterDEBUG
   const int myProcId = this->Controller->GetLocalProcessId();
   vtkIdType nInitial = 0;
   vtkIdType nFinal = 0;
 #endif
-  // clean each frgament mesh we own.
-  int nLocal = static_cast<int>(resolvedFragmentIds.size());
+  // Swap dirty old meshes for new cleaned meshes.
   for (int localId = 0; localId < nLocal; ++localId)
   {
-    // get the material id
     int fragmentId = resolvedFragmentIds[localId];
-    // get the fragment
-    vtkPolyData* fragmentMesh = dynamic_cast<vtkPolyData*>(resolvedFragments->GetPiece(fragmentId));
 #ifdef vtkMaterialInterfaceFilterDEBUG
-    nInitial += fragmentMesh->GetNumberOfPoints();
+    nInitial += resolvedFragments->GetPiece(fragmentId)->GetNumberOfPoints();
+    nFinal += cleanedFragments[localId]->GetNumberOfPoints();
 #endif
-    // clean duplicate points
-    cpd->SetInputData(fragmentMesh);
-    cpd->Update();
-    vtkPolyData* cleanedFragmentMesh = cpd->GetOutput();
-
-#ifdef vtkMaterialInterfaceFilterDEBUG
-    nFinal += cleanedFragmentMesh->GetNumberOfPoints();
-#endif
-    // Free unused resources
-    cleanedFragmentMesh->Squeeze();
-    // Copy and swap dirty old mesh for new cleaned mesh.
-    vtkPolyData* cleanedFragmentMeshOut = vtkPolyData::New();
-    cleanedFragmentMeshOut->ShallowCopy(cleanedFragmentMesh);
-    resolvedFragments->SetPiece(fragmentId, cleanedFragmentMeshOut);
-    cleanedFragmentMeshOut->Delete();
-  }
-  cpd->Delete();
+    resolvedFragments->SetPiece(fragmentId, cleanedFragments[localId]);
+  }
 #ifdef vtkMaterialInterfaceFilterDEBUG
   cerr << "[" << __LINE__ << "] " << myProcId << " cleaned " << nInitial - nFinal
        << " points from local fragments. ("
@@ -7902,8 +8166,7 @@ int vtkMaterialInterfaceFilter::PrepareToResolveIntegratedAttributes()
     memset(pResolved, 0, bytesPerComponent);
     NewVtkArrayPointer(this->ClipDepthMinimums, nComps, this->NumberOfResolvedFragments,
       this->ClipDepthMinimums->GetName());
-    pResolved = this->ClipDepthMinimums->GetPointer(0);
-    memset(pResolved, 0, bytesPerComponent);
+    this->ClipDepthMinimums->FillComponent(0, VTK_FLOAT_MAX);
   }
 
   // moments
@@ -7999,7 +8262,7 @@ int vtkMaterialInterfaceFilter::ResolveIntegratedAttributes(const int controllin
         ++pUnresolved;
         ++eqSetId;
       }
-      // clip depth
+      // clip depth, the extremes over all pieces
       if (this->ClipWithPlane)
       {
         pUnresolved = clipDepthMaxs[procId]->GetPointer(0);
@@ -8008,7 +8271,7 @@ int vtkMaterialInterfaceFilter::ResolveIntegratedAttributes(const int controllin
         for (int i = 0; i < nUnresolved; ++i)
         {
           int resIdx = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          pResolved[resIdx] += pUnresolved[0];
+          pResolved[resIdx] = std::max(pResolved[resIdx], pUnresolved[0]);
           ++pUnresolved;
           ++eqSetId;
         }
@@ -8018,7 +8281,7 @@ int vtkMaterialInterfaceFilter::ResolveIntegratedAttributes(const int controllin
         for (int i = 0; i < nUnresolved; ++i)
         {
           int resIdx = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          pResolved[resIdx] += pUnresolved[0];
+          pResolved[resIdx] = std::min(pResolved[resIdx], pUnresolved[0]);
           ++pUnresolved;
           ++eqSetId;
         }
@@ -9256,6 +9519,97 @@ void vtkMaterialInterfaceFilter::CopyAttributesToOutput2()
   repStrips->Delete();
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Computes the OBB of local, non-split fragments concurrently. Each
+// thread uses its own vtkOBBTree.
+class vtkMaterialInterfaceFragmentOBBWorker
+{
+public:
+  vtkMultiPieceDataSet* Fragments;
+  vector<int>* FragmentIds;
+  vector<int>* FragmentSplitMarker;
+  double* OBBs;
+  vtkSMPThreadLocalObject<vtkOBBTree> OBBCalculator;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkOBBTree* obbCalc = this->OBBCalculator.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      // skip split fragments, these have already been
+      // taken care of.
+      if ((*this->FragmentSplitMarker)[i] == 1)
+      {
+        continue;
+      }
+
+      // get fragment mesh
+      int globalId = (*this->FragmentIds)[i];
+      vtkPolyData* thisFragment = dynamic_cast<vtkPolyData*>(this->Fragments->GetPiece(globalId));
+
+      // compute OBB
+      double* pObb = this->OBBs + 15 * i;
+      double size[3];
+      // (c_x,c_y,c_z),(max_x,max_y,max_z),(mid_x,mid_y,mid_z),(min_x,min_y,min_z),|max|,|mid|,|min|
+      obbCalc->ComputeOBB(thisFragment, pObb, pObb + 3, pObb + 6, pObb + 9, size);
+
+      // compute magnitudes
+      for (int q = 0; q < 3; ++q)
+      {
+        pObb[12 + q] = 0;
+      }
+      for (int q = 0; q < 3; ++q)
+      {
+        pObb[12] += pObb[3 + q] * pObb[3 + q];
+        pObb[13] += pObb[6 + q] * pObb[6 + q];
+        pObb[14] += pObb[9 + q] * pObb[9 + q];
+      }
+      for (int q = 0; q < 3; ++q)
+      {
+        pObb[12 + q] = sqrt(pObb[12 + q]);
+      }
+    }
+  }
+};
+
+// Computes the AABB centers of local, non-split fragments concurrently.
+class vtkMaterialInterfaceFragmentAABBWorker
+{
+public:
+  vtkMultiPieceDataSet* Fragments;
+  vector<int>* FragmentIds;
+  vector<int>* FragmentSplitMarker;
+  double* Centers;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double aabb[6];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      // skip fragments with geometry split over multiple
+      // processes. These have been already taken care of.
+      if ((*this->FragmentSplitMarker)[i] == 1)
+      {
+        continue;
+      }
+
+      int globalId = (*this->FragmentIds)[i];
+      vtkPolyData* thisFragment = dynamic_cast<vtkPolyData*>(this->Fragments->GetPiece(globalId));
+
+      // AABB calculation
+      thisFragment->GetBounds(aabb);
+      double* pCoaabb = this->Centers + 3 * i;
+      for (int q = 0, k = 0; q < 3; ++q, k += 2)
+      {
+        pCoaabb[q] = (aabb[k] + aabb[k + 1]) / 2.0;
+      }
+    }
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 // For each fragment compute its oriented bounding box(OBB).
 //
@@ -9272,54 +9626,15 @@ int vtkMaterialInterfaceFilter::ComputeLocalFragmentOBB()
   int nLocal = static_cast<int>(resolvedFragmentIds.size());
 
   // OBB set up
-  vtkOBBTree* obbCalc;
-  double* pObb;
-  obbCalc = vtkOBBTree::New();
   assert("FragmentOBBs has incorrect size." && this->FragmentOBBs->GetNumberOfTuples() == nLocal);
-  pObb = this->FragmentOBBs->GetPointer(0);
-
-  // Traverse the fragments we own
-  for (int i = 0; i < nLocal; ++i)
-  {
-    // skip split fragments, these have already been
-    // taken care of.
-    if (fragmentSplitMarker[i] == 1)
-    {
-      pObb += 15;
-      continue;
-    }
-
-    // get fragment mesh
-    int globalId = resolvedFragmentIds[i];
-    vtkPolyData* thisFragment = dynamic_cast<vtkPolyData*>(resolvedFragments->GetPiece(globalId));
 
-    // compute OBB
-    double size[3];
-    // (c_x,c_y,c_z),(max_x,max_y,max_z),(mid_x,mid_y,mid_z),(min_x,min_y,min_z),|max|,|mid|,|min|
-    obbCalc->ComputeOBB(thisFragment, pObb, pObb + 3, pObb + 6, pObb + 9, size);
-    // obbCalc->ComputeOBB(thisFragment->GetPoints(),pObb,pObb+3,pObb+6,pObb+9,size);
-
-    // compute magnitudes
-    for (int q = 0; q < 3; ++q)
-    {
-      pObb[12 + q] = 0;
-    }
-    for (int q = 0; q < 3; ++q)
-    {
-      pObb[12] += pObb[3 + q] * pObb[3 + q];
-      pObb[13] += pObb[6 + q] * pObb[6 + q];
-      pObb[14] += pObb[9 + q] * pObb[9 + q];
-    }
-    for (int q = 0; q < 3; ++q)
-    {
-      pObb[12 + q] = sqrt(pObb[12 + q]);
-    }
-
-    pObb += 15;
-  } // fragment traversal
-
-  // OBB clean up
-  obbCalc->Delete();
+  // Traverse the fragments we own, in parallel.
+  vtkMaterialInterfaceFragmentOBBWorker worker;
+  worker.Fragments = resolvedFragments;
+  worker.FragmentIds = &resolvedFragmentIds;
+  worker.FragmentSplitMarker = &fragmentSplitMarker;
+  worker.OBBs = this->FragmentOBBs->GetPointer(0);
+  vtkSMPTools::For(0, nLocal, worker);
 
   return 1;
 }
@@ -9342,32 +9657,14 @@ int vtkMaterialInterfaceFilter::ComputeLocalFragmentAABBCenters()
   // AABB set up
   assert("FragmentAABBCenters is expected to be pre-allocated." &&
     this->FragmentAABBCenters->GetNumberOfTuples() == nLocal);
-  double aabb[6];
-  double* pCoaabb = this->FragmentAABBCenters->GetPointer(0);
 
-  // Traverse the fragments we own
-  for (int i = 0; i < nLocal; ++i)
-  {
-    // skip fragments with geometry split over multiple
-    // processes. These have been already taken care of.
-    if (fragmentSplitMarker[i] == 1)
-    {
-      pCoaabb += 3;
-      continue;
-    }
-
-    int globalId = resolvedFragmentIds[i];
-
-    vtkPolyData* thisFragment = dynamic_cast<vtkPolyData*>(resolvedFragments->GetPiece(globalId));
-
-    // AABB calculation
-    thisFragment->GetBounds(aabb);
-    for (int q = 0, k = 0; q < 3; ++q, k += 2)
-    {
-      pCoaabb[q] = (aabb[k] + aabb[k + 1]) / 2.0;
-    }
-    pCoaabb += 3;
-  } // fragment traversal
+  // Traverse the fragments we own, in parallel.
+  vtkMaterialInterfaceFragmentAABBWorker worker;
+  worker.Fragments = resolvedFragments;
+  worker.FragmentIds = &resolvedFragmentIds;
+  worker.FragmentSplitMarker = &fragmentSplitMarker;
+  worker.Centers = this->FragmentAABBCenters->GetPointer(0);
+  vtkSMPTools::For(0, nLocal, worker);
 
   return 1;
 }
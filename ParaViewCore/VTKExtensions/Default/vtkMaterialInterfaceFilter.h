@@ -61,6 +61,7 @@ class vtkImplicitFunction;
 class vtkMaterialInterfaceLevel;
 class vtkMaterialInterfaceFilterBlock;
 class vtkMaterialInterfaceFilterIterator;
+class vtkMaterialInterfaceFilterBlockFragments;
 class vtkMaterialInterfaceEquivalenceSet;
 class vtkMaterialInterfaceFilterRingBuffer;
 class vtkMaterialInterfacePieceLoading;
@@ -349,22 +350,39 @@ protected:
     std::vector<std::string>& integratedArrayNames);
   // Craete a new fragment/piece.
   vtkPolyData* NewFragmentMesh();
-  // Process each cell, looking for fragments.
-  int ProcessBlock(int blockId);
+  // Find the fragments of all local blocks. Blocks are processed
+  // concurrently, then the pieces are numbered and connected across
+  // block boundaries.
+  void ProcessBlocks();
+  friend class vtkMaterialInterfaceFilterProcessBlocksFunctor;
+  // Process each cell, looking for fragments. The walk stays in the
+  // block, pieces are stored in "fragments".
+  int ProcessBlock(int blockId, vtkMaterialInterfaceFilterBlockFragments* fragments);
   // Cell has been identified as inside the fragment. Integrate, and
   // generate fragement surface etc...
-  void ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* iterator);
+  void ConnectFragment(vtkMaterialInterfaceFilterBlockFragments* fragments,
+    vtkMaterialInterfaceFilterRingBuffer* iterator);
+  // Add equivalences between pieces that touch across block boundaries,
+  // and label the ghost voxels connected to local pieces.
+  void ConnectBlockFragments();
+  void ConnectNeighbor(vtkMaterialInterfaceFilterIterator* iterator,
+    vtkMaterialInterfaceFilterIterator* neighbor, vtkMaterialInterfaceFilterRingBuffer* queue);
+  // Returns the voxels touching the given face of a voxel. That is one
+  // voxel, or up to four when the neighbor is a higher level.
+  int GetFaceNeighborIterators(vtkMaterialInterfaceFilterIterator neighbors[4],
+    vtkMaterialInterfaceFilterIterator* iterator, int axis, int maxFlag);
   void GetNeighborIterator(vtkMaterialInterfaceFilterIterator* next,
     vtkMaterialInterfaceFilterIterator* iterator, int axis0, int maxFlag0, int axis1, int maxFlag1,
     int axis2, int maxFlag2);
   void GetNeighborIteratorPad(vtkMaterialInterfaceFilterIterator* next,
     vtkMaterialInterfaceFilterIterator* iterator, int axis0, int maxFlag0, int axis1, int maxFlag1,
     int axis2, int maxFlag2);
-  void CreateFace(vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out,
-    int axis, int outMaxFlag);
+  void CreateFace(vtkMaterialInterfaceFilterBlockFragments* fragments,
+    vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+    int outMaxFlag);
   int ComputeDisplacementFactors(vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8],
     double displacmentFactors[3], int rootNeighborIdx, int faceAxis);
-  int SubVoxelPositionCorner(double* point,
+  int SubVoxelPositionCorner(vtkMaterialInterfaceFilterBlockFragments* fragments, double* point,
     vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx,
     int faceAxis);
   void FindPointNeighbors(vtkMaterialInterfaceFilterIterator* iteratorMin0,
@@ -526,10 +544,6 @@ protected:
   char* MaterialFractionArrayName;
   vtkSetStringMacro(MaterialFractionArrayName);
 
-  // while processing a material array this holds
-  // a pointer to the output poly data
-  // data set
-  vtkPolyData* CurrentFragmentMesh;
   // As peices/fragments are found they are stored here
   // until resolution.
   std::vector<vtkPolyData*> FragmentMeshes;
@@ -539,24 +553,20 @@ protected:
   // all of the supported operations.
   /// class vtkMaterialInterfaceFilterIntegrator
   ///{
-  // Local id of current fragment
+  // Number of fragment pieces found on this process. The accumulators
+  // for the piece being built live in
+  // vtkMaterialInterfaceFilterBlockFragments.
   int FragmentId;
-  // Accumulator for the volume of the current fragment.
-  double FragmentVolume;
   // Fragment volumes indexed by the fragment id. It's a local
   // per-process indexing until fragments have been resolved
   vtkDoubleArray* FragmentVolumes;
 
   // Min and max depth of crater.
   // These are only computed when the clip plane is on.
-  double ClipDepthMin;
-  double ClipDepthMax;
   vtkDoubleArray* ClipDepthMinimums;
   vtkDoubleArray* ClipDepthMaximums;
 
-  // Accumulator for moments of the current fragment
-  std::vector<double> FragmentMoment; // =(Myz, Mxz, Mxy, m)
-  // Moments indexed by fragment id
+  // Moments (Myz, Mxz, Mxy, m) indexed by fragment id
   vtkDoubleArray* FragmentMoments;
   // Centers of fragment AABBs, only computed if moments are not
   vtkDoubleArray* FragmentAABBCenters;
@@ -564,8 +574,6 @@ protected:
   bool ComputeMoments;
 
   // Weighted average, where weights correspond to fragment volume.
-  // Accumulators one for each array to average, scalar or vector
-  std::vector<std::vector<double> > FragmentVolumeWtdAvg;
   // weighted averages indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentVolumeWtdAvgs;
   // number of arrays for which to compute the weighted average
@@ -574,8 +582,6 @@ protected:
   std::vector<std::string> VolumeWtdAvgArrayNames;
 
   // Weighted average, where weights correspond to fragment mass.
-  // Accumulators one for each array to average, scalar or vector
-  std::vector<std::vector<double> > FragmentMassWtdAvg;
   // weighted averages indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentMassWtdAvgs;
   // number of arrays for which to compute the weighted average
@@ -592,8 +598,6 @@ protected:
   int NToIntegrate;
 
   // Sum of data over the fragment.
-  // Accumulators, one for each array to sum
-  std::vector<std::vector<double> > FragmentSum;
   // sums indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentSums;
   // number of arrays for which to compute the weighted average
@@ -657,20 +661,19 @@ protected:
   // It could be changed into the primary storage of blocks.
   std::vector<vtkMaterialInterfaceLevel*> Levels;
 
-  // Ivars for computing the point on corners and edges of a face.
-  vtkMaterialInterfaceFilterIterator* FaceNeighbors;
   // Permutation of the neighbors. Axis0 normal to face.
   int faceAxis0;
   int faceAxis1;
   int faceAxis2;
-  double FaceCornerPoints[12];
-  double FaceEdgePoints[12];
-  int FaceEdgeFlags[4];
+  // Compute the point on corners and edges of a face. Results are stored
+  // in the scratch space of "fragments".
   // outMaxFlag implies out is positive direction of axis.
-  void ComputeFacePoints(vtkMaterialInterfaceFilterIterator* in,
-    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
-  void ComputeFaceNeighbors(vtkMaterialInterfaceFilterIterator* in,
-    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
+  void ComputeFacePoints(vtkMaterialInterfaceFilterBlockFragments* fragments,
+    vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+    int outMaxFlag);
+  void ComputeFaceNeighbors(vtkMaterialInterfaceFilterBlockFragments* fragments,
+    vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+    int outMaxFlag);
 
   long ComputeProximity(const int faceIdx[3], int faceLevel, const int ext[6], int refLevel);
 
@@ -13,12 +13,57 @@
 
 =========================================================================*/
 #include "vtkPEquivalenceSet.h"
-#include "vtkIntArray.h"
+#include "vtkCommunicator.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkPEquivalenceSet);
 
+namespace
+{
+// Sends the members that are not equivalent to only themselves, as
+// (member, smallest equivalent member) pairs.
+void vtkPEquivalenceSetSend(
+  vtkEquivalenceSet* set, vtkMultiProcessController* controller, int remote, int tag)
+{
+  std::vector<vtkIdType> pairs;
+  vtkIdType numMembers = set->GetNumberOfMembers();
+  for (vtkIdType ii = 0; ii < numMembers; ++ii)
+  {
+    vtkIdType setId = set->GetEquivalentSetId(ii);
+    if (setId != ii)
+    {
+      pairs.push_back(ii);
+      pairs.push_back(setId);
+    }
+  }
+  vtkIdType length = static_cast<vtkIdType>(pairs.size());
+  controller->Send(&length, 1, remote, tag);
+  if (length > 0)
+  {
+    controller->Send(&pairs[0], length, remote, tag);
+  }
+}
+
+void vtkPEquivalenceSetReceive(
+  vtkEquivalenceSet* set, vtkMultiProcessController* controller, int remote, int tag)
+{
+  vtkIdType length = 0;
+  controller->Receive(&length, 1, remote, tag);
+  if (length > 0)
+  {
+    std::vector<vtkIdType> pairs(length);
+    controller->Receive(&pairs[0], length, remote, tag);
+    for (vtkIdType ii = 0; ii + 1 < length; ii += 2)
+    {
+      set->AddEquivalence(pairs[ii], pairs[ii + 1]);
+    }
+  }
+}
+}
+
 vtkPEquivalenceSet::vtkPEquivalenceSet()
 {
 }
@@ -32,55 +77,65 @@ void vtkPEquivalenceSet::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 }
 
-int vtkPEquivalenceSet::ResolveEquivalences()
+vtkIdType vtkPEquivalenceSet::ResolveEquivalences()
 {
   vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  int numProcs = controller ? controller->GetNumberOfProcesses() : 1;
+  if (numProcs <= 1)
+  {
+    return this->Superclass::ResolveEquivalences();
+  }
   int myProc = controller->GetLocalProcessId();
-  int numProcs = controller->GetNumberOfProcesses();
 
-  vtkIntArray* workingSet = vtkIntArray::New();
-  workingSet->SetNumberOfComponents(1);
+  // All processes must resolve the same domain.
+  vtkIdType numMembers = this->GetNumberOfMembers();
+  vtkIdType globalNumMembers = 0;
+  controller->AllReduce(&numMembers, &globalNumMembers, 1, vtkCommunicator::MAX_OP);
+  this->SetNumberOfMembers(globalNumMembers);
+
+  // Recursive doubling among the largest power of two processes. The
+  // remaining processes hand their equivalences to a partner first and get
+  // the merged result back at the end.
+  int pow2 = 1;
+  while (pow2 * 2 <= numProcs)
+  {
+    pow2 *= 2;
+  }
 
   int tag = 475893745;
-  int pivot = (numProcs + 1) / 2;
-  while (pivot > 0 && myProc < (pivot * 2))
+  if (myProc >= pow2)
+  {
+    vtkPEquivalenceSetSend(this, controller, myProc - pow2, tag);
+    vtkPEquivalenceSetReceive(this, controller, myProc - pow2, tag + 1);
+  }
+  else
   {
-    int tuples;
-    if (myProc >= pivot)
+    if (myProc + pow2 < numProcs)
     {
-      tuples = this->EquivalenceArray->GetNumberOfTuples();
-      controller->Send(&tuples, 1, myProc - pivot, tag + pivot + 0);
-      controller->Send(this->EquivalenceArray, myProc - pivot, tag + pivot + 1);
+      vtkPEquivalenceSetReceive(this, controller, myProc + pow2, tag);
     }
-    else if ((myProc + pivot) < numProcs)
+    for (int mask = 1; mask < pow2; mask *= 2)
     {
-      controller->Receive(&tuples, 1, myProc + pivot, tag + pivot + 0);
-      workingSet->SetNumberOfTuples(tuples);
-
-      controller->Receive(workingSet, myProc + pivot, tag + pivot + 1);
-      while (workingSet->GetNumberOfTuples() > this->EquivalenceArray->GetNumberOfTuples())
+      // Lower process sends first so that the blocking calls pair up.
+      int partner = myProc ^ mask;
+      if (myProc < partner)
       {
-        this->EquivalenceArray->InsertNextTuple1(0);
+        vtkPEquivalenceSetSend(this, controller, partner, tag + 2);
+        vtkPEquivalenceSetReceive(this, controller, partner, tag + 2);
       }
-      for (int i = 0; i < workingSet->GetNumberOfTuples(); i++)
+      else
       {
-        int workingVal = workingSet->GetValue(i);
-        if (workingVal == 0)
-        {
-          continue;
-        }
-        int existingVal = this->EquivalenceArray->GetValue(i);
-        this->EquivalenceArray->SetValue(i, workingVal);
-        if (existingVal != 0 && existingVal < workingVal)
-        {
-          this->EquateInternal(existingVal, workingVal);
-        }
+        vtkPEquivalenceSetReceive(this, controller, partner, tag + 2);
+        vtkPEquivalenceSetSend(this, controller, partner, tag + 2);
       }
     }
-    pivot /= 2;
+    if (myProc + pow2 < numProcs)
+    {
+      vtkPEquivalenceSetSend(this, controller, myProc + pow2, tag + 1);
+    }
   }
-  controller->Broadcast(this->EquivalenceArray, 0);
 
-  this->Superclass::ResolveEquivalences();
-  return 1;
+  // Since the representative of each set is its smallest member, all
+  // processes end up with the same sequential ids.
+  return this->Superclass::ResolveEquivalences();
 }
@@ -17,6 +17,9 @@
  * @brief   distributed method of Equivalence
  *
  * Same as EquivalenceSet, but resolving is a global operation.
+ * Processes exchange their (non trivial) equivalences with a partner in
+ * log2(numberOfProcesses) rounds of recursive doubling, after which all
+ * processes hold the same equivalences and resolve them identically.
  * .SEE vtkEquivalenceSet
 */
 
@@ -34,7 +37,7 @@ public:
   static vtkPEquivalenceSet* New();
 
   // Globally equivalent set IDs are reassigned to be sequential.
-  virtual int ResolveEquivalences() VTK_OVERRIDE;
+  virtual vtkIdType ResolveEquivalences() VTK_OVERRIDE;
 
 protected:
   vtkPEquivalenceSet();
@@ -14,21 +14,419 @@
 =========================================================================*/
 #include "vtkPVConnectivityFilter.h"
 
+#include "vtkCellData.h"
+#include "vtkCommunicator.h"
+#include "vtkDoubleArray.h"
+#include "vtkEquivalenceSet.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Makes the points of each cell equivalent.
+class vtkLinkCellPoints
+{
+public:
+  vtkDataSet* Input;
+  vtkEquivalenceSet* Points;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* ptIds = this->CellPoints.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      this->Input->GetCellPoints(cellId, ptIds);
+      for (vtkIdType i = 1; i < ptIds->GetNumberOfIds(); ++i)
+      {
+        this->Points->AddEquivalence(ptIds->GetId(0), ptIds->GetId(i));
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Coordinates used to match points of different processes when there are no
+// global ids.
+struct vtkPointKey
+{
+  double X[3];
+
+  bool operator<(const vtkPointKey& other) const
+  {
+    return std::lexicographical_compare(this->X, this->X + 3, other.X, other.X + 3);
+  }
+};
+
+bool vtkInsideBounds(const double x[3], const double bounds[6])
+{
+  return x[0] >= bounds[0] && x[0] <= bounds[1] && x[1] >= bounds[2] && x[1] <= bounds[3] &&
+    x[2] >= bounds[4] && x[2] <= bounds[5];
+}
+}
+
 vtkStandardNewMacro(vtkPVConnectivityFilter);
+vtkCxxSetObjectMacro(vtkPVConnectivityFilter, Controller, vtkMultiProcessController);
 
+//----------------------------------------------------------------------------
 vtkPVConnectivityFilter::vtkPVConnectivityFilter()
 {
   this->ExtractionMode = VTK_EXTRACT_ALL_REGIONS;
   this->ColorRegions = 1;
+  this->GlobalRegionIds = false;
+  this->SortRegionsBySize = false;
+  this->Controller = NULL;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//----------------------------------------------------------------------------
+vtkPVConnectivityFilter::~vtkPVConnectivityFilter()
+{
+  this->SetController(NULL);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVConnectivityFilter::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (!this->GlobalRegionIds || this->ScalarConnectivity ||
+    (this->ExtractionMode != VTK_EXTRACT_ALL_REGIONS &&
+        this->ExtractionMode != VTK_EXTRACT_LARGEST_REGION))
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  vtkDataSet* input = vtkDataSet::GetData(inputVector[0], 0);
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::GetData(outputVector, 0);
+  return this->ExtractGlobalRegions(input, output);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVConnectivityFilter::ExtractGlobalRegions(vtkDataSet* input, vtkUnstructuredGrid* output)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+
+  // STEP 1: Label the points of this process. Points of a cell are
+  // equivalent, this is done concurrently.
+  vtkNew<vtkEquivalenceSet> pointSets;
+  pointSets->SetNumberOfMembers(numPts);
+  if (numCells > 0)
+  {
+    // GetCellPoints() is thread safe once the cells are built.
+    vtkNew<vtkGenericCell> cell;
+    input->GetCell(0, cell.GetPointer());
+
+    vtkLinkCellPoints linker;
+    linker.Input = input;
+    linker.Points = pointSets.GetPointer();
+    vtkSMPTools::For(0, numCells, linker);
+  }
+
+  // Number the local regions in order of their first cell. Points not used
+  // by any cell do not belong to any region.
+  std::vector<vtkIdType> pointRegions(numPts, -1);
+  std::vector<vtkIdType> cellRegions(numCells, -1);
+  std::vector<vtkIdType> setRegions(numPts, -1);
+  vtkIdType numLocalRegions = 0;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    input->GetCellPoints(cellId, ptIds.GetPointer());
+    if (ptIds->GetNumberOfIds() == 0)
+    {
+      continue;
+    }
+    vtkIdType set = pointSets->GetEquivalentSetId(ptIds->GetId(0));
+    if (setRegions[set] < 0)
+    {
+      setRegions[set] = numLocalRegions++;
+    }
+    cellRegions[cellId] = setRegions[set];
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+    {
+      pointRegions[ptIds->GetId(i)] = setRegions[set];
+    }
+  }
+
+  // STEP 2: Give each local region a global id.
+  vtkMultiProcessController* controller = this->Controller;
+  int numProcs = controller ? controller->GetNumberOfProcesses() : 1;
+  int myId = controller ? controller->GetLocalProcessId() : 0;
+  std::vector<vtkIdType> regionCounts(numProcs, numLocalRegions);
+  if (numProcs > 1)
+  {
+    controller->AllGather(&numLocalRegions, &regionCounts[0], 1);
+  }
+  vtkIdType offset = 0;
+  vtkIdType numRegions = 0;
+  for (int i = 0; i < numProcs; ++i)
+  {
+    offset += (i < myId) ? regionCounts[i] : 0;
+    numRegions += regionCounts[i];
+  }
+
+  // STEP 3: Find the regions touching regions of other processes. Only the
+  // points within the bounds of another process can be shared, these boundary
+  // points are gathered once, keyed by global id (or by coordinates when
+  // there are no global ids). Every process then merges the regions of
+  // matching keys the same way, giving the same global region ids everywhere.
+  vtkNew<vtkEquivalenceSet> regionSets;
+  regionSets->SetNumberOfMembers(numRegions);
+  if (numProcs > 1)
+  {
+    int hasGlobalIds = input->GetPointData()->GetGlobalIds() != NULL ? 1 : 0;
+    int useGlobalIds = 0;
+    controller->AllReduce(&hasGlobalIds, &useGlobalIds, 1, vtkCommunicator::MIN_OP);
+    vtkDataArray* globalIds = input->GetPointData()->GetGlobalIds();
+
+    double bounds[6];
+    input->GetBounds(bounds);
+    std::vector<double> allBounds(6 * numProcs);
+    controller->AllGather(bounds, &allBounds[0], 6);
+
+    // Overlap of the local bounds with the bounds of every other process.
+    std::vector<double> overlaps;
+    for (int proc = 0; numPts > 0 && proc < numProcs; ++proc)
+    {
+      double overlap[6];
+      bool empty = (proc == myId);
+      for (int i = 0; i < 3 && !empty; ++i)
+      {
+        overlap[2 * i] = std::max(bounds[2 * i], allBounds[6 * proc + 2 * i]);
+        overlap[2 * i + 1] = std::min(bounds[2 * i + 1], allBounds[6 * proc + 2 * i + 1]);
+        empty = overlap[2 * i] > overlap[2 * i + 1];
+      }
+      if (!empty)
+      {
+        overlaps.insert(overlaps.end(), overlap, overlap + 6);
+      }
+    }
+
+    vtkNew<vtkIdTypeArray> sendRegions;
+    vtkSmartPointer<vtkDataArray> sendKeys;
+    if (useGlobalIds)
+    {
+      sendKeys = vtkSmartPointer<vtkIdTypeArray>::New();
+    }
+    else
+    {
+      sendKeys = vtkSmartPointer<vtkDoubleArray>::New();
+      sendKeys->SetNumberOfComponents(3);
+    }
+    double x[3];
+    for (vtkIdType pt = 0; pt < numPts && !overlaps.empty(); ++pt)
+    {
+      if (pointRegions[pt] < 0)
+      {
+        continue;
+      }
+      input->GetPoint(pt, x);
+      bool boundary = false;
+      for (size_t i = 0; i < overlaps.size() && !boundary; i += 6)
+      {
+        boundary = vtkInsideBounds(x, &overlaps[i]);
+      }
+      if (!boundary)
+      {
+        continue;
+      }
+      sendRegions->InsertNextValue(pointRegions[pt] + offset);
+      if (useGlobalIds)
+      {
+        sendKeys->InsertNextTuple1(globalIds->GetTuple1(pt));
+      }
+      else
+      {
+        sendKeys->InsertNextTuple(x);
+      }
+    }
+
+    vtkNew<vtkIdTypeArray> recvRegions;
+    vtkSmartPointer<vtkDataArray> recvKeys;
+    recvKeys.TakeReference(sendKeys->NewInstance());
+    controller->AllGatherV(sendRegions.GetPointer(), recvRegions.GetPointer());
+    controller->AllGatherV(sendKeys, recvKeys);
+
+    // Sort the gathered points by key, points with the same key are the same
+    // point and their regions are equivalent.
+    vtkIdType numRecv = recvRegions->GetNumberOfTuples();
+    std::vector<vtkIdType> order(numRecv);
+    for (vtkIdType i = 0; i < numRecv; ++i)
+    {
+      order[i] = i;
+    }
+    if (useGlobalIds)
+    {
+      std::vector<vtkIdType> keys(numRecv);
+      for (vtkIdType i = 0; i < numRecv; ++i)
+      {
+        keys[i] = static_cast<vtkIdType>(recvKeys->GetTuple1(i));
+      }
+      std::sort(order.begin(), order.end(),
+        [&keys](vtkIdType a, vtkIdType b) { return keys[a] < keys[b]; });
+      for (vtkIdType i = 1; i < numRecv; ++i)
+      {
+        if (keys[order[i]] == keys[order[i - 1]])
+        {
+          regionSets->AddEquivalence(
+            recvRegions->GetValue(order[i - 1]), recvRegions->GetValue(order[i]));
+        }
+      }
+    }
+    else
+    {
+      std::vector<vtkPointKey> keys(numRecv);
+      for (vtkIdType i = 0; i < numRecv; ++i)
+      {
+        recvKeys->GetTuple(i, keys[i].X);
+      }
+      std::sort(order.begin(), order.end(),
+        [&keys](vtkIdType a, vtkIdType b) { return keys[a] < keys[b]; });
+      for (vtkIdType i = 1; i < numRecv; ++i)
+      {
+        if (!(keys[order[i - 1]] < keys[order[i]]))
+        {
+          regionSets->AddEquivalence(
+            recvRegions->GetValue(order[i - 1]), recvRegions->GetValue(order[i]));
+        }
+      }
+    }
+  }
+  vtkIdType numGlobalRegions = regionSets->ResolveEquivalences();
+
+  // STEP 4: Count the cells of each region over all processes.
+  std::vector<vtkIdType> localSizes(numGlobalRegions, 0);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (cellRegions[cellId] >= 0)
+    {
+      ++localSizes[regionSets->GetEquivalentSetId(cellRegions[cellId] + offset)];
+    }
+  }
+  std::vector<vtkIdType> sizes(localSizes);
+  if (numProcs > 1 && numGlobalRegions > 0)
+  {
+    controller->AllReduce(&localSizes[0], &sizes[0], numGlobalRegions, vtkCommunicator::SUM_OP);
+  }
+
+  // Final region id of each resolved set, by decreasing size if requested.
+  std::vector<vtkIdType> order(numGlobalRegions);
+  for (vtkIdType i = 0; i < numGlobalRegions; ++i)
+  {
+    order[i] = i;
+  }
+  if (this->SortRegionsBySize)
+  {
+    std::stable_sort(order.begin(), order.end(),
+      [&sizes](vtkIdType a, vtkIdType b) { return sizes[a] > sizes[b]; });
+  }
+  std::vector<vtkIdType> finalIds(numGlobalRegions);
+  this->RegionSizes->Reset();
+  for (vtkIdType i = 0; i < numGlobalRegions; ++i)
+  {
+    finalIds[order[i]] = i;
+    this->RegionSizes->InsertValue(i, sizes[order[i]]);
+  }
+
+  vtkIdType largestRegion = -1;
+  if (this->ExtractionMode == VTK_EXTRACT_LARGEST_REGION && numGlobalRegions > 0)
+  {
+    largestRegion = finalIds[std::max_element(sizes.begin(), sizes.end()) - sizes.begin()];
+  }
+
+  // STEP 5: Generate the output.
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* inCD = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  outPD->CopyAllocate(inPD);
+  outCD->CopyAllocate(inCD);
+
+  vtkNew<vtkPoints> newPts;
+  if (vtkPointSet* ps = vtkPointSet::SafeDownCast(input))
+  {
+    if (ps->GetPoints())
+    {
+      newPts->SetDataType(ps->GetPoints()->GetDataType());
+    }
+  }
+  vtkNew<vtkIdTypeArray> pointRegionIds;
+  pointRegionIds->SetName("RegionId");
+  vtkNew<vtkIdTypeArray> cellRegionIds;
+  cellRegionIds->SetName("RegionId");
+
+  output->Allocate(numCells);
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkNew<vtkIdList> newPtIds;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (cellRegions[cellId] < 0)
+    {
+      continue;
+    }
+    vtkIdType regionId = finalIds[regionSets->GetEquivalentSetId(cellRegions[cellId] + offset)];
+    if (largestRegion >= 0 && regionId != largestRegion)
+    {
+      continue;
+    }
+
+    input->GetCellPoints(cellId, ptIds.GetPointer());
+    newPtIds->SetNumberOfIds(ptIds->GetNumberOfIds());
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+    {
+      vtkIdType pt = ptIds->GetId(i);
+      if (pointMap[pt] < 0)
+      {
+        pointMap[pt] = newPts->InsertNextPoint(input->GetPoint(pt));
+        outPD->CopyData(inPD, pt, pointMap[pt]);
+        pointRegionIds->InsertValue(pointMap[pt], regionId);
+      }
+      newPtIds->SetId(i, pointMap[pt]);
+    }
+    vtkIdType newCellId = output->InsertNextCell(input->GetCellType(cellId), newPtIds.GetPointer());
+    outCD->CopyData(inCD, cellId, newCellId);
+    cellRegionIds->InsertValue(newCellId, regionId);
+  }
+  output->SetPoints(newPts.GetPointer());
+  output->Squeeze();
+
+  if (this->ColorRegions)
+  {
+    int idx = outPD->AddArray(pointRegionIds.GetPointer());
+    outPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+    outCD->AddArray(cellRegionIds.GetPointer());
+  }
+
+  vtkDebugMacro(<< "Extracted " << numGlobalRegions << " region(s) across " << numProcs
+                << " process(es)");
+  return 1;
 }
 
+//----------------------------------------------------------------------------
 void vtkPVConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "GlobalRegionIds: " << this->GlobalRegionIds << endl;
+  os << indent << "SortRegionsBySize: " << this->SortRegionsBySize << endl;
+  os << indent << "Controller: " << this->Controller << endl;
 }
@@ -20,6 +20,17 @@
  * changes the default settings.  We want different defaults than
  * vtkConnectivityFilter has, but we don't want the user to have access to
  * these parameters in the UI.
+ *
+ * It also adds a GlobalRegionIds mode for distributed data. Region ids
+ * computed by vtkConnectivityFilter are only unique within each process.
+ * In this mode, regions are labeled using multiple threads on each process.
+ * Regions touching regions of other processes, through points with the
+ * same global id (or the same coordinates when there are no global ids),
+ * are then merged so that region ids are consistent across all processes.
+ * Regions can optionally be numbered by decreasing size. This mode supports
+ * the VTK_EXTRACT_ALL_REGIONS and VTK_EXTRACT_LARGEST_REGION extraction
+ * modes without scalar connectivity. Other settings fall back to
+ * vtkConnectivityFilter.
 */
 
 #ifndef vtkPVConnectivityFilter_h
@@ -28,6 +39,10 @@
 #include "vtkConnectivityFilter.h"
 #include "vtkPVVTKExtensionsDefaultModule.h" //needed for exports
 
+class vtkDataSet;
+class vtkMultiProcessController;
+class vtkUnstructuredGrid;
+
 class VTKPVVTKEXTENSIONSDEFAULT_EXPORT vtkPVConnectivityFilter : public vtkConnectivityFilter
 {
 public:
@@ -36,9 +51,50 @@ public:
 
   static vtkPVConnectivityFilter* New();
 
+  //@{
+  /**
+   * When on, region ids are consistent across processes and regions are
+   * labeled using multiple threads. Off by default.
+   */
+  vtkSetMacro(GlobalRegionIds, bool);
+  vtkGetMacro(GlobalRegionIds, bool);
+  vtkBooleanMacro(GlobalRegionIds, bool);
+  //@}
+
+  //@{
+  /**
+   * When on, with GlobalRegionIds, region 0 is the region with the most
+   * cells across all processes, region 1 the next one and so on. Otherwise
+   * the order of the regions is unspecified. Off by default.
+   */
+  vtkSetMacro(SortRegionsBySize, bool);
+  vtkGetMacro(SortRegionsBySize, bool);
+  vtkBooleanMacro(SortRegionsBySize, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the controller used to resolve the regions across processes.
+   * Defaults to the global controller.
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  //@}
+
 protected:
   vtkPVConnectivityFilter();
-  ~vtkPVConnectivityFilter(){};
+  ~vtkPVConnectivityFilter();
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) VTK_OVERRIDE;
+
+  /**
+   * Computes globally consistent regions, see GlobalRegionIds.
+   */
+  int ExtractGlobalRegions(vtkDataSet* input, vtkUnstructuredGrid* output);
+
+  bool GlobalRegionIds;
+  bool SortRegionsBySize;
+  vtkMultiProcessController* Controller;
 
 private:
   vtkPVConnectivityFilter(const vtkPVConnectivityFilter&) VTK_DELETE_FUNCTION;
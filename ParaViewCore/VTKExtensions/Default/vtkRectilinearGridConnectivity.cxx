@@ -115,11 +115,11 @@ public:
 class vtkRectilinearGridConnectivityFace
 {
 public:
-  // It is currently assumed that there are not so many blocks, fragments, and
-  // processes. In case this assumption does not hold, 'short' needs to be
-  // changed to 'int'
-  short BlockId;       // for intra-process inter-block fragments extraction
-  short FragmentId;    // for any level fragments extraction
+  // It is currently assumed that there are not so many blocks and processes.
+  // In case this assumption does not hold, 'short' needs to be changed to
+  // 'int'. Fragment ids come from vtkEquivalenceSet and are not narrowed.
+  short BlockId;        // for intra-process inter-block fragments extraction
+  vtkIdType FragmentId; // for any level fragments extraction
   short ProcessId;     // for inter-process fragments extraction
   vtkIdType PolygonId; // for any level fragments extraction
                        // global index of the face / polygon in a vtkPolyData
@@ -2261,8 +2261,8 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
   int numArays = 0;
   int tupleSiz = 0;        // number of integrated components
   int newIndex = 0;        // index of a new face
-  int fragIndx = 1;        // next fragment Id and 0 for removing faces
-  int minIndex = 1;        // the smallest fragment Id so far
+  vtkIdType fragIndx = 1;  // next fragment Id and 0 for removing faces
+  vtkIdType minIndex = 1;  // the smallest fragment Id so far
   int* numComps = NULL;    // number of integrated components
   double* tupleBuf = NULL; // integrated component values
   double** attrPtrs = NULL;
@@ -2475,7 +2475,7 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
 
 //-----------------------------------------------------------------------------
 void vtkRectilinearGridConnectivity::IntegrateFragmentAttributes(
-  int fragIndx, int numComps, double* attrVals)
+  vtkIdType fragIndx, int numComps, double* attrVals)
 {
   // note this function may be called with non-successive values of fragIndx
 
@@ -2786,7 +2786,7 @@ void vtkRectilinearGridConnectivity::ExtractFragmentPolygons(int blockIdx, int&
       // add the original face to the output vtkPolyData (the PolygonId is
       // not useful any more and is ignored below)
       cellIndx = plyCells->InsertNextCell(numbPnts, facePIds);
-      fragIdxs->InsertValue(cellIndx, thisFace->FragmentId);
+      fragIdxs->InsertValue(cellIndx, static_cast<int>(thisFace->FragmentId));
       this->FragmentValues->GetTypedTuple(thisFace->FragmentId, tupleBuf);
       for (theShift = 0, i = 0; i < numArays; i++)
       {
@@ -2902,8 +2902,8 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(
   int numArays = 0;
   int tupleSiz = 0;        // number of integrated components
   int newIndex = 0;        // index of a new face of the local fragment
-  int minIndex = 1;        // the smallest (inter-block) fragment Id
-  int fragIndx = 1;        // next inter-block fragment Id and 0 for
+  vtkIdType minIndex = 1;  // the smallest (inter-block) fragment Id
+  vtkIdType fragIndx = 1;  // next inter-block fragment Id and 0 for
                            // removing faces
   int* lfIdsPtr = NULL;    // array of local fragment Ids
   int* numComps = NULL;    // number of integrated components
@@ -3313,7 +3313,7 @@ void vtkRectilinearGridConnectivity::GenerateOutputFromSingleProcess(
 
         // add the original face to the output vtkPolyData
         polygons->InsertNextCell(numbPnts, facePIds);
-        fragIdxs->InsertNextValue(thisFace->FragmentId);
+        fragIdxs->InsertNextValue(static_cast<int>(thisFace->FragmentId));
         partIdxs->InsertNextValue(partIndx);
         this->FragmentValues->GetTypedTuple(thisFace->FragmentId, tupleBuf);
         for (theShift = 0, i = 0; i < numArays; i++)
@@ -3572,8 +3572,8 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
   int numArays = 0;
   int tupleSiz = 0;        // number of integrated components
   int newIndex = 0;        // index of a new face of a local fragment
-  int minIndex = 1;        // the smallest (inter-process) fragment Id
-  int fragIndx = 1;        // next inter-process fragment Id and 0 for
+  vtkIdType minIndex = 1;  // the smallest (inter-process) fragment Id
+  vtkIdType fragIndx = 1;  // next inter-process fragment Id and 0 for
                            // removing faces
   int* fIdxsPtr = NULL;    // array of local fragment Ids
   int* numComps = NULL;    // number of integrated components
@@ -3989,7 +3989,7 @@ void vtkRectilinearGridConnectivity::GenerateOutputFromMultiProcesses(
         // add the original polygon and the associated cell data attributes of
         // interest to the output vtkPolyData
         polygons->InsertNextCell(numbPnts, facePIds);
-        fragIdxs->InsertNextValue(thisFace->FragmentId);
+        fragIdxs->InsertNextValue(static_cast<int>(thisFace->FragmentId));
         procIdxs->InsertNextValue(thisFace->ProcessId);
         partIdxs->InsertNextValue(partIndx);
         this->FragmentValues->GetTypedTuple(thisFace->FragmentId, tupleBuf);
@@ -248,7 +248,7 @@ protected:
    * different sub-volumes or macro-volumes belonging to the same fragment
    * have their integrated results summed together.
    */
-  void IntegrateFragmentAttributes(int fragIndx, int numComps, double* attrVals);
+  void IntegrateFragmentAttributes(vtkIdType fragIndx, int numComps, double* attrVals);
 
   /**
    * This function resolves the equivalence set (intra-process intra-block,
@@ -0,0 +1,197 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestKdTreeReuseMPI.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkKdTreeManager reuses the cuts of the previous build when the
+// data barely moved, and that vtkOrderedCompositeDistributor then only
+// migrates the cells that left the regions of their process.
+#include "vtkIdList.h"
+#include "vtkKdTreeManager.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkOrderedCompositeDistributor.h"
+#include "vtkPKdTree.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "mpi.h"
+
+namespace
+{
+// Exposes ClassifyCells().
+class vtkTestDistributor : public vtkOrderedCompositeDistributor
+{
+public:
+  static vtkTestDistributor* New();
+  vtkTypeMacro(vtkTestDistributor, vtkOrderedCompositeDistributor);
+
+  void Classify(vtkDataSet* input, vtkIdList* retained, vtkIdList* migrated)
+  {
+    this->ClassifyCells(input, retained, migrated);
+  }
+};
+vtkStandardNewMacro(vtkTestDistributor);
+
+const int POINTS_PER_PROCESS = 8;
+
+// Adds vertex cells at x = 0.5 + i for the points `first` to `first + count`
+// of the row of 8 points per process, moved towards the center of the row by
+// `shrink`. Vertices never straddle a cut, so the number of cells is kept by
+// the redistribution.
+void AddVertices(
+  vtkUnstructuredGrid* grid, vtkPoints* points, int first, int count, int numProcs, double shrink)
+{
+  const double center = 0.5 * POINTS_PER_PROCESS * numProcs;
+  for (int i = first; i < first + count; ++i)
+  {
+    double x = center + (0.5 + i - center) * (1.0 - shrink);
+    vtkIdType ptId = points->InsertNextPoint(x, i % 2, (i / 2) % 2);
+    grid->InsertNextCell(VTK_VERTEX, 1, &ptId);
+  }
+}
+
+vtkIdType Sum(vtkMultiProcessController* controller, vtkIdType value)
+{
+  vtkIdType result = 0;
+  controller->AllReduce(&value, &result, 1, vtkCommunicator::SUM_OP);
+  return result;
+}
+
+bool TestReuse(vtkMultiProcessController* controller)
+{
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+  const vtkIdType numPoints = POINTS_PER_PROCESS * numProcs;
+
+  // Failures do not return early, the next steps are collective.
+  bool success = true;
+
+  // First timestep: each process has its own part of the row.
+  vtkNew<vtkUnstructuredGrid> first;
+  vtkNew<vtkPoints> firstPoints;
+  first->Allocate(POINTS_PER_PROCESS);
+  AddVertices(first.GetPointer(), firstPoints.GetPointer(), POINTS_PER_PROCESS * myId,
+    POINTS_PER_PROCESS, numProcs, 0.0);
+  first->SetPoints(firstPoints.GetPointer());
+
+  vtkNew<vtkKdTreeManager> manager;
+  manager->SetReuseCutsTolerance(0.01);
+  manager->AddDataObject(first.GetPointer());
+  if (!manager->GenerateKdTree())
+  {
+    cerr << "ERROR: the first kd-tree was not built on process " << myId << endl;
+    success = false;
+  }
+  vtkMTimeType cutsTime = manager->GetKdTree()->GetMTime();
+
+  // Second timestep: the data moved slightly and half of each part is now on
+  // the previous process.
+  vtkNew<vtkUnstructuredGrid> second;
+  vtkNew<vtkPoints> secondPoints;
+  second->Allocate(POINTS_PER_PROCESS);
+  const double shrink = 0.002;
+  AddVertices(second.GetPointer(), secondPoints.GetPointer(), POINTS_PER_PROCESS * myId,
+    POINTS_PER_PROCESS / 2, numProcs, shrink);
+  AddVertices(second.GetPointer(), secondPoints.GetPointer(),
+    POINTS_PER_PROCESS * ((myId + 1) % numProcs) + POINTS_PER_PROCESS / 2, POINTS_PER_PROCESS / 2,
+    numProcs, shrink);
+  second->SetPoints(secondPoints.GetPointer());
+
+  manager->RemoveAllDataObjects();
+  manager->AddDataObject(second.GetPointer());
+  if (manager->GenerateKdTree() || manager->GetKdTree()->GetMTime() != cutsTime)
+  {
+    cerr << "ERROR: the cuts were not reused on process " << myId << endl;
+    success = false;
+  }
+
+  vtkNew<vtkTestDistributor> distributor;
+  distributor->SetController(controller);
+  distributor->SetPKdTree(manager->GetKdTree());
+  distributor->SetOutputType("vtkUnstructuredGrid");
+  distributor->SetIncrementalRedistribution(true);
+  distributor->SetInputData(second.GetPointer());
+
+  vtkNew<vtkIdList> retained;
+  vtkNew<vtkIdList> migrated;
+  distributor->Classify(second.GetPointer(), retained.GetPointer(), migrated.GetPointer());
+  if (retained->GetNumberOfIds() + migrated->GetNumberOfIds() != second->GetNumberOfCells())
+  {
+    cerr << "ERROR: some cells were not classified on process " << myId << endl;
+    success = false;
+  }
+  if (Sum(controller, retained->GetNumberOfIds()) == 0 ||
+    (numProcs > 1 && Sum(controller, migrated->GetNumberOfIds()) == 0))
+  {
+    cerr << "ERROR: unexpected classification of the cells on process " << myId << endl;
+    success = false;
+  }
+
+  distributor->Update();
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(distributor->GetOutput());
+  vtkIdType numCells = output ? output->GetNumberOfCells() : 0;
+  if (Sum(controller, numCells) != numPoints)
+  {
+    cerr << "ERROR: the redistribution did not keep the " << numPoints << " cells" << endl;
+    success = false;
+  }
+
+  // Every cell must now lie in a region of its process.
+  if (output)
+  {
+    distributor->Classify(output, retained.GetPointer(), migrated.GetPointer());
+  }
+  if (!output || migrated->GetNumberOfIds() != 0)
+  {
+    cerr << "ERROR: cells left outside of the regions of process " << myId << endl;
+    success = false;
+  }
+
+  // Moving the data beyond the tolerance rebuilds the kd-tree.
+  manager->RemoveAllDataObjects();
+  vtkNew<vtkUnstructuredGrid> third;
+  vtkNew<vtkPoints> thirdPoints;
+  third->Allocate(POINTS_PER_PROCESS);
+  AddVertices(third.GetPointer(), thirdPoints.GetPointer(), POINTS_PER_PROCESS * myId,
+    POINTS_PER_PROCESS, numProcs, 0.5);
+  third->SetPoints(thirdPoints.GetPointer());
+  manager->AddDataObject(third.GetPointer());
+  if (!manager->GenerateKdTree())
+  {
+    cerr << "ERROR: the cuts were reused beyond the tolerance on process " << myId << endl;
+    success = false;
+  }
+  return success;
+}
+}
+
+int TestKdTreeReuseMPI(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv, 1);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int retVal = TestReuse(controller) ? 1 : 0;
+
+  int allRetVal = 0;
+  controller->AllReduce(&retVal, &allRetVal, 1, vtkCommunicator::MIN_OP);
+
+  vtkMultiProcessController::SetGlobalController(NULL);
+  controller->Finalize();
+  controller->Delete();
+
+  return !allRetVal;
+}
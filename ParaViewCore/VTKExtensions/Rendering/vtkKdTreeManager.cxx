@@ -19,6 +19,7 @@
 #include "vtkCompositeDataSet.h"
 #include "vtkExtentTranslator.h"
 #include "vtkKdTreeGenerator.h"
+#include "vtkMath.h"
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -28,6 +29,8 @@
 #include "vtkSphereSource.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <cmath>
 #include <set>
 #include <vector>
 
@@ -48,6 +51,11 @@ vtkKdTreeManager::vtkKdTreeManager()
   this->KdTree = 0;
   this->NumberOfPieces = globalController ? globalController->GetNumberOfProcesses() : 1;
   this->KdTreeInitialized = false;
+  this->ReuseCutsTolerance = 0.0;
+  this->LastBoundsValid = false;
+  this->LastNumberOfPieces = 0;
+  vtkMath::UninitializeBounds(this->LastBounds);
+  std::fill(this->LastWholeExtent, this->LastWholeExtent + 6, 0);
 
   vtkPKdTree* tree = vtkPKdTree::New();
   tree->SetController(globalController);
@@ -91,6 +99,7 @@ void vtkKdTreeManager::SetKdTree(vtkPKdTree* tree)
   {
     vtkSetObjectBodyMacro(KdTree, vtkPKdTree, tree);
     this->KdTreeInitialized = false;
+    this->LastBoundsValid = false;
   }
 }
 
@@ -106,8 +115,136 @@ void vtkKdTreeManager::SetStructuredDataInformation(vtkExtentTranslator* transla
 }
 
 //----------------------------------------------------------------------------
-void vtkKdTreeManager::GenerateKdTree()
+void vtkKdTreeManager::ClearStructuredDataInformation()
 {
+  if (this->ExtentTranslator)
+  {
+    this->ExtentTranslator = NULL;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkKdTreeManager::ComputeGlobalBounds(double bounds[6])
+{
+  vtkBoundingBox bbox;
+  if (this->ExtentTranslator)
+  {
+    bbox.AddPoint(this->Origin[0] + this->WholeExtent[0] * this->Spacing[0],
+      this->Origin[1] + this->WholeExtent[2] * this->Spacing[1],
+      this->Origin[2] + this->WholeExtent[4] * this->Spacing[2]);
+    bbox.AddPoint(this->Origin[0] + this->WholeExtent[1] * this->Spacing[0],
+      this->Origin[1] + this->WholeExtent[3] * this->Spacing[1],
+      this->Origin[2] + this->WholeExtent[5] * this->Spacing[2]);
+  }
+
+  for (vtkDataObjectSet::iterator iter = this->DataObjects->begin();
+       iter != this->DataObjects->end(); ++iter)
+  {
+    vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(iter->GetPointer());
+    if (cd)
+    {
+      vtkSmartPointer<vtkCompositeDataIterator> citer;
+      citer.TakeReference(cd->NewIterator());
+      for (citer->InitTraversal(); !citer->IsDoneWithTraversal(); citer->GoToNextItem())
+      {
+        vtkDataSet* ds = vtkDataSet::SafeDownCast(citer->GetCurrentDataObject());
+        if (ds && ds->GetNumberOfCells() > 0)
+        {
+          bbox.AddBounds(ds->GetBounds());
+        }
+      }
+    }
+    else if (vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetPointer()))
+    {
+      if (ds->GetNumberOfCells() > 0)
+      {
+        bbox.AddBounds(ds->GetBounds());
+      }
+    }
+  }
+
+  // An uninitialized vtkBoundingBox has its min point at VTK_DOUBLE_MAX and
+  // max point at VTK_DOUBLE_MIN, so it reduces correctly.
+  double localMin[3], localMax[3], globalMin[3], globalMax[3];
+  bbox.GetMinPoint(localMin[0], localMin[1], localMin[2]);
+  bbox.GetMaxPoint(localMax[0], localMax[1], localMax[2]);
+
+  vtkMultiProcessController* controller = this->KdTree->GetController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    controller->AllReduce(localMin, globalMin, 3, vtkCommunicator::MIN_OP);
+    controller->AllReduce(localMax, globalMax, 3, vtkCommunicator::MAX_OP);
+  }
+  else
+  {
+    std::copy(localMin, localMin + 3, globalMin);
+    std::copy(localMax, localMax + 3, globalMax);
+  }
+
+  if (globalMin[0] > globalMax[0] || globalMin[1] > globalMax[1] || globalMin[2] > globalMax[2])
+  {
+    vtkMath::UninitializeBounds(bounds);
+    return;
+  }
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    bounds[2 * cc] = globalMin[cc];
+    bounds[2 * cc + 1] = globalMax[cc];
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkKdTreeManager::CanReuseCuts(const double bounds[6])
+{
+  if (this->ReuseCutsTolerance <= 0.0 || !this->LastBoundsValid ||
+    this->KdTree->GetCuts() == NULL || !vtkMath::AreBoundsInitialized(const_cast<double*>(bounds)))
+  {
+    return false;
+  }
+
+  if (this->LastExtentTranslator != this->ExtentTranslator ||
+    this->LastNumberOfPieces != this->NumberOfPieces ||
+    (this->ExtentTranslator &&
+      !std::equal(this->WholeExtent, this->WholeExtent + 6, this->LastWholeExtent)))
+  {
+    return false;
+  }
+
+  // The outer bounds of the kd-tree regions are the bounds of the data used to
+  // build it. Don't reuse the cuts if the data has moved outside of them, since
+  // such cells would not belong to any region.
+  vtkBoundingBox lastBBox(this->LastBounds);
+  if (!lastBBox.ContainsPoint(bounds[0], bounds[2], bounds[4]) ||
+    !lastBBox.ContainsPoint(bounds[1], bounds[3], bounds[5]))
+  {
+    return false;
+  }
+
+  const double tolerance = this->ReuseCutsTolerance * lastBBox.GetDiagonalLength();
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    if (std::abs(bounds[cc] - this->LastBounds[cc]) > tolerance)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkKdTreeManager::GenerateKdTree()
+{
+  double bounds[6];
+  this->ComputeGlobalBounds(bounds);
+  if (this->CanReuseCuts(bounds))
+  {
+    // Leave the KdTree untouched, so that its MTime doesn't change and
+    // consumers don't need to redistribute data that has already been
+    // distributed with these cuts.
+    return false;
+  }
+
   this->KdTree->RemoveAllDataSets();
   if (!this->KdTreeInitialized)
   {
@@ -138,11 +275,12 @@ void vtkKdTreeManager::GenerateKdTree()
     // outline source with the right bounds so that vtkPKdTree is happy.
     vtkNew<vtkOutlineSource> outline;
     vtkBoundingBox bbox;
-    bbox.AddPoint(this->Origin);
-    bbox.AddPoint(
-      this->Origin[0] + (this->WholeExtent[1] - this->WholeExtent[0] + 1) * this->Spacing[0],
-      this->Origin[1] + (this->WholeExtent[3] - this->WholeExtent[2] + 1) * this->Spacing[1],
-      this->Origin[2] + (this->WholeExtent[5] - this->WholeExtent[4] + 1) * this->Spacing[2]);
+    bbox.AddPoint(this->Origin[0] + this->WholeExtent[0] * this->Spacing[0],
+      this->Origin[1] + this->WholeExtent[2] * this->Spacing[1],
+      this->Origin[2] + this->WholeExtent[4] * this->Spacing[2]);
+    bbox.AddPoint(this->Origin[0] + this->WholeExtent[1] * this->Spacing[0],
+      this->Origin[1] + this->WholeExtent[3] * this->Spacing[1],
+      this->Origin[2] + this->WholeExtent[5] * this->Spacing[2]);
     double bounds[6];
     bbox.GetBounds(bounds);
     outline->SetBounds(bounds);
@@ -166,7 +304,15 @@ void vtkKdTreeManager::GenerateKdTree()
   }
 
   this->KdTree->BuildLocator();
+  this->KdTree->Modified();
   // this->KdTree->PrintTree();
+
+  std::copy(bounds, bounds + 6, this->LastBounds);
+  this->LastBoundsValid = vtkMath::AreBoundsInitialized(bounds) != 0;
+  this->LastExtentTranslator = this->ExtentTranslator;
+  std::copy(this->WholeExtent, this->WholeExtent + 6, this->LastWholeExtent);
+  this->LastNumberOfPieces = this->NumberOfPieces;
+  return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -285,4 +431,5 @@ void vtkKdTreeManager::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "KdTree: " << this->KdTree << endl;
   os << indent << "NumberOfPieces: " << this->NumberOfPieces << endl;
+  os << indent << "ReuseCutsTolerance: " << this->ReuseCutsTolerance << endl;
 }
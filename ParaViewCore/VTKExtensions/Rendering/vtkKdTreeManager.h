@@ -60,6 +60,12 @@ public:
   void SetStructuredDataInformation(vtkExtentTranslator* translator, const int whole_extent[6],
     const double origin[3], const double spacing[3]);
 
+  /**
+   * Clears the structured data information set using
+   * SetStructuredDataInformation().
+   */
+  void ClearStructuredDataInformation();
+
   //@{
   /**
    * Get/Set the KdTree managed by this manager.
@@ -78,10 +84,26 @@ public:
   vtkGetMacro(NumberOfPieces, int);
   //@}
 
+  //@{
+  /**
+   * When non-zero, GenerateKdTree() keeps the cuts from the previous call
+   * instead of rebuilding the KdTree, provided the structured data information
+   * is unchanged and the global bounds of the data are contained in the bounds
+   * used for the previous build and differ from them by no more than this
+   * fraction of the bounding box diagonal. This is useful for time series where
+   * the spatial distribution of the data barely changes between timesteps.
+   * Default is 0 i.e. the KdTree is always rebuilt.
+   */
+  vtkSetClampMacro(ReuseCutsTolerance, double, 0.0, 1.0);
+  vtkGetMacro(ReuseCutsTolerance, double);
+  //@}
+
   /**
-   * Rebuilds the KdTree.
+   * Rebuilds the KdTree. Returns false if the KdTree was left untouched since
+   * the cuts from the previous build could be reused (see
+   * SetReuseCutsTolerance()).
    */
-  void GenerateKdTree();
+  bool GenerateKdTree();
 
 protected:
   vtkKdTreeManager();
@@ -90,9 +112,29 @@ protected:
   void AddDataObjectToKdTree(vtkDataObject* data);
   void AddDataSetToKdTree(vtkDataSet* data);
 
+  /**
+   * Computes the bounds of all data objects (or the structured data
+   * information, if any) across all processes.
+   */
+  void ComputeGlobalBounds(double bounds[6]);
+
+  /**
+   * Returns true if the cuts built for LastBounds can be reused for data with
+   * the given bounds.
+   */
+  bool CanReuseCuts(const double bounds[6]);
+
   bool KdTreeInitialized;
   vtkPKdTree* KdTree;
   int NumberOfPieces;
+  double ReuseCutsTolerance;
+
+  // Global bounds and structured data information used for the last build.
+  bool LastBoundsValid;
+  double LastBounds[6];
+  vtkSmartPointer<vtkExtentTranslator> LastExtentTranslator;
+  int LastWholeExtent[6];
+  int LastNumberOfPieces;
 
   vtkSmartPointer<vtkExtentTranslator> ExtentTranslator;
   double Origin[3];
@@ -25,20 +25,28 @@
 #include "vtkOrderedCompositeDistributor.h"
 #include "vtkPVConfig.h" // needed for PARAVIEW_USE_MPI
 
+#include "vtkAppendFilter.h"
 #include "vtkBSPCuts.h"
+#include "vtkBoundingBox.h"
 #include "vtkCallbackCommand.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSetSurfaceFilter.h"
+#include "vtkExtractCells.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPKdTree.h"
 #include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vector>
+
 #ifdef PARAVIEW_USE_MPI
 #include "vtkDistributedDataFilter.h"
 #endif
@@ -66,6 +74,7 @@ vtkOrderedCompositeDistributor::vtkOrderedCompositeDistributor()
   this->PKdTree = NULL;
   this->Controller = NULL;
   this->PassThrough = false;
+  this->IncrementalRedistribution = false;
   this->OutputType = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
@@ -85,6 +94,7 @@ void vtkOrderedCompositeDistributor::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PKdTree: " << this->PKdTree << endl;
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "PassThrough: " << this->PassThrough << endl;
+  os << indent << "IncrementalRedistribution: " << this->IncrementalRedistribution << endl;
   os << indent << "OutputType: " << (this->OutputType ? this->OutputType : "(none)") << endl;
 }
 
@@ -193,6 +203,42 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
 
   this->UpdateProgress(0.01);
 
+  // When redistributing incrementally, cells that are already on the process
+  // owning them are set aside and only the remaining ones are handed to D3.
+  vtkSmartPointer<vtkDataSet> toDistribute = input;
+  vtkSmartPointer<vtkDataSet> retainedData;
+  if (this->IncrementalRedistribution)
+  {
+    vtkNew<vtkIdList> retainedIds;
+    vtkNew<vtkIdList> migratedIds;
+    this->ClassifyCells(input, retainedIds.GetPointer(), migratedIds.GetPointer());
+
+    vtkIdType numMigrated = migratedIds->GetNumberOfIds();
+    vtkIdType totalMigrated = 0;
+    this->Controller->AllReduce(&numMigrated, &totalMigrated, 1, vtkCommunicator::SUM_OP);
+    if (totalMigrated == 0)
+    {
+      // Everything is already where it needs to be.
+      output->ShallowCopy(input);
+      return 1;
+    }
+
+    if (retainedIds->GetNumberOfIds() > 0)
+    {
+      vtkNew<vtkExtractCells> retainedExtractor;
+      retainedExtractor->SetInputData(input);
+      retainedExtractor->SetCellList(retainedIds.GetPointer());
+      retainedExtractor->Update();
+      retainedData = retainedExtractor->GetOutput();
+
+      vtkNew<vtkExtractCells> migratedExtractor;
+      migratedExtractor->SetInputData(input);
+      migratedExtractor->SetCellList(migratedIds.GetPointer());
+      migratedExtractor->Update();
+      toDistribute = migratedExtractor->GetOutput();
+    }
+  }
+
   vtkNew<vtkDistributedDataFilter> d3;
 
   // add progress observer.
@@ -202,7 +248,7 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
   d3->AddObserver(vtkCommand::ProgressEvent, cbc.GetPointer());
 
   d3->SetBoundaryModeToSplitBoundaryCells();
-  d3->SetInputData(input);
+  d3->SetInputData(toDistribute);
   d3->SetCuts(cuts);
 
   // We need to pass the region assignments from PKdTree to D3
@@ -213,7 +259,19 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
   // d3->SetClipAlgorithmType(vtkDistributedDataFilter::USE_TABLEBASEDCLIPDATASET);
   d3->Update();
 
-  vtkDataSet* distributedData = vtkDataSet::SafeDownCast(d3->GetOutputDataObject(0));
+  vtkSmartPointer<vtkDataSet> distributedData =
+    vtkDataSet::SafeDownCast(d3->GetOutputDataObject(0));
+  if (retainedData)
+  {
+    vtkNew<vtkAppendFilter> appender;
+    appender->AddInputData(retainedData);
+    if (distributedData && distributedData->GetNumberOfCells() > 0)
+    {
+      appender->AddInputData(distributedData);
+    }
+    appender->Update();
+    distributedData = appender->GetOutput();
+  }
   // D3 can result in certain processes having empty datasets. Since we use
   // internal methods on vtkDataSetSurfaceFilter, they are not empty-data safe
   // and hence can segfault. This check avoids such segfaults.
@@ -240,3 +298,45 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
 
   return 1;
 }
+
+//-----------------------------------------------------------------------------
+void vtkOrderedCompositeDistributor::ClassifyCells(
+  vtkDataSet* input, vtkIdList* retained, vtkIdList* migrated)
+{
+  retained->Reset();
+  migrated->Reset();
+
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkNew<vtkIntArray> regionIds;
+  this->PKdTree->GetRegionAssignmentList(
+    this->Controller->GetLocalProcessId(), regionIds.GetPointer());
+
+  std::vector<vtkBoundingBox> regions(regionIds->GetNumberOfTuples());
+  for (vtkIdType cc = 0; cc < regionIds->GetNumberOfTuples(); ++cc)
+  {
+    double bounds[6];
+    this->PKdTree->GetRegionBounds(regionIds->GetValue(cc), bounds);
+    regions[cc].SetBounds(bounds);
+  }
+
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    double bounds[6];
+    input->GetCellBounds(cellId, bounds);
+    vtkBoundingBox cellBBox(bounds);
+
+    bool owned = false;
+    for (size_t cc = 0; cc < regions.size() && !owned; ++cc)
+    {
+      owned = regions[cc].Contains(cellBBox) != 0;
+    }
+    if (owned)
+    {
+      retained->InsertNextId(cellId);
+    }
+    else
+    {
+      migrated->InsertNextId(cellId);
+    }
+  }
+}
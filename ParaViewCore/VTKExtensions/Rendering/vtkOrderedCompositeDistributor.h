@@ -48,6 +48,7 @@ class vtkBSPCuts;
 class vtkDataSet;
 class vtkDataSetSurfaceFilter;
 class vtkDistributedDataFilter;
+class vtkIdList;
 class vtkMultiProcessController;
 class vtkPKdTree;
 
@@ -84,6 +85,20 @@ public:
   vtkBooleanMacro(PassThrough, bool);
   //@}
 
+  //@{
+  /**
+   * When on, only cells that do not lie entirely within a kd-tree region
+   * assigned to the local process are migrated. Cells that already are on the
+   * process owning them are kept as is. If no process has cells to migrate,
+   * the data is passed through without communicating any cells. This makes
+   * redistributing data that barely moved, e.g. for successive timesteps
+   * distributed with the same kd-tree, much cheaper. Off by default.
+   */
+  vtkSetMacro(IncrementalRedistribution, bool);
+  vtkGetMacro(IncrementalRedistribution, bool);
+  vtkBooleanMacro(IncrementalRedistribution, bool);
+  //@}
+
   //@{
   /**
    * When non-null, the output will be converted to the given type.
@@ -98,6 +113,7 @@ protected:
 
   char* OutputType;
   bool PassThrough;
+  bool IncrementalRedistribution;
   vtkPKdTree* PKdTree;
   vtkMultiProcessController* Controller;
 
@@ -106,6 +122,13 @@ protected:
     vtkInformation*, vtkInformationVector**, vtkInformationVector*) VTK_OVERRIDE;
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) VTK_OVERRIDE;
 
+  /**
+   * Splits the cells of the input into the ones that lie entirely within one
+   * of the kd-tree regions assigned to this process (retained) and the rest
+   * (migrated).
+   */
+  void ClassifyCells(vtkDataSet* input, vtkIdList* retained, vtkIdList* migrated);
+
 private:
   vtkOrderedCompositeDistributor(const vtkOrderedCompositeDistributor&) VTK_DELETE_FUNCTION;
   void operator=(const vtkOrderedCompositeDistributor&) VTK_DELETE_FUNCTION;
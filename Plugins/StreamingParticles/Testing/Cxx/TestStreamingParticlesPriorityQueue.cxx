@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestStreamingParticlesPriorityQueue.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCamera.h"
+#include "vtkDummyController.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreamingParticlesPriorityQueue.h"
+
+#include <iostream>
+#include <set>
+
+#define TEST_ASSERT(cond)                                                                          \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    std::cerr << "ERROR: failed at line " << __LINE__ << ": " #cond << std::endl;                  \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Two levels of two blocks each, the second level refining the first one.
+// Composite ids are 0 and 1 for level 0 and 2 and 3 for level 1.
+void CreateMetaData(vtkMultiBlockDataSet* metadata)
+{
+  metadata->SetNumberOfBlocks(2);
+  for (unsigned int level = 0; level < 2; ++level)
+  {
+    vtkNew<vtkMultiBlockDataSet> levelMetaData;
+    levelMetaData->SetNumberOfBlocks(2);
+    for (unsigned int cc = 0; cc < 2; ++cc)
+    {
+      double bounds[6] = { static_cast<double>(cc), cc + 1.0, 0, 1, 0, 1 };
+      levelMetaData->GetMetaData(cc)->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(), bounds, 6);
+    }
+    metadata->SetBlock(level, levelMetaData.GetPointer());
+  }
+}
+
+// Data with the given leaves present, the others empty. Levels without any
+// leaf are left NULL.
+void CreateData(vtkMultiBlockDataSet* data, const std::set<unsigned int>& ids)
+{
+  data->SetNumberOfBlocks(2);
+  for (unsigned int level = 0; level < 2; ++level)
+  {
+    if (ids.lower_bound(2 * level) == ids.lower_bound(2 * level + 2))
+    {
+      continue;
+    }
+    vtkNew<vtkMultiBlockDataSet> levelData;
+    levelData->SetNumberOfBlocks(2);
+    for (unsigned int cc = 0; cc < 2; ++cc)
+    {
+      if (ids.count(2 * level + cc))
+      {
+        vtkNew<vtkPolyData> leaf;
+        levelData->SetBlock(cc, leaf.GetPointer());
+      }
+    }
+    data->SetBlock(level, levelData.GetPointer());
+  }
+}
+}
+
+int TestStreamingParticlesPriorityQueue(int, char* [])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkNew<vtkMultiBlockDataSet> metadata;
+  CreateMetaData(metadata.GetPointer());
+
+  vtkNew<vtkStreamingParticlesPriorityQueue> queue;
+  queue->SetController(controller.GetPointer());
+  queue->Initialize(metadata.GetPointer());
+
+  // A NULL level must not shift the ids of the next levels.
+  std::set<unsigned int> fine;
+  fine.insert(3);
+  vtkNew<vtkMultiBlockDataSet> fineData;
+  CreateData(fineData.GetPointer(), fine);
+  TEST_ASSERT(queue->GetBlockIds(fineData.GetPointer()) == fine);
+
+  // The coarse level delivered by the non-streaming pass.
+  std::set<unsigned int> coarse;
+  coarse.insert(0);
+  coarse.insert(1);
+  vtkNew<vtkMultiBlockDataSet> coarseData;
+  CreateData(coarseData.GetPointer(), coarse);
+  TEST_ASSERT(queue->GetBlockIds(coarseData.GetPointer()) == coarse);
+  queue->SetRequestedBlocks(coarse);
+
+  // Streaming refines the coarse blocks rather than requesting them again.
+  vtkNew<vtkCamera> camera;
+  camera->SetPosition(1, 0.5, 5);
+  camera->SetFocalPoint(1, 0.5, 0.5);
+  double planes[24];
+  camera->GetFrustumPlanes(1.0, planes);
+  queue->Update(planes);
+
+  TEST_ASSERT(queue->GetBlocksToPurge() == coarse);
+  std::set<unsigned int> requested;
+  while (!queue->IsEmpty())
+  {
+    requested.insert(queue->Pop());
+  }
+  std::set<unsigned int> refined;
+  refined.insert(2);
+  refined.insert(3);
+  TEST_ASSERT(requested == refined);
+
+  // Purging the coarse blocks leaves an empty coarse level.
+  queue->PurgeBlocks(coarseData.GetPointer(), queue->GetBlocksToPurge());
+  TEST_ASSERT(queue->GetBlockIds(coarseData.GetPointer()).empty());
+
+  // Purging data with a NULL level removes the right leaf.
+  std::set<unsigned int> purge;
+  purge.insert(3);
+  queue->PurgeBlocks(fineData.GetPointer(), purge);
+  TEST_ASSERT(queue->GetBlockIds(fineData.GetPointer()).empty());
+
+  return EXIT_SUCCESS;
+}
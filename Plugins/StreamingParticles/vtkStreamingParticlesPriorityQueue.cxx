@@ -371,9 +371,9 @@ unsigned int vtkStreamingParticlesPriorityQueue::Pop()
   {
     int myid = this->Controller->GetLocalProcessId();
     int num_ranks = this->Controller->GetNumberOfProcesses();
-    std::vector<unsigned int> items;
-    items.resize(num_ranks);
-    for (int i = 0; i < num_ranks; ++i)
+    // there may be fewer blocks left than processes
+    std::vector<unsigned int> items(num_ranks, VTK_UNSIGNED_INT_MAX);
+    for (int i = 0; i < num_ranks && !this->Internals->BlocksToRequest.empty(); ++i)
     {
       items[i] = this->Internals->BlocksToRequest.front();
       this->Internals->BlocksToRequest.pop();
@@ -431,6 +431,73 @@ const std::set<unsigned int>& vtkStreamingParticlesPriorityQueue::GetBlocksToPur
   return this->Internals->BlocksToPurge;
 }
 
+//----------------------------------------------------------------------------
+void vtkStreamingParticlesPriorityQueue::SetRequestedBlocks(const std::set<unsigned int>& blocks)
+{
+  this->Internals->BlocksRequested = blocks;
+}
+
+//----------------------------------------------------------------------------
+// Visits the leaves of `data`, numbered following the levels of `structure`.
+// The ids of the non-empty leaves are added to `ids` if given and the leaves
+// whose ids are in `purge` (if given) are removed.
+static void vtkVisitParticleBlocks(vtkMultiBlockDataSet* structure, vtkMultiBlockDataSet* data,
+  std::set<unsigned int>* ids, const std::set<unsigned int>* purge)
+{
+  unsigned int block_index = 0;
+  unsigned int num_levels = structure->GetNumberOfBlocks();
+  for (unsigned int level = 0; level < num_levels; level++)
+  {
+    vtkMultiBlockDataSet* levelStructure =
+      vtkMultiBlockDataSet::SafeDownCast(structure->GetBlock(level));
+    vtkMultiBlockDataSet* mb = level < data->GetNumberOfBlocks()
+      ? vtkMultiBlockDataSet::SafeDownCast(data->GetBlock(level))
+      : NULL;
+    unsigned int num_blocks = levelStructure ? levelStructure->GetNumberOfBlocks() : 0;
+    unsigned int num_data_blocks = mb ? mb->GetNumberOfBlocks() : 0;
+    for (unsigned int cc = 0; cc < num_blocks; cc++, block_index++)
+    {
+      if (cc >= num_data_blocks || mb->GetBlock(cc) == NULL)
+      {
+        continue;
+      }
+      if (ids)
+      {
+        ids->insert(block_index);
+      }
+      if (purge && purge->find(block_index) != purge->end())
+      {
+        mb->SetBlock(cc, NULL);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+std::set<unsigned int> vtkStreamingParticlesPriorityQueue::GetBlockIds(vtkMultiBlockDataSet* data)
+{
+  std::set<unsigned int> ids;
+  if (data)
+  {
+    vtkMultiBlockDataSet* structure =
+      this->Internals->Metadata ? this->Internals->Metadata.GetPointer() : data;
+    vtkVisitParticleBlocks(structure, data, &ids, NULL);
+  }
+  return ids;
+}
+
+//----------------------------------------------------------------------------
+void vtkStreamingParticlesPriorityQueue::PurgeBlocks(
+  vtkMultiBlockDataSet* data, const std::set<unsigned int>& blocks)
+{
+  if (data && !blocks.empty())
+  {
+    vtkMultiBlockDataSet* structure =
+      this->Internals->Metadata ? this->Internals->Metadata.GetPointer() : data;
+    vtkVisitParticleBlocks(structure, data, NULL, &blocks);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkStreamingParticlesPriorityQueue::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -87,6 +87,25 @@ public:
   // given the current view.
   const std::set<unsigned int>& GetBlocksToPurge() const;
 
+  // Description:
+  // Marks blocks as already requested, e.g. the coarsest level delivered by the
+  // input when no particular blocks were requested. These blocks are not
+  // requested again and are purged when a higher resolution of the same block
+  // is requested. Call after Initialize().
+  void SetRequestedBlocks(const std::set<unsigned int>& blocks);
+
+  // Description:
+  // Returns the composite ids, as returned by Pop(), of the non-empty leaves of
+  // `data`. Ids follow the structure of the meta-data given to Initialize() (or
+  // of `data` before that), so a level missing in `data` does not shift the ids
+  // of the levels after it.
+  std::set<unsigned int> GetBlockIds(vtkMultiBlockDataSet* data);
+
+  // Description:
+  // Removes the leaves of `data` whose composite ids, numbered as in
+  // GetBlockIds(), are in `blocks`.
+  void PurgeBlocks(vtkMultiBlockDataSet* data, const std::set<unsigned int>& blocks);
+
   // Description:
   // If this variable is set to true and the blocks have
   // vtkPGenericIOMultiBlockReader::BLOCK_AMOUNT_OF_DETAIL information, use this
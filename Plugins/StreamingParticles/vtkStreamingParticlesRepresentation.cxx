@@ -43,27 +43,6 @@
 
 static char const BLOCKS_TO_PURGE_ARRAY_NAME[] = "__blocks_to_purge";
 
-static inline void purge_blocks(
-  vtkMultiBlockDataSet* data, const std::set<unsigned int>& blocksToPurge)
-{
-  unsigned int block_index = 0;
-  unsigned int num_levels = data->GetNumberOfBlocks();
-  for (unsigned int level = 0; level < num_levels; level++)
-  {
-    vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(data->GetBlock(level));
-    assert(mb != NULL);
-
-    unsigned int num_blocks = mb->GetNumberOfBlocks();
-    for (unsigned int cc = 0; cc < num_blocks; cc++, block_index++)
-    {
-      if (blocksToPurge.find(block_index) != blocksToPurge.end())
-      {
-        mb->SetBlock(cc, NULL);
-      }
-    }
-  }
-}
-
 vtkStandardNewMacro(vtkStreamingParticlesRepresentation);
 //----------------------------------------------------------------------------
 vtkStreamingParticlesRepresentation::vtkStreamingParticlesRepresentation()
@@ -220,7 +199,7 @@ int vtkStreamingParticlesRepresentation::ProcessViewRequest(
         {
           blocksToPurge.insert(array->GetValue(i));
         }
-        purge_blocks(data, blocksToPurge);
+        this->PriorityQueue->PurgeBlocks(data, blocksToPurge);
       }
 
       // merge with what we are already rendering.
@@ -315,6 +294,25 @@ int vtkStreamingParticlesRepresentation::RequestData(
       vtkMultiBlockDataSet* metadata = vtkMultiBlockDataSet::SafeDownCast(
         inInfo->Get(vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA()));
       this->PriorityQueue->Initialize(metadata);
+
+      // The input delivered its default blocks (e.g. the coarsest level of a
+      // multi-resolution reader) which are rendered right away. Let the queue
+      // know so that streaming refines these blocks instead of loading them
+      // again.
+      vtkMultiBlockDataSet* input = vtkMultiBlockDataSet::GetData(inputVector[0], 0);
+      if (input)
+      {
+        std::set<unsigned int> loaded = this->PriorityQueue->GetBlockIds(input);
+        if (this->PriorityQueue->GetAnyProcessCanLoadAnyBlock())
+        {
+          // the queue is the same on all processes, so must be its state.
+          this->PriorityQueue->SetRequestedBlocks(this->GatherLoadedBlocks(loaded));
+        }
+        else
+        {
+          this->PriorityQueue->SetRequestedBlocks(loaded);
+        }
+      }
     }
   }
 
@@ -407,7 +405,7 @@ bool vtkStreamingParticlesRepresentation::StreamingUpdate(const double view_plan
 
     vtkMultiBlockDataSet* data = vtkMultiBlockDataSet::SafeDownCast(this->RenderedData);
 
-    purge_blocks(data, blocksToPurge);
+    this->PriorityQueue->PurgeBlocks(data, blocksToPurge);
 
     this->RenderedData->Modified();
     if (this->PriorityQueue->IsEmpty())
@@ -475,6 +473,35 @@ bool vtkStreamingParticlesRepresentation::StreamingUpdate(const double view_plan
   return true;
 }
 
+//----------------------------------------------------------------------------
+std::set<unsigned int> vtkStreamingParticlesRepresentation::GatherLoadedBlocks(
+  const std::set<unsigned int>& localBlocks)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (controller == NULL || controller->GetNumberOfProcesses() <= 1)
+  {
+    return localBlocks;
+  }
+
+  vtkNew<vtkUnsignedIntArray> localArray;
+  localArray->SetNumberOfTuples(static_cast<vtkIdType>(localBlocks.size()));
+  vtkIdType i = 0;
+  for (std::set<unsigned int>::const_iterator itr = localBlocks.begin();
+       itr != localBlocks.end(); ++itr, ++i)
+  {
+    localArray->SetValue(i, *itr);
+  }
+  vtkNew<vtkUnsignedIntArray> globalArray;
+  controller->AllGatherV(localArray.GetPointer(), globalArray.GetPointer());
+
+  std::set<unsigned int> blocks;
+  for (i = 0; i < globalArray->GetNumberOfTuples(); ++i)
+  {
+    blocks.insert(globalArray->GetValue(i));
+  }
+  return blocks;
+}
+
 //----------------------------------------------------------------------------
 bool vtkStreamingParticlesRepresentation::DetermineBlocksToStream()
 {
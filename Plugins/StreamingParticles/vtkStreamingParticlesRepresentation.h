@@ -25,6 +25,7 @@
 #include "vtkPVDataRepresentation.h"
 #include "vtkSmartPointer.h" // for smart pointer.
 #include "vtkWeakPointer.h"  // for weak pointer.
+#include <set>               // needed for std::set
 #include <vector>            // needed for std::vector
 
 class vtkCompositePolyDataMapper2;
@@ -180,6 +181,10 @@ protected:
   // current pass. Returns false if no blocks need to be streaming currently.
   bool DetermineBlocksToStream();
 
+  // Description:
+  // Returns the union over all processes of the blocks loaded locally.
+  std::set<unsigned int> GatherLoadedBlocks(const std::set<unsigned int>& localBlocks);
+
   // Description:
   // This is the data object generated processed by the most recent call to
   // RequestData() while not streaming.
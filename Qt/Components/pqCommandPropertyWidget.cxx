@@ -79,12 +79,12 @@ void pqCommandPropertyWidget::buttonClicked()
     {
       smproxy->InvokeCommand(pname);
 
-      // Update pipeline information, if possible, otherwise, simple update
-      // information properties.
+      // Update pipeline information, if possible, including that of the
+      // filters downstream, otherwise, simple update information properties.
       vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(smproxy);
       if (source)
       {
-        source->UpdatePipelineInformation();
+        source->UpdateDownstreamPipelineInformation();
       }
       else
       {
@@ -240,21 +240,36 @@ public:
   void triggerAutoApply() { this->AutoApplyTimer.start(pqPropertiesPanel::autoApplyDelay()); }
 
   //---------------------------------------------------------------------------
-  void updateInformationAndDomains()
+  // When `applied` is given, the information of the applied sources and of
+  // the filters downstream of them is updated as well, in a single request.
+  void updateInformationAndDomains(vtkCollection* applied = NULL)
   {
+    vtkNew<vtkCollection> sources;
     if (this->Source)
     {
       // this->Source->updatePipeline();
       vtkSMProxy* proxy = this->Source->getProxy();
-      if (vtkSMSourceProxy* sourceProxy = vtkSMSourceProxy::SafeDownCast(proxy))
+      if (vtkSMSourceProxy::SafeDownCast(proxy))
       {
-        sourceProxy->UpdatePipelineInformation();
+        sources->AddItem(proxy);
       }
       else
       {
         proxy->UpdatePropertyInformation();
       }
     }
+    if (applied)
+    {
+      for (int cc = 0; cc < applied->GetNumberOfItems(); ++cc)
+      {
+        sources->AddItem(applied->GetItemAsObject(cc));
+      }
+      vtkSMSourceProxy::UpdateDownstreamPipelineInformation(sources.GetPointer());
+    }
+    else
+    {
+      vtkSMSourceProxy::UpdatePipelineInformation(sources.GetPointer());
+    }
   }
 };
 
@@ -803,6 +818,7 @@ void pqPropertiesPanel::apply()
 
   bool onlyApplyCurrentPanel = vtkPVGeneralSettings::GetInstance()->GetAutoApplyActiveOnly();
 
+  vtkNew<vtkCollection> applied;
   if (onlyApplyCurrentPanel)
   {
     pqProxyWidgets* widgets =
@@ -810,6 +826,7 @@ void pqPropertiesPanel::apply()
     if (widgets)
     {
       widgets->apply(this->view());
+      applied->AddItem(widgets->Proxy->getProxy());
       emit this->applied(widgets->Proxy);
     }
   }
@@ -818,11 +835,12 @@ void pqPropertiesPanel::apply()
     foreach (pqProxyWidgets* widgets, this->Internals->SourceWidgets)
     {
       widgets->apply(this->view());
+      applied->AddItem(widgets->Proxy->getProxy());
       emit this->applied(widgets->Proxy);
     }
   }
 
-  this->Internals->updateInformationAndDomains();
+  this->Internals->updateInformationAndDomains(applied.GetPointer());
   this->updateButtonState();
 
   emit this->applied();
@@ -74,7 +74,8 @@ void pqProgressManager::onServerAdded(pqServer* server)
 {
   vtkPVProgressHandler* progressHandler = server->session()->GetProgressHandler();
 
-  pqCoreUtilities::connect(progressHandler, vtkCommand::StartEvent, this, SLOT(onStartProgress()));
+  pqCoreUtilities::connect(
+    progressHandler, vtkCommand::StartEvent, this, SLOT(onStartProgress(vtkObject*)));
   pqCoreUtilities::connect(progressHandler, vtkCommand::EndEvent, this, SLOT(onEndProgress()));
   pqCoreUtilities::connect(
     progressHandler, vtkCommand::ProgressEvent, this, SLOT(onProgress(vtkObject*)));
@@ -212,12 +213,18 @@ void pqProgressManager::setEnableProgress(bool enable)
 void pqProgressManager::triggerAbort()
 {
   emit this->abort();
+  if (this->ActiveHandler)
+  {
+    this->ActiveHandler->RequestAbort();
+  }
 }
 
 //-----------------------------------------------------------------------------
-void pqProgressManager::onStartProgress()
+void pqProgressManager::onStartProgress(vtkObject* caller)
 {
   this->ReadyEnableProgress = true;
+  this->ActiveHandler = vtkPVProgressHandler::SafeDownCast(caller);
+  this->setEnableAbort(true);
   emit progressStartEvent();
 }
 
@@ -225,6 +232,11 @@ void pqProgressManager::onStartProgress()
 void pqProgressManager::onEndProgress()
 {
   this->ReadyEnableProgress = false;
+  if (this->ActiveHandler)
+  {
+    this->ActiveHandler = NULL;
+    this->setEnableAbort(false);
+  }
   if (this->EnableProgress)
   {
     this->setEnableProgress(false);
@@ -272,6 +284,13 @@ void pqProgressManager::onProgress(vtkObject* caller)
     text = text.mid(3);
   }
   this->setProgress(text, oldProgress);
+
+  if (this->ActiveHandler && !this->ActiveHandler->GetAbortRequested())
+  {
+    // Let the abort button see the user clicking it. Key and mouse events on
+    // other widgets are blocked by eventFilter().
+    pqCoreUtilities::processEvents(QEventLoop::ExcludeSocketNotifiers);
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -37,7 +37,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <QObject>
 #include <QPointer>
 
+#include "vtkWeakPointer.h" // needed for vtkWeakPointer.
+
 class vtkObject;
+class vtkPVProgressHandler;
 class pqServer;
 /**
 * pqProgressManager is progress manager. It centralizes progress raising/
@@ -114,8 +117,8 @@ public slots:
   void setEnableAbort(bool);
 
   /**
-  * fires abort(). Must be called by the GUI that triggers
-  * abort.
+  * fires abort() and asks the server manager to abort the pipeline update in
+  * progress, if any. Must be called by the GUI that triggers abort.
   */
   void triggerAbort();
 
@@ -154,7 +157,7 @@ protected slots:
   /**
   * callbacks for signals fired from vtkProcessModule.
   */
-  void onStartProgress();
+  void onStartProgress(vtkObject*);
   void onEndProgress();
   void onProgress(vtkObject*);
   void onMessage(vtkObject*);
@@ -171,6 +174,10 @@ protected:
   bool ReadyEnableProgress;
   bool UnblockEvents;
 
+  // Progress handler of the update in progress, asked to abort it by
+  // triggerAbort().
+  vtkWeakPointer<vtkPVProgressHandler> ActiveHandler;
+
 private:
   Q_DISABLE_COPY(pqProgressManager)
 };
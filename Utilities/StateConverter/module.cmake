@@ -0,0 +1,6 @@
+vtk_module(vtkUtilitiesStateConverter
+  GROUPS
+    ParaViewCore
+  DEPENDS
+    vtkPVCommon
+  EXCLUDE_FROM_WRAPPING)
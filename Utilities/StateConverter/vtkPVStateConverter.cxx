@@ -0,0 +1,32 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVStateConverter.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVXMLBinarySerializer.h"
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    cerr << "Usage:\n"
+         << "    " << argv[0] << " [path to state file to convert] [path to output state file]\n"
+         << "Converts an XML state file (.pvsm) to the binary state format (.pvsb) or a binary\n"
+         << "state file to XML, depending on the format of the input file." << endl;
+    return -1;
+  }
+
+  bool status = vtkPVXMLBinarySerializer::IsBinary(argv[1])
+    ? vtkPVXMLBinarySerializer::ConvertBinaryToXML(argv[1], argv[2])
+    : vtkPVXMLBinarySerializer::ConvertXMLToBinary(argv[1], argv[2]);
+  return status ? 0 : -1;
+}
@@ -501,13 +501,15 @@ class SourceProxy(Proxy):
         else:
             self.SMProxy.UpdatePipeline()
         # This is here to cause a receive
-        # on the client side so that progress works properly.
+        # on the client side so that progress works properly. The information
+        # of this source and of the filters downstream of it, along with its
+        # data information, is updated with a single request.
         if ActiveConnection and ActiveConnection.IsRemote():
-            self.SMProxy.GetDataInformation()
+            self.SMProxy.UpdateDownstreamPipelineInformation()
 
     def FileNameChanged(self):
         "Called when the filename of a source proxy is changed."
-        self.UpdatePipelineInformation()
+        self.SMProxy.UpdateDownstreamPipelineInformation()
 
     def UpdatePipelineInformation(self):
         """This method updates the meta-data of the server-side VTK pipeline and
@@ -1785,7 +1787,10 @@ class ProxyManager(object):
         self.SMProxyManager.LoadXMLState(filename, loader)
 
     def SaveState(self, filename):
-        self.SMProxyManager.SaveXMLState(filename)
+        if filename.endswith(".pvsb"):
+            self.SMProxyManager.SaveBinaryState(filename)
+        else:
+            self.SMProxyManager.SaveXMLState(filename)
 
 class PropertyIterator(object):
     """Wrapper for a vtkSMPropertyIterator class to satisfy
@@ -1996,6 +2001,13 @@ class Connection(object):
            connection"""
         return self.Session.GetServerInformation().GetNumberOfProcesses()
 
+    def AbortUpdate(self):
+        """Requests that the pipeline update in progress on this connection be
+        aborted. Since Python is blocked during the update, this is meant to
+        be called from an observer of the progress events of
+        self.Session.GetProgressHandler()."""
+        self.Session.GetProgressHandler().RequestAbort()
+
     def AttachDefinitionUpdater(self):
         """Attach observer to automatically update modules when needed."""
         dfnMgr = self.Session.GetProxyDefinitionManager()
@@ -2019,7 +2031,8 @@ class Connection(object):
 
 def SaveState(filename):
     """Given a state filename, saves the state of objects registered
-    with the proxy manager."""
+    with the proxy manager. Files with the .pvsb extension are saved in
+    the binary state format."""
     pm = ProxyManager()
     pm.SaveState(filename)
 